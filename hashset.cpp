@@ -0,0 +1,286 @@
+/* 
+ * Copyright 2009 Core Security Technologies.
+ * 
+ * This file is part of turbodiff, an IDA plugin for analyzing differences
+ * between binary files.
+ * The plugin was designed and developed by Nicolas Economou, from the
+ * Exploit Writers team of Core Security Technologies.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License version 2
+ *  as published by the Free Software Foundation.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * For further details, see the file COPYING distributed with turbodiff.
+ */
+
+/****************************************************************************/
+/****************************************************************************/
+
+/* hashset.cpp */
+
+/****************************************************************************/
+/****************************************************************************/
+
+/* Includes */
+
+#include <stdlib.h>
+#include <string.h>
+
+/****************************************************************************/
+/****************************************************************************/
+
+/* Defines */
+
+/* Cantidad inicial de slots de la tabla ( siempre potencia de 2 ) */
+#define SLOTS_INICIALES 64
+
+/* Slot de la tabla sin elemento */
+#define SLOT_VACIO 0
+
+/****************************************************************************/
+/****************************************************************************/
+
+/* Definicion de las clases */
+
+class HashSet
+{
+private:
+  unsigned int len;
+  unsigned int capacidad;
+  unsigned int *elementos;
+  unsigned int cantidad_slots;
+  unsigned int *slots;
+
+private:
+  unsigned int Hash ( unsigned int );
+  unsigned int *Buscar_Slot ( unsigned int );
+  int Agrandar ( void );
+
+public:
+  HashSet ();
+  ~HashSet ();
+  unsigned int Len ( void );
+  int Add ( unsigned int );
+  int Find ( unsigned int );
+  unsigned int Get ( unsigned int );
+  int Clear ( void );
+};
+
+/****************************************************************************/
+/****************************************************************************/
+
+/* Metodos */
+
+/****************************************************************************/
+
+HashSet::HashSet ()
+{
+/* Seteo la longitud del set */
+  this -> len = 0;
+  this -> capacidad = 0;
+  this -> cantidad_slots = 0;
+
+/* Inicializo los elementos y la tabla */
+  this -> elementos = NULL;
+  this -> slots = NULL;
+}
+
+/****************************************************************************/
+
+HashSet::~HashSet ()
+{
+/* Libero los elementos y la tabla */
+  free ( this -> elementos );
+  free ( this -> slots );
+}
+
+/****************************************************************************/
+
+unsigned int HashSet::Len ( void )
+{
+/* Retorno la cantidad de elementos */
+  return ( this -> len );
+}
+
+/****************************************************************************/
+
+int HashSet::Add ( unsigned int elemento )
+{
+  unsigned int *nuevos_elementos;
+  unsigned int nueva_capacidad;
+  unsigned int *slot;
+
+/* Si el elemento ya esta en el set */
+  if ( this -> Find ( elemento ) == TRUE )
+  {
+  /* No lo vuelvo a agregar */
+    return ( FALSE );
+  }
+
+/* Si la tabla se llenaria mas de la mitad */
+  if ( ( this -> len + 1 ) * 2 > this -> cantidad_slots )
+  {
+  /* Si NO pude agrandar la tabla */
+    if ( this -> Agrandar () == FALSE )
+    {
+    /* Retorno ERROR */
+      return ( FALSE );
+    }
+  }
+
+/* Si NO hay lugar para un elemento mas */
+  if ( this -> len == this -> capacidad )
+  {
+  /* Duplico la capacidad para no realocar en cada elemento */
+    nueva_capacidad = ( this -> capacidad == 0 ) ? SLOTS_INICIALES / 2 : this -> capacidad * 2;
+    nuevos_elementos = ( unsigned int * ) realloc ( this -> elementos , nueva_capacidad * sizeof ( unsigned int ) );
+
+  /* Si NO pude agrandar los elementos */
+    if ( nuevos_elementos == NULL )
+    {
+    /* Retorno ERROR */
+      return ( FALSE );
+    }
+
+  /* Seteo los nuevos elementos */
+    this -> elementos = nuevos_elementos;
+    this -> capacidad = nueva_capacidad;
+  }
+
+/* Agrego el elemento en orden de llegada */
+  this -> elementos [ this -> len ] = elemento;
+  this -> len ++;
+
+/* El slot guarda la posicion del elemento + 1 ( 0 es slot vacio ) */
+  slot = this -> Buscar_Slot ( elemento );
+  *slot = this -> len;
+
+  return ( TRUE );
+}
+
+/****************************************************************************/
+
+int HashSet::Find ( unsigned int elemento )
+{
+/* Si la tabla esta vacia */
+  if ( this -> cantidad_slots == 0 )
+  {
+    return ( FALSE );
+  }
+
+/* El elemento esta si su slot NO esta vacio */
+  return ( ( *this -> Buscar_Slot ( elemento ) != SLOT_VACIO ) ? TRUE : FALSE );
+}
+
+/****************************************************************************/
+
+unsigned int HashSet::Get ( unsigned int pos )
+{
+  unsigned int elemento = 0;
+
+/* Si el elemento esta dentro del set */
+  if ( pos < this -> len )
+  {
+  /* Retorno el elemento de esa posicion ( orden de llegada ) */
+    elemento = this -> elementos [ pos ];
+  }
+
+  return ( elemento );
+}
+
+/****************************************************************************/
+
+int HashSet::Clear ( void )
+{
+  int ret = TRUE;
+
+/* Seteo la longitud del set */
+  this -> len = 0;
+  this -> capacidad = 0;
+  this -> cantidad_slots = 0;
+
+/* Libero los elementos y la tabla */
+  free ( this -> elementos );
+  free ( this -> slots );
+
+/* Inicializo los elementos y la tabla */
+  this -> elementos = NULL;
+  this -> slots = NULL;
+
+  return ( ret );
+}
+
+/****************************************************************************/
+
+unsigned int HashSet::Hash ( unsigned int elemento )
+{
+/* Mezclo los bits altos y bajos ( las direcciones suelen estar alineadas ) */
+  elemento = elemento ^ ( elemento >> 16 );
+  elemento = elemento * 0x45d9f3b;
+  elemento = elemento ^ ( elemento >> 16 );
+
+  return ( elemento );
+}
+
+/****************************************************************************/
+
+unsigned int *HashSet::Buscar_Slot ( unsigned int elemento )
+{
+  unsigned int mascara = this -> cantidad_slots - 1;
+  unsigned int pos;
+
+/* Arranco en el slot que le corresponde al elemento */
+  pos = this -> Hash ( elemento ) & mascara;
+
+/* Avanzo linealmente hasta encontrar el elemento o un slot vacio */
+  while ( ( this -> slots [ pos ] != SLOT_VACIO ) && ( this -> elementos [ this -> slots [ pos ] - 1 ] != elemento ) )
+  {
+    pos = ( pos + 1 ) & mascara;
+  }
+
+  return ( &this -> slots [ pos ] );
+}
+
+/****************************************************************************/
+
+int HashSet::Agrandar ( void )
+{
+  unsigned int *nuevos_slots;
+  unsigned int nueva_cantidad;
+  unsigned int pos;
+
+/* Duplico la cantidad de slots */
+  nueva_cantidad = ( this -> cantidad_slots == 0 ) ? SLOTS_INICIALES : this -> cantidad_slots * 2;
+  nuevos_slots = ( unsigned int * ) calloc ( nueva_cantidad , sizeof ( unsigned int ) );
+
+/* Si NO pude agrandar la tabla */
+  if ( nuevos_slots == NULL )
+  {
+  /* Retorno ERROR */
+    return ( FALSE );
+  }
+
+/* Cambio la tabla */
+  free ( this -> slots );
+  this -> slots = nuevos_slots;
+  this -> cantidad_slots = nueva_cantidad;
+
+/* Vuelvo a ubicar todos los elementos */
+  for ( pos = 0 ; pos < this -> len ; pos ++ )
+  {
+    *this -> Buscar_Slot ( this -> elementos [ pos ] ) = pos + 1;
+  }
+
+  return ( TRUE );
+}
+
+/****************************************************************************/
+/****************************************************************************/
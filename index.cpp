@@ -0,0 +1,287 @@
+/* 
+ * Copyright 2009 Core Security Technologies.
+ * 
+ * This file is part of turbodiff, an IDA plugin for analyzing differences
+ * between binary files.
+ * The plugin was designed and developed by Nicolas Economou, from the
+ * Exploit Writers team of Core Security Technologies.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License version 2
+ *  as published by the Free Software Foundation.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * For further details, see the file COPYING distributed with turbodiff.
+ */
+
+/****************************************************************************/
+/****************************************************************************/
+
+/* index.cpp */
+
+/****************************************************************************/
+/****************************************************************************/
+
+/* Includes */
+
+#include <stdlib.h>
+
+/****************************************************************************/
+/****************************************************************************/
+
+/* Estructuras */
+
+typedef struct
+{
+  unsigned int clave;
+  unsigned int orden;
+  void *valor;
+} Entrada_Indice;
+
+/****************************************************************************/
+/****************************************************************************/
+
+/* Definicion de las clases */
+
+class Index
+{
+private:
+  int ordenado;
+  unsigned int len;
+  unsigned int capacidad;
+  Entrada_Indice *entradas;
+
+private:
+  static int Comparar_Entradas ( const void * , const void * );
+
+public:
+  Index ();
+  ~Index ();
+  unsigned int Len ( void );
+  int Add ( unsigned int , void * );
+  unsigned int GetKey ( unsigned int );
+  void *Get ( unsigned int );
+  void Sort ( void );
+  int Find ( unsigned int , unsigned int * );
+  int Clear ( void );
+};
+
+/****************************************************************************/
+/****************************************************************************/
+
+/* Metodos */
+
+/****************************************************************************/
+
+Index::Index ()
+{
+/* El indice vacio esta ordenado */
+  this -> ordenado = TRUE;
+
+/* Seteo la longitud del indice */
+  this -> len = 0;
+  this -> capacidad = 0;
+
+/* Inicializo las entradas */
+  this -> entradas = NULL;
+}
+
+/****************************************************************************/
+
+Index::~Index ()
+{
+/* Libero las entradas */
+  free ( this -> entradas );
+}
+
+/****************************************************************************/
+
+unsigned int Index::Len ( void )
+{
+/* Retorno la cantidad de entradas */
+  return ( this -> len );
+}
+
+/****************************************************************************/
+
+int Index::Add ( unsigned int clave , void *valor )
+{
+  Entrada_Indice *nuevas_entradas;
+  unsigned int nueva_capacidad;
+  int ret = TRUE;
+
+/* Si NO hay lugar para una entrada mas */
+  if ( this -> len == this -> capacidad )
+  {
+  /* Duplico la capacidad para no realocar en cada entrada */
+    nueva_capacidad = ( this -> capacidad == 0 ) ? 16 : this -> capacidad * 2;
+    nuevas_entradas = ( Entrada_Indice * ) realloc ( this -> entradas , nueva_capacidad * sizeof ( Entrada_Indice ) );
+
+  /* Si NO pude agrandar el indice */
+    if ( nuevas_entradas == NULL )
+    {
+    /* Retorno ERROR */
+      return ( FALSE );
+    }
+
+  /* Seteo las nuevas entradas */
+    this -> entradas = nuevas_entradas;
+    this -> capacidad = nueva_capacidad;
+  }
+
+/* Si la clave es menor que la ultima, pierdo el orden */
+  if ( ( this -> len > 0 ) && ( this -> entradas [ this -> len - 1 ].clave > clave ) )
+  {
+    this -> ordenado = FALSE;
+  }
+
+/* Agrego la entrada ( el orden de llegada desempata claves iguales ) */
+  this -> entradas [ this -> len ].clave = clave;
+  this -> entradas [ this -> len ].orden = this -> len;
+  this -> entradas [ this -> len ].valor = valor;
+  this -> len ++;
+
+  return ( ret );
+}
+
+/****************************************************************************/
+
+unsigned int Index::GetKey ( unsigned int pos )
+{
+  unsigned int clave = 0;
+
+/* Si la entrada esta dentro del indice */
+  if ( pos < this -> len )
+  {
+  /* Retorno la clave de esa posicion */
+    clave = this -> entradas [ pos ].clave;
+  }
+
+  return ( clave );
+}
+
+/****************************************************************************/
+
+void *Index::Get ( unsigned int pos )
+{
+  void *valor = NULL;
+
+/* Si la entrada esta dentro del indice */
+  if ( pos < this -> len )
+  {
+  /* Retorno el valor de esa posicion */
+    valor = this -> entradas [ pos ].valor;
+  }
+
+  return ( valor );
+}
+
+/****************************************************************************/
+
+void Index::Sort ( void )
+{
+/* Si el indice NO esta ordenado */
+  if ( this -> ordenado == FALSE )
+  {
+  /* Ordeno las entradas por clave */
+    qsort ( this -> entradas , this -> len , sizeof ( Entrada_Indice ) , Index::Comparar_Entradas );
+
+  /* Marco el indice como ordenado */
+    this -> ordenado = TRUE;
+  }
+}
+
+/****************************************************************************/
+
+int Index::Find ( unsigned int clave , unsigned int *posicion )
+{
+  unsigned int cota_minima;
+  unsigned int cota_maxima;
+  unsigned int pos_actual;
+  int ret = FALSE;
+
+/* Me aseguro de que el indice este ordenado */
+  this -> Sort ();
+
+/* Seteo las cotas */
+  cota_minima = 0;
+  cota_maxima = this -> len;
+
+/* Busco la primera entrada con una clave mayor o igual a la buscada */
+  while ( cota_minima < cota_maxima )
+  {
+  /* Me posiciono en la mitad de las 2 cotas */
+    pos_actual = ( cota_minima + cota_maxima ) / 2;
+
+  /* Si la clave de la posicion es menor a la buscada */
+    if ( this -> entradas [ pos_actual ].clave < clave )
+    {
+      cota_minima = pos_actual + 1;
+    }
+    else
+    {
+      cota_maxima = pos_actual;
+    }
+  }
+
+/* Si encontre la clave */
+  if ( ( cota_minima < this -> len ) && ( this -> entradas [ cota_minima ].clave == clave ) )
+  {
+  /* Retorno la primera posicion con esa clave */
+    *posicion = cota_minima;
+
+  /* Retorno OK */
+    ret = TRUE;
+  }
+
+  return ( ret );
+}
+
+/****************************************************************************/
+
+int Index::Clear ( void )
+{
+  int ret = TRUE;
+
+/* Reinicializo el flag de indice ordenado */
+  this -> ordenado = TRUE;
+
+/* Seteo la longitud del indice */
+  this -> len = 0;
+  this -> capacidad = 0;
+
+/* Libero las entradas */
+  free ( this -> entradas );
+
+/* Inicializo las entradas */
+  this -> entradas = NULL;
+
+  return ( ret );
+}
+
+/****************************************************************************/
+
+int Index::Comparar_Entradas ( const void *entrada1 , const void *entrada2 )
+{
+  Entrada_Indice *e1 = ( Entrada_Indice * ) entrada1;
+  Entrada_Indice *e2 = ( Entrada_Indice * ) entrada2;
+
+/* Comparo por clave */
+  if ( e1 -> clave != e2 -> clave )
+  {
+    return ( ( e1 -> clave < e2 -> clave ) ? -1 : 1 );
+  }
+
+/* Desempato por orden de llegada */
+  return ( ( e1 -> orden < e2 -> orden ) ? -1 : ( e1 -> orden > e2 -> orden ) ? 1 : 0 );
+}
+
+/****************************************************************************/
+/****************************************************************************/
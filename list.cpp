@@ -29,6 +29,28 @@
 /****************************************************************************/
 /****************************************************************************/
 /*
+/* Defines */
+
+/* Elementos que entran en la lista sin pedir memoria */
+/* ( la mayoria de los basic blocks tienen hasta 2 hijos y 1 llamado ) */
+#define CAPACIDAD_INTERNA 4
+
+/****************************************************************************/
+/****************************************************************************/
+
+/* Estructuras */
+
+/* Formato de las propiedades de la lista en los files de analisis */
+typedef struct
+{
+  int ordenada;
+  unsigned int len;
+  void **elementos;
+} Propiedades_Lista;
+
+/****************************************************************************/
+/****************************************************************************/
+
 /* Prototipos */
 
 class List
@@ -36,11 +58,14 @@ class List
 private:
   int ordenada;
   unsigned int len;
+  unsigned int capacidad;
   void **elementos;
+  void *elementos_internos [ CAPACIDAD_INTERNA ];
 
 private:
   int Get_Element_By_Secuential_Search ( void * , unsigned int * );
   int Get_Element_By_Binary_Search ( void * , unsigned int * );
+  int Reservar ( unsigned int );
 
 public:
   List ();
@@ -61,6 +86,7 @@ public:
 /* Metodos para hacer PERSISTENCIA */
   int Save ( FILE * );
   int Load ( FILE * );
+  static int Skip ( FILE * );
 };
 
 /****************************************************************************/
@@ -83,6 +109,7 @@ int get_element_by_binary_search ( void * , unsigned int * );
 #ifdef _IDA_HPP
   #define fread(a,b,c,d) qfread(d,a,b)
   #define fwrite(a,b,c,d) qfwrite(d,a,b)
+  #define fseek(a,b,c) qfseek(a,b,c)
 #endif
 
 /****************************************************************************/
@@ -98,16 +125,21 @@ List::List ()
 /* Seteo la longitud de la lista */
   this -> len = 0;
 
-/* Inicializo la lista */
-  this -> elementos = NULL;
+/* Inicializo la lista con los elementos internos */
+  this -> capacidad = CAPACIDAD_INTERNA;
+  this -> elementos = this -> elementos_internos;
 }
 
 /****************************************************************************/
 
 List::~List ()
 {
-/* Libero la lista */
-  free ( this -> elementos );
+/* Si la lista se paso a memoria dinamica */
+  if ( this -> elementos != this -> elementos_internos )
+  {
+  /* Libero la lista */
+    free ( this -> elementos );
+  }
 }
 
 /****************************************************************************/
@@ -122,18 +154,18 @@ unsigned int List::Len ( void )
 
 unsigned int List::Add ( void *elemento )
 {
-  void *new_list;
-  unsigned int ultima_pos;
-
-/* Agrando la lista */
-  new_list = realloc ( this -> elementos , ( sizeof ( void * ) ) * ( this -> len + 1 ) ); 
+  unsigned int ultima_pos = 0;
+  int ret = TRUE;
 
-/* Si pude agrandar la lista */
-  if ( new_list != NULL )
+/* Si la lista esta llena, duplico su capacidad */
+  if ( this -> len == this -> capacidad )
   {
-  /* Seteo la nueva lista */
-    this -> elementos = ( void ** ) new_list;
+    ret = this -> Reservar ( this -> capacidad * 2 );
+  }
 
+/* Si hay lugar en la lista */
+  if ( ret == TRUE )
+  {
   /* Agrego el nuevo elemento */
     this -> elementos [ this -> len ] = elemento;
 
@@ -268,10 +300,7 @@ int List::Delete ( unsigned int pos )
       this -> elementos [ cont - 1 ] = this -> elementos [ cont ];
     }
 
-  /* Achico la lista */
-    this -> elementos = ( void ** ) realloc ( this -> elementos , ( sizeof ( void * ) ) * ( this -> len - 1 ) );
-
-  /* Seteo la nueva longitud de la lista */
+  /* Seteo la nueva longitud de la lista ( la capacidad queda para los proximos Add ) */
     this -> len --;
 
   /* Retorno OK */
@@ -313,11 +342,16 @@ int List::Clear ( void )
 /* Seteo la longitud de la lista */
   this -> len = 0;
 
-/* Libero la lista */
-  free ( this -> elementos );
+/* Si la lista se paso a memoria dinamica */
+  if ( this -> elementos != this -> elementos_internos )
+  {
+  /* Libero la lista */
+    free ( this -> elementos );
+  }
 
-/* Inicializo la lista */
-  this -> elementos = NULL;
+/* Vuelvo a los elementos internos */
+  this -> capacidad = CAPACIDAD_INTERNA;
+  this -> elementos = this -> elementos_internos;
 
   return ( ret );
 }
@@ -390,6 +424,45 @@ int List::Swap ( unsigned int pos1 , unsigned int pos2 )
 
 /****************************************************************************/
 
+int List::Reservar ( unsigned int capacidad )
+{
+  void **nuevos_elementos;
+  int ret = TRUE;
+
+/* Si ya hay lugar suficiente */
+  if ( capacidad <= this -> capacidad )
+  {
+    return ( TRUE );
+  }
+
+/* Alloco el nuevo espacio */
+  nuevos_elementos = ( void ** ) malloc ( capacidad * sizeof ( void * ) );
+
+/* Si NO hay memoria */
+  if ( nuevos_elementos == NULL )
+  {
+    return ( FALSE );
+  }
+
+/* Copio los elementos que ya tenia */
+  memcpy ( nuevos_elementos , this -> elementos , this -> len * sizeof ( void * ) );
+
+/* Si la lista ya estaba en memoria dinamica */
+  if ( this -> elementos != this -> elementos_internos )
+  {
+  /* Libero el espacio anterior */
+    free ( this -> elementos );
+  }
+
+/* Seteo el nuevo espacio */
+  this -> elementos = nuevos_elementos;
+  this -> capacidad = capacidad;
+
+  return ( ret );
+}
+
+/****************************************************************************/
+
 int List::Get_Element_By_Secuential_Search ( void *elemento , unsigned int *pos )
 {
   unsigned int cont;
@@ -477,10 +550,16 @@ int List::Get_Element_By_Binary_Search ( void *elemento , unsigned int *pos )
 
 int List::Save ( FILE *f )
 {
+  Propiedades_Lista propiedades;
   int ret = TRUE;
 
+/* Armo las propiedades del objeto ( los elementos internos no se guardan ) */
+  propiedades.ordenada = this -> ordenada;
+  propiedades.len = this -> len;
+  propiedades.elementos = NULL;
+
 /* Guardo las propiedades del objeto */
-  fwrite ( this , sizeof ( List ) , 1 , f );
+  fwrite ( &propiedades , sizeof ( Propiedades_Lista ) , 1 , f );
 
 /* Guardo la lista de todos los elementos */
   fwrite ( this -> elementos , this -> len * sizeof ( void * ) , 1 , f );
@@ -492,13 +571,24 @@ int List::Save ( FILE *f )
 
 int List::Load ( FILE *f )
 {
+  Propiedades_Lista propiedades;
   int ret = TRUE;
 
 /* Levanto las propiedades del objeto */
-  fread ( this , sizeof ( List ) , 1 , f );
+  fread ( &propiedades , sizeof ( Propiedades_Lista ) , 1 , f );
 
-/* Alloco espacio para todas las propiedades */
-  this -> elementos = ( void ** ) malloc ( this -> len * sizeof ( void * ) );
+/* Vacio la lista */
+  this -> Clear ();
+
+/* Me aseguro de tener espacio para todos los elementos */
+  if ( this -> Reservar ( propiedades.len ) == FALSE )
+  {
+    return ( FALSE );
+  }
+
+/* Seteo las propiedades */
+  this -> ordenada = propiedades.ordenada;
+  this -> len = propiedades.len;
 
 /* Levanto toda la lista de elementos */
   fread ( this -> elementos , this -> len * sizeof ( void * ) , 1 , f );
@@ -506,5 +596,21 @@ int List::Load ( FILE *f )
   return ( ret );
 }
 
+/****************************************************************************/
+
+int List::Skip ( FILE *f )
+{
+  Propiedades_Lista propiedades;
+  int ret = TRUE;
+
+/* Levanto las propiedades del objeto */
+  fread ( &propiedades , sizeof ( Propiedades_Lista ) , 1 , f );
+
+/* Salteo toda la lista de elementos */
+  fseek ( f , propiedades.len * sizeof ( void * ) , SEEK_CUR );
+
+  return ( ret );
+}
+
 /****************************************************************************/
 /****************************************************************************/
@@ -41,10 +41,13 @@
 #include <name.hpp>
 
 #include <windows.h>
+#include <psapi.h>
 #include <ctype.h>
 
 #include "list.cpp"
 #include "string.cpp"
+#include "index.cpp"
+#include "hashset.cpp"
 
 /****************************************************************************/ 
 /****************************************************************************/ 
@@ -53,7 +56,7 @@
 
 #define TD_VERSION        0x101B
 #define TD_RELEASE        0x01
-#define TD_SUBRELEASE     0x01
+#define TD_SUBRELEASE     0x07
 #define VERSION           ( TD_VERSION << 16 ) + ( TD_RELEASE << 8 ) + TD_SUBRELEASE
 
 #define NAME_LEN          256
@@ -69,6 +72,68 @@
 #define UNMATCHED1_MATCH  4
 #define UNMATCHED2_MATCH  5
 
+#define USE_SYMBOLS_OPTION  0x01
+#define INCREMENTAL_OPTION  0x02
+#define STREAM_RESULTS_OPTION 0x04
+
+#define UNDEFINED_FUNCTIONS_OPTION  0x01
+#define FUNCTION_STORE_OPTION       0x02
+
+#define ARCHIVO_ALMACEN       "turbodiff.tds"
+#define ARCHIVO_INDICE_ALMACEN "turbodiff.tdi"
+#define ARCHIVO_CORPUS        "turbodiff.tdx"
+#define MAX_RESULTADOS_CORPUS 50
+#define VOTO_CORPUS_GRAFO     16
+#define VOTO_CORPUS_CHECKSUM  32
+#define TABLA_CORPUS_GRAFO    0
+#define TABLA_CORPUS_CHECKSUM 1
+#define TABLA_CORPUS_BANDAS   2
+#define TABLAS_CORPUS         ( TABLA_CORPUS_BANDAS + BANDAS_LSH )
+#define EXTENSION_MANIFIESTO  "tdm"
+
+#define HASH_INICIAL      0x811c9dc5
+#define HASH_PRIMO        0x01000193
+
+#define ITERACIONES_WL    3
+
+#define PALABRAS_FILTRO         8
+#define BITS_FILTRO             ( PALABRAS_FILTRO * 32 )
+#define MIN_BITS_FILTRO         8
+#define MIN_SOLAPAMIENTO_FILTRO 25
+
+#define SIN_DOMINADOR     -1
+
+#define MAX_LARGO_ANCLA   256
+#define MIN_LARGO_ANCLA   4
+#define PREFIJO_IMPORT    "__imp_"
+
+#define SIN_PAREJA                0xffffffff
+#define MAX_PASADAS_PROPAGACION   8
+#define MAX_GRADO_PROPAGACION     64
+#define MAX_PROPORCION_BLOQUES    2
+
+#define CANTIDAD_MINHASH          16
+#define BANDAS_LSH                8
+#define FILAS_LSH                 ( CANTIDAD_MINHASH / BANDAS_LSH )
+#define CANDIDATOS_LSH            5
+#define MAX_BALDE_LSH             256
+#define MIN_COINCIDENCIAS_MINHASH ( CANTIDAD_MINHASH / 2 )
+
+#define PERIODO_CANCELACION     100
+#define PERIODO_PROGRESO        5000
+
+#define BENCHMARK_MIN_ARG       1
+#define BENCHMARK_MAX_ARG       4
+#define BENCHMARK_MIN_FUNCIONES 1000
+
+#define SERVICIO_ARG            0x10
+#define PIPE_SERVICIO           "\\\\.\\pipe\\turbodiff"
+#define MAX_PEDIDO_SERVICIO     4096
+#define MAX_CAMPOS_SERVICIO     8
+
+#define BASE_SINTETICA    0xa0000000
+#define SIN_SALTO         -1
+
 /****************************************************************************/ 
 /****************************************************************************/ 
 
@@ -86,10 +151,18 @@ typedef struct
   unsigned int peso;
   unsigned int pos_file_disasm;
 
-/* Properties usadas para recorrer el grafo */
+/* Estructura de dominadores y loops ( posiciones en el array de basic blocks ) */
+  int dominador;
+  unsigned int profundidad_loop;
+  int cabecera_loop;
+
+/* Properties usadas para recorrer el grafo ( visitado solo en las funciones sin grafo de programa ) */
   int visitado;
   int id;
 
+/* Posicion del basic block en el grafo del programa ( solo en memoria ) */
+  unsigned int indice;
+
 /* Properties usadas para diffear funciones */
   int association_id;
   int change_type;
@@ -106,6 +179,9 @@ typedef struct
 
 /* Concateno los basic blocks que estan conectados por JUMPs incodicionales */
   List *cadena_basic_blocks;
+
+/* Creo una lista PERSISTENTE con los hashes de los imports y strings referenciados */
+  List *anclas;
 } Basic_Block;
 
 typedef struct
@@ -122,6 +198,17 @@ typedef struct
   unsigned int pos;
 } Referencia_Vtable;
 
+typedef struct
+{
+/* Funcion padre ( en programa2 ), largo de la vtable y posicion en ella */
+  unsigned int padre;
+  unsigned int largo;
+  unsigned int ranura;
+
+/* Funcion apuntada por la ranura */
+  unsigned int funcion;
+} Ranura_Vtable;
+
 typedef struct
 {
 /* Datos generales de la funcion */
@@ -132,8 +219,11 @@ typedef struct
   unsigned int longitud;
   unsigned int checksum;
   unsigned int checksum_real;
+  unsigned int hash_contenido;
   unsigned int peso;
   char *graph_ecuation;
+  unsigned int hash_grafo;
+  unsigned int filtro [ PALABRAS_FILTRO ];
   int identica;
   int patcheada;
 
@@ -152,12 +242,211 @@ typedef struct
 /* Todas las referencias hijas */
   unsigned int cantidad_referencias_hijas;
 
+/* Grafo del programa al que pertenece la funcion y su posicion ( solo en memoria ) */
+  void *grafo;
+  unsigned int indice;
+
 /* Esto es solo decorativo, los valores se dumpean al file directamente */
   Basic_Block volcado_basic_blocks [ 0 ];
   Basic_Block_Padre volcado_basic_blocks_padres [ 0 ];
   Referencia_Vtable volcado_referencias_x_vtable;
 } Funcion;
 
+typedef struct
+{
+  unsigned int address;
+  unsigned int checksum;
+  unsigned int checksum_real;
+  unsigned int longitud;
+  unsigned int cantidad_basic_blocks;
+  unsigned int conexiones_internas;
+  unsigned int hash_cuerpo;
+} Huella_Funcion;
+
+typedef struct
+{
+/* Huella fuerte del contenido de la funcion ( 64 bits ) */
+  unsigned int huella [ 2 ];
+
+/* Posicion del registro de la funcion en el almacen */
+  unsigned int posicion;
+
+/* Basic blocks de la funcion ( en el manifiesto los siguen sus posiciones en el .dis ) */
+  unsigned int cantidad_basic_blocks;
+} Entrada_Almacen;
+
+typedef struct
+{
+/* Analisis del corpus y direccion de la funcion */
+  unsigned int archivo;
+  unsigned int address;
+
+/* Claves de busqueda: firma del grafo, checksum y bandas del minhash */
+  unsigned int hash_grafo;
+  unsigned int checksum;
+  unsigned int cantidad_basic_blocks;
+  unsigned int bandas [ BANDAS_LSH ];
+} Entrada_Corpus;
+
+typedef struct
+{
+/* Clave de busqueda y posicion de la entrada en el corpus */
+  unsigned int clave;
+  unsigned int entrada;
+} Clave_Corpus;
+
+typedef struct
+{
+/* Nombres de los analisis indexados */
+  unsigned int cantidad_archivos;
+  char ( *archivos ) [ QMAXPATH ];
+
+/* Funciones de todos los analisis */
+  unsigned int cantidad_entradas;
+  Entrada_Corpus *entradas;
+
+/* Tablas ( clave , entrada ) ordenadas por clave: grafo, checksum y una por banda */
+  unsigned int cantidad_claves [ TABLAS_CORPUS ];
+  Clave_Corpus *claves [ TABLAS_CORPUS ];
+} Corpus;
+
+typedef struct
+{
+/* Analisis cargado por el servicio */
+  char nombre [ QMAXPATH ];
+
+/* File abierto para levantar los cuerpos por demanda */
+  FILE *f;
+
+/* Indice de las funciones del analisis */
+  List indice_funciones;
+  List funciones;
+  List posiciones;
+} Analisis_Residente;
+
+typedef struct
+{
+  char nombre [ 64 ];
+  unsigned int tiempo;
+  unsigned int pares_examinados;
+  unsigned int llamados_predicado;
+  unsigned int matcheos;
+} Estadistica_Fase;
+
+typedef struct
+{
+/* Si hay una operacion en curso y si fue cancelada */
+  int activa;
+  int cancelada;
+
+/* Etapa que se esta ejecutando y unidades hechas sobre el total ( 0 si no se conoce ) */
+  char etapa [ 64 ];
+  unsigned int hechas;
+  unsigned int totales;
+
+/* Tiempos del ultimo aviso, de la ultima consulta al usuario y limite de la operacion ( 0 sin limite ) */
+  unsigned int ultimo_aviso;
+  unsigned int ultimo_chequeo;
+  unsigned int limite;
+} Progreso;
+
+typedef struct
+{
+/* Tipo de matcheo y funciones de la fila ( NULL si no hay funcion de ese lado ) */
+  unsigned int match_value;
+  Funcion *funcion1;
+  Funcion *funcion2;
+
+/* Columnas ya formateadas */
+  char direccion1 [ 12 ];
+  char direccion2 [ 12 ];
+  char *nombre1;
+  char *nombre2;
+} Fila_Resultado;
+
+typedef struct
+{
+/* Los nodos son las posiciones de las funciones en la lista del programa */
+  unsigned int cantidad_nodos;
+
+/* Funciones llamadas por cada nodo ( hijos [ inicio_hijos [ n ] .. inicio_hijos [ n + 1 ] ) ) */
+  unsigned int *inicio_hijos;
+  unsigned int *hijos;
+
+/* Funciones que llaman a cada nodo */
+  unsigned int *inicio_padres;
+  unsigned int *padres;
+} Grafo_Disperso;
+
+typedef struct
+{
+/* Lista de funciones a partir de la cual se armo el grafo */
+  List *lista_funciones;
+
+/* Funciones y basic blocks numerados en forma densa */
+  unsigned int cantidad_funciones;
+  unsigned int cantidad_basic_blocks;
+  Funcion **funciones;
+  Basic_Block **basic_blocks;
+
+/* Direccion de cada funcion -> funcion ( arbol binario en orden Eytzinger, desde 1 ) */
+  unsigned int *claves_eytzinger;
+  Funcion **funciones_eytzinger;
+
+/* Sucesores de cada basic block ( mismo orden que basic_blocks_hijos ) */
+  unsigned int *inicio_sucesores;
+  unsigned int *sucesores;
+
+/* Predecesores de cada basic block dentro de su funcion ( sin repetir ) */
+  unsigned int *inicio_predecesores;
+  unsigned int *predecesores;
+
+/* Funciones llamadas por cada basic block ( mismo orden que funciones_hijas ) */
+  unsigned int *inicio_llamados;
+  unsigned int *llamados;
+
+/* Checksums de los basic blocks ( se recorren sin tocar los Basic_Block ) */
+  unsigned int *checksums;
+
+/* Marcas de visita de los recorridos ( visitado si la marca es la epoca actual ) */
+  unsigned int *marcas_visita;
+  unsigned int epoca_visita;
+} Grafo_Programa;
+
+typedef struct
+{
+  unsigned int cantidad_funciones;
+  unsigned int max_basic_blocks;
+  unsigned int max_llamados;
+  unsigned int porcentaje_saltos;
+  unsigned int porcentaje_vtables;
+
+/* Porcentajes de funciones de la version siguiente */
+  unsigned int porcentaje_identicas;
+  unsigned int porcentaje_patcheadas;
+  unsigned int porcentaje_movidas;
+  unsigned int porcentaje_nuevas;
+} Parametros_Sinteticos;
+
+typedef struct
+{
+/* Identidad de la funcion, se mantiene entre versiones */
+  unsigned int id;
+
+/* Basic blocks de la funcion */
+  unsigned int cantidad_basic_blocks;
+  unsigned int *longitudes;
+  unsigned int *checksums;
+  int *saltos;
+
+/* Llamados a otras funciones ( basic block origen e id de la funcion llamada ) */
+  List *llamados_desde;
+  List *llamados_a;
+
+/* Ids de las funciones de la vtable referenciada desde el primer basic block */
+  List *vtable;
+} Funcion_Sintetica;
+
 /****************************************************************************/ 
 /****************************************************************************/ 
 
@@ -166,8 +455,11 @@ typedef struct
 int comparar_analisis ( void );
 int comparar_funciones ( int );
 
-int analizar_programa ( int );
+int analizar_programa ( int , char * );
 int analizar_funcion ( unsigned int , Funcion * );
+unsigned int calcular_hash_de_contenido ( unsigned int );
+int reutilizar_analisis_de_funcion ( Funcion * , Funcion * );
+int tiene_padres_reanalizados ( Funcion * , List & );
 int identificar_basic_blocks ( Funcion * , List & , unsigned int , unsigned int , unsigned int );
 int compactar_basic_blocks ( Funcion * , List & );
 int suprimir_basic_blocks_vacios ( Funcion * , List & );
@@ -178,6 +470,8 @@ int is_referencia_interna ( unsigned int , unsigned int , unsigned int * );
 int is_referencia_externa_por_codigo ( unsigned int );
 int is_referencia_externa_por_dato ( unsigned int );
 int is_call ( unsigned int , unsigned int * );
+unsigned int get_ancla_de_import ( unsigned int );
+unsigned int get_ancla_de_dato ( unsigned int );
 int is_llamado_a_funcion ( unsigned int , unsigned int * );
 int is_funcion ( unsigned int );
 int is_inicio_basic_block ( Funcion * , List & , unsigned int );
@@ -200,7 +494,7 @@ int get_funcion_padre ( unsigned int , unsigned int * );
 int is_ptr_a_funcion ( unsigned int , unsigned int * );
 int is_ptr_vtable ( unsigned int );
 List *get_funciones_de_vtable ( unsigned int );
-int get_funciones_undefined ( unsigned int , unsigned int , List & );
+int get_funciones_undefined ( unsigned int , HashSet & , List & );
 int get_referencias_fcode_from ( unsigned int , List & );
 int get_referencias_data_from ( unsigned int , List & );
 int get_referencias_to ( unsigned int , List & );
@@ -212,7 +506,10 @@ void setear_maxima_profundidad_hacia_abajo ( int , Funcion * , Basic_Block * );
 void setear_profundidad_hacia_arriba ( int , Funcion * , Basic_Block * );
 unsigned int setear_peso_a_basic_blocks ( unsigned int , Funcion * , Basic_Block * );
 void poner_ids_a_basic_blocks ( int , Funcion * , Basic_Block * );
+void calcular_dominadores ( Funcion * );
+int es_dominado ( int * , unsigned int , unsigned int );
 char *generar_ecuacion_de_grafo_de_funcion ( Funcion * );
+unsigned int calcular_hash_de_grafo ( Funcion * );
 Basic_Block *get_basic_block_by_id ( Funcion * , int );
 Basic_Block *get_basic_block_by_association_id ( Funcion * , int );
 void liberar_basic_blocks ( Funcion * );
@@ -220,20 +517,71 @@ void liberar_basic_blocks ( Funcion * );
 ///////////////////////
 
 int guardar_analisis ( char * );
+int guardar_funciones ( char * , List & );
+int guardar_funcion ( FILE * , Funcion * );
+int guardar_en_almacen ( char * , List & );
+FILE *reconstruir_analisis_desde_almacen ( char * );
+void guardar_datos_de_build ( FILE * , Funcion * );
+void levantar_datos_de_build ( FILE * , Funcion * );
+void desplazar_funcion ( Funcion * , unsigned int );
+void guardar_valores_de_lista ( FILE * , List * );
+void levantar_valores_de_lista ( FILE * , List * );
+FILE *abrir_almacen ( char * , int );
+int indexar_almacen ( FILE * , char * , Index & , List & );
+int guardar_indice_almacen ( FILE * , char * , List & );
+Entrada_Almacen *buscar_en_almacen ( Index & , unsigned int * );
+void calcular_huella_fuerte ( Funcion * , unsigned int * );
+void agregar_a_huella_fuerte ( unsigned int * , unsigned int );
+void agregar_lista_a_huella_fuerte ( unsigned int * , List * );
+FILE *abrir_analisis ( char * );
 int guardar_desensamblado ( char * );
 int guardar_desensamblado_de_funcion ( FILE * , Funcion * );
 char *get_instruction ( unsigned int , char * , unsigned int );
 
 ///////////////////////
 
-int comparar_files ( char * , char * , char * , int );
+int comparar_files ( char * , char * , char * , int , int , int , Analisis_Residente * , Analisis_Residente * );
+int levantar_funciones_a_comparar ( char * , Analisis_Residente * , List & , List & );
 void get_formated_name ( Funcion * , char * , unsigned int , int );
 int levantar_funciones ( FILE * , List & , List & );
+int levantar_cuerpo_de_funcion ( FILE * , Funcion * );
+void linkear_basic_blocks_padres ( List & , List & , Funcion * );
+int levantar_indice_de_funciones ( FILE * , List & , List & , List & );
+int saltear_cuerpo_de_funcion ( FILE * , Funcion * );
+int levantar_funcion_por_demanda ( FILE * , List & , List & , List & , Funcion * );
 int asociar_funciones ( int , Funcion * , Funcion * , List & , List & , List & , List & );
 int tienen_el_mismo_nombre ( Funcion * , Funcion * );
 int reconocer_funciones_con_misma_geometria ( List & , List & , List & , List & );
 unsigned int reconocer_funciones_x_vtables ( List & , List & , List & , List & , List & , List & );
-int son_funciones_equivalentes_x_vtables ( List & , List & , Funcion * , Funcion * );
+Funcion *get_pareja_x_vtables ( List & , List & , Index & , Index & , Index & , List & , Funcion * );
+void indexar_ranuras_de_vtables ( Funcion * , Index & , List & );
+unsigned int get_clave_de_ranura ( unsigned int , unsigned int , unsigned int );
+unsigned int reconocer_funciones_x_call_graph ( List & , List & , List & , List & , List & , List & );
+void elegir_candidatos_x_vecinos ( Grafo_Disperso * , Grafo_Disperso * , List & , List & , unsigned int * , unsigned int * , unsigned int * , unsigned int * );
+void armar_grafo_disperso ( List & , Grafo_Disperso * );
+void liberar_grafo_disperso ( Grafo_Disperso * );
+void armar_grafo_programa ( List & , Grafo_Programa * );
+void liberar_grafo_programa ( Grafo_Programa * );
+Grafo_Programa *get_grafo_de_lista ( List & );
+Basic_Block *get_basic_block_hijo ( Funcion * , Basic_Block * , unsigned int );
+Funcion *get_funcion_llamada ( List & , Funcion * , Basic_Block * , unsigned int );
+unsigned int llenar_indice_eytzinger ( Grafo_Programa * , Index & , unsigned int , unsigned int );
+Funcion *buscar_funcion_en_grafo ( Grafo_Programa * , unsigned int );
+void liberar_marcas_de_recorrido ( Funcion * );
+void marcar_basic_block_visitado ( Funcion * , Basic_Block * );
+int is_basic_block_visitado ( Funcion * , Basic_Block * );
+unsigned int *get_checksums_de_funcion ( Funcion * );
+void construir_filtro_de_funcion ( List & , List & , Funcion * );
+void agregar_a_filtro ( unsigned int * , unsigned int );
+int son_filtros_compatibles ( Funcion * , Funcion * );
+int son_tamanos_compatibles ( Funcion * , Funcion * );
+unsigned int contar_bits ( unsigned int );
+unsigned int reconocer_funciones_x_similitud ( List & , List & , List & , List & );
+unsigned int reconocer_funciones_x_anclas ( List & , List & , List & , List & , List & , List & );
+void indexar_anclas ( List & , Index & );
+Funcion *get_duena_de_ancla ( Index & , unsigned int );
+void calcular_minhash_de_funcion ( Funcion * , unsigned int * );
+int comparar_valores ( const void * , const void * );
 int son_funciones_iguales ( Funcion * , Funcion * );
 int son_funciones_cuasi_identicas ( Funcion * , Funcion * );
 int es_funcion_patcheada ( Funcion * , List & , Funcion ** );
@@ -244,14 +592,39 @@ int get_funcion_equivalente_x_hijos ( Funcion * , List & , List & , Funcion ** )
 int get_funcion_equivalente_x_hijos_x_padres_en_comun ( Funcion * , List & , List & , Funcion ** );
 int get_funcion_equivalente_x_hijos_x_unico_padre ( Funcion * , List & , List & , Funcion ** );
 int clasificar_funciones_cambiadas ( List & , List & , List & , List & );
+unsigned int reutilizar_comparacion_previa ( char * , char * );
+void iniciar_fase ( char * , ... );
+void terminar_fase ( void );
+void iniciar_operacion ( void );
+int terminar_operacion ( void );
+void iniciar_progreso ( char * , unsigned int );
+void fijar_total_progreso ( unsigned int );
+void fijar_avance_progreso ( unsigned int );
+int avanzar_progreso ( unsigned int );
+void cancelar_operacion ( void );
+int is_operacion_cancelada ( void );
+int guardar_estadisticas ( char * , char * , char * , unsigned int );
+void escapar_string_json ( char * , char * , unsigned int );
+int abrir_stream_resultados ( char * );
+void cerrar_stream_resultados ( void );
+void emitir_registro_resultado ( char * , Funcion * , Funcion * , unsigned int );
+unsigned int get_similitud_de_filtros ( Funcion * , Funcion * );
+int es_huella_vigente ( List & , List & , Funcion * );
 
 ///////////////////////
 
 /* Funciones asociadas con el muestreo de los resultados */
 
 int armar_resultados ( void );
+void agregar_fila_resultado ( unsigned int , Funcion * , Funcion * );
+void liberar_filas_resultados ( void );
 int guardar_resultados ( char * , char * );
 int levantar_resultados ( char * , char * );
+int guardar_huellas ( FILE * , List & );
+int levantar_huellas ( FILE * , List & , List & );
+void liberar_huellas ( void );
+void calcular_huella_de_funcion ( Funcion * , Huella_Funcion * );
+unsigned int calcular_hash ( unsigned int , void * , unsigned int );
 int mostrar_resultados ( char * , char * );
 unsigned int mostrar_funciones ( unsigned int );
 
@@ -273,6 +646,42 @@ void mostrar_grafo ( char * );
 ///////////////////////
 
 int buscar_funciones_equivalentes ( char * , char * );
+int buscar_en_corpus ( void );
+int indexar_corpus ( char * );
+void armar_entrada_de_corpus ( Funcion * , unsigned int , Entrada_Corpus * );
+int levantar_corpus ( char * , Corpus * );
+void liberar_corpus ( Corpus * );
+unsigned int consultar_corpus ( Corpus * , Funcion * );
+unsigned int rankear_corpus ( Corpus * , Funcion * , List & , List & );
+void votar_entradas_de_corpus ( Corpus * , unsigned int , unsigned int , unsigned int , unsigned int * , List & );
+void armar_path_en_directorio ( char * , char * , char * );
+int ejecutar_servicio ( void );
+int leer_pedido_servicio ( HANDLE , HANDLE , char * );
+int esperar_pipe ( HANDLE , OVERLAPPED * , BOOL , DWORD * );
+int atender_pedido ( HANDLE , List & , Corpus * , char * , char * );
+unsigned int partir_pedido ( char * , char ** , unsigned int );
+int responder_pedido ( HANDLE , const char * , ... );
+Analisis_Residente *get_analisis_residente ( List & , char * , int );
+void liberar_analisis_residente ( Analisis_Residente * );
+int servir_diff ( HANDLE , Analisis_Residente * , unsigned int , Analisis_Residente * , unsigned int );
+int servir_busqueda ( HANDLE , Corpus * , char * , Analisis_Residente * , unsigned int );
+
+///////////////////////
+
+/* Funciones asociadas con el benchmark */
+
+int ejecutar_benchmark ( unsigned int );
+int generar_analisis_sintetico ( char * , char * , Parametros_Sinteticos * , unsigned int , List & , List & );
+Funcion_Sintetica *crear_funcion_sintetica ( unsigned int , Parametros_Sinteticos * , unsigned int * );
+Funcion_Sintetica *duplicar_funcion_sintetica ( Funcion_Sintetica * );
+void patchear_funcion_sintetica ( Funcion_Sintetica * , unsigned int * );
+void liberar_funcion_sintetica ( Funcion_Sintetica * );
+void materializar_funciones_sinteticas ( List & , unsigned int * , List & , List & );
+Basic_Block *crear_basic_block ( unsigned int , unsigned int , unsigned int );
+unsigned int numero_aleatorio ( unsigned int * , unsigned int );
+unsigned int get_memoria_maxima ( void );
+void liberar_funciones ( List & , List & );
+void reiniciar_comparacion ( void );
 
 /****************************************************************************/
 /****************************************************************************/ 
@@ -291,12 +700,26 @@ unsigned int turbodiff_version = VERSION;
 List indice_funciones;
 List funciones;
 
+// Listas donde guardo las funciones del analisis previo del programa
+List indice_funciones_previas;
+List funciones_previas;
+
 List indice_funciones1;
 List funciones1;
 
 List indice_funciones2;
 List funciones2;
 
+// Grafos con las conexiones de los 2 programas que se estan comparando
+Grafo_Programa grafo_programa1;
+Grafo_Programa grafo_programa2;
+
+// Files y posiciones usados para levantar las funciones por demanda
+FILE *file_por_demanda1;
+FILE *file_por_demanda2;
+List posiciones_funciones1;
+List posiciones_funciones2;
+
 // Listas donde guardo el resultado del analisis
 List funciones1_reconocidas;
 List funciones2_reconocidas;
@@ -322,11 +745,11 @@ List basic_blocks;
 // Lista donde guardo los basic blocks que se unen con otros
 List basic_blocks_compuestos [ 2 ];
 
-// Lista donde guardo todas las referencias padre de codigo NO asociado a una funcion
-List referencias_undefined;
+// Set donde guardo todas las referencias padre de codigo NO asociado a una funcion
+HashSet referencias_undefined;
 
-// Lista donde guardo todas las funciones UNDEFINEDs
-List undefined_functions;
+// Set donde guardo todas las funciones UNDEFINEDs
+HashSet undefined_functions;
 
 // Listas donde guardo el CALL GRAPH de los programas
 List *call_graph1;
@@ -337,6 +760,28 @@ List matcheo_1_2;
 List resultado1;
 List resultado2;
 
+// Tabla de filas que muestra el chooser ( las filas de funciones que no estan en los analisis se descartan )
+List filas_resultados;
+
+// File donde emito cada par a medida que se asocia ( NULL si no se pidio )
+FILE *f_stream_resultados = NULL;
+
+// Lista donde guardo las estadisticas de cada fase de la comparacion
+List estadisticas_fases;
+
+// Fase de la comparacion que se esta ejecutando ( fase_nula fuera de una comparacion )
+Estadistica_Fase fase_nula;
+Estadistica_Fase *fase_actual = &fase_nula;
+
+// Progreso de la operacion en curso ( extraccion, comparacion o diff de basic blocks )
+Progreso progreso;
+
+// Listas donde guardo las huellas de las funciones de la comparacion previa
+List indice_huellas1;
+List huellas1;
+List indice_huellas2;
+List huellas2;
+
 /****************************************************************************/
 /****************************************************************************/ 
 
@@ -457,6 +902,65 @@ void my_close_chooser ( char *title )
 
 /****************************************************************************/ 
 
+void my_show_wait_box ( const char *format , ... )
+{
+  void ( *my_callui ) ( int , int , const char * , va_list );
+  va_list va;
+
+/* Resuelvo el simbolo */
+  ( unsigned int ) my_callui = * ( unsigned int * ) GetProcAddress ( GetModuleHandle ( "ida.wll" ) , "callui" );
+
+/* Muestro la ventana de espera */
+  va_start ( va , format );
+  my_callui ( ui_mbox , mbox_wait , format , va );
+  va_end ( va );
+}
+
+/****************************************************************************/ 
+
+void my_replace_wait_box ( const char *format , ... )
+{
+  void ( *my_callui ) ( int , int , const char * , va_list );
+  va_list va;
+
+/* Resuelvo el simbolo */
+  ( unsigned int ) my_callui = * ( unsigned int * ) GetProcAddress ( GetModuleHandle ( "ida.wll" ) , "callui" );
+
+/* Cambio el mensaje de la ventana de espera */
+  va_start ( va , format );
+  my_callui ( ui_mbox , mbox_replace , format , va );
+  va_end ( va );
+}
+
+/****************************************************************************/ 
+
+void my_hide_wait_box ( void )
+{
+  void ( *my_callui ) ( int , int , const char * , va_list );
+  va_list va;
+
+/* Resuelvo el simbolo */
+  ( unsigned int ) my_callui = * ( unsigned int * ) GetProcAddress ( GetModuleHandle ( "ida.wll" ) , "callui" );
+
+/* Cierro la ventana de espera */
+  my_callui ( ui_mbox , mbox_hide , NULL , va );
+}
+
+/****************************************************************************/ 
+
+bool my_wasBreak ( void )
+{
+  bool ( *my_callui ) ( int );
+
+/* Resuelvo el simbolo */
+  ( unsigned int ) my_callui = * ( unsigned int * ) GetProcAddress ( GetModuleHandle ( "ida.wll" ) , "callui" );
+
+/* Pregunto si el usuario apreto cancelar */
+  return ( my_callui ( ui_wasbreak ) );
+}
+
+/****************************************************************************/ 
+
 unsigned int my_choose ( bool flags , int x1 , int y1 , int x2 , int y2 , void *obj , unsigned int columnas , int *ancho , void *size_function , void *description_function , void *enter_function , void *destroy_function , unsigned int pos )
 {
   int ( *my_callui ) ( int , int , int , ... );
@@ -519,6 +1023,28 @@ void change_extension ( char *filename , char *extension )
 
 /****************************************************************************/ 
 
+void armar_path_en_directorio ( char *file , char *nombre , char *path )
+{
+/* Copio el path del file */
+  qstrncpy ( path , file , QMAXPATH );
+
+/* Busco la barra invertida */
+  if ( strrchr ( path , '\\' ) != NULL )
+  {
+  /* Cierro el string despues de la ultima barra */
+    * ( strrchr ( path , '\\' ) + 1 ) = '\0';
+  }
+  else
+  {
+    path [ 0 ] = '\0';
+  }
+
+/* Agrego el nombre al directorio */
+  qstrncat ( path , nombre , QMAXPATH );
+}
+
+/****************************************************************************/ 
+
 char *version = " v1.01b r1";
 
 static const char pantalla_inicial [] =
@@ -531,7 +1057,8 @@ static const char pantalla_inicial [] =
 "<take info from this idb:R>"
 "<compare with ...:R>"
 "<compare functions with ...:R>"
-"<free comparison with ...:R>>"
+"<free comparison with ...:R>"
+"<search function in corpus ...:R>>"
 //"<search equivalent functions (experimental):R>>"
 "\n\n\n\n\n";
 
@@ -543,7 +1070,8 @@ static const char files_a_analizar [] =
 "\n\n"
 "Important: The analysis will be saved on the current idb path.\n"
 "\n\n"
-"<analize undefined functions:C>>"
+"<analize undefined functions:C>\n"
+"<keep functions in the shared store ( turbodiff.tds ):C>>"
 "\n\n";
 
 static const char files_a_comparar [] =
@@ -556,7 +1084,9 @@ static const char files_a_comparar [] =
 "\n"
 "<log file\t:A:256:16::>"
 "\n"
-"\t<use symbols:C>>"
+"\t<use symbols:C>\n"
+"\t<incremental ( reuse previous results ):C>\n"
+"\t<stream results as NDJSON ( next to the log file ):C>>"
 "\n\n"
 "\n\n";
 
@@ -580,6 +1110,19 @@ static const char funciones_a_buscar [] =
 "<function2\t:$:500:16:::>\n"
 "\n";
 
+static const char funcion_a_buscar_en_corpus [] =
+"Search a function in the corpus\n"
+"turbodiff v1.01b r1\n"
+"Created by Nicolas A. Economou ( neconomou@corest.com )\n"
+"Buenos Aires, Argentina ( 2009 )\n"
+"\n\n"
+"Important: The corpus is built from the analysis files on the current idb path.\n"
+"\n"
+"<function\t:$:500:16:::>\n"
+"\n"
+"<rebuild the corpus index:C>>"
+"\n\n";
+
 /****************************************************************************/
 /****************************************************************************/ 
 
@@ -600,8 +1143,30 @@ void __stdcall run ( int arg )
   unsigned int final_time;
   int tipo_operacion = 0;
   int analizar_undefined_functions = FALSE;
+  int opciones_analisis = 0;
+  int almacenado = FALSE;
   int ret;
 
+/* Si el plugin fue invocado para correr el benchmark */
+  if ( ( arg >= BENCHMARK_MIN_ARG ) && ( arg <= BENCHMARK_MAX_ARG ) )
+  {
+  /* Corro el benchmark hasta la cantidad de funciones pedida */
+    ejecutar_benchmark ( arg );
+
+  /* Salgo */
+    return;
+  }
+
+/* Si el plugin fue invocado como servicio de comparacion */
+  if ( arg == SERVICIO_ARG )
+  {
+  /* Atiendo pedidos hasta que un cliente pida terminar */
+    ejecutar_servicio ();
+
+  /* Salgo */
+    return;
+  }
+
 /* Pido al usuario la funcion origen y destino */
   ret = my_AskUsingForm ( pantalla_inicial , &tipo_operacion );
 
@@ -624,7 +1189,7 @@ void __stdcall run ( int arg )
   if ( tipo_operacion == 0 )
   {
   /* Pido al usuario la funcion a analizar */
-    ret = my_AskUsingForm ( files_a_analizar , &analizar_undefined_functions );
+    ret = my_AskUsingForm ( files_a_analizar , &opciones_analisis );
 
   /* Si el usuario apreto ESC */
     if ( ret != 1 )
@@ -632,6 +1197,9 @@ void __stdcall run ( int arg )
     /* Salgo */
       return;
     }
+
+  /* Obtengo las opciones elegidas por el usuario */
+    analizar_undefined_functions = ( opciones_analisis & UNDEFINED_FUNCTIONS_OPTION ) ? TRUE : FALSE;
   }
 /* Si el usuario quiere diffear funciones */
   else if ( tipo_operacion == 2 )
@@ -651,6 +1219,15 @@ void __stdcall run ( int arg )
   /* Salgo porque el usuario apreto ESCAPE */
     return;
   }
+/* Si el usuario quiere buscar una funcion en los analisis archivados */
+  else if ( tipo_operacion == 4 )
+  {
+  /* Busco la funcion en el corpus */
+    buscar_en_corpus ();
+
+  /* Salgo porque el usuario apreto ESCAPE */
+    return;
+  }
 
 /* Tomo el tiempo actual */
   initial_time = GetTickCount ();
@@ -661,12 +1238,27 @@ void __stdcall run ( int arg )
 /* Si tengo que sacar un analisis */
   if ( tipo_operacion == 0 )
   {
-  /* Levanto todas las funciones del programa */
-    analizar_programa ( analizar_undefined_functions );
-
   /* Obtengo el nombre del IDB actual */
     get_actual_idb_name ( file1 );
 
+  /* Armo el nombre del analisis previo ( si existe ) */
+    change_extension ( file1 , "ana" );
+
+  /* Levanto todas las funciones del programa ( el usuario puede cancelarlo ) */
+    iniciar_operacion ();
+    ret = analizar_programa ( analizar_undefined_functions , file1 );
+    terminar_operacion ();
+
+  /* Si el analisis fue cancelado */
+    if ( ret == FALSE )
+    {
+    /* Mensaje al usuario */
+      my_msg ( "analysis cancelled, nothing was saved\n" );
+
+    /* Salgo */
+      return;
+    }
+
   /* Cambio la extension para guardar el desensamblado */
     change_extension ( file1 , "dis" );
 
@@ -679,11 +1271,29 @@ void __stdcall run ( int arg )
   /* Cambio la extension para guardar el desensamblado */
     change_extension ( file1 , "ana" );
 
-  /* Mensaje al usuario */
-    my_msg ( "generating %s\n" , file1 );
+  /* Si el usuario quiere guardar las funciones en el almacen compartido */
+    if ( opciones_analisis & FUNCTION_STORE_OPTION )
+    {
+    /* Guardo las funciones en el almacen ( el .ana se reconstruye desde el manifiesto ) */
+      almacenado = guardar_en_almacen ( file1 , funciones );
 
-  /* Guardo el analisis */
-    guardar_analisis ( file1 );
+    /* Si el almacen quedo actualizado */
+      if ( almacenado == TRUE )
+      {
+      /* Borro el .ana anterior para que abrir_analisis NO lo prefiera al manifiesto */
+        qunlink ( file1 );
+      }
+    }
+
+  /* Si el analisis NO quedo en el almacen */
+    if ( almacenado == FALSE )
+    {
+    /* Mensaje al usuario */
+      my_msg ( "generating %s\n" , file1 );
+
+    /* Guardo el analisis */
+      guardar_analisis ( file1 );
+    }
   }
   else
   {
@@ -714,7 +1324,10 @@ int comparar_analisis ( void )
   char *file;
   unsigned int initial_time;
   unsigned int final_time;
-  int usar_simbolos = TRUE;
+  int opciones = USE_SYMBOLS_OPTION;
+  int usar_simbolos;
+  int incremental;
+  int emitir_stream;
   int ret = TRUE;
 
 /* Obtengo el path del IDB actual */
@@ -740,8 +1353,13 @@ int comparar_analisis ( void )
     qsnprintf ( log_file , QMAXPATH , "%s\\results.txt" , current_path );
 
   /* Mensaje al usuario con las opciones a comparar */
-    if ( my_AskUsingForm ( files_a_comparar , log_file , &usar_simbolos ) == TRUE )
+    if ( my_AskUsingForm ( files_a_comparar , log_file , &opciones ) == TRUE )
     {
+    /* Obtengo las opciones elegidas por el usuario */
+      usar_simbolos = ( opciones & USE_SYMBOLS_OPTION ) ? TRUE : FALSE;
+      incremental = ( opciones & INCREMENTAL_OPTION ) ? TRUE : FALSE;
+      emitir_stream = ( opciones & STREAM_RESULTS_OPTION ) ? TRUE : FALSE;
+
     /* Tomo el tiempo actual */
       initial_time = GetTickCount ();
 
@@ -753,7 +1371,7 @@ int comparar_analisis ( void )
       change_extension ( file2 , "ana" );
 
     /* Comparo el analisis de los 2 archivos */
-      if ( comparar_files ( file1 , file2 , log_file , usar_simbolos ) == FALSE )
+      if ( comparar_files ( file1 , file2 , log_file , usar_simbolos , incremental , emitir_stream , NULL , NULL ) == FALSE )
       {
       /* Mensaje de ERROR */
         MessageBox ( NULL , "cannot load analysis files" , "ERROR" , MB_ICONERROR | MB_TOPMOST );
@@ -838,19 +1456,50 @@ int comparar_funciones ( int comparar_por_pares )
 
 /* Funciones */
 
-int analizar_programa ( int analizar_undefined_functions )
+int analizar_programa ( int analizar_undefined_functions , char *file_analisis_previo )
 {
   List direcciones_iniciales;
+  List funciones_reanalizadas;
+  List padres_cambiados;
+  HashSet basic_blocks_visitados;
+  Funcion *funcion_previa;
   Funcion *funcion;
   unsigned int address_inicial;
   unsigned int cantidad_funciones;
   unsigned int referencia_padre;
+  unsigned int hash_contenido;
+  unsigned int version_previa;
+  unsigned int reutilizadas = 0;
   unsigned int decena;
   unsigned int pos;
   unsigned int cont;
   func_t *f;
+  FILE *f_previo;
   int ret = TRUE;
 
+/* Intento abrir el analisis previo de este mismo programa ( o reconstruirlo desde el almacen ) */
+  f_previo = abrir_analisis ( file_analisis_previo );
+
+/* Si hay un analisis previo */
+  if ( f_previo != NULL )
+  {
+  /* Leo la version del file */
+    qfread ( f_previo , ( void * ) &version_previa , sizeof ( unsigned int ) );
+
+  /* Si el analisis previo tiene el formato actual */
+    if ( version_previa == turbodiff_version )
+    {
+    /* Mensaje al usuario */
+      my_msg ( "loading previous analysis %s ...\n" , file_analisis_previo );
+
+    /* Levanto todas las funciones del analisis previo */
+      levantar_funciones ( f_previo , indice_funciones_previas , funciones_previas );
+    }
+
+  /* Cierro el file */
+    qfclose ( f_previo );
+  }
+
 /* Cantidad de funciones que tiene el programa */
   cantidad_funciones = get_func_qty ();
 
@@ -880,8 +1529,16 @@ int analizar_programa ( int analizar_undefined_functions )
   }
 
 /* Analizo todas las funciones del programa */
+  iniciar_progreso ( "analyzing" , funciones.Len () );
+
   for ( pos = 1 ; pos <= funciones.Len () ; pos ++ )
   {
+  /* Si el usuario cancelo el analisis */
+    if ( avanzar_progreso ( 1 ) == FALSE )
+    {
+      break;
+    }
+
   /* Si paso el 10 porciento mas */
     if ( pos == 1 || ( pos % decena ) == 0 )
     {
@@ -892,41 +1549,107 @@ int analizar_programa ( int analizar_undefined_functions )
   /* Levanto la siguiente funcion */
     funcion = ( Funcion * ) funciones.Get ( pos - 1 );
 
-  /* Relevo todos los datos de la funcion */
-    analizar_funcion ( funcion -> address , funcion );
-  }
+  /* Calculo el hash de los bytes y los llamados de la funcion */
+    hash_contenido = calcular_hash_de_contenido ( funcion -> address );
 
-////////////////////////////
+  /* Busco la funcion en el analisis previo */
+    funcion_previa = get_estructura_funcion2 ( indice_funciones_previas , funciones_previas , funcion -> address );
 
-/* Si tengo que analizar las funciones NO encontradas por IDA */
-  if ( analizar_undefined_functions == TRUE )
-  {
-  /* Recorro todas las referencias padre de codigo NO asociado a funciones */
-    for ( pos = 0 ; pos < referencias_undefined.Len () ; pos ++ )
+  /* Si la funcion NO cambio desde el analisis previo */
+    if ( ( funcion_previa != NULL ) && ( funcion_previa -> hash_contenido == hash_contenido ) )
     {
-    /* Levanto la siguiente referencia */
-      referencia_padre = ( unsigned int ) referencias_undefined.Get ( pos );
-
-    /* Si encontre una funcion */
-      if ( get_funciones_undefined ( 0 , referencia_padre , direcciones_iniciales ) == TRUE )
+    /* Copio el analisis previo de la funcion */
+      if ( reutilizar_analisis_de_funcion ( funcion , funcion_previa ) == TRUE )
       {
-      /* Recorro la lista de funciones detectadas */
-        for ( cont = 0 ; cont < direcciones_iniciales.Len () ; cont ++ )
-        {
-        /* Levanto la siguiente direccion */
-          address_inicial = ( unsigned int ) direcciones_iniciales.Get ( cont );
+      /* Las referencias padre son las mismas que antes */
+        padres_cambiados.Add ( ( void * ) FALSE );
+      }
+      else
+      {
+      /* Las referencias padre cambiaron */
+        padres_cambiados.Add ( ( void * ) TRUE );
+      }
 
-        /* Si la funcion NO esta registrada */
-          if ( undefined_functions.Find ( ( void * ) address_inicial ) == FALSE )
-          {
-          /* Agrego la funcion a la lista */
-            undefined_functions.Add ( ( void * ) address_inicial );
+    /* Marco la funcion como NO reanalizada */
+      funciones_reanalizadas.Add ( ( void * ) FALSE );
 
-          /* Mensaje al usuario */
-//            my_msg ( "U_FUNCTION: %x\n" , address_inicial );
-          }
-        }
-      }
+    /* Incremento la cantidad de funciones reutilizadas */
+      reutilizadas ++;
+    }
+    else
+    {
+    /* Relevo todos los datos de la funcion */
+      analizar_funcion ( funcion -> address , funcion );
+
+    /* Marco la funcion como reanalizada */
+      funciones_reanalizadas.Add ( ( void * ) TRUE );
+      padres_cambiados.Add ( ( void * ) TRUE );
+    }
+
+  /* Seteo el hash del contenido de la funcion */
+    funcion -> hash_contenido = hash_contenido;
+  }
+
+/* Libero lo que quedo del analisis previo ( lo reusado ya paso a las funciones nuevas ) */
+  liberar_funciones ( indice_funciones_previas , funciones_previas );
+
+/* Si el analisis fue cancelado */
+  if ( is_operacion_cancelada () == TRUE )
+  {
+  /* Descarto las funciones que no llegue a analizar */
+    while ( funciones.Len () >= pos )
+    {
+      free ( funciones.Get ( pos - 1 ) );
+      funciones.Delete ( pos - 1 );
+      indice_funciones.Delete ( pos - 1 );
+    }
+
+  /* Libero las funciones analizadas ( un nuevo analisis arranca de cero ) */
+    liberar_funciones ( indice_funciones , funciones );
+
+  /* Vacio las referencias y las funciones undefined relevadas */
+    referencias_undefined.Clear ();
+    undefined_functions.Clear ();
+
+  /* Retorno ERROR ( un analisis incompleto no se guarda ) */
+    return ( FALSE );
+  }
+
+/* Si pude reusar algo del analisis previo */
+  if ( reutilizadas > 0 )
+  {
+  /* Mensaje al usuario */
+    my_msg ( "reused functions from previous analysis: %i\n" , reutilizadas );
+  }
+
+////////////////////////////
+
+/* Si tengo que analizar las funciones NO encontradas por IDA */
+  if ( analizar_undefined_functions == TRUE )
+  {
+  /* Recorro todas las referencias padre de codigo NO asociado a funciones */
+    for ( pos = 0 ; pos < referencias_undefined.Len () ; pos ++ )
+    {
+    /* Levanto la siguiente referencia */
+      referencia_padre = referencias_undefined.Get ( pos );
+
+    /* Si encontre una funcion ( los basic blocks visitados se comparten entre referencias ) */
+      if ( get_funciones_undefined ( referencia_padre , basic_blocks_visitados , direcciones_iniciales ) == TRUE )
+      {
+      /* Recorro la lista de funciones detectadas */
+        for ( cont = 0 ; cont < direcciones_iniciales.Len () ; cont ++ )
+        {
+        /* Levanto la siguiente direccion */
+          address_inicial = ( unsigned int ) direcciones_iniciales.Get ( cont );
+
+        /* Si la funcion NO estaba registrada ( el set descarta las repetidas ) */
+          if ( undefined_functions.Add ( address_inicial ) == TRUE )
+          {
+          /* Mensaje al usuario */
+//            my_msg ( "U_FUNCTION: %x\n" , address_inicial );
+          }
+        }
+      }
     }
 
   /* Mensaje al usuario */
@@ -936,7 +1659,7 @@ int analizar_programa ( int analizar_undefined_functions )
     for ( pos = 0 ; pos < undefined_functions.Len () ; pos ++ )
     {
     /* Levanto la siguiente direccion */
-      address_inicial = ( unsigned int ) undefined_functions.Get ( pos );
+      address_inicial = undefined_functions.Get ( pos );
 
     /* Creo una nueva estructura para la funcion */
       funcion = ( Funcion * ) malloc ( sizeof ( Funcion ) );
@@ -949,6 +1672,10 @@ int analizar_programa ( int analizar_undefined_functions )
       {
       /* Agrego la funcion a la lista */
         funciones.Add ( funcion );
+
+      /* Las funciones undefined siempre se reanalizan */
+        funciones_reanalizadas.Add ( ( void * ) TRUE );
+        padres_cambiados.Add ( ( void * ) TRUE );
       }
 //      else
 //      {
@@ -971,6 +1698,13 @@ int analizar_programa ( int analizar_undefined_functions )
   /* Levanto la siguiente funcion */
     funcion = ( Funcion * ) funciones.Get ( pos );
 
+  /* Si la funcion fue reusada, sus padres son los mismos y ninguno cambio */
+    if ( ( funciones_reanalizadas.Get ( pos ) == ( void * ) FALSE ) && ( padres_cambiados.Get ( pos ) == ( void * ) FALSE ) && ( tiene_padres_reanalizados ( funcion , funciones_reanalizadas ) == FALSE ) )
+    {
+    /* Los checksums del analisis previo siguen siendo validos */
+      continue;
+    }
+
   /* Actualizo los basic blocks para esta funcion */
     actualizar_checksum_basic_blocks_padres ( indice_funciones , funciones , funcion );
   }
@@ -980,6 +1714,159 @@ int analizar_programa ( int analizar_undefined_functions )
 
 /****************************************************************************/ 
 
+unsigned int calcular_hash_de_contenido ( unsigned int address )
+{
+  unsigned int hash = HASH_INICIAL;
+  unsigned int address_funcion;
+  unsigned int addr_actual;
+  unsigned int len_item;
+  unsigned char byte;
+  unsigned int cont;
+  func_t *f;
+
+/* Obtengo los limites de la funcion */
+  f = get_func ( address );
+
+/* Si la funcion NO esta definida por IDA */
+  if ( f == NULL )
+  {
+  /* No tengo forma de saber si cambio */
+    return ( 0 );
+  }
+
+/* Agrego los limites de la funcion al hash */
+  hash = calcular_hash ( hash , &f -> startEA , sizeof ( unsigned int ) );
+  hash = calcular_hash ( hash , &f -> endEA , sizeof ( unsigned int ) );
+
+/* Recorro todos los items de la funcion */
+  for ( addr_actual = f -> startEA ; addr_actual < f -> endEA ; addr_actual += len_item )
+  {
+  /* Averiguo la longitud del item */
+    len_item = get_item_size ( addr_actual );
+
+  /* Agrego los bytes del item al hash */
+    for ( cont = 0 ; cont < len_item ; cont ++ )
+    {
+      byte = get_byte ( addr_actual + cont );
+      hash = calcular_hash ( hash , &byte , sizeof ( unsigned char ) );
+    }
+
+  /* Si el item es un llamado a funcion */
+    if ( is_call ( addr_actual , &address_funcion ) == TRUE )
+    {
+    /* Agrego el destino del llamado al hash */
+      hash = calcular_hash ( hash , &address_funcion , sizeof ( unsigned int ) );
+    }
+  }
+
+/* El hash 0 queda reservado para las funciones que siempre se reanalizan */
+  if ( hash == 0 )
+  {
+    hash = HASH_INICIAL;
+  }
+
+  return ( hash );
+}
+
+/****************************************************************************/ 
+
+int reutilizar_analisis_de_funcion ( Funcion *funcion , Funcion *funcion_previa )
+{
+  Basic_Block_Padre *basic_blocks_padres_previos;
+  unsigned int cantidad_referencias_previas;
+  unsigned int cont;
+  int ret = TRUE;
+
+/* Copio todo el analisis previo de la funcion */
+  memcpy ( funcion , funcion_previa , sizeof ( Funcion ) );
+
+/* Los basic blocks y la ecuacion del grafo pasan a ser de la funcion nueva */
+  funcion_previa -> cantidad_basic_blocks = 0;
+  funcion_previa -> basic_blocks = NULL;
+  funcion_previa -> graph_ecuation = NULL;
+
+/* Las referencias padre previas se liberan aca abajo */
+  funcion_previa -> cantidad_referencias_padre = 0;
+  funcion_previa -> basic_blocks_padres = NULL;
+
+/* Actualizo el nombre de la funcion ( pudo haber sido renombrada ) */
+  qstrncpy ( funcion -> name , "" , 256 );
+  get_func_name ( funcion -> address , funcion -> name , 255 );
+  qstrncpy ( funcion -> demangled_name , "" , 256 );
+  demangle_name ( funcion -> demangled_name , 1024 , funcion -> name , 0x0ea3be67 );
+
+/* Inicializo los flags de comparacion */
+  funcion -> address_equivalente = BADADDR;
+  funcion -> identica = FALSE;
+  funcion -> patcheada = FALSE;
+
+/* Me guardo las referencias padre previas */
+  basic_blocks_padres_previos = funcion -> basic_blocks_padres;
+  cantidad_referencias_previas = funcion -> cantidad_referencias_padre;
+
+/* Las referencias padre dependen de las OTRAS funciones, las vuelvo a relevar */
+  funcion -> cantidad_referencias_padre = 0;
+  funcion -> basic_blocks_padres = NULL;
+  funcion -> referencias_padre_x_vtable = new ( List );
+  get_referencias_padre ( funcion );
+
+/* Si cambio la cantidad de referencias padre */
+  if ( funcion -> cantidad_referencias_padre != cantidad_referencias_previas )
+  {
+  /* Hay que recalcular los checksums de los padres */
+    ret = FALSE;
+  }
+  else
+  {
+  /* Recorro todas las referencias padre */
+    for ( cont = 0 ; cont < funcion -> cantidad_referencias_padre ; cont ++ )
+    {
+    /* Si la referencia NO es la misma que antes */
+      if ( ( funcion -> basic_blocks_padres [ cont ].direccion_funcion != basic_blocks_padres_previos [ cont ].direccion_funcion ) || ( funcion -> basic_blocks_padres [ cont ].referencia != basic_blocks_padres_previos [ cont ].referencia ) )
+      {
+      /* Hay que recalcular los checksums de los padres */
+        ret = FALSE;
+        break;
+      }
+
+    /* Reuso el checksum del basic block padre */
+      funcion -> basic_blocks_padres [ cont ].checksum = basic_blocks_padres_previos [ cont ].checksum;
+    }
+  }
+
+/* Libero las referencias padre previas */
+  free ( basic_blocks_padres_previos );
+
+  return ( ret );
+}
+
+/****************************************************************************/ 
+
+int tiene_padres_reanalizados ( Funcion *funcion , List &funciones_reanalizadas )
+{
+  unsigned int cont;
+  unsigned int pos;
+  int ret = FALSE;
+
+/* Recorro todas las referencias padres */
+  for ( cont = 0 ; cont < funcion -> cantidad_referencias_padre ; cont ++ )
+  {
+  /* Si la funcion padre NO esta en el indice o fue reanalizada */
+    if ( ( indice_funciones.GetPos ( ( void * ) funcion -> basic_blocks_padres [ cont ].direccion_funcion , &pos ) == FALSE ) || ( funciones_reanalizadas.Get ( pos ) == ( void * ) TRUE ) )
+    {
+    /* Retorno OK */
+      ret = TRUE;
+
+    /* Corto la busqueda */
+      break;
+    }
+  }
+
+  return ( ret );
+}
+
+/****************************************************************************/ 
+
 int analizar_funcion ( unsigned int address , Funcion *funcion )
 {
   unsigned int cont;
@@ -1006,13 +1893,21 @@ int analizar_funcion ( unsigned int address , Funcion *funcion )
   /* Demangleo el nombre de la funcion */
     demangle_name ( funcion -> demangled_name , 1024 , funcion -> name , 0x0ea3be67 );
 
-  /* Inicializo la ecuacion que representa el grafo de la funcion */
+  /* Inicializo la ecuacion y la firma que representan el grafo de la funcion */
     funcion -> graph_ecuation = NULL;
+    funcion -> hash_grafo = 0;
+    funcion -> grafo = NULL;
+
+  /* El filtro se construye al levantar el analisis */
+    memset ( funcion -> filtro , 0 , sizeof ( funcion -> filtro ) );
 
   /* Inicializo el flag de funcion identica, patcheada */
     funcion -> identica = FALSE;
     funcion -> patcheada = FALSE;
 
+  /* Inicializo el hash del contenido ( lo calcula el que analiza el programa ) */
+    funcion -> hash_contenido = 0;
+
   /* Analizo todos los basic blocks de la funcion */
 //    my_msg ( "procesing function %x\n" , funcion -> address );
     ret = identificar_basic_blocks ( funcion , basic_blocks , 0 , funcion -> address , funcion -> address );
@@ -1070,6 +1965,9 @@ int analizar_funcion ( unsigned int address , Funcion *funcion )
   /* Calculo el peso de la funcion */
     funcion -> peso = setear_peso_a_basic_blocks ( 0 , funcion , funcion -> basic_blocks [ 0 ] );
 
+  /* Calculo los dominadores y los loops de la funcion */
+    calcular_dominadores ( funcion );
+
   /* Marco todos los basic blocks con IDs */
     poner_ids_a_basic_blocks ( 0 , funcion , funcion -> basic_blocks [ 0 ] );
 
@@ -1109,6 +2007,7 @@ int identificar_basic_blocks ( Funcion *funcion , List &basic_blocks , unsigned
   unsigned int mini_checksum;
   unsigned int checksum;
   unsigned int conditional_checksum;
+  unsigned int ancla;
   unsigned int cont;
   int levantar_proxima_instruccion;
   int fin_basic_block = FALSE;
@@ -1145,6 +2044,11 @@ int identificar_basic_blocks ( Funcion *funcion , List &basic_blocks , unsigned
   /* Inicializo la posicion en el file de desensamblado */
     basic_block_actual -> pos_file_disasm = 0;
 
+  /* Inicializo la estructura de dominadores y loops */
+    basic_block_actual -> dominador = SIN_DOMINADOR;
+    basic_block_actual -> profundidad_loop = 0;
+    basic_block_actual -> cabecera_loop = FALSE;
+
   /* Creo una lista PERSISTENTE para guardar las conexiones con otros basic blocks */
     basic_block_actual -> basic_blocks_hijos = new ( List );
 
@@ -1164,6 +2068,9 @@ int identificar_basic_blocks ( Funcion *funcion , List &basic_blocks , unsigned
   /* Inicializo la lista que encadena basic blocks simples */
     basic_block_actual -> cadena_basic_blocks = new ( List );
 
+  /* Creo una lista PERSISTENTE para guardar las anclas del basic block */
+    basic_block_actual -> anclas = new ( List );
+
   /* Agrego el basic block a la lista */
     basic_blocks.Add ( ( void * ) basic_block_actual );
   }
@@ -1214,6 +2121,14 @@ int identificar_basic_blocks ( Funcion *funcion , List &basic_blocks , unsigned
       {
       /* Incremento el checksum en 0x0f0000 */
         checksum += 0x0f0000;
+
+      /* Me guardo el import llamado */
+        ancla = get_ancla_de_import ( funcion_hija );
+
+        if ( ancla != 0 )
+        {
+          basic_block_actual -> anclas -> Add ( ( void * ) ancla );
+        }
       }
     }
   /* Si es una JUMP TABLE */
@@ -1279,6 +2194,14 @@ int identificar_basic_blocks ( Funcion *funcion , List &basic_blocks , unsigned
       {
       /* Incremento el checksum en 0x10000 */
         checksum += 0x10000;
+
+      /* Me guardo el string o el import referenciado */
+        ancla = get_ancla_de_dato ( addr_actual );
+
+        if ( ancla != 0 )
+        {
+          basic_block_actual -> anclas -> Add ( ( void * ) ancla );
+        }
       }
     }
     else
@@ -1506,6 +2429,9 @@ int compactar_basic_blocks ( Funcion *funcion , List &basic_blocks )
               basic_block_padre -> funciones_hijas -> Add ( basic_block_hijo -> funciones_hijas -> Get ( cont2 ) );
             }
 
+          /* Absorvo las anclas del hijo */
+            basic_block_padre -> anclas -> Append ( basic_block_hijo -> anclas );
+
           /* Elimino la unica conexion del basic block padre */
             basic_block_padre -> basic_blocks_hijos -> Clear ();
 
@@ -1797,6 +2723,85 @@ int is_call ( unsigned int address , unsigned int *address_funcion )
 
 /****************************************************************************/ 
 
+unsigned int get_ancla_de_import ( unsigned int address )
+{
+  char nombre [ MAX_LARGO_ANCLA + 1 ];
+  char *nombre_import;
+  unsigned int ancla = 0;
+
+/* Si el import NO tiene nombre */
+  if ( get_name ( BADADDR , address , nombre , sizeof ( nombre ) ) == NULL )
+  {
+    return ( 0 );
+  }
+
+/* Salteo el prefijo de los punteros a imports */
+  nombre_import = nombre;
+
+  if ( strncmp ( nombre , PREFIJO_IMPORT , strlen ( PREFIJO_IMPORT ) ) == 0 )
+  {
+    nombre_import += strlen ( PREFIJO_IMPORT );
+  }
+
+/* Si quedo algun nombre */
+  if ( strlen ( nombre_import ) > 0 )
+  {
+  /* El ancla es el hash del nombre */
+    ancla = calcular_hash ( HASH_PRIMO , nombre_import , strlen ( nombre_import ) );
+  }
+
+  return ( ancla );
+}
+
+/****************************************************************************/ 
+
+unsigned int get_ancla_de_dato ( unsigned int address )
+{
+  char contenido [ MAX_LARGO_ANCLA + 1 ];
+  unsigned int referencia;
+  unsigned int ancla = 0;
+  unsigned int cont;
+
+/* Leo la zona referenciada por la instruccion */
+  referencia = get_first_dref_from ( address );
+
+/* Si es un string */
+  if ( isASCII ( getFlags ( referencia ) ) )
+  {
+  /* Levanto el contenido del string */
+    for ( cont = 0 ; cont < MAX_LARGO_ANCLA ; cont ++ )
+    {
+      contenido [ cont ] = get_byte ( referencia + cont );
+
+    /* Si llegue al final del string */
+      if ( contenido [ cont ] == '\0' )
+      {
+        break;
+      }
+    }
+
+  /* Los strings muy cortos se repiten por todos lados */
+    if ( cont >= MIN_LARGO_ANCLA )
+    {
+    /* El ancla es el hash del contenido */
+      ancla = calcular_hash ( HASH_INICIAL , contenido , cont );
+    }
+  }
+/* Si es un puntero a un import */
+  else if ( get_name ( BADADDR , referencia , contenido , sizeof ( contenido ) ) != NULL )
+  {
+    if ( strncmp ( contenido , PREFIJO_IMPORT , strlen ( PREFIJO_IMPORT ) ) == 0 )
+    {
+    /* Uso el mismo ancla que un llamado directo al import */
+      ancla = get_ancla_de_import ( referencia );
+    }
+  }
+
+  return ( ancla );
+}
+
+/****************************************************************************/ 
+
 int is_llamado_a_funcion ( unsigned int address , unsigned int *funcion_llamada )
 {
   unsigned int funcion_hija;
@@ -2182,12 +3187,8 @@ int get_referencias_padre ( Funcion *funcion )
 //          my_msg ( "warning: lost reference from %x\n" , referencia_padre );
 //          procesar_codigo_undefined ( referencia_padre );
 
-        /* Si la direccion NO la tengo registrada */
-          if ( referencias_undefined.Find ( ( void * ) referencia_padre ) == NULL )
-          {
-          /* Agrego la referencia a la lista */
-            referencias_undefined.Add ( ( void * ) referencia_padre );
-          }
+        /* Registro la referencia ( el set descarta las repetidas ) */
+          referencias_undefined.Add ( referencia_padre );
         }
       }
 
@@ -2307,6 +3308,7 @@ unsigned int get_cantidad_basic_blocks_padres_from_list ( Funcion *funcion , Bas
 
 int get_basic_blocks_padres ( Funcion *funcion , Basic_Block *basic_block , List &basic_blocks_padres )
 {
+  Grafo_Programa *grafo = ( Grafo_Programa * ) funcion -> grafo;
   Basic_Block *basic_block_padre;
   unsigned int cont;
   int ret = FALSE;
@@ -2314,17 +3316,30 @@ int get_basic_blocks_padres ( Funcion *funcion , Basic_Block *basic_block , List
 /* Inicializo la lista */
   basic_blocks_padres.Clear ();
 
-/* Recorro todos los basic blocks de la funcion */
-  for ( cont = 0 ; cont < funcion -> cantidad_basic_blocks ; cont ++ )
+/* Si la funcion pertenece a un grafo armado */
+  if ( grafo != NULL )
   {
-  /* Levanto el siguiente basic block */
-    basic_block_padre = funcion -> basic_blocks [ cont ];
-
-  /* Si el basic block padre tiene como hijo al basic block actual */
-    if ( basic_block_padre -> basic_blocks_hijos -> Find ( ( void * ) basic_block -> addr_inicial ) == TRUE )
+  /* Recorro los predecesores del basic block en el grafo */
+    for ( cont = grafo -> inicio_predecesores [ basic_block -> indice ] ; cont < grafo -> inicio_predecesores [ basic_block -> indice + 1 ] ; cont ++ )
     {
     /* Agrego el basic block a la lista */
-      basic_blocks_padres.Add ( basic_block_padre );
+      basic_blocks_padres.Add ( grafo -> basic_blocks [ grafo -> predecesores [ cont ] ] );
+    }
+  }
+  else
+  {
+  /* Recorro todos los basic blocks de la funcion */
+    for ( cont = 0 ; cont < funcion -> cantidad_basic_blocks ; cont ++ )
+    {
+    /* Levanto el siguiente basic block */
+      basic_block_padre = funcion -> basic_blocks [ cont ];
+
+    /* Si el basic block padre tiene como hijo al basic block actual */
+      if ( basic_block_padre -> basic_blocks_hijos -> Find ( ( void * ) basic_block -> addr_inicial ) == TRUE )
+      {
+      /* Agrego el basic block a la lista */
+        basic_blocks_padres.Add ( basic_block_padre );
+      }
     }
   }
 
@@ -2343,18 +3358,14 @@ int get_basic_blocks_padres ( Funcion *funcion , Basic_Block *basic_block , List
 int get_basic_blocks_hijos ( Funcion *funcion , Basic_Block *basic_block , List &basic_blocks_hijos )
 {
   Basic_Block *basic_block_hijo;
-  unsigned int address_hija;
   unsigned int cont;
   int ret = TRUE;
 
 /* Recorro todos los basic blocks hijos */
   for ( cont = 0 ; cont < basic_block -> basic_blocks_hijos -> Len () ; cont ++ )
   {
-  /* Levanto la siguiente direccion hija */
-    address_hija = ( unsigned int ) basic_block -> basic_blocks_hijos -> Get ( cont );
-
   /* Obtengo el basic block */
-    basic_block_hijo = get_basic_block_from_array ( funcion -> basic_blocks , funcion -> cantidad_basic_blocks , address_hija );
+    basic_block_hijo = get_basic_block_hijo ( funcion , basic_block , cont );
 
   /* Agrego el basic block a la lista */
     basic_blocks_hijos.Add ( ( void * ) basic_block_hijo );
@@ -2367,24 +3378,37 @@ int get_basic_blocks_hijos ( Funcion *funcion , Basic_Block *basic_block , List
 
 Funcion *get_estructura_funcion ( List &funciones , unsigned int address )
 {
+  Grafo_Programa *grafo;
   Funcion *funcion_a_retornar = NULL;
   Funcion *funcion;
   unsigned int cont;
 
-/* Recorro toda la lista de funciones */
-  for ( cont = 0 ; cont < funciones.Len () ; cont ++ )
-  {
-  /* Levanto la proxima funcion */
-    funcion = ( Funcion * ) funciones.Get ( cont );
+/* Levanto el grafo armado con la lista ( si hay ) */
+  grafo = get_grafo_de_lista ( funciones );
 
-  /* Si es la funcion que estoy buscando */
-    if ( funcion -> address == address )
+/* Si la lista tiene un grafo armado */
+  if ( grafo != NULL )
+  {
+  /* Busco la funcion en el indice del grafo */
+    funcion_a_retornar = buscar_funcion_en_grafo ( grafo , address );
+  }
+  else
+  {
+  /* Recorro toda la lista de funciones */
+    for ( cont = 0 ; cont < funciones.Len () ; cont ++ )
     {
-    /* Retorno OK */
-      funcion_a_retornar = funcion;
+    /* Levanto la proxima funcion */
+      funcion = ( Funcion * ) funciones.Get ( cont );
 
-    /* Corto la busqueda */
-      break;
+    /* Si es la funcion que estoy buscando */
+      if ( funcion -> address == address )
+      {
+      /* Retorno OK */
+        funcion_a_retornar = funcion;
+
+      /* Corto la busqueda */
+        break;
+      }
     }
   }
 
@@ -2395,11 +3419,21 @@ Funcion *get_estructura_funcion ( List &funciones , unsigned int address )
 
 Funcion *get_estructura_funcion2 ( List &indice_funciones , List &funciones , unsigned int address )
 {
+  Grafo_Programa *grafo;
   Funcion *funcion = NULL;
   unsigned int pos;
 
+/* Levanto el grafo armado con la lista ( si hay ) */
+  grafo = get_grafo_de_lista ( funciones );
+
+/* Si la lista tiene un grafo armado */
+  if ( grafo != NULL )
+  {
+  /* Busco la funcion en el indice del grafo */
+    funcion = buscar_funcion_en_grafo ( grafo , address );
+  }
 /* Si la direccion de la funcion esta en el indice */
-  if ( indice_funciones.GetPos ( ( void * ) address , &pos ) == TRUE )
+  else if ( indice_funciones.GetPos ( ( void * ) address , &pos ) == TRUE )
   {
   /* Retorno la estructura de la funcion buscada */
     funcion = ( Funcion * ) funciones.Get ( pos );
@@ -2560,9 +3594,9 @@ List *get_funciones_de_vtable ( unsigned int address )
 
 /****************************************************************************/
 
-int get_funciones_undefined ( unsigned int nivel , unsigned int address , List &direcciones_iniciales )
+int get_funciones_undefined ( unsigned int address , HashSet &basic_blocks_visitados , List &direcciones_iniciales )
 {
-  static List inicio_basic_blocks;
+  List referencias_pendientes;
   List referencias_padre;
   unsigned int referencia_padre;
   unsigned int address_referenciada;
@@ -2571,56 +3605,63 @@ int get_funciones_undefined ( unsigned int nivel , unsigned int address , List &
   unsigned int cont;
   int ret = FALSE;
 
-/* Si estoy en el primer nivel */
-  if ( nivel == 0 )
-  {
-  /* Reseteo la lista */
-    inicio_basic_blocks.Clear ();
+/* Reinicializo la lista de funciones encontradas */
+  direcciones_iniciales.Clear ();
 
-  /* Reinicializo la lista de funciones encontradas */
-    direcciones_iniciales.Clear ();
-  }
- 
-/* Igualo las direcciones */
-  address_actual = address;
+/* Arranco por la referencia pedida */
+  referencias_pendientes.Add ( ( void * ) address );
 
-/* Avanzo hacia arriba hasta que encuentro una referencia a la direccion actual */
-  while ( ( get_first_fcref_to ( address_actual ) == BADADDR ) && ( get_func ( address_actual ) == NULL ) )
+/* Mientras haya referencias por recorrer */
+  while ( referencias_pendientes.Len () > 0 )
   {
-  /* Backupeo la direccion anterior */
-    address_anterior = address_actual;
+  /* Saco la ultima referencia agregada */
+    address_actual = ( unsigned int ) referencias_pendientes.Get ( referencias_pendientes.Len () - 1 );
+    referencias_pendientes.Delete ( referencias_pendientes.Len () - 1 );
+
+  /* Avanzo hacia arriba hasta que encuentro una referencia a la direccion actual */
+    while ( ( get_first_fcref_to ( address_actual ) == BADADDR ) && ( get_func ( address_actual ) == NULL ) )
+    {
+    /* Backupeo la direccion anterior */
+      address_anterior = address_actual;
+
+    /* Sigo avanzando hacia arriba */
+      address_actual = get_first_cref_to ( address_actual );    
 
-  /* Sigo avanzando hacia arriba */
-    address_actual = get_first_cref_to ( address_actual );    
+    /* Si llegue a una instruccion que NO es referenciada por NADIE */
+      if ( address_actual == BADADDR )
+      {
+      /* Agrego la direccion encontrada a la lista */
+        direcciones_iniciales.Add ( ( void * ) address_anterior );
+        break;
+      }
+    }
 
-  /* Si llegue a una instruccion que NO es referenciada por NADIE */
+  /* Si la referencia termino en una instruccion sin referencias */
     if ( address_actual == BADADDR )
     {
-    /* Agrego la direccion encontrada a la lista */
-      direcciones_iniciales.Add ( ( void * ) address_anterior );
-
-    /* Retorno OK */
-      return ( TRUE );
+    /* Sigo con la proxima */
+      continue;
     }
-  }
 
-/* Si llegue hasta aca encontre el principio de un basic block */
-//  my_msg ( "%x: SUPUESTO BB: %x - %x\n" , address , address_actual , get_first_cref_to ( address_actual ) );
+  /* Si llegue hasta aca encontre el principio de un basic block */
+//    my_msg ( "%x: SUPUESTO BB: %x - %x\n" , address , address_actual , get_first_cref_to ( address_actual ) );
 
-/* Si este basic block no fue visitado */
-  if ( inicio_basic_blocks.Find ( ( void * ) address_actual ) == FALSE )
-  {
-  /* Agrego el basic block a la lista */
-    inicio_basic_blocks.Add ( ( void * ) address_actual );
+  /* Si este basic block ya fue visitado ( desde esta u otra referencia ) */
+    if ( basic_blocks_visitados.Add ( address_actual ) == FALSE )
+    {
+    /* Sigo con la proxima */
+      continue;
+    }
 
   /* Obtengo todas las referencias padre a esta direccion */
+    referencias_padre.Clear ();
     get_referencias_to ( address_actual , referencias_padre );
 
-  /* Avanzo por todas las referencias padre */
-    for ( cont = 0 ; cont < referencias_padre.Len () ; cont ++ )
+  /* Avanzo por todas las referencias padre ( al reves, para recorrerlas en orden ) */
+    for ( cont = referencias_padre.Len () ; cont > 0 ; cont -- )
     {
     /* Levanto la siguiente referencia */
-      referencia_padre = ( unsigned int ) referencias_padre.Get ( cont );
+      referencia_padre = ( unsigned int ) referencias_padre.Get ( cont - 1 );
 
     /* Si es un CALL */
       if ( is_call ( referencia_padre , &address_referenciada ) == TRUE )
@@ -2638,8 +3679,8 @@ int get_funciones_undefined ( unsigned int nivel , unsigned int address , List &
         }
       }
 
-    /* Avanzo por esta referencia */
-      get_funciones_undefined ( nivel + 1 , referencia_padre , direcciones_iniciales );
+    /* Dejo la referencia para recorrer */
+      referencias_pendientes.Add ( ( void * ) referencia_padre );
     }
   }
 
@@ -2965,17 +4006,343 @@ unsigned int setear_peso_a_basic_blocks ( unsigned int nivel , Funcion *funcion
 
 /****************************************************************************/ 
 
-void poner_ids_a_basic_blocks ( int id , Funcion *funcion , Basic_Block *basic_block )
+void calcular_dominadores ( Funcion *funcion )
 {
-  static int id_actual;
-  List ranking_pesos;  
-  Basic_Block *basic_block_hijo1;
-  Basic_Block *basic_block_hijo2;
-  unsigned int address_hija;
-  unsigned int cont1, cont2;
+  Basic_Block *basic_block;
+  Index posiciones;
+  unsigned int *inicio_sucesores;
+  unsigned int *sucesores;
+  unsigned int *inicio_predecesores;
+  unsigned int *predecesores;
+  unsigned int *siguiente_predecesor;
+  unsigned int *postorden;
+  unsigned int *numero_postorden;
+  unsigned int *pila;
+  unsigned int *proximo_hijo;
+  unsigned int *marcas;
+  int *dominadores;
+  unsigned int cantidad;
+  unsigned int cantidad_postorden = 0;
+  unsigned int altura_pila = 0;
+  unsigned int nodo;
+  unsigned int hijo;
+  unsigned int padre;
   unsigned int pos;
+  int nuevo_dominador;
+  int dedo1, dedo2;
+  int es_cabecera;
+  int cambios;
+  unsigned int cont, cont2;
 
-/* Si el basic block NO tiene ID */
+/* Cantidad de basic blocks de la funcion */
+  cantidad = funcion -> cantidad_basic_blocks;
+
+/* Si la funcion NO tiene basic blocks */
+  if ( cantidad == 0 )
+  {
+    return;
+  }
+
+/* Indexo los basic blocks por direccion */
+  for ( cont = 0 ; cont < cantidad ; cont ++ )
+  {
+    posiciones.Add ( funcion -> basic_blocks [ cont ] -> addr_inicial , ( void * ) cont );
+  }
+
+  posiciones.Sort ();
+
+/* Alloco los arrays de trabajo */
+  inicio_sucesores = ( unsigned int * ) malloc ( ( cantidad + 1 ) * sizeof ( unsigned int ) );
+  inicio_predecesores = ( unsigned int * ) malloc ( ( cantidad + 1 ) * sizeof ( unsigned int ) );
+  siguiente_predecesor = ( unsigned int * ) malloc ( cantidad * sizeof ( unsigned int ) );
+  postorden = ( unsigned int * ) malloc ( cantidad * sizeof ( unsigned int ) );
+  numero_postorden = ( unsigned int * ) malloc ( cantidad * sizeof ( unsigned int ) );
+  pila = ( unsigned int * ) malloc ( cantidad * sizeof ( unsigned int ) );
+  proximo_hijo = ( unsigned int * ) malloc ( cantidad * sizeof ( unsigned int ) );
+  marcas = ( unsigned int * ) malloc ( cantidad * sizeof ( unsigned int ) );
+  dominadores = ( int * ) malloc ( cantidad * sizeof ( int ) );
+
+/* Cuento los sucesores de cada basic block */
+  inicio_sucesores [ 0 ] = 0;
+
+  for ( cont = 0 ; cont < cantidad ; cont ++ )
+  {
+    inicio_sucesores [ cont + 1 ] = inicio_sucesores [ cont ] + funcion -> basic_blocks [ cont ] -> basic_blocks_hijos -> Len ();
+    inicio_predecesores [ cont ] = 0;
+  }
+
+/* Resuelvo los sucesores a posiciones y cuento los predecesores */
+  sucesores = ( unsigned int * ) malloc ( ( inicio_sucesores [ cantidad ] + 1 ) * sizeof ( unsigned int ) );
+  predecesores = ( unsigned int * ) malloc ( ( inicio_sucesores [ cantidad ] + 1 ) * sizeof ( unsigned int ) );
+
+  for ( cont = 0 ; cont < cantidad ; cont ++ )
+  {
+    basic_block = funcion -> basic_blocks [ cont ];
+
+    for ( cont2 = 0 ; cont2 < basic_block -> basic_blocks_hijos -> Len () ; cont2 ++ )
+    {
+    /* Si el hijo NO es un basic block de la funcion */
+      if ( posiciones.Find ( ( unsigned int ) basic_block -> basic_blocks_hijos -> Get ( cont2 ) , &pos ) == FALSE )
+      {
+      /* Lo marco como inexistente */
+        sucesores [ inicio_sucesores [ cont ] + cont2 ] = SIN_PAREJA;
+        continue;
+      }
+
+      hijo = ( unsigned int ) posiciones.Get ( pos );
+      sucesores [ inicio_sucesores [ cont ] + cont2 ] = hijo;
+      inicio_predecesores [ hijo ] ++;
+    }
+  }
+
+/* Acumulo los predecesores */
+  for ( cont = 0 , pos = 0 ; cont < cantidad ; cont ++ )
+  {
+    nodo = inicio_predecesores [ cont ];
+    inicio_predecesores [ cont ] = pos;
+    siguiente_predecesor [ cont ] = pos;
+    pos += nodo;
+  }
+
+  inicio_predecesores [ cantidad ] = pos;
+
+/* Lleno los predecesores */
+  for ( cont = 0 ; cont < cantidad ; cont ++ )
+  {
+    for ( cont2 = inicio_sucesores [ cont ] ; cont2 < inicio_sucesores [ cont + 1 ] ; cont2 ++ )
+    {
+      if ( sucesores [ cont2 ] != SIN_PAREJA )
+      {
+        predecesores [ siguiente_predecesor [ sucesores [ cont2 ] ] ++ ] = cont;
+      }
+    }
+  }
+
+/* Inicializo los numeros de postorden y los dominadores */
+  for ( cont = 0 ; cont < cantidad ; cont ++ )
+  {
+    numero_postorden [ cont ] = SIN_PAREJA;
+    dominadores [ cont ] = SIN_DOMINADOR;
+    marcas [ cont ] = SIN_PAREJA;
+  }
+
+/* Recorro el grafo en profundidad desde el basic block raiz ( sin recursion ) */
+  pila [ altura_pila ++ ] = 0;
+  proximo_hijo [ 0 ] = inicio_sucesores [ 0 ];
+  marcas [ 0 ] = 0;
+
+  while ( altura_pila > 0 )
+  {
+    nodo = pila [ altura_pila - 1 ];
+
+  /* Si al basic block le quedan hijos por recorrer */
+    if ( proximo_hijo [ nodo ] < inicio_sucesores [ nodo + 1 ] )
+    {
+      hijo = sucesores [ proximo_hijo [ nodo ] ++ ];
+
+    /* Si el hijo NO fue visitado */
+      if ( ( hijo != SIN_PAREJA ) && ( marcas [ hijo ] == SIN_PAREJA ) )
+      {
+        marcas [ hijo ] = 0;
+        proximo_hijo [ hijo ] = inicio_sucesores [ hijo ];
+        pila [ altura_pila ++ ] = hijo;
+      }
+    }
+  /* Si ya recorri todos los hijos */
+    else
+    {
+      numero_postorden [ nodo ] = cantidad_postorden;
+      postorden [ cantidad_postorden ++ ] = nodo;
+      altura_pila --;
+    }
+  }
+
+/* Calculo los dominadores inmediatos ( Cooper, Harvey, Kennedy ) */
+  dominadores [ 0 ] = 0;
+
+  do
+  {
+    cambios = FALSE;
+
+  /* Recorro los basic blocks en postorden inverso */
+    for ( cont = cantidad_postorden - 1 ; cont > 0 ; cont -- )
+    {
+      nodo = postorden [ cont - 1 ];
+      nuevo_dominador = SIN_DOMINADOR;
+
+    /* Intersecto los dominadores de los padres ya procesados */
+      for ( cont2 = inicio_predecesores [ nodo ] ; cont2 < inicio_predecesores [ nodo + 1 ] ; cont2 ++ )
+      {
+        padre = predecesores [ cont2 ];
+
+      /* Si el padre todavia no tiene dominador */
+        if ( dominadores [ padre ] == SIN_DOMINADOR )
+        {
+          continue;
+        }
+
+      /* Si es el primer padre */
+        if ( nuevo_dominador == SIN_DOMINADOR )
+        {
+          nuevo_dominador = ( int ) padre;
+          continue;
+        }
+
+      /* Subo por el arbol de dominadores hasta que los dedos se encuentran */
+        dedo1 = ( int ) padre;
+        dedo2 = nuevo_dominador;
+
+        while ( dedo1 != dedo2 )
+        {
+          while ( numero_postorden [ dedo1 ] < numero_postorden [ dedo2 ] )
+          {
+            dedo1 = dominadores [ dedo1 ];
+          }
+
+          while ( numero_postorden [ dedo2 ] < numero_postorden [ dedo1 ] )
+          {
+            dedo2 = dominadores [ dedo2 ];
+          }
+        }
+
+        nuevo_dominador = dedo1;
+      }
+
+    /* Si el dominador cambio */
+      if ( dominadores [ nodo ] != nuevo_dominador )
+      {
+        dominadores [ nodo ] = nuevo_dominador;
+        cambios = TRUE;
+      }
+    }
+  }
+  while ( cambios == TRUE );
+
+/* Guardo los dominadores inmediatos ( la raiz no tiene ) */
+  for ( cont = 0 ; cont < cantidad ; cont ++ )
+  {
+    basic_block = funcion -> basic_blocks [ cont ];
+    basic_block -> dominador = ( cont == 0 ) ? SIN_DOMINADOR : dominadores [ cont ];
+    basic_block -> profundidad_loop = 0;
+    basic_block -> cabecera_loop = FALSE;
+    marcas [ cont ] = SIN_PAREJA;
+  }
+
+/* Busco los loops naturales: los padres dominados por el basic block son back edges */
+  for ( nodo = 0 ; nodo < cantidad ; nodo ++ )
+  {
+  /* Si el basic block es inalcanzable */
+    if ( dominadores [ nodo ] == SIN_DOMINADOR )
+    {
+      continue;
+    }
+
+    altura_pila = 0;
+    es_cabecera = FALSE;
+
+  /* Junto los origenes de los back edges que llegan a este basic block */
+    for ( cont2 = inicio_predecesores [ nodo ] ; cont2 < inicio_predecesores [ nodo + 1 ] ; cont2 ++ )
+    {
+      padre = predecesores [ cont2 ];
+
+      if ( ( dominadores [ padre ] != SIN_DOMINADOR ) && ( es_dominado ( dominadores , padre , nodo ) == TRUE ) )
+      {
+        es_cabecera = TRUE;
+
+      /* Los loops de un solo basic block no tienen cuerpo para recorrer */
+        if ( ( padre != nodo ) && ( marcas [ padre ] != nodo ) )
+        {
+          marcas [ padre ] = nodo;
+          pila [ altura_pila ++ ] = padre;
+        }
+      }
+    }
+
+  /* Si NO es la cabecera de un loop */
+    if ( es_cabecera == FALSE )
+    {
+      continue;
+    }
+
+  /* Marco la cabecera del loop */
+    funcion -> basic_blocks [ nodo ] -> cabecera_loop = TRUE;
+    funcion -> basic_blocks [ nodo ] -> profundidad_loop ++;
+    marcas [ nodo ] = nodo;
+
+  /* Subo por los padres hasta la cabecera marcando el cuerpo del loop */
+    while ( altura_pila > 0 )
+    {
+      hijo = pila [ -- altura_pila ];
+      funcion -> basic_blocks [ hijo ] -> profundidad_loop ++;
+
+      for ( cont2 = inicio_predecesores [ hijo ] ; cont2 < inicio_predecesores [ hijo + 1 ] ; cont2 ++ )
+      {
+        padre = predecesores [ cont2 ];
+
+        if ( ( dominadores [ padre ] != SIN_DOMINADOR ) && ( marcas [ padre ] != nodo ) )
+        {
+          marcas [ padre ] = nodo;
+          pila [ altura_pila ++ ] = padre;
+        }
+      }
+    }
+  }
+
+/* Libero los arrays de trabajo */
+  free ( inicio_sucesores );
+  free ( sucesores );
+  free ( inicio_predecesores );
+  free ( predecesores );
+  free ( siguiente_predecesor );
+  free ( postorden );
+  free ( numero_postorden );
+  free ( pila );
+  free ( proximo_hijo );
+  free ( marcas );
+  free ( dominadores );
+}
+
+/****************************************************************************/ 
+
+int es_dominado ( int *dominadores , unsigned int nodo , unsigned int dominador )
+{
+  int ret = FALSE;
+
+/* Subo por el arbol de dominadores */
+  while ( TRUE )
+  {
+  /* Si llegue al dominador */
+    if ( nodo == dominador )
+    {
+      ret = TRUE;
+      break;
+    }
+
+  /* Si llegue a la raiz */
+    if ( ( nodo == 0 ) || ( dominadores [ nodo ] == SIN_DOMINADOR ) )
+    {
+      break;
+    }
+
+    nodo = ( unsigned int ) dominadores [ nodo ];
+  }
+
+  return ( ret );
+}
+
+/****************************************************************************/ 
+
+void poner_ids_a_basic_blocks ( int id , Funcion *funcion , Basic_Block *basic_block )
+{
+  static int id_actual;
+  List ranking_pesos;  
+  Basic_Block *basic_block_hijo1;
+  Basic_Block *basic_block_hijo2;
+  unsigned int address_hija;
+  unsigned int cont1, cont2;
+  unsigned int pos;
+
+/* Si el basic block NO tiene ID */
   if ( basic_block -> id == -1 )
   {
   /* Pongo el ID al basic block */
@@ -3144,6 +4511,128 @@ char *generar_ecuacion_de_grafo_de_funcion ( Funcion *funcion )
 
 /****************************************************************************/ 
 
+unsigned int calcular_hash_de_grafo ( Funcion *funcion )
+{
+  Basic_Block *basic_block;
+  Index posiciones;
+  unsigned int *etiquetas;
+  unsigned int *vecinos_hijos;
+  unsigned int *vecinos_padres;
+  unsigned int *conexiones;
+  unsigned int caracteristicas [ 4 ];
+  unsigned int cantidad_conexiones = 0;
+  unsigned int address_hija;
+  unsigned int etiqueta;
+  unsigned int hash;
+  unsigned int suma = 0;
+  unsigned int iteracion;
+  unsigned int cont, cont2;
+  unsigned int pos;
+
+/* Alloco las etiquetas y las sumas de los vecinos de cada basic block */
+  etiquetas = ( unsigned int * ) malloc ( funcion -> cantidad_basic_blocks * sizeof ( unsigned int ) );
+  vecinos_hijos = ( unsigned int * ) malloc ( funcion -> cantidad_basic_blocks * sizeof ( unsigned int ) );
+  vecinos_padres = ( unsigned int * ) malloc ( funcion -> cantidad_basic_blocks * sizeof ( unsigned int ) );
+
+/* Alloco las conexiones como pares ( padre , hijo ) de posiciones en el array */
+  conexiones = ( unsigned int * ) malloc ( ( funcion -> conexiones_internas + 1 ) * 2 * sizeof ( unsigned int ) );
+
+/* Indexo los basic blocks por direccion */
+  for ( cont = 0 ; cont < funcion -> cantidad_basic_blocks ; cont ++ )
+  {
+    posiciones.Add ( funcion -> basic_blocks [ cont ] -> addr_inicial , ( void * ) cont );
+  }
+
+  posiciones.Sort ();
+
+/* Resuelvo las conexiones una sola vez */
+  for ( cont = 0 ; cont < funcion -> cantidad_basic_blocks ; cont ++ )
+  {
+  /* Levanto el siguiente basic block */
+    basic_block = funcion -> basic_blocks [ cont ];
+
+  /* Recorro todos los hijos del basic block */
+    for ( cont2 = 0 ; ( cont2 < basic_block -> basic_blocks_hijos -> Len () ) && ( cantidad_conexiones < funcion -> conexiones_internas + 1 ) ; cont2 ++ )
+    {
+    /* Levanto la direccion del hijo */
+      address_hija = ( unsigned int ) basic_block -> basic_blocks_hijos -> Get ( cont2 );
+
+    /* Si el hijo es un basic block de la funcion */
+      if ( posiciones.Find ( address_hija , &pos ) == TRUE )
+      {
+      /* Agrego la conexion */
+        conexiones [ cantidad_conexiones * 2 ] = cont;
+        conexiones [ cantidad_conexiones * 2 + 1 ] = ( unsigned int ) posiciones.Get ( pos );
+        cantidad_conexiones ++;
+      }
+    }
+  }
+
+/* Etiqueto cada basic block con sus caracteristicas */
+  for ( cont = 0 ; cont < funcion -> cantidad_basic_blocks ; cont ++ )
+  {
+  /* Levanto el siguiente basic block */
+    basic_block = funcion -> basic_blocks [ cont ];
+
+  /* Cantidad de instrucciones, llamados, hijos y si es la entrada de la funcion */
+    caracteristicas [ 0 ] = basic_block -> longitud;
+    caracteristicas [ 1 ] = basic_block -> funciones_hijas -> Len ();
+    caracteristicas [ 2 ] = basic_block -> basic_blocks_hijos -> Len ();
+    caracteristicas [ 3 ] = ( cont == 0 ) ? TRUE : FALSE;
+
+  /* Seteo la etiqueta inicial */
+    etiquetas [ cont ] = calcular_hash ( HASH_INICIAL , caracteristicas , sizeof ( caracteristicas ) );
+  }
+
+/* Refino las etiquetas con las de los vecinos ( Weisfeiler-Lehman ) */
+  for ( iteracion = 0 ; iteracion < ITERACIONES_WL ; iteracion ++ )
+  {
+  /* Inicializo las sumas de los vecinos */
+    memset ( vecinos_hijos , 0 , funcion -> cantidad_basic_blocks * sizeof ( unsigned int ) );
+    memset ( vecinos_padres , 0 , funcion -> cantidad_basic_blocks * sizeof ( unsigned int ) );
+
+  /* Sumo las etiquetas de los vecinos ( la suma no depende del orden de los saltos ) */
+    for ( cont = 0 ; cont < cantidad_conexiones ; cont ++ )
+    {
+      etiqueta = etiquetas [ conexiones [ cont * 2 + 1 ] ];
+      vecinos_hijos [ conexiones [ cont * 2 ] ] += calcular_hash ( HASH_INICIAL , &etiqueta , sizeof ( etiqueta ) );
+
+      etiqueta = etiquetas [ conexiones [ cont * 2 ] ];
+      vecinos_padres [ conexiones [ cont * 2 + 1 ] ] += calcular_hash ( HASH_PRIMO , &etiqueta , sizeof ( etiqueta ) );
+    }
+
+  /* Armo la nueva etiqueta de cada basic block */
+    for ( cont = 0 ; cont < funcion -> cantidad_basic_blocks ; cont ++ )
+    {
+      caracteristicas [ 0 ] = etiquetas [ cont ];
+      caracteristicas [ 1 ] = vecinos_hijos [ cont ];
+      caracteristicas [ 2 ] = vecinos_padres [ cont ];
+      etiquetas [ cont ] = calcular_hash ( HASH_INICIAL , caracteristicas , sizeof ( unsigned int ) * 3 );
+    }
+  }
+
+/* Combino todas las etiquetas sin importar el orden de los basic blocks */
+  for ( cont = 0 ; cont < funcion -> cantidad_basic_blocks ; cont ++ )
+  {
+    etiqueta = etiquetas [ cont ];
+    suma += calcular_hash ( HASH_INICIAL , &etiqueta , sizeof ( etiqueta ) );
+  }
+
+/* La firma incluye la cantidad de basic blocks */
+  hash = calcular_hash ( HASH_INICIAL , &funcion -> cantidad_basic_blocks , sizeof ( unsigned int ) );
+  hash = calcular_hash ( hash , &suma , sizeof ( suma ) );
+
+/* Libero los arrays */
+  free ( etiquetas );
+  free ( vecinos_hijos );
+  free ( vecinos_padres );
+  free ( conexiones );
+
+  return ( hash );
+}
+
+/****************************************************************************/ 
+
 Basic_Block *get_basic_block_by_id ( Funcion *funcion , int id )
 {
   Basic_Block *basic_block;
@@ -3212,11 +4701,15 @@ void liberar_basic_blocks ( Funcion *funcion )
 
 int guardar_analisis ( char *filename )
 {
-  Funcion *funcion;
-  unsigned int referencia_hija;
+/* Guardo todas las funciones del programa */
+  return ( guardar_funciones ( filename , funciones ) );
+}
+
+/****************************************************************************/
+
+int guardar_funciones ( char *filename , List &funciones )
+{
   unsigned int cont;
-  unsigned int cont2;
-  unsigned int cont3;
   int ret = TRUE;
   FILE *f;
 
@@ -3229,1447 +4722,6770 @@ int guardar_analisis ( char *filename )
 /* Recorro todas las funciones detectadas */
   for ( cont = 0 ; cont < funciones.Len () ; cont ++ )
   {
-  /* Levanto la siguiente funcion */
-    funcion = ( Funcion * ) funciones.Get ( cont );
+  /* Guardo el analisis de la siguiente funcion */
+    guardar_funcion ( f , ( Funcion * ) funciones.Get ( cont ) );
+  }
+
+/* Cierro el archivo */
+  qfclose ( f );
 
-  /* Guardo el analisis de la funcion */
-    qfwrite ( f , funcion , sizeof ( Funcion ) );
+  return ( ret );
+}
 
-  /* Guardo todos los basic blocks */
-    for ( cont2 = 0 ; cont2 < funcion -> cantidad_basic_blocks ; cont2 ++ )
-    {
-    /* Guardo el siguiente basic block en el file */
-      qfwrite ( f , funcion -> basic_blocks [ cont2 ] , sizeof ( Basic_Block ) );
+/****************************************************************************/
+
+int guardar_funcion ( FILE *f , Funcion *funcion )
+{
+  unsigned int referencia_hija;
+  unsigned int cont2;
+  unsigned int cont3;
+  int ret = TRUE;
 
-    /* Guardo todas las conexiones con los basic blocks hijos */
-      funcion -> basic_blocks [ cont2 ] -> basic_blocks_hijos -> Save ( f );
+/* Guardo el analisis de la funcion */
+  qfwrite ( f , funcion , sizeof ( Funcion ) );
 
-    /* Guardo todas las referencias de este basic block */
-      for ( cont3 = 0 ; cont3 < funcion -> basic_blocks [ cont2 ] -> cantidad_referencias ; cont3 ++ )
-      {
-      /* Levanto la siguiente direccion */
-        referencia_hija = ( unsigned int ) funcion -> basic_blocks [ cont2 ] -> funciones_hijas -> Get ( cont3 );
+/* Guardo todos los basic blocks */
+  for ( cont2 = 0 ; cont2 < funcion -> cantidad_basic_blocks ; cont2 ++ )
+  {
+  /* Guardo el siguiente basic block en el file */
+    qfwrite ( f , funcion -> basic_blocks [ cont2 ] , sizeof ( Basic_Block ) );
 
-      /* Guardo la direccion */
-        qfwrite ( f , &referencia_hija , sizeof ( unsigned int ) );
-      }
+  /* Guardo todas las conexiones con los basic blocks hijos */
+    funcion -> basic_blocks [ cont2 ] -> basic_blocks_hijos -> Save ( f );
+
+  /* Guardo todas las referencias de este basic block */
+    for ( cont3 = 0 ; cont3 < funcion -> basic_blocks [ cont2 ] -> cantidad_referencias ; cont3 ++ )
+    {
+    /* Levanto la siguiente direccion */
+      referencia_hija = ( unsigned int ) funcion -> basic_blocks [ cont2 ] -> funciones_hijas -> Get ( cont3 );
 
-    /* Guardo la lista PERSISTENTE de conexiones DEBILES ( vtables ) */
-      funcion -> basic_blocks [ cont2 ] -> ptr_funciones_hijas -> Save ( f );
+    /* Guardo la direccion */
+      qfwrite ( f , &referencia_hija , sizeof ( unsigned int ) );
     }
 
-  /* Guardo todas las referencias padre */
-    qfwrite ( f , funcion -> basic_blocks_padres , funcion -> cantidad_referencias_padre * sizeof ( Basic_Block_Padre ) );
+  /* Guardo la lista PERSISTENTE de conexiones DEBILES ( vtables ) */
+    funcion -> basic_blocks [ cont2 ] -> ptr_funciones_hijas -> Save ( f );
+
+  /* Guardo la cadena de basic blocks ( para poder reusar el analisis ) */
+    funcion -> basic_blocks [ cont2 ] -> cadena_basic_blocks -> Save ( f );
 
-  /* Guardo todas las referencias a traves de vtables */
-//    qfwrite ( f , funcion -> referencias_x_vtable , funcion -> cantidad_referencias_x_vtable * sizeof ( Referencia_Vtable ) );
-    funcion -> referencias_padre_x_vtable -> Save ( f );
+  /* Guardo las anclas del basic block */
+    funcion -> basic_blocks [ cont2 ] -> anclas -> Save ( f );
   }
 
-/* Cierro el archivo */
-  qfclose ( f );
+/* Guardo todas las referencias padre */
+  qfwrite ( f , funcion -> basic_blocks_padres , funcion -> cantidad_referencias_padre * sizeof ( Basic_Block_Padre ) );
+
+/* Guardo todas las referencias a traves de vtables */
+//  qfwrite ( f , funcion -> referencias_x_vtable , funcion -> cantidad_referencias_x_vtable * sizeof ( Referencia_Vtable ) );
+  funcion -> referencias_padre_x_vtable -> Save ( f );
 
   return ( ret );
 }
 
-/****************************************************************************/ 
+/****************************************************************************/
 
-int guardar_desensamblado ( char *file_dis )
+int guardar_en_almacen ( char *file_analisis , List &funciones )
 {
+  char file_manifiesto [ QMAXPATH ];
+  Entrada_Almacen *entrada_previa;
+  Entrada_Almacen *entrada_nueva;
+  Entrada_Almacen entrada;
   Funcion *funcion;
+  Index entradas;
+  List entradas_alocadas;
+  unsigned int cantidad;
+  unsigned int nuevas = 0;
   unsigned int pos;
+  FILE *f_almacen;
+  FILE *f_manifiesto;
   int ret = TRUE;
-  FILE *fdis;
 
-/* Intento abrir el file */
-  fdis = qfopen ( file_dis , "wb" );
+/* Abro el almacen ( si no existe lo creo ) */
+  f_almacen = abrir_almacen ( file_analisis , TRUE );
 
-/* Si no pude abrir el archivo */
-  if ( fdis == NULL )
+/* Si no pude abrir el almacen */
+  if ( f_almacen == NULL )
   {
   /* Retorno ERROR */
     return ( FALSE );
   }
 
-/* Recorro todas las funciones */
-  for ( pos = 0 ; pos < funciones.Len () ; pos ++ )
-  {
-  /* Levanto la siguiente funcion */
-    funcion = ( Funcion * ) funciones.Get ( pos );
-
-  /* Guardo el codigo desensamblado de la funcion */
-    guardar_desensamblado_de_funcion ( fdis , funcion );
-  }
-
-/* Cierro el file */
-  qfclose ( fdis );
-
-  return ( ret );
-}
+/* Indexo las funciones que ya estan en el almacen */
+  indexar_almacen ( f_almacen , file_analisis , entradas , entradas_alocadas );
 
-/****************************************************************************/ 
+/* Armo el nombre del manifiesto */
+  qstrncpy ( file_manifiesto , file_analisis , QMAXPATH );
+  change_extension ( file_manifiesto , EXTENSION_MANIFIESTO );
 
-int guardar_desensamblado_de_funcion ( FILE *fdis , Funcion *funcion )
-{
-  List *cadena_basic_blocks;
-  String desensamblado;
-  char instruccion [ 256 ];
-  unsigned int addr_actual;
-  unsigned int len_instruccion;
-  unsigned int cont, cont2, cont3;
-  Basic_Block *basic_block;
-  int ret = TRUE;
+/* Creo el manifiesto de este analisis */
+  f_manifiesto = qfopen ( file_manifiesto , "wb" );
 
-/* Recorro todos los basic blocks de la funcion */
-  for ( cont = 0 ; cont < funcion -> cantidad_basic_blocks ; cont ++ )
+/* Si no pude crear el manifiesto */
+  if ( f_manifiesto == NULL )
   {
-  /* Levanto el siguiente basic block */
-    basic_block = funcion -> basic_blocks [ cont ];
-
-  /* Obtengo la posicion en el file donde esta el desensamblado del basic block */
-    basic_block -> pos_file_disasm = qftell ( fdis );
-
-  /* Obtengo el encadenamiento de basic blocks */
-    cadena_basic_blocks = basic_block -> cadena_basic_blocks;
-
-  /* Reinicializo el string donde van a ir a parar las instrucciones del basic block */
-    desensamblado.Reset ();
-
-  /* Recorro toda la cadena de basic blocks simples */
-    for ( cont3 = 0 ; cont3 < cadena_basic_blocks -> Len () ; cont3 = cont3 + 2 )
-    {
-    /* Direccion inicial del basic block simple */
-      addr_actual = ( unsigned int ) cadena_basic_blocks -> Get ( cont3 );
-
-    /* Guardo las n instrucciones en el file */
-      for ( cont2 = 0 ; cont2 < ( unsigned int ) cadena_basic_blocks -> Get ( cont3 + 1 ) ; cont2 ++ )
-      {
-      /* Averiguo la longitud en bytes de la instruccion */
-        len_instruccion = get_item_size ( addr_actual );
+  /* Cierro el almacen */
+    qfclose ( f_almacen );
 
-      /* Levanto la siguiente instruccion */
-        get_instruction ( addr_actual , instruccion , 256 );
-
-      /* Anexo la siguiente instruccion */
-        desensamblado.Append ( instruccion );
-
-      /* Anexo un ENTER */
-        desensamblado.Append ( "\n" );
-
-      /* Avanzo a la siguiente instruccion */
-        addr_actual = addr_actual + len_instruccion;
-      }
-    }
-
-  /* Guardo el desensamblado del basic block en el file */
-    desensamblado.Save ( fdis );
+  /* Retorno ERROR */
+    ret = FALSE;
   }
+  else
+  {
+  /* Guardo la version y la cantidad de funciones */
+    cantidad = funciones.Len ();
+    qfwrite ( f_manifiesto , ( void * ) &turbodiff_version , sizeof ( unsigned int ) );
+    qfwrite ( f_manifiesto , &cantidad , sizeof ( unsigned int ) );
 
-  return ( ret );
-}                                                
-
-/****************************************************************************/ 
-
-char *get_instruction ( unsigned int address , char *instruction , unsigned int buffer_len )
-{
-  unsigned int longitud;
-  unsigned int pos1, pos2;
-  char s [ 256 ];
+  /* Me paro al final del almacen para agregar las funciones nuevas */
+    qfseek ( f_almacen , 0 , SEEK_END );
 
-/* Desensamblo la linea */
-  generate_disasm_line ( address , s , 256 );
+  /* Recorro todas las funciones */
+    for ( pos = 0 ; pos < funciones.Len () ; pos ++ )
+    {
+    /* Levanto la siguiente funcion */
+      funcion = ( Funcion * ) funciones.Get ( pos );
 
-/* Longitud de la instruccion */
-  longitud = strlen ( s );
+    /* Calculo la huella fuerte de la funcion */
+      calcular_huella_fuerte ( funcion , entrada.huella );
+      entrada.cantidad_basic_blocks = funcion -> cantidad_basic_blocks;
 
-/* Voy copiando el string limpito al destino */
-  for ( pos1 = 0 , pos2 = 0 ; pos1 < longitud , ( pos2 + 1 ) < buffer_len ; pos1 ++ )
-  {
-  /* Si detecto una referencia en el programa */
-    if ( ( s [ pos1 ] == 0x01 ) && ( s [ pos1 + 1 ] == 0x28 ) )
-    {
-    /* Avanzo 2 posiciones en el string */
-      pos1 = pos1 + 2 + ( sizeof ( unsigned int ) * 2 );
-    }
+    /* Busco si la funcion ya esta en el almacen */
+      entrada_previa = buscar_en_almacen ( entradas , entrada.huella );
 
-  /* Si no es ningun caracter especial */
-    if ( ( s [ pos1 ] != 0x01 ) && ( s [ pos1 ] != 0x02 ) )
-    {
-    /* Si NO es una comilla */
-      if ( s [ pos1 ] != '"' )
+    /* Si la funcion ya esta guardada */
+      if ( entrada_previa != NULL )
       {
-      /* Copio el siguiente caracter */
-        instruction [ pos2 ] = s [ pos1 ];
+      /* Referencio el registro existente */
+        entrada.posicion = entrada_previa -> posicion;
       }
-    /* Si es una comilla */
       else
       {
-      /* Reemplazo la comilla doble por una comilla simple */
-        instruction [ pos2 ] = '\'';
+      /* Agrego la funcion al final del almacen */
+        entrada.posicion = qftell ( f_almacen );
+        qfwrite ( f_almacen , entrada.huella , sizeof ( entrada.huella ) );
+        guardar_funcion ( f_almacen , funcion );
+
+      /* La agrego a las entradas que van al indice persistente */
+        entrada_nueva = ( Entrada_Almacen * ) malloc ( sizeof ( Entrada_Almacen ) );
+        memcpy ( entrada_nueva , &entrada , sizeof ( Entrada_Almacen ) );
+        entradas_alocadas.Add ( entrada_nueva );
+
+      /* Cuento la funcion nueva */
+        nuevas ++;
       }
 
-    /* Avanzo en el string destino */
-      pos2 ++;
-    }
-    else
-    {
-    /* Salteo el proximo byte */
-      pos1 ++;
+    /* Guardo la referencia en el manifiesto */
+      qfwrite ( f_manifiesto , &entrada , sizeof ( Entrada_Almacen ) );
+
+    /* Guardo lo que depende del build ( direcciones, nombres y posiciones en el .dis ) */
+      guardar_datos_de_build ( f_manifiesto , funcion );
     }
-  }   
 
-/* Cierro el string generado */
-  instruction [ pos2 ] = '\x00';
+  /* Actualizo el indice persistente del almacen */
+    guardar_indice_almacen ( f_almacen , file_analisis , entradas_alocadas );
 
-/* Retorno el string armado */
-  return ( instruction );
+  /* Cierro los archivos */
+    qfclose ( f_manifiesto );
+    qfclose ( f_almacen );
+
+  /* Mensaje al usuario */
+    my_msg ( "function store: %u new functions, %u already stored\n" , nuevas , funciones.Len () - nuevas );
+  }
+
+/* Libero el indice del almacen */
+  for ( pos = 0 ; pos < entradas_alocadas.Len () ; pos ++ )
+  {
+    free ( entradas_alocadas.Get ( pos ) );
+  }
+
+  return ( ret );
 }
 
-/****************************************************************************/ 
+/****************************************************************************/
 
-int comparar_files ( char *filename1 , char *filename2 , char *log_file , int usar_simbolos )
+FILE *reconstruir_analisis_desde_almacen ( char *file_analisis )
 {
+  char file_manifiesto [ QMAXPATH ];
+  char directorio [ QMAXPATH ];
+  char file_temporal [ QMAXPATH ];
+  Entrada_Almacen entrada;
   Funcion *funcion;
-  Funcion *funcion1;
-  Funcion *funcion2;
-  char error_message [ 256 ];
-  char funcion1_name [ NAME_LEN ];
-  char funcion2_name [ NAME_LEN ];
-  unsigned int error_pos;
-  unsigned int file1_version;
-  unsigned int file2_version;
-  unsigned int cont, cont1, cont2;
+  List indice_reconstruidas;
+  List reconstruidas;
+  unsigned int version_manifiesto;
+  unsigned int cantidad;
   unsigned int pos;
-  unsigned int pasada = 0;
-  int funciones_reconocidas;
-  int matched_functions;
-  int ret = TRUE;
-  FILE *f_log_file;
-  FILE *f1;
-  FILE *f2;
-  int err;
+  FILE *f_almacen;
+  FILE *f_manifiesto;
+  FILE *f = NULL;
 
-/* Abro el primer archivo */
-  f1 = qfopen ( filename1 , "rb" );
+/* Armo el nombre del manifiesto */
+  qstrncpy ( file_manifiesto , file_analisis , QMAXPATH );
+  change_extension ( file_manifiesto , EXTENSION_MANIFIESTO );
 
-/* Abro el segundo archivo */
-  f2 = qfopen ( filename2 , "rb" );
+/* Abro el manifiesto */
+  f_manifiesto = qfopen ( file_manifiesto , "rb" );
 
-/* Si no pude abrir alguno de los 2 archivos */
-  if ( ( f1 == NULL ) || ( f2 == NULL ) )
+/* Si NO hay manifiesto de este analisis */
+  if ( f_manifiesto == NULL )
   {
   /* Retorno ERROR */
-    return ( FALSE );
+    return ( NULL );
   }
 
-/* Leo la version de los files */
-  qfread ( f1 , ( void * ) &file1_version , sizeof ( unsigned int ) );
-  qfread ( f2 , ( void * ) &file2_version , sizeof ( unsigned int ) );
+/* Leo la version del manifiesto */
+  qfread ( f_manifiesto , &version_manifiesto , sizeof ( unsigned int ) );
 
-/* Si alguna de las versiones NO coincide con la actual */
-  if ( ( file1_version != turbodiff_version ) || ( file2_version != turbodiff_version ) )
-  {
-  /* Mensaje al usuario */
-    my_msg ( "ERROR: Different file versions, please take the analysis again\n" );
+/* Abro el almacen */
+  f_almacen = abrir_almacen ( file_analisis , FALSE );
 
-  /* Retorno ERROR */
-    return ( FALSE );
+/* Si el manifiesto es de esta version y hay almacen */
+  if ( ( version_manifiesto == turbodiff_version ) && ( f_almacen != NULL ) )
+  {
+  /* Armo un file temporal ( la "D" lo borra al cerrarlo, el analisis NO queda en disco ) */
+    GetTempPath ( QMAXPATH , directorio );
+    GetTempFileName ( directorio , "tdf" , 0 , file_temporal );
+    f = qfopen ( file_temporal , "w+bD" );
   }
 
-/* Abro el file para loguear el resultado */
-  if ( ( f_log_file = qfopen ( log_file , "wt" ) ) == NULL )
+/* Si no pude reconstruir el analisis */
+  if ( f == NULL )
   {
-  /* Mensaje de ERROR */
-    MessageBox ( NULL , "cannot open log file" , "ERROR" , MB_ICONERROR | MB_TOPMOST );
+  /* Mensaje al usuario */
+    my_msg ( "ERROR: cannot rebuild %s from the function store\n" , file_analisis );
+
+  /* Cierro los archivos */
+    qfclose ( f_manifiesto );
+
+    if ( f_almacen != NULL )
+    {
+      qfclose ( f_almacen );
+    }
 
   /* Retorno ERROR */
-    return ( FALSE );
+    return ( NULL );
   }
 
-/* Levanto todas las funciones analizadas de file1 */
-  my_msg ( "loading %s ...\n" , filename1 );
-  levantar_funciones ( f1 , indice_funciones1 , funciones1 );
+/* Mensaje al usuario */
+  my_msg ( "rebuilding %s from the function store ...\n" , file_analisis );
 
-/* Hago una copia de la lista de funciones */
-  for ( pos = 0 ; pos < funciones1.Len () ; pos ++ )
+/* Leo la cantidad de funciones */
+  qfread ( f_manifiesto , &cantidad , sizeof ( unsigned int ) );
+
+/* Guardo la version del differ */
+  qfwrite ( f , ( void * ) &turbodiff_version , sizeof ( unsigned int ) );
+
+/* Levanto todas las funciones referenciadas */
+  for ( pos = 0 ; pos < cantidad ; pos ++ )
   {
-  /* Levanto el siguiente elemento */
-    funcion = ( Funcion * ) funciones1.Get ( pos );
+  /* Leo la siguiente referencia */
+    qfread ( f_manifiesto , &entrada , sizeof ( Entrada_Almacen ) );
 
-  /* Duplico el elemento */
-    funciones1_levantadas.Add ( funcion );
-  }
+  /* Me paro en el registro de la funcion ( despues de la huella ) */
+    qfseek ( f_almacen , entrada.posicion + sizeof ( entrada.huella ) , SEEK_SET );
 
-/* Levanto todas las funciones analizadas de file2 */
-  my_msg ( "loading %s ...\n" , filename2 );
-  levantar_funciones ( f2 , indice_funciones2 , funciones2 );
+  /* Levanto la funcion */
+    funcion = ( Funcion * ) malloc ( sizeof ( Funcion ) );
+    qfread ( f_almacen , funcion , sizeof ( Funcion ) );
+    levantar_cuerpo_de_funcion ( f_almacen , funcion );
 
-/* Hago una copia de la lista de funciones */
-  for ( pos = 0 ; pos < funciones2.Len () ; pos ++ )
-  {
-  /* Levanto el siguiente elemento */
-    funcion = ( Funcion * ) funciones2.Get ( pos );
+  /* Los punteros guardados no valen nada */
+    funcion -> graph_ecuation = NULL;
+    funcion -> grafo = NULL;
 
-  /* Duplico el elemento */
-    funciones2_levantadas.Add ( funcion );
+  /* Llevo la funcion a las direcciones de este build */
+    levantar_datos_de_build ( f_manifiesto , funcion );
+
+  /* La agrego al analisis temporal */
+    guardar_funcion ( f , funcion );
+
+  /* Libero la funcion ( no hace falta tener todo el analisis en memoria ) */
+    indice_reconstruidas.Add ( ( void * ) funcion -> address );
+    reconstruidas.Add ( funcion );
+    liberar_funciones ( indice_reconstruidas , reconstruidas );
   }
 
 /* Cierro los archivos */
-  qfclose ( f1 );
-  qfclose ( f2 );
+  qfclose ( f_manifiesto );
+  qfclose ( f_almacen );
 
-/* Mensaje de funciones cargadas para el usuario */
-  my_msg ( "loaded functions for file1: %i\n" , funciones1_levantadas.Len () );
-  my_msg ( "loaded functions for file2: %i\n" , funciones2_levantadas.Len () );
+/* Dejo el analisis listo para leer desde el principio */
+  qfseek ( f , 0 , SEEK_SET );
 
-/* Arranco a analizar todas las funciones */
-  my_msg ( "comparing functions ...\n" );
+  return ( f );
+}
 
-////////////////////////////////////////
+/****************************************************************************/
 
-/* Si puedo usar los simbolos */
-  if ( usar_simbolos == TRUE )
-  {
-  /* Recorro todas las funciones de programa1 */
-    for ( cont = 0 ; cont < funciones1_levantadas.Len () ; cont ++ )
-    {
-    /* Levanto la siguiente funcion */
-      funcion1 = ( Funcion * ) funciones1_levantadas.Get ( cont );
+void guardar_datos_de_build ( FILE *f , Funcion *funcion )
+{
+  Basic_Block *basic_block;
+  unsigned int valor;
+  unsigned int cont, cont2;
 
-    /* Si la funcion tiene nombre */
-      if ( strncmp ( funcion1 -> name , "sub_" , 4 ) != 0 )
-      {
-      /* Busco en programa2 esta misma funcion */
-        for ( cont2 = 0 ; cont2 < funciones2_levantadas.Len () ; cont2 ++ )
-        {
-        /* Levanto la siguiente funcion */
-          funcion2 = ( Funcion * ) funciones2_levantadas.Get ( cont2 );
+/* Guardo la direccion, el hash de los bytes y los nombres de la funcion */
+  qfwrite ( f , &funcion -> address , sizeof ( unsigned int ) );
+  qfwrite ( f , &funcion -> hash_contenido , sizeof ( unsigned int ) );
+  qfwrite ( f , funcion -> name , NAME_LEN );
+  qfwrite ( f , funcion -> demangled_name , NAME_LEN );
 
-        /* Si esta funcion es la que estoy buscando */
-          if ( tienen_el_mismo_nombre ( funcion1 , funcion2 ) == TRUE )
-          {
-          /* Si las funciones son identicas */
-            if ( son_funciones_iguales ( funcion1 , funcion2 ) == TRUE )
-            {
-            /* Relaciono las funciones */
-              asociar_funciones ( TRUE , funcion1 , funcion2 , funciones1_reconocidas , funciones2_reconocidas , funciones1_levantadas , funciones2_levantadas );
-            }
-          /* Si son funciones patcheadas */
-            else
-            {
-            /* Relaciono las funciones */
-              asociar_funciones ( FALSE , funcion1 , funcion2 , funciones1_cambiadas , funciones2_cambiadas , funciones1_levantadas , funciones2_levantadas );
-            }
+/* Recorro todos los basic blocks */
+  for ( cont = 0 ; cont < funcion -> cantidad_basic_blocks ; cont ++ )
+  {
+  /* Levanto el siguiente basic block */
+    basic_block = funcion -> basic_blocks [ cont ];
 
-          /* Compenso el puntero en la lista de programa1 */
-            cont --;
+  /* Guardo la posicion en el .dis */
+    qfwrite ( f , &basic_block -> pos_file_disasm , sizeof ( unsigned int ) );
 
-          /* Corto la busqueda en programa2 */
-            break;
-          }
-        }
-      }
+  /* Guardo los llamados a funciones ( igual que en el analisis ) */
+    for ( cont2 = 0 ; cont2 < basic_block -> cantidad_referencias ; cont2 ++ )
+    {
+      valor = ( unsigned int ) basic_block -> funciones_hijas -> Get ( cont2 );
+      qfwrite ( f , &valor , sizeof ( unsigned int ) );
     }
-  }
 
-////////////////////////////////////////
+  /* Guardo los punteros a funciones ( vtables ) */
+    guardar_valores_de_lista ( f , basic_block -> ptr_funciones_hijas );
+  }
 
-/* Recorro todas las funciones buscando las que son IDENTICAS */
-  while ( funciones1_levantadas.Len () > 0 )
+/* Guardo de donde es llamada la funcion */
+  for ( cont = 0 ; cont < funcion -> cantidad_referencias_padre ; cont ++ )
   {
-  /* Marco el flag de funciones matcheadas */
-    matched_functions = FALSE;
+    qfwrite ( f , &funcion -> basic_blocks_padres [ cont ].direccion_funcion , sizeof ( unsigned int ) );
+    qfwrite ( f , &funcion -> basic_blocks_padres [ cont ].referencia , sizeof ( unsigned int ) );
+  }
 
-  /* Levanto la proxima funcion de 1 */
-    funcion1 = ( Funcion * ) funciones1_levantadas.Get ( 0 );
+/* Guardo las referencias padre x vtables */
+  guardar_valores_de_lista ( f , funcion -> referencias_padre_x_vtable );
+}
 
-  /* Si la funcion tiene mas de 1 basic block o tiene un checksum confiable */
-    if ( ( funcion1 -> cantidad_basic_blocks > 1 ) || ( funcion1 -> checksum & 0xfff ) )
-    {
-    /* Levanto todas las funciones2 */
-      for ( pos = 0 ; pos < funciones2_levantadas.Len () ; pos ++ )
-      {
-      /* Levanto la proxima funcion de 2 */
-        funcion2 = ( Funcion * ) funciones2_levantadas.Get ( pos );
+/****************************************************************************/
 
-      /* Si las funciones son iguales */
-        if ( son_funciones_iguales ( funcion1 , funcion2 ) == TRUE )
-        {
-        /* Relaciono las 2 funciones */
-          asociar_funciones ( TRUE , funcion1 , funcion2 , funciones1_reconocidas , funciones2_reconocidas , funciones1_levantadas , funciones2_levantadas );
-    
-        /* Marco el flag de funciones matcheadas */
-          matched_functions = TRUE;
+void levantar_datos_de_build ( FILE *f , Funcion *funcion )
+{
+  Basic_Block *basic_block;
+  unsigned int address;
+  unsigned int desplazamiento;
+  unsigned int cont;
 
-        /* Paso a la siguiente funcion */
-          break;
-        }
-      }
-    }
+/* Levanto la direccion de la funcion en este build */
+  qfread ( f , &address , sizeof ( unsigned int ) );
 
-  /* Si no pude matchear esta funcion */
-    if ( matched_functions == FALSE )
-    {
-    /* Saco la funcion1 y la paso a la lista de intermedias */
-      funciones1_intermedias.Add ( funcion1 );
-      funciones1_levantadas.DeleteElement ( funcion1 );
-    }
-  }
+/* Muevo los basic blocks al lugar que ocupan en este build */
+  desplazamiento = address - funcion -> address;
+  desplazar_funcion ( funcion , desplazamiento );
+  funcion -> address = address;
 
-////////////////////////////////////////
+/* Levanto el hash de los bytes y los nombres de la funcion */
+  qfread ( f , &funcion -> hash_contenido , sizeof ( unsigned int ) );
+  qfread ( f , funcion -> name , NAME_LEN );
+  qfread ( f , funcion -> demangled_name , NAME_LEN );
 
-/* Recorro todas las funciones buscando las que son CUASI-IDENTICAS */
-  for ( cont = 0 ; cont < funciones1_intermedias.Len () ; cont ++ )
+/* Recorro todos los basic blocks */
+  for ( cont = 0 ; cont < funcion -> cantidad_basic_blocks ; cont ++ )
   {
-  /* Levanto la proxima funcion de 1 */
-    funcion1 = ( Funcion * ) funciones1_intermedias.Get ( cont );
-
-  /* Levanto todas las funciones2 */
-    for ( pos = 0 ; pos < funciones2_levantadas.Len () ; pos ++ )
-    {
-    /* Levanto la proxima funcion de 2 */
-      funcion2 = ( Funcion * ) funciones2_levantadas.Get ( pos );
+  /* Levanto el siguiente basic block */
+    basic_block = funcion -> basic_blocks [ cont ];
 
-    /* Si son funciones cuasi-identicas */
-      if ( son_funciones_cuasi_identicas ( funcion1 , funcion2 ) == TRUE )
-      {
-      /* Relaciono las 2 funciones */
-        asociar_funciones ( FALSE , funcion1 , funcion2 , funciones1_cambiadas , funciones2_cambiadas , funciones1_intermedias , funciones2_levantadas );
+  /* Levanto la posicion en el .dis */
+    qfread ( f , &basic_block -> pos_file_disasm , sizeof ( unsigned int ) );
 
-      /* Compenso la extraccion de la funcion */
-        cont --;
+  /* Levanto los llamados a funciones y los punteros a funciones ( vtables ) */
+    levantar_valores_de_lista ( f , basic_block -> funciones_hijas );
+    levantar_valores_de_lista ( f , basic_block -> ptr_funciones_hijas );
+  }
 
-      /* Sigo buscando */
-        break;
-      }
-    }
+/* Levanto de donde es llamada la funcion */
+  for ( cont = 0 ; cont < funcion -> cantidad_referencias_padre ; cont ++ )
+  {
+    qfread ( f , &funcion -> basic_blocks_padres [ cont ].direccion_funcion , sizeof ( unsigned int ) );
+    qfread ( f , &funcion -> basic_blocks_padres [ cont ].referencia , sizeof ( unsigned int ) );
   }
 
-////////////////////////////////////////
+/* Levanto las referencias padre x vtables */
+  levantar_valores_de_lista ( f , funcion -> referencias_padre_x_vtable );
+}
 
-/* Recorro todas las funciones buscando las que cambiaron */
-/* y las reconozco desde las funciones identicas */
-  while ( funciones1_intermedias.Len () > 0 )
+/****************************************************************************/
+
+void desplazar_funcion ( Funcion *funcion , unsigned int desplazamiento )
+{
+  Basic_Block *basic_block;
+  unsigned int cont, cont2;
+
+/* Si la funcion NO se movio */
+  if ( desplazamiento == 0 )
   {
-  /* Marco el flag de funciones matcheadas */
-    matched_functions = FALSE;
+    return;
+  }
 
-  /* Levanto la proxima funcion de 1 */
-    funcion1 = ( Funcion * ) funciones1_intermedias.Get ( 0 );
+/* Recorro todos los basic blocks */
+  for ( cont = 0 ; cont < funcion -> cantidad_basic_blocks ; cont ++ )
+  {
+  /* Levanto el siguiente basic block */
+    basic_block = funcion -> basic_blocks [ cont ];
 
-    // nicolas 
-//    my_msg ( "?son patcheadas %x %x\n" , funcion1 -> address , funcion2 -> address );
+  /* Muevo los limites del basic block */
+    basic_block -> addr_inicial += desplazamiento;
+    basic_block -> addr_final += desplazamiento;
 
-  /* Si es una funcion que esta patcheada */
-    if ( es_funcion_patcheada ( funcion1 , funciones2 , &funcion2 ) == TRUE )
+  /* Muevo las conexiones con los basic blocks hijos */
+    for ( cont2 = 0 ; cont2 < basic_block -> basic_blocks_hijos -> Len () ; cont2 ++ )
     {
-    /* Relaciono las 2 funciones */
-      asociar_funciones ( FALSE , funcion1 , funcion2 , funciones1_cambiadas , funciones2_cambiadas , funciones1_intermedias , funciones2_levantadas );
-
-    /* Marco el flag de funciones matcheadas */
-      matched_functions = TRUE;
+      basic_block -> basic_blocks_hijos -> Set ( cont2 , ( void * ) ( ( unsigned int ) basic_block -> basic_blocks_hijos -> Get ( cont2 ) + desplazamiento ) );
     }
 
-  /* Si no pude matchear esta funcion */
-    if ( matched_functions == FALSE )
+  /* Muevo la cadena de basic blocks ( pares direccion , longitud ) */
+    for ( cont2 = 0 ; cont2 < basic_block -> cadena_basic_blocks -> Len () ; cont2 = cont2 + 2 )
     {
-    /* Saco la funcion1 y la paso a la lista de irreconocidas */
-      funciones1_irreconocidas.Add ( funcion1 );
-      funciones1_intermedias.DeleteElement ( funcion1 );
+      basic_block -> cadena_basic_blocks -> Set ( cont2 , ( void * ) ( ( unsigned int ) basic_block -> cadena_basic_blocks -> Get ( cont2 ) + desplazamiento ) );
     }
   }
+}
 
-////////////////////////////////////////
-////////////////////////////////////////
+/****************************************************************************/
 
-/* Recorro toda la lista de funciones intermedias */
-  for ( pos = 0 ; pos < funciones1_irreconocidas.Len () ; pos ++ )
+void guardar_valores_de_lista ( FILE *f , List *lista )
+{
+  unsigned int valor;
+  unsigned int pos;
+
+/* Guardo los elementos ( la cantidad ya esta en el almacen ) */
+  for ( pos = 0 ; pos < lista -> Len () ; pos ++ )
   {
-  /* Levanto la proxima funcion de 1 */
-    funcion1 = ( Funcion * ) funciones1_irreconocidas.Get ( pos );
+    valor = ( unsigned int ) lista -> Get ( pos );
+    qfwrite ( f , &valor , sizeof ( unsigned int ) );
+  }
+}
 
-  /* Analizar esta funcion SI TIENE UN PADRE en la lista de cambiadas */
-    // nicolas
+/****************************************************************************/
 
-  /* Si la funcion fue reconocida */
-    if ( es_funcion_patcheada ( funcion1 , funciones2 , &funcion2 ) == TRUE )
-    {
-    /* Relaciono las 2 funciones */
-      asociar_funciones ( FALSE , funcion1 , funcion2 , funciones1_cambiadas , funciones2_cambiadas , funciones1_irreconocidas , funciones2_levantadas );
+void levantar_valores_de_lista ( FILE *f , List *lista )
+{
+  unsigned int valor;
+  unsigned int pos;
 
-    /* Decremento la posicion en la lista para compensar la extraccion del elemento */
-      pos --;
-    }
+/* Piso los elementos que vinieron del almacen */
+  for ( pos = 0 ; pos < lista -> Len () ; pos ++ )
+  {
+    qfread ( f , &valor , sizeof ( unsigned int ) );
+    lista -> Set ( pos , ( void * ) valor );
   }
+}
 
-////////////////////////////////////////
+/****************************************************************************/
 
-/* Reconozco las funciones que tienen la misma geometria */
-//  reconocer_funciones_con_misma_geometria ( funciones1_cambiadas , funciones2_cambiadas , funciones1_irreconocidas , funciones2_levantadas );
+FILE *abrir_almacen ( char *file_analisis , int crear )
+{
+  char file_almacen [ QMAXPATH ];
+  unsigned int version_almacen;
+  FILE *f;
 
-////////////////////////////////////////
+/* El almacen esta en el mismo directorio que el analisis */
+  armar_path_en_directorio ( file_analisis , ARCHIVO_ALMACEN , file_almacen );
 
-// nicolas
-//  goto salto;
+/* Intento abrir el almacen */
+  f = qfopen ( file_almacen , "r+b" );
 
-/* Recorro todas las funciones que me quedaron sueltas */
-/* y las reconozco desde las funciones cambiadas */
-  do
+/* Si el almacen NO existe */
+  if ( f == NULL )
   {
-  /* Cuento la cantidad de pasadas */
-    pasada ++;
+  /* Si no tengo que crearlo */
+    if ( crear == FALSE )
+    {
+      return ( NULL );
+    }
 
-  /* Seteo el contador de funciones reconocidas analizando las funciones patcheadas */
-    funciones_reconocidas = 0;
+  /* Creo el almacen vacio */
+    f = qfopen ( file_almacen , "w+b" );
 
-  /* Recorro toda la lista de funciones intermedias */
-    for ( pos = 0 ; pos < funciones1_irreconocidas.Len () ; pos ++ )
+    if ( f != NULL )
     {
-    /* Levanto la proxima funcion de 1 */
-      funcion1 = ( Funcion * ) funciones1_irreconocidas.Get ( pos );
-
-    /* Analizar esta funcion SI TIENE UN PADRE en la lista de cambiadas */
-      // nicolas
+      qfwrite ( f , ( void * ) &turbodiff_version , sizeof ( unsigned int ) );
+    }
 
-    /* Si la funcion fue reconocida */
-      if ( es_funcion_patcheada ( funcion1 , funciones2 , &funcion2 ) == TRUE )
-      {
-      /* Relaciono las 2 funciones */
-        asociar_funciones ( FALSE , funcion1 , funcion2 , funciones1_cambiadas , funciones2_cambiadas , funciones1_irreconocidas , funciones2_levantadas );
+    return ( f );
+  }
 
-      /* Incremento la cantidad de funciones reconocidas */
-        funciones_reconocidas ++;
+/* Si el almacen es de otra version */
+  if ( ( qfread ( f , &version_almacen , sizeof ( unsigned int ) ) != sizeof ( unsigned int ) ) || ( version_almacen != turbodiff_version ) )
+  {
+  /* Mensaje al usuario */
+    my_msg ( "ERROR: %s has a different file version\n" , file_almacen );
 
-      /* Decremento la posicion en la lista para compensar la extraccion del elemento */
-        pos --;
-      }
-    }
+  /* Cierro el almacen */
+    qfclose ( f );
 
-//  salto:;
+    return ( NULL );
+  }
 
-////////////////////////////////////////
+  return ( f );
+}
 
-//  goto salto2;
+/****************************************************************************/
 
-///* Recorro todas las funciones que me quedaron sueltas */
-///* y las reconozco desde las funciones hijas */
-//  /* Recorro todas las funciones huerfanas que no fueron reconocidas como identicas */
-//    for ( pos = 0 ; pos < funciones1_irreconocidas.Len () ; pos ++ )
-//    {
-//    /* Levanto la siguiente funcion */
-//      funcion1 = ( Funcion * ) funciones1_irreconocidas.Get ( pos );
-//
-//    /* Si reconozco la funcion a traves de los hijos */
-//      if ( get_funcion_equivalente_x_hijos ( funcion1 , funciones1 , funciones2 , &funcion2 ) == TRUE )
-//      {
-////        my_msg ( "reconocida %x\n" , funcion1 -> address );
-//
-//      /* Relaciono las 2 funciones */
-//        asociar_funciones ( FALSE , funcion1 , funcion2 , funciones1_cambiadas , funciones2_cambiadas , funciones1_irreconocidas , funciones2_levantadas );
-//
-//      /* Incremento la cantidad de funciones reconocidas */
-//        funciones_reconocidas ++;
-//
-//      /* Decremento la posicion en la lista para compensar la extraccion del elemento */
-//        pos --;
-//      }
-//    }
+int indexar_almacen ( FILE *f , char *file_analisis , Index &entradas , List &entradas_alocadas )
+{
+  char file_indice [ QMAXPATH ];
+  Entrada_Almacen *entrada;
+  Funcion funcion;
+  unsigned int version_indice;
+  unsigned int indexado = 0;
+  unsigned int tamano_almacen;
+  unsigned int posicion;
+  unsigned int pos;
+  FILE *f_indice;
+  int ret = TRUE;
 
-//  salto2:;
+/* Obtengo el tamano del almacen */
+  qfseek ( f , 0 , SEEK_END );
+  tamano_almacen = qftell ( f );
 
-////////////////////////////////////////
+/* El indice persistente esta al lado del almacen */
+  armar_path_en_directorio ( file_analisis , ARCHIVO_INDICE_ALMACEN , file_indice );
+  f_indice = qfopen ( file_indice , "rb" );
 
-  /* Mensaje al usuario */
-    if ( funciones_reconocidas > 0 )
+/* Si hay un indice guardado */
+  if ( f_indice != NULL )
+  {
+  /* Si el indice es de esta version y NO cubre mas de lo que hay en el almacen */
+    if ( ( qfread ( f_indice , &version_indice , sizeof ( unsigned int ) ) == sizeof ( unsigned int ) ) && ( version_indice == turbodiff_version ) && ( qfread ( f_indice , &indexado , sizeof ( unsigned int ) ) == sizeof ( unsigned int ) ) && ( indexado <= tamano_almacen ) )
     {
-//      my_msg ( "pasada %i: funciones reconocidas = %i\n" , pasada , funciones_reconocidas );
-    }
-  }
-  while ( funciones_reconocidas > 0 );
+    /* Levanto todas las entradas del indice */
+      while ( 1 )
+      {
+        entrada = ( Entrada_Almacen * ) malloc ( sizeof ( Entrada_Almacen ) );
 
-////////////////////////////////////////
+        if ( qfread ( f_indice , entrada , sizeof ( Entrada_Almacen ) ) != sizeof ( Entrada_Almacen ) )
+        {
+          free ( entrada );
+          break;
+        }
 
-/* Reconozco todas las funciones a traves de vtables padres */
-  reconocer_funciones_x_vtables ( funciones1 , funciones2 , funciones1_irreconocidas , funciones2_levantadas , funciones1_cambiadas , funciones2_cambiadas );
+        entradas.Add ( entrada -> huella [ 0 ] , entrada );
+        entradas_alocadas.Add ( entrada );
+      }
+    }
+    else
+    {
+    /* El indice no sirve, reindexo todo el almacen */
+      indexado = 0;
+    }
 
-////////////////////////////////////////
+  /* Cierro el indice */
+    qfclose ( f_indice );
+  }
 
-/* Recorro todas las funciones que me quedaron sueltas en 2 */
-  while ( funciones2_levantadas.Len () > 0 )
+/* Si el indice no cubre nada, arranco despues de la version */
+  if ( indexado == 0 )
   {
-  /* Levanto la proxima funcion de 2 */
-    funcion2 = ( Funcion * ) funciones2_levantadas.Get ( 0 );
+    for ( pos = 0 ; pos < entradas_alocadas.Len () ; pos ++ )
+    {
+      free ( entradas_alocadas.Get ( pos ) );
+    }
 
-  /* Saco la funcion1 y la paso a la lista de irreconocidas */
-    funciones2_irreconocidas.Add ( funcion2 );
-    funciones2_levantadas.DeleteElement ( funcion2 );
+    entradas.Clear ();
+    entradas_alocadas.Clear ();
+    indexado = sizeof ( unsigned int );
   }
 
-////////////////////////////////////////
+/* Recorro SOLO los registros que el indice todavia no cubre */
+  qfseek ( f , indexado , SEEK_SET );
 
-/* Recorro todas las funciones que cambiaron */
-/* e identifico las funciones IDENTICAS de un 1 basic block */
-  for ( cont = 0 ; cont < funciones1_cambiadas.Len () ; cont ++ )
+  while ( 1 )
   {
-  /* Levanto el siguiente par asociado */
-    funcion1 = ( Funcion * ) funciones1_cambiadas.Get ( cont );
-    funcion2 = ( Funcion * ) funciones2_cambiadas.Get ( cont );
+  /* Alloco la siguiente entrada */
+    entrada = ( Entrada_Almacen * ) malloc ( sizeof ( Entrada_Almacen ) );
+    posicion = qftell ( f );
 
-  /* Si estan formadas por un solo basic block */
-    if ( funcion1 -> cantidad_basic_blocks == 1 )
+  /* Si llegue al final del almacen */
+    if ( ( qfread ( f , entrada -> huella , sizeof ( entrada -> huella ) ) != sizeof ( entrada -> huella ) ) || ( qfread ( f , &funcion , sizeof ( Funcion ) ) != sizeof ( Funcion ) ) )
     {
-    /* Si las funciones son IDENTICAS */
-      if ( son_funciones_iguales ( funcion1 , funcion2 ) == TRUE )
-      {
-      /* Asumo que son identicas */
-        asociar_funciones ( TRUE , funcion1 , funcion2 , funciones1_reconocidas , funciones2_reconocidas , funciones1_cambiadas , funciones2_cambiadas );
-
-      /* Compenso la extraccion */
-        cont --;
-      }
+    /* Libero la entrada que no llegue a usar */
+      free ( entrada );
+      break;
     }
+
+  /* Salteo el cuerpo de la funcion */
+    saltear_cuerpo_de_funcion ( f , &funcion );
+
+  /* Indexo la funcion por su huella */
+    entrada -> posicion = posicion;
+    entrada -> cantidad_basic_blocks = funcion.cantidad_basic_blocks;
+    entradas.Add ( entrada -> huella [ 0 ] , entrada );
+    entradas_alocadas.Add ( entrada );
   }
 
-////////////////////////////////////////
+  return ( ret );
+}
 
-/* Discrimino los cambios importantes de los triviales */
-/* en las funciones cambiadas */
-  clasificar_funciones_cambiadas ( funciones1_cambiadas , funciones2_cambiadas , funciones1_matcheadas , funciones2_matcheadas );
+/****************************************************************************/
 
-////////////////////////////////////////
+int guardar_indice_almacen ( FILE *f , char *file_analisis , List &entradas_alocadas )
+{
+  char file_indice [ QMAXPATH ];
+  unsigned int indexado;
+  unsigned int pos;
+  FILE *f_indice;
 
-/* Separador */
-  my_msg ( "-------------------------------------------------------------\n" );
-  qfprintf ( f_log_file , "-------------------------------------------------------------\n" );
-  my_msg ( "-------------------------------------------------------------\n" );
-  qfprintf ( f_log_file , "-------------------------------------------------------------\n" );
+/* El indice cubre todo lo que hay en el almacen */
+  qfseek ( f , 0 , SEEK_END );
+  indexado = qftell ( f );
 
-/* Imprimo el reporte */
-  my_msg ( "identical functions: %i\n" , funciones1_reconocidas.Len () );
-  qfprintf ( f_log_file , "identical functions: %i\n" , funciones1_reconocidas.Len () );
+/* Armo el nombre del indice */
+  armar_path_en_directorio ( file_analisis , ARCHIVO_INDICE_ALMACEN , file_indice );
 
-/* Imprimo las funciones que son identicas */
-  for ( pos = 0 ; pos < funciones1_reconocidas.Len () ; pos ++ )
+/* Creo el indice */
+  f_indice = qfopen ( file_indice , "wb" );
+
+/* Si no pude crear el indice ( la proxima vez se reindexa el almacen ) */
+  if ( f_indice == NULL )
   {
-  /* Levanto las funciones cambiadas de los 2 archivos */
-    funcion1 = ( Funcion * ) funciones1_reconocidas.Get ( pos );
-    funcion2 = ( Funcion * ) funciones2_reconocidas.Get ( pos );
+    return ( FALSE );
+  }
 
-  /* Formateo el nombre de las funciones para poderlos imprimir */
-    get_formated_name ( funcion1 , funcion1_name , NAME_LEN , TRUE );
-    get_formated_name ( funcion2 , funcion2_name , NAME_LEN , TRUE );
+/* Guardo la version y hasta donde cubre el indice */
+  qfwrite ( f_indice , ( void * ) &turbodiff_version , sizeof ( unsigned int ) );
+  qfwrite ( f_indice , &indexado , sizeof ( unsigned int ) );
 
-  /* Imprimo los pares */
-    qfprintf ( f_log_file , "%.8x %.48s - %.8x %.48s\n" , funcion1 -> address , funcion1_name , funcion2 -> address , funcion2_name );
+/* Guardo todas las entradas en el orden del almacen */
+  for ( pos = 0 ; pos < entradas_alocadas.Len () ; pos ++ )
+  {
+    qfwrite ( f_indice , entradas_alocadas.Get ( pos ) , sizeof ( Entrada_Almacen ) );
   }
 
-////////////////////
+/* Cierro el indice */
+  qfclose ( f_indice );
 
-/* Separador */
-  my_msg ( "-------------------------------------------------------------\n" );
-  qfprintf ( f_log_file , "-------------------------------------------------------------\n" );
+  return ( TRUE );
+}
 
-/* Imprimo el reporte */
-  my_msg ( "matched functions: %i\n" , funciones1_matcheadas.Len () + funciones1_geometricamente_identicas.Len () );
-  qfprintf ( f_log_file , "matched functions: %i\n" , funciones1_matcheadas.Len () + funciones1_geometricamente_identicas.Len () );
+/****************************************************************************/
 
-/* Imprimo las funciones que cambiaron */
-  for ( pos = 0 ; pos < funciones1_matcheadas.Len () ; pos ++ )
+Entrada_Almacen *buscar_en_almacen ( Index &entradas , unsigned int *huella )
+{
+  Entrada_Almacen *entrada;
+  unsigned int pos;
+
+/* Si no hay funciones con la primera mitad de la huella */
+  if ( entradas.Find ( huella [ 0 ] , &pos ) == FALSE )
   {
-  /* Levanto las funciones cambiadas de los 2 archivos */
-    funcion1 = ( Funcion * ) funciones1_matcheadas.Get ( pos );
-    funcion2 = ( Funcion * ) funciones2_matcheadas.Get ( pos );
+    return ( NULL );
+  }
 
-  /* Formateo el nombre de las funciones */
-    get_formated_name ( funcion1 , funcion1_name , NAME_LEN , TRUE );
-    get_formated_name ( funcion2 , funcion2_name , NAME_LEN , TRUE );
+/* Recorro las funciones con la misma primera mitad */
+  for ( ; ( pos < entradas.Len () ) && ( entradas.GetKey ( pos ) == huella [ 0 ] ) ; pos ++ )
+  {
+    entrada = ( Entrada_Almacen * ) entradas.Get ( pos );
 
-  /* Imprimo los pares */
-    qfprintf ( f_log_file , "[.] %.8x %.48s - %.8x %.48s\n" , funcion1 -> address , funcion1_name , funcion2 -> address , funcion2_name );
+  /* Si coincide la huella completa */
+    if ( entrada -> huella [ 1 ] == huella [ 1 ] )
+    {
+      return ( entrada );
+    }
   }
 
-/* Imprimo las funciones que cambiaron */
-  for ( pos = 0 ; pos < funciones1_geometricamente_identicas.Len () ; pos ++ )
-  {
-  /* Levanto las funciones cambiadas de los 2 archivos */
-    funcion1 = ( Funcion * ) funciones1_geometricamente_identicas.Get ( pos );
-    funcion2 = ( Funcion * ) funciones2_geometricamente_identicas.Get ( pos );
+  return ( NULL );
+}
 
-  /* Formateo el nombre de las funciones */
-    get_formated_name ( funcion1 , funcion1_name , NAME_LEN , TRUE );
-    get_formated_name ( funcion2 , funcion2_name , NAME_LEN , TRUE );
+/****************************************************************************/
 
-  /* Imprimo los pares */
-    qfprintf ( f_log_file , "[*] %.8x %.48s - %.8x %.48s\n" , funcion1 -> address , funcion1_name , funcion2 -> address , funcion2_name );
-  }
+void calcular_huella_fuerte ( Funcion *funcion , unsigned int *huella )
+{
+  Basic_Block *basic_block;
+  unsigned int base;
+  unsigned int cont, cont2;
 
-////////////////////
+/* Arranco las 2 mitades con semillas distintas */
+  huella [ 0 ] = HASH_INICIAL;
+  huella [ 1 ] = ~HASH_INICIAL;
 
-/* Separador */
-  my_msg ( "-------------------------------------------------------------\n" );
-  qfprintf ( f_log_file , "-------------------------------------------------------------\n" );
+/* Las direcciones propias se toman relativas al inicio de la funcion */
+  base = funcion -> address;
 
-  my_msg ( "unmatched functions1: %i\n" , funciones1_irreconocidas.Len () );
-  qfprintf ( f_log_file , "unmatched functions1: %i\n" , funciones1_irreconocidas.Len () );
+/* Agrego los datos generales de la funcion ( nombres y direcciones van en el manifiesto ) */
+  agregar_a_huella_fuerte ( huella , funcion -> longitud );
+  agregar_a_huella_fuerte ( huella , funcion -> checksum );
+  agregar_a_huella_fuerte ( huella , funcion -> checksum_real );
+  agregar_a_huella_fuerte ( huella , funcion -> conexiones_internas );
+  agregar_a_huella_fuerte ( huella , funcion -> cantidad_referencias_hijas );
+  agregar_a_huella_fuerte ( huella , funcion -> cantidad_basic_blocks );
 
-/* Imprimo las funciones que no pude reconocer para file1 */
-  for ( pos = 0 ; pos < funciones1_irreconocidas.Len () ; pos ++ )
+/* Recorro todos los basic blocks */
+  for ( cont = 0 ; cont < funcion -> cantidad_basic_blocks ; cont ++ )
   {
-  /* Levanto las funciones cambiadas de los 2 archivos */
-    funcion1 = ( Funcion * ) funciones1_irreconocidas.Get ( pos );
+  /* Levanto el siguiente basic block */
+    basic_block = funcion -> basic_blocks [ cont ];
 
-  /* Formateo el nombre de las funciones */
-    get_formated_name ( funcion1 , funcion1_name , NAME_LEN , TRUE );
+  /* Agrego el contenido del basic block */
+    agregar_a_huella_fuerte ( huella , basic_block -> addr_inicial - base );
+    agregar_a_huella_fuerte ( huella , basic_block -> addr_final - base );
+    agregar_a_huella_fuerte ( huella , basic_block -> longitud );
+    agregar_a_huella_fuerte ( huella , basic_block -> longitud_en_bytes );
+    agregar_a_huella_fuerte ( huella , basic_block -> checksum );
 
-  /* Imprimo los pares */
-    qfprintf ( f_log_file , "%.8x %s\n" , funcion1 -> address , funcion1_name );
-  }
+  /* Agrego las conexiones relativas al inicio de la funcion */
+    agregar_a_huella_fuerte ( huella , basic_block -> basic_blocks_hijos -> Len () );
 
-////////////////////
+    for ( cont2 = 0 ; cont2 < basic_block -> basic_blocks_hijos -> Len () ; cont2 ++ )
+    {
+      agregar_a_huella_fuerte ( huella , ( unsigned int ) basic_block -> basic_blocks_hijos -> Get ( cont2 ) - base );
+    }
 
-/* Separador */
-  my_msg ( "-------------------------------------------------------------\n" );
-  qfprintf ( f_log_file , "-------------------------------------------------------------\n" );
+  /* Agrego la cadena de basic blocks ( pares direccion , longitud ) */
+    agregar_a_huella_fuerte ( huella , basic_block -> cadena_basic_blocks -> Len () );
 
-  my_msg ( "unmatched functions2: %i\n" , funciones2_irreconocidas.Len () );
-  qfprintf ( f_log_file , "unmatched functions2: %i\n" , funciones2_irreconocidas.Len () );
+    for ( cont2 = 0 ; cont2 < basic_block -> cadena_basic_blocks -> Len () ; cont2 ++ )
+    {
+      agregar_a_huella_fuerte ( huella , ( unsigned int ) basic_block -> cadena_basic_blocks -> Get ( cont2 ) - ( ( cont2 % 2 == 0 ) ? base : 0 ) );
+    }
 
-/* Imprimo las funciones que no pude reconocer para file2 */
-  for ( pos = 0 ; pos < funciones2_irreconocidas.Len () ; pos ++ )
-  {
-  /* Levanto las funciones cambiadas de los 2 archivos */
-    funcion2 = ( Funcion * ) funciones2_irreconocidas.Get ( pos );
+  /* Agrego SOLO la cantidad de llamados ( las funciones llamadas van en el manifiesto ) */
+    agregar_a_huella_fuerte ( huella , basic_block -> cantidad_referencias );
+    agregar_a_huella_fuerte ( huella , basic_block -> ptr_funciones_hijas -> Len () );
 
-  /* Formateo el nombre de las funciones */
-    get_formated_name ( funcion2 , funcion2_name , NAME_LEN , TRUE );
+  /* Agrego las anclas ( hashes de imports y strings ) */
+    agregar_lista_a_huella_fuerte ( huella , basic_block -> anclas );
+  }
 
-  /* Imprimo los pares */
-    qfprintf ( f_log_file , "%.8x %s\n" , funcion2 -> address , funcion2_name );
+/* Agrego las referencias padre ( de donde la llaman va en el manifiesto ) */
+  agregar_a_huella_fuerte ( huella , funcion -> cantidad_referencias_padre );
+
+  for ( cont2 = 0 ; cont2 < funcion -> cantidad_referencias_padre ; cont2 ++ )
+  {
+    agregar_a_huella_fuerte ( huella , funcion -> basic_blocks_padres [ cont2 ].checksum );
   }
 
-////////////////////
+/* Agrego la cantidad de referencias padre x vtables */
+  agregar_a_huella_fuerte ( huella , funcion -> referencias_padre_x_vtable -> Len () );
+}
 
-/* Separador */
-  my_msg ( "-------------------------------------------------------------\n" );
-  qfprintf ( f_log_file , "-------------------------------------------------------------\n" );
+/****************************************************************************/
 
-/* Imprimo todas las funciones que cambiaron */
-  my_msg ( "changed functions: %i\n" , funciones1_cambiadas.Len () );
-  qfprintf ( f_log_file , "changed functions: %i\n" , funciones1_cambiadas.Len () );
+void agregar_a_huella_fuerte ( unsigned int *huella , unsigned int valor )
+{
+/* Primera mitad: FNV-1a */
+  huella [ 0 ] = calcular_hash ( huella [ 0 ] , &valor , sizeof ( unsigned int ) );
 
-/* Recorro todas las funciones que cambiaron */
-  for ( pos = 0 ; pos < funciones1_cambiadas.Len () ; pos ++ )
-  {
-  /* Levanto las funciones cambiadas de los 2 archivos */
-    funcion1 = ( Funcion * ) funciones1_cambiadas.Get ( pos );
-    funcion2 = ( Funcion * ) funciones2_cambiadas.Get ( pos );
+/* Segunda mitad: rotacion y multiplicacion ( independiente de la primera ) */
+  huella [ 1 ] = ( huella [ 1 ] << 5 ) | ( huella [ 1 ] >> 27 );
+  huella [ 1 ] = ( huella [ 1 ] ^ valor ) * 0x9e3779b1;
+}
 
-  /* Formateo el nombre de las funciones */
-    get_formated_name ( funcion1 , funcion1_name , NAME_LEN , TRUE );
-    get_formated_name ( funcion2 , funcion2_name , NAME_LEN , TRUE );
+/****************************************************************************/
 
-  /* Imprimo los pares */
-    qfprintf ( f_log_file , "[%c] %.8x %.48s - [%c] %.8x %.48s\n" , '.' , funcion1 -> address , funcion1_name , '.' , funcion2 -> address , funcion2_name );
+void agregar_lista_a_huella_fuerte ( unsigned int *huella , List *lista )
+{
+  unsigned int pos;
+
+/* Agrego el largo para no confundir listas contiguas */
+  agregar_a_huella_fuerte ( huella , lista -> Len () );
+
+/* Agrego todos los elementos */
+  for ( pos = 0 ; pos < lista -> Len () ; pos ++ )
+  {
+    agregar_a_huella_fuerte ( huella , ( unsigned int ) lista -> Get ( pos ) );
   }
+}
 
-////////////////////
+/****************************************************************************/
 
-/* Separador */
-  my_msg ( "-------------------------------------------------------------\n" );
-  qfprintf ( f_log_file , "-------------------------------------------------------------\n" );
-  my_msg ( "-------------------------------------------------------------\n" );
-  qfprintf ( f_log_file , "-------------------------------------------------------------\n" );
+FILE *abrir_analisis ( char *file_analisis )
+{
+  FILE *f;
 
-/* Aviso al usuario */
-  my_msg ( "logued output in %s\n" , log_file );
+/* Intento abrir el analisis */
+  f = qfopen ( file_analisis , "rb" );
 
-/* Cierro el archivo de logueo */
-  qfclose ( f_log_file );
+/* Si el analisis NO esta, lo reconstruyo desde el almacen en un file temporal */
+  if ( f == NULL )
+  {
+    f = reconstruir_analisis_desde_almacen ( file_analisis );
+  }
 
-  return ( ret );
+  return ( f );
 }
 
 /****************************************************************************/ 
 
-void get_formated_name ( Funcion *funcion , char *name , unsigned int len , int fill )
+int guardar_desensamblado ( char *file_dis )
 {
-/* Si la funcion tiene un nombre demangleado */
-  if ( strlen ( funcion -> demangled_name ) > 0 )
-  {
-  /* Escribo el nombre de la funcion en el buffer */
-    qstrncpy ( name , funcion -> demangled_name , len );
-  }
-/* Si la funcion NO tiene un nombre que se puede demanglear */
-  else
+  Funcion *funcion;
+  unsigned int pos;
+  int ret = TRUE;
+  FILE *fdis;
+
+/* Intento abrir el file */
+  fdis = qfopen ( file_dis , "wb" );
+
+/* Si no pude abrir el archivo */
+  if ( fdis == NULL )
   {
-  /* Escribo el nombre de la funcion en el buffer */
-    qstrncpy ( name , funcion -> name , len );
+  /* Retorno ERROR */
+    return ( FALSE );
   }
 
-/* Si tengo que completar el nombre de la funcion con espacios */
-  if ( fill == TRUE )
+/* Recorro todas las funciones */
+  for ( pos = 0 ; pos < funciones.Len () ; pos ++ )
   {
-  /* Relleno lo que falta con espacios en blanco */
-    memset ( &name [ strlen ( name ) ] , ' ' , len - strlen ( name ) - 1 );
+  /* Levanto la siguiente funcion */
+    funcion = ( Funcion * ) funciones.Get ( pos );
 
-  /* Pongo el fin de string */
-    name [ len - 1 ] = '\x00';
+  /* Guardo el codigo desensamblado de la funcion */
+    guardar_desensamblado_de_funcion ( fdis , funcion );
   }
+
+/* Cierro el file */
+  qfclose ( fdis );
+
+  return ( ret );
 }
 
 /****************************************************************************/ 
 
-int levantar_funciones ( FILE *f , List &indice_funciones , List &funciones )
+int guardar_desensamblado_de_funcion ( FILE *fdis , Funcion *funcion )
 {
-  Funcion *funcion_padre;
-  Funcion *funcion;
-  unsigned int cont, cont2;
-  unsigned int pos, pos2;
-  unsigned int referencia_hija;
-  int err;
+  List *cadena_basic_blocks;
+  String desensamblado;
+  char instruccion [ 256 ];
+  unsigned int addr_actual;
+  unsigned int len_instruccion;
+  unsigned int cont, cont2, cont3;
+  Basic_Block *basic_block;
   int ret = TRUE;
 
-/* Mientras haya funciones por leer */
-  while ( 1 )
+/* Recorro todos los basic blocks de la funcion */
+  for ( cont = 0 ; cont < funcion -> cantidad_basic_blocks ; cont ++ )
   {
-  /* Alloco espacio para la funcion a cargar */
-    funcion = ( Funcion * ) malloc ( sizeof ( Funcion ) );
+  /* Levanto el siguiente basic block */
+    basic_block = funcion -> basic_blocks [ cont ];
 
-  /* Levanto la funcion del archivo */
-    err = qfread ( f , funcion , sizeof ( Funcion ) );
+  /* Obtengo la posicion en el file donde esta el desensamblado del basic block */
+    basic_block -> pos_file_disasm = qftell ( fdis );
 
-  /* Si llegue al final del archivo */
-    if ( err == 0 )
-    {
-    /* Corto la busqueda */
-      break;
-    }
+  /* Obtengo el encadenamiento de basic blocks */
+    cadena_basic_blocks = basic_block -> cadena_basic_blocks;
 
-  /* Alloco espacio y guardo los basic blocks */
-    funcion -> basic_blocks = ( Basic_Block ** ) malloc ( sizeof ( Basic_Block * ) * funcion -> cantidad_basic_blocks );
+  /* Reinicializo el string donde van a ir a parar las instrucciones del basic block */
+    desensamblado.Reset ();
 
-  /* Levanto basic block a basic block */
-    for ( cont = 0 ; cont < funcion -> cantidad_basic_blocks ; cont ++ )
+  /* Recorro toda la cadena de basic blocks simples */
+    for ( cont3 = 0 ; cont3 < cadena_basic_blocks -> Len () ; cont3 = cont3 + 2 )
     {
-    /* Alloco espacio para un basic block mas */
-      funcion -> basic_blocks [ cont ] = ( Basic_Block * ) malloc ( sizeof ( Basic_Block ) );
-
-    /* Levanto el basic block a la memoria */
-      qfread ( f , funcion -> basic_blocks [ cont ] , sizeof ( Basic_Block ) );
+    /* Direccion inicial del basic block simple */
+      addr_actual = ( unsigned int ) cadena_basic_blocks -> Get ( cont3 );
 
-    /* Creo la lista PERSISTENTE que contiene los basic blocks hijos */
-      funcion -> basic_blocks [ cont ] -> basic_blocks_hijos = new ( List );
+    /* Guardo las n instrucciones en el file */
+      for ( cont2 = 0 ; cont2 < ( unsigned int ) cadena_basic_blocks -> Get ( cont3 + 1 ) ; cont2 ++ )
+      {
+      /* Averiguo la longitud en bytes de la instruccion */
+        len_instruccion = get_item_size ( addr_actual );
 
-    /* Levanto la lista */
-      funcion -> basic_blocks [ cont ] -> basic_blocks_hijos -> Load ( f );
+      /* Levanto la siguiente instruccion */
+        get_instruction ( addr_actual , instruccion , 256 );
 
-    /* Inicializo la lista de llamados a funciones */
-      funcion -> basic_blocks [ cont ] -> funciones_hijas = new ( List );
+      /* Anexo la siguiente instruccion */
+        desensamblado.Append ( instruccion );
 
-    /* Levanto los llamados a funciones del basic block */
-      for ( cont2 = 0 ; cont2 < funcion -> basic_blocks [ cont ] -> cantidad_referencias ; cont2 ++ )
-      {
-      /* Levanto el siguiente llamado */
-        qfread ( f , &referencia_hija , sizeof ( unsigned int ) ); 
+      /* Anexo un ENTER */
+        desensamblado.Append ( "\n" );
 
-      /* Agrego el llamado a la lista */
-        funcion -> basic_blocks [ cont ] -> funciones_hijas -> Add ( ( void * ) referencia_hija );
+      /* Avanzo a la siguiente instruccion */
+        addr_actual = addr_actual + len_instruccion;
       }
-
-    /* Creo la lista PERSISTENTE para contener los punteros a funciones */
-      funcion -> basic_blocks [ cont ] -> ptr_funciones_hijas = new ( List );
-
-    /* Levanto los punteros a funciones ( vtables ) del basic block */
-      funcion -> basic_blocks [ cont ] -> ptr_funciones_hijas -> Load ( f );
     }
 
-  /* Genero la ecuacion que representa al grafo de la funcion */
-    funcion -> graph_ecuation = generar_ecuacion_de_grafo_de_funcion ( funcion );
-
-  /* Levanto todas las referencias padre */
-    funcion -> basic_blocks_padres = ( Basic_Block_Padre * ) malloc ( funcion -> cantidad_referencias_padre * sizeof ( Basic_Block_Padre ) );
-    qfread ( f , funcion -> basic_blocks_padres , funcion -> cantidad_referencias_padre * sizeof ( Basic_Block_Padre ) );
+  /* Guardo el desensamblado del basic block en el file */
+    desensamblado.Save ( fdis );
+  }
 
-  /* Levanto todas las referencias a traves de vtables */
-//    funcion -> referencias_x_vtable = ( Referencia_Vtable * ) malloc ( sizeof ( Referencia_Vtable ) * funcion -> cantidad_referencias_x_vtable );   
-//    qfread ( f , funcion -> referencias_x_vtable , sizeof ( Referencia_Vtable ) * funcion -> cantidad_referencias_x_vtable );
-    funcion -> referencias_padre_x_vtable = new ( List );
-    funcion -> referencias_padre_x_vtable -> Load ( f );
+  return ( ret );
+}                                                
 
-  /* Agrego la direccion de la funcion a la lista */
-    indice_funciones.Add ( ( void * ) funcion -> address );
+/****************************************************************************/ 
 
-  /* Agrego la funcion a la lista */
-    funciones.Add ( funcion );
-  }
+char *get_instruction ( unsigned int address , char *instruction , unsigned int buffer_len )
+{
+  unsigned int longitud;
+  unsigned int pos1, pos2;
+  char s [ 256 ];
 
-/* Resuelvo todas las conexiones entre los basic blocks padres y sus funciones */
-/* Recorro toda la lista de funciones */
-  for ( pos = 0 ; pos < funciones.Len () ; pos ++ )
-  {
-  /* Levanto la siguiente funcion */
-    funcion = ( Funcion * ) funciones.Get ( pos );
+/* Desensamblo la linea */
+  generate_disasm_line ( address , s , 256 );
+
+/* Longitud de la instruccion */
+  longitud = strlen ( s );
 
-  /* Recorro todos los basic blocks padres */
-    for ( pos2 = 0 ; pos2 < funcion -> cantidad_referencias_padre ; pos2 ++ )
+/* Voy copiando el string limpito al destino */
+  for ( pos1 = 0 , pos2 = 0 ; pos1 < longitud , ( pos2 + 1 ) < buffer_len ; pos1 ++ )
+  {
+  /* Si detecto una referencia en el programa */
+    if ( ( s [ pos1 ] == 0x01 ) && ( s [ pos1 + 1 ] == 0x28 ) )
     {
-    /* Busco la funcion padre */
-      funcion_padre = get_estructura_funcion2 ( indice_funciones , funciones , funcion -> basic_blocks_padres [ pos2 ].direccion_funcion );
+    /* Avanzo 2 posiciones en el string */
+      pos1 = pos1 + 2 + ( sizeof ( unsigned int ) * 2 );
+    }
 
-    /* Mensaje para chequear ERRORES */  
-      if ( funcion_padre == NULL )
+  /* Si no es ningun caracter especial */
+    if ( ( s [ pos1 ] != 0x01 ) && ( s [ pos1 ] != 0x02 ) )
+    {
+    /* Si NO es una comilla */
+      if ( s [ pos1 ] != '"' )
+      {
+      /* Copio el siguiente caracter */
+        instruction [ pos2 ] = s [ pos1 ];
+      }
+    /* Si es una comilla */
+      else
       {
-        my_msg ( "Warning: parent function %x doesn't exist\n" , funcion -> basic_blocks_padres [ pos2 ].direccion_funcion );
+      /* Reemplazo la comilla doble por una comilla simple */
+        instruction [ pos2 ] = '\'';
       }
 
-    /* Linkeo el basic block padre con la funcion padre */
-      funcion -> basic_blocks_padres [ pos2 ].funcion = funcion_padre;
+    /* Avanzo en el string destino */
+      pos2 ++;
     }
-  }
+    else
+    {
+    /* Salteo el proximo byte */
+      pos1 ++;
+    }
+  }   
 
-  return ( ret );
+/* Cierro el string generado */
+  instruction [ pos2 ] = '\x00';
+
+/* Retorno el string armado */
+  return ( instruction );
 }
 
-/****************************************************************************/
+/****************************************************************************/ 
 
-int asociar_funciones ( int identica , Funcion *funcion1 , Funcion *funcion2 , List &reconocidas1 , List &reconocidas2 , List &funciones1 , List &funciones2 )
+int comparar_files ( char *filename1 , char *filename2 , char *log_file , int usar_simbolos , int incremental , int emitir_stream , Analisis_Residente *residente1 , Analisis_Residente *residente2 )
 {
-  Referencia_Vtable *vtable1_padre;
-  Referencia_Vtable *vtable2_padre;
-  unsigned int cont1, cont2;
+  Funcion *funcion;
+  Funcion *funcion1;
+  Funcion *funcion2;
+  Index grafos2;
+  char error_message [ 256 ];
+  char funcion1_name [ NAME_LEN ];
+  char funcion2_name [ NAME_LEN ];
+  unsigned int error_pos;
+  unsigned int cont, cont1, cont2;
+  unsigned int pos;
+  unsigned int pasada = 0;
+  unsigned int reutilizadas;
+  unsigned int initial_time;
+  int funciones_reconocidas;
+  int matched_functions;
+  int cargadas;
   int ret = TRUE;
+  FILE *f_log_file;
+  int err;
 
-/* Si la funcion es identica */
-  if ( identica == TRUE )
+/* Tomo el tiempo actual */
+  initial_time = GetTickCount ();
+
+/* Abro el file para loguear el resultado */
+  if ( ( f_log_file = qfopen ( log_file , "wt" ) ) == NULL )
   {
-  /* Seteo las funciones como identicas */
-    funcion1 -> identica = TRUE;
-    funcion2 -> identica = TRUE;
+  /* Mensaje de ERROR */
+    MessageBox ( NULL , "cannot open log file" , "ERROR" , MB_ICONERROR | MB_TOPMOST );
+
+  /* Retorno ERROR */
+    return ( FALSE );
   }
-/* Si la funcion esta patcheada */
-  else
+
+/* Si el usuario quiere recibir los pares a medida que se asocian */
+  if ( emitir_stream == TRUE )
   {
-  /* Seteo las funciones como patcheadas */
-    funcion1 -> patcheada = TRUE;
-    funcion2 -> patcheada = TRUE;
+  /* Abro el stream al lado del log */
+    if ( abrir_stream_resultados ( log_file ) == FALSE )
+    {
+      my_msg ( "ERROR: cannot create the results stream\n" );
+    }
   }
 
-/* Relaciono las funciones */
-  funcion1 -> address_equivalente = funcion2 -> address;
-  funcion2 -> address_equivalente = funcion1 -> address;
-
-/* Agrego las funciones en la listas */
-  reconocidas1.Add ( funcion1 );
-  reconocidas2.Add ( funcion2 );
-
-/* Saco las funciones de las otras listas */
-  funciones1.DeleteElement ( funcion1 );
-  funciones2.DeleteElement ( funcion2 );
+/* Arranco la operacion ( el usuario puede cancelarla y quedarse con lo asociado hasta ese momento ) */
+  iniciar_operacion ();
 
-  return ( ret );
-}
+/* Levanto todas las funciones analizadas de file1 ( o las tomo del analisis residente ) */
+  iniciar_fase ( "loading" );
+  cargadas = levantar_funciones_a_comparar ( filename1 , residente1 , indice_funciones1 , funciones1 );
 
-/****************************************************************************/
+/* Si pude levantar file1, levanto todas las funciones analizadas de file2 */
+  if ( cargadas == TRUE )
+  {
+    cargadas = levantar_funciones_a_comparar ( filename2 , residente2 , indice_funciones2 , funciones2 );
+  }
 
-int tienen_el_mismo_nombre ( Funcion *funcion1 , Funcion *funcion2 )
-{
-  int ret = FALSE;
+  terminar_fase ();
 
-/* Si las 2 funciones estan demangleadas */
-  if ( ( strlen ( funcion1 -> demangled_name ) > 0 ) && ( strlen ( funcion2 -> demangled_name ) > 0 ) )
+/* Si la carga fallo o fue cancelada, no hay nada que comparar ( y no piso los resultados previos ) */
+  if ( cargadas == FALSE )
   {
-  /* Comparo los nombres demangleados */
-    if ( strncmp ( funcion1 -> demangled_name , funcion2 -> demangled_name , NAME_LEN ) == 0 )
+  /* Cierro la operacion y dejo asentado en el log si fue cancelada */
+    if ( terminar_operacion () == TRUE )
     {
-    /* Retorno OK */
-      ret = TRUE;
+      qfprintf ( f_log_file , "comparison cancelled while loading the analysis files\n" );
+    }
+  /* Si alguno de los analisis no se pudo levantar */
+    else
+    {
+      qfprintf ( f_log_file , "cannot load the analysis files\n" );
     }
-  }
-/* Si las 2 funciones NO estan demangleadas, comparo el nombre sin demanglear */
-  else if ( strncmp ( funcion1 -> name , funcion2 -> name , NAME_LEN ) == 0 )
-  {
-  /* Retorno OK */
-    ret = TRUE;
-  }
-
-  return ( ret );
-}
-
-/****************************************************************************/
-
-int reconocer_funciones_con_misma_geometria ( List &funciones1_reconocidas , List &funciones2_reconocidas , List &funciones1 , List &funciones2 )
-{
-  Funcion *funcion1;
-  Funcion *funcion2;
-  unsigned int cont, cont2;
-  int ret = TRUE;
 
-/* Recorro todas las funciones de programa1 */
-  for ( cont = 0 ; cont < funciones1.Len () ; cont ++ )
-  {
-  /* Levanto la siguiente funcion */
-    funcion1 = ( Funcion * ) funciones1.Get ( cont );
+  /* Cierro el stream y el log */
+    cerrar_stream_resultados ();
+    qfclose ( f_log_file );
 
-  /* Si la funcion no es confiable para asociarla con otra por su geometria */
-    if ( funcion1 -> cantidad_basic_blocks == 1 )
+  /* Las funciones prestadas por los residentes NO se liberan */
+    if ( residente1 != NULL )
     {
-    /* Sigo con otra funcion */
-      continue;
+      indice_funciones1.Clear ();
+      funciones1.Clear ();
     }
 
-  /* Recorro todas las funciones de programa2 */
-    for ( cont2 = 0 ; cont2 < funciones2.Len () ; cont2 ++ )
+    if ( residente2 != NULL )
     {
-    /* Levanto la siguiente funcion */
-      funcion2 = ( Funcion * ) funciones2.Get ( cont2 );
-
-    /* Si las 2 funciones tienen la misma geometria */
-      if ( strcmp ( funcion1 -> graph_ecuation , funcion2 -> graph_ecuation ) == 0 )
-      {
-//        my_msg ( "pareja formada: %x - %x\n" , funcion1 -> address , funcion2 -> address );
-
-      /* Relaciono las 2 funciones */
-        asociar_funciones ( FALSE , funcion1 , funcion2 , funciones1_reconocidas , funciones2_reconocidas , funciones1 , funciones2 );
+      indice_funciones2.Clear ();
+      funciones2.Clear ();
+    }
 
-      /* Decremento la posicion en la lista para compensar la extraccion del elemento */
-        cont --;
+  /* Libero las funciones que llegue a levantar */
+    reiniciar_comparacion ();
 
-      /* Corto la busqueda */
-        break;
-      }
-    }
+  /* Retorno ERROR */
+    return ( FALSE );
   }
 
-  return ( ret );
-}
+/* Armo el grafo del programa1 */
+  armar_grafo_programa ( funciones1 , &grafo_programa1 );
 
-/****************************************************************************/
+/* Hago una copia de la lista de funciones */
+  for ( pos = 0 ; pos < funciones1.Len () ; pos ++ )
+  {
+  /* Levanto el siguiente elemento */
+    funcion = ( Funcion * ) funciones1.Get ( pos );
 
-unsigned int reconocer_funciones_x_vtables ( List &funciones1 , List &funciones2 , List &funciones1_irreconocidas , List &funciones2_irreconocidas , List &funciones1_cambiadas , List &funciones2_cambiadas )
-{
-  Funcion *funcion1;
-  Funcion *funcion2;
-  unsigned int cont1;
-  unsigned int cont2;
-  unsigned int funciones_reconocidas = 0;
+  /* Duplico el elemento */
+    funciones1_levantadas.Add ( funcion );
+  }
 
-/* Recorro todas las funciones irreconocidas */
-  for ( cont1 = 0 ; cont1 < funciones1_irreconocidas.Len () ; cont1 ++ )
+/* Armo el grafo del programa2 */
+  armar_grafo_programa ( funciones2 , &grafo_programa2 );
+
+/* Hago una copia de la lista de funciones */
+  for ( pos = 0 ; pos < funciones2.Len () ; pos ++ )
   {
-  /* Levanto la siguiente funcion en programa1 */
-    funcion1 = ( Funcion * ) funciones1_irreconocidas.Get ( cont1 );
+  /* Levanto el siguiente elemento */
+    funcion = ( Funcion * ) funciones2.Get ( pos );
 
-  /* Si la funcion NO tiene referencias padre x vtable */
-    if ( funcion1 -> referencias_padre_x_vtable -> Len () == 0 )
-    {
-    /* Sigo buscando */
-      continue;
-    }
+  /* Duplico el elemento */
+    funciones2_levantadas.Add ( funcion );
+  }
 
-  /* Recorro todas las funciones irreconocidas en programa2 */
-    for ( cont2 = 0 ; cont2 < funciones2_irreconocidas.Len () ; cont2 ++ )
-    {
-    /* Levanto la siguiente funcion */
-      funcion2 = ( Funcion * ) funciones2_irreconocidas.Get ( cont2 );
+/* Mensaje de funciones cargadas para el usuario */
+  my_msg ( "loaded functions for file1: %i\n" , funciones1_levantadas.Len () );
+  my_msg ( "loaded functions for file2: %i\n" , funciones2_levantadas.Len () );
 
-    /* Si la funcion NO tiene referencias padre x vtable */
-      if ( funcion2 -> referencias_padre_x_vtable -> Len () == 0 )
-      {
-      /* Sigo buscando */
-        continue;
-      }
+/* Arranco a analizar todas las funciones */
+  my_msg ( "comparing functions ...\n" );
 
-    /* Si son funciones equivalentes */
-      if ( son_funciones_equivalentes_x_vtables ( funciones1 , funciones2 , funcion1 , funcion2 ) == TRUE )
-      {
-//        my_msg ( "igual_x_vtable: %x - %x\n" , funcion1 -> address , funcion2 -> address );
+////////////////////////////////////////
 
-      /* Asocio las funciones */
-        asociar_funciones ( FALSE , funcion1 , funcion2 , funciones1_cambiadas , funciones2_cambiadas , funciones1_irreconocidas , funciones2_irreconocidas );
+/* Si el usuario quiere reusar la comparacion previa */
+  if ( incremental == TRUE )
+  {
+  /* Arrastro los matcheos de las funciones que no cambiaron */
+    iniciar_fase ( "incremental" );
+    reutilizadas = reutilizar_comparacion_previa ( filename1 , filename2 );
+    terminar_fase ();
 
-      /* Compenso la extraccion de la lista */
-        cont1 --;
+  /* Mensaje al usuario */
+    my_msg ( "reused matches from previous comparison: %i\n" , reutilizadas );
+  }
 
-      /* Aumento la cantidad de funciones reconocidas */
-        funciones_reconocidas ++;
+////////////////////////////////////////
+
+/* Si puedo usar los simbolos */
+  if ( usar_simbolos == TRUE )
+  {
+  /* Arranco la fase */
+    iniciar_fase ( "symbols" );
+    fijar_total_progreso ( funciones1_levantadas.Len () );
 
-      /* Continuo en la proxima funcion */
+  /* Recorro todas las funciones de programa1 */
+    for ( cont = 0 ; cont < funciones1_levantadas.Len () ; cont ++ )
+    {
+    /* Si la operacion fue cancelada, me quedo con lo asociado hasta ahora */
+      if ( avanzar_progreso ( 1 ) == FALSE )
+      {
         break;
       }
-    }
-  }
 
-  return ( funciones_reconocidas );
-}
-
-/****************************************************************************/
+    /* Levanto la siguiente funcion */
+      funcion1 = ( Funcion * ) funciones1_levantadas.Get ( cont );
 
-int son_funciones_equivalentes_x_vtables ( List &funciones1 , List &funciones2 , Funcion *funcion1 , Funcion *funcion2 )
-{
-  Funcion *funcion1_padre;
-  Funcion *funcion2_padre;
-  Basic_Block *basic_block1_padre;
-  Basic_Block *basic_block2_padre;
-  unsigned int address_funcion_referenciada;
-  unsigned int address_padre;
-  unsigned int cont, cont1, cont2;
-  unsigned int pos;
-  int ret = FALSE;
-
-/* Recorro todas las referencias padre x vtables */
-  for ( cont = 0 ; cont < funcion1 -> referencias_padre_x_vtable -> Len () ; cont ++ )
-  {
-  /* Levanto la siguiente direccion */
-    address_padre = ( unsigned int ) funcion1 -> referencias_padre_x_vtable -> Get ( cont );
-
-  /* Obtengo la funcion padre */
-    funcion1_padre = get_estructura_funcion ( funciones1 , address_padre );
-
-  /* Si la funcion padre se asocio con alguna */
-    if ( funcion1_padre -> identica == TRUE || funcion1_padre -> patcheada == TRUE )
-    {
-    /* Obtengo la pareja de funcion1 padre */
-      funcion2_padre = get_estructura_funcion ( funciones2 , funcion1_padre -> address_equivalente );
-
-    /* Recorro todos los basic blocks de funcion1 padre */
-      for ( cont1 = 0 ; cont1 < funcion1_padre -> cantidad_basic_blocks ; cont1 ++ )
+    /* Si la funcion tiene nombre */
+      if ( strncmp ( funcion1 -> name , "sub_" , 4 ) != 0 )
       {
-      /* Levanto el siguiente basic block */
-        basic_block1_padre = funcion1_padre -> basic_blocks [ cont1 ];
-
-      /* Si el basic block tiene asociada una VTABLE */
-        if ( basic_block1_padre -> ptr_funciones_hijas -> Len () > 0 )
+      /* Busco en programa2 esta misma funcion */
+        for ( cont2 = 0 ; cont2 < funciones2_levantadas.Len () ; cont2 ++ )
         {
-        /* Si la funcion NO esta en esta VTABLE */
-          if ( basic_block1_padre -> ptr_funciones_hijas -> Find ( ( void * ) funcion1 -> address ) != TRUE )
-          {
-          /* Sigo buscando */
-            continue;
-          }
-          else
-          {
-          /* Obtengo la posicion en la VTABLE de la funcion */
-            basic_block1_padre -> ptr_funciones_hijas -> GetPos ( ( void * ) funcion1 -> address , &pos );
-          }
+        /* Levanto la siguiente funcion */
+          funcion2 = ( Funcion * ) funciones2_levantadas.Get ( cont2 );
 
-        /* Recorro todos los basic blocks de funcion2 padre */
-          for ( cont2 = 0 ; cont2 < funcion2_padre -> cantidad_basic_blocks ; cont2 ++ )
-          {
-          /* Levanto el siguiente basic block */
-            basic_block2_padre = funcion2_padre -> basic_blocks [ cont2 ];
+        /* Cuento el par examinado */
+          fase_actual -> pares_examinados ++;
 
-          /* Si el basic block tiene asociada una VTABLE */
-            if ( basic_block2_padre -> ptr_funciones_hijas -> Len () > 0 )
+        /* Si esta funcion es la que estoy buscando */
+          if ( tienen_el_mismo_nombre ( funcion1 , funcion2 ) == TRUE )
+          {
+          /* Si las funciones son identicas */
+            if ( son_funciones_iguales ( funcion1 , funcion2 ) == TRUE )
             {
-            /* Si las vtables miden lo mismo */
-              if ( basic_block1_padre -> ptr_funciones_hijas -> Len () == basic_block2_padre -> ptr_funciones_hijas -> Len () )
-              {
-              /* Obtengo la direccion de la funcion referenciada por VTABLE2 en esa posicion */
-                address_funcion_referenciada = ( unsigned int ) basic_block2_padre -> ptr_funciones_hijas -> Get ( pos );
-
-              /* Si la funcion equivalente en la VTABLE2 es la que estoy buscando */
-                if ( funcion2 -> address == address_funcion_referenciada )
-                {
-//                  my_msg ( "EQU --> bb1: %x, pos = %x\n" , basic_block1_padre -> addr_inicial , pos );
-                  
-                /* Retorno OK */
-                  return ( TRUE );
-                }
-              }
+            /* Relaciono las funciones */
+              asociar_funciones ( TRUE , funcion1 , funcion2 , funciones1_reconocidas , funciones2_reconocidas , funciones1_levantadas , funciones2_levantadas );
+            }
+          /* Si son funciones patcheadas */
+            else
+            {
+            /* Relaciono las funciones */
+              asociar_funciones ( FALSE , funcion1 , funcion2 , funciones1_cambiadas , funciones2_cambiadas , funciones1_levantadas , funciones2_levantadas );
             }
+
+          /* Compenso el puntero en la lista de programa1 */
+            cont --;
+
+          /* Corto la busqueda en programa2 */
+            break;
           }
         }
       }
     }
-  }
 
-  return ( ret );
-}
+  /* Termino la fase */
+    terminar_fase ();
+  }
 
-/****************************************************************************/
+////////////////////////////////////////
 
-int son_funciones_iguales ( Funcion *funcion1 , Funcion *funcion2 )
-{
-  int ret = FALSE;
+/* Arranco la fase */
+  iniciar_fase ( "identical" );
 
-/* Si las funciones tienen la misma longitud */
-  if ( funcion1 -> longitud == funcion2 -> longitud )
+/* Indexo las funciones de programa2 por la firma de su grafo */
+  for ( pos = 0 ; pos < funciones2_levantadas.Len () ; pos ++ )
   {
-  /* Si tienen el mismo checksum */
-    if ( funcion1 -> checksum == funcion2 -> checksum )
-    {
-    /* Si tienen la misma geometria */
-      if ( strcmp ( funcion1 -> graph_ecuation , funcion2 -> graph_ecuation ) == 0 )
-      {
-      /* Asumo que las funciones son iguales */
-        ret = TRUE;
-      }
-    }
-  }
+  /* Levanto la siguiente funcion */
+    funcion2 = ( Funcion * ) funciones2_levantadas.Get ( pos );
 
-  return ( ret );
-}
+  /* Agrego la funcion al indice */
+    grafos2.Add ( funcion2 -> hash_grafo , funcion2 );
+  }
 
-/****************************************************************************/
+/* Ordeno el indice */
+  grafos2.Sort ();
 
-int son_funciones_cuasi_identicas ( Funcion *funcion1 , Funcion *funcion2 )
-{
-  int ret = FALSE;
+/* Recorro todas las funciones buscando las que son IDENTICAS */
+  fijar_total_progreso ( funciones1_levantadas.Len () );
 
-/* Si las funciones tienen mas de un basic block */
-  if ( funcion1 -> cantidad_basic_blocks > 1 )
+  while ( funciones1_levantadas.Len () > 0 )
   {
-  /* Si las funciones tienen la misma longitud */
-    if ( ( funcion1 -> longitud > 0 ) && ( funcion1 -> longitud == funcion2 -> longitud ) )
+  /* Marco el flag de funciones matcheadas */
+    matched_functions = FALSE;
+
+  /* Levanto la proxima funcion de 1 */
+    funcion1 = ( Funcion * ) funciones1_levantadas.Get ( 0 );
+
+  /* Si la operacion sigue en curso, la funcion tiene mas de 1 basic block o tiene un checksum confiable */
+  /* y hay funciones2 con la misma firma de grafo ( si fue cancelada, solo la paso a las intermedias ) */
+    if ( ( avanzar_progreso ( 1 ) == TRUE ) && ( ( funcion1 -> cantidad_basic_blocks > 1 ) || ( funcion1 -> checksum & 0xfff ) ) && ( grafos2.Find ( funcion1 -> hash_grafo , &pos ) == TRUE ) )
     {
-    /* Si las funciones tienen el mismo grafo */
-      if ( strcmp ( funcion1 -> graph_ecuation , funcion2 -> graph_ecuation ) == 0 )
+    /* Levanto las funciones2 con la misma firma */
+      for ( ; ( pos < grafos2.Len () ) && ( grafos2.GetKey ( pos ) == funcion1 -> hash_grafo ) ; pos ++ )
       {
-      /* Asumo que las funciones son iguales pero con cambios triviales */
-        ret = TRUE;
+      /* Levanto la proxima funcion de 2 */
+        funcion2 = ( Funcion * ) grafos2.Get ( pos );
+
+      /* Si la funcion ya fue asociada */
+        if ( funcion2 -> address_equivalente != BADADDR )
+        {
+        /* Sigo con la proxima */
+          continue;
+        }
+
+      /* Cuento el par examinado */
+        fase_actual -> pares_examinados ++;
+
+      /* Si las funciones son iguales y su geometria coincide exactamente */
+      /* ( la firma del grafo solo agrupa a las candidatas, puede colisionar ) */
+        if ( ( son_funciones_iguales ( funcion1 , funcion2 ) == TRUE ) && ( strcmp ( funcion1 -> graph_ecuation , funcion2 -> graph_ecuation ) == 0 ) )
+        {
+        /* Relaciono las 2 funciones */
+          asociar_funciones ( TRUE , funcion1 , funcion2 , funciones1_reconocidas , funciones2_reconocidas , funciones1_levantadas , funciones2_levantadas );
+    
+        /* Marco el flag de funciones matcheadas */
+          matched_functions = TRUE;
+
+        /* Paso a la siguiente funcion */
+          break;
+        }
       }
     }
+
+  /* Si no pude matchear esta funcion */
+    if ( matched_functions == FALSE )
+    {
+    /* Saco la funcion1 y la paso a la lista de intermedias */
+      funciones1_intermedias.Add ( funcion1 );
+      funciones1_levantadas.DeleteElement ( funcion1 );
+    }
   }
 
-  return ( ret );
-}
+/* Termino la fase */
+  terminar_fase ();
 
-/****************************************************************************/
+////////////////////////////////////////
 
-int es_funcion_patcheada ( Funcion *funcion1 , List &funciones_2 , Funcion **funcion2 )
-{
-  Basic_Block_Padre *basic_block_padre;
-  Funcion *funcion_padre1;
-  Funcion *funcion_padre2;
-  unsigned int cont;
-  int ret = FALSE;
+/* Arranco la fase */
+  iniciar_fase ( "quasi-identical" );
 
-/* Recorro todas las funciones padres de funcion1 */
-  for ( cont = 0 ; cont < funcion1 -> cantidad_referencias_padre ; cont ++ )
+/* Recorro todas las funciones buscando las que son CUASI-IDENTICAS */
+  fijar_total_progreso ( funciones1_intermedias.Len () );
+
+  for ( cont = 0 ; cont < funciones1_intermedias.Len () ; cont ++ )
   {
-  /* Obtengo el basic block donde es llamada la funcion */
-    basic_block_padre = &funcion1 -> basic_blocks_padres [ cont ];
+  /* Si la operacion fue cancelada, me quedo con lo asociado hasta ahora */
+    if ( avanzar_progreso ( 1 ) == FALSE )
+    {
+      break;
+    }
 
-  /* Obtengo la funcion padre que llama a la funcion */
-    funcion_padre1 = ( Funcion * ) basic_block_padre -> funcion;
+  /* Levanto la proxima funcion de 1 */
+    funcion1 = ( Funcion * ) funciones1_intermedias.Get ( cont );
 
-  /* Si la funcion padre fue relacionada con otra funcion en programa2 */
-    if ( ( funcion_padre1 -> identica == TRUE ) || ( funcion_padre1 -> patcheada == TRUE ) )
+  /* Si NO hay funciones2 con la misma firma de grafo */
+    if ( grafos2.Find ( funcion1 -> hash_grafo , &pos ) == FALSE )
     {
-    /* Obtengo la funcion padre de 2 */
-      funcion_padre2 = get_estructura_funcion ( funciones_2 , funcion_padre1 -> address_equivalente );
+    /* Sigo con la proxima */
+      continue;
+    }
 
-    /* Busco en las funciones padres el basic block en comun */
-      ret = get_funcion_equivalente_x_grafo ( 0 , funcion_padre1 , funcion1 , NULL , funciones_2 , funcion_padre2 , funcion2 , NULL );
+  /* Levanto las funciones2 con la misma firma */
+    for ( ; ( pos < grafos2.Len () ) && ( grafos2.GetKey ( pos ) == funcion1 -> hash_grafo ) ; pos ++ )
+    {
+    /* Levanto la proxima funcion de 2 */
+      funcion2 = ( Funcion * ) grafos2.Get ( pos );
 
-    /* Si encontre la funcion equivalente */
-      if ( ret == TRUE )
+    /* Si la funcion ya fue asociada */
+      if ( funcion2 -> address_equivalente != BADADDR )
       {
-      /* Salgo */
+      /* Sigo con la proxima */
+        continue;
+      }
+
+    /* Cuento el par examinado */
+      fase_actual -> pares_examinados ++;
+
+    /* Si son funciones cuasi-identicas */
+      if ( son_funciones_cuasi_identicas ( funcion1 , funcion2 ) == TRUE )
+      {
+      /* Relaciono las 2 funciones */
+        asociar_funciones ( FALSE , funcion1 , funcion2 , funciones1_cambiadas , funciones2_cambiadas , funciones1_intermedias , funciones2_levantadas );
+
+      /* Compenso la extraccion de la funcion */
+        cont --;
+
+      /* Sigo buscando */
         break;
       }
     }
   }
 
-  return ( ret );
-}
+/* Termino la fase */
+  terminar_fase ();
 
-/****************************************************************************/
+////////////////////////////////////////
 
-int get_funcion_equivalente_x_grafo ( int nivel , Funcion *funcion_padre1 , Funcion *funcion1 , Basic_Block *basic_block1 , List &funciones2 , Funcion *funcion_padre2 , Funcion **funcion2 , Basic_Block *basic_block2 )
-{
-  List basic_blocks_padres1;
-  List basic_blocks_padres2;
-  Funcion *funcion_buscada;
-  Basic_Block *basic_block_padre1;
-  Basic_Block *basic_block_padre2;
-  Basic_Block *basic_block_hijo1;
-  Basic_Block *basic_block_hijo2;
-  int condicion_invertida = FALSE;
-  unsigned int funcion2_address;
-  unsigned int address_hija1;
-  unsigned int address_hija2;
-  unsigned int cont, cont2;
-  unsigned int pos;
-  int ret = FALSE;
+/* Asocio las funciones que comparten un import o un string que nadie mas usa */
+  iniciar_fase ( "anchors" );
+  reconocer_funciones_x_anclas ( funciones1 , funciones2 , funciones1_intermedias , funciones2_levantadas , funciones1_cambiadas , funciones2_cambiadas );
+  terminar_fase ();
 
-/* Si estoy en el primer nivel */
-  if ( nivel == 0 )
-  {
-  /* Marco como libre a todos los basic blocks de las funciones padres */
-    liberar_basic_blocks ( funcion_padre1 );
-    liberar_basic_blocks ( funcion_padre2 );
+////////////////////////////////////////
 
-  /* Levanto los basic blocks iniciales */
-    basic_block1 = funcion_padre1 -> basic_blocks [ 0 ];
-    basic_block2 = funcion_padre2 -> basic_blocks [ 0 ];
-  }
+/* Arranco la fase */
+  iniciar_fase ( "patched pass %u" , pasada );
 
-/* Marco los basic blocks como visitados */
-  basic_block1 -> visitado = TRUE;
-  basic_block2 -> visitado = TRUE;
+/* Recorro todas las funciones buscando las que cambiaron */
+/* y las reconozco desde las funciones identicas */
+  fijar_total_progreso ( funciones1_intermedias.Len () );
 
-/* Si los basic blocks tienen checksums distintos */
-  if ( basic_block1 -> checksum != basic_block2 -> checksum )
+  while ( funciones1_intermedias.Len () > 0 )
   {
-  /* Si tengo una condicion invertida */
-    if ( is_condicion_invertida ( funcion_padre1 , funcion_padre2 , basic_block1 , basic_block2 ) == TRUE )
+  /* Marco el flag de funciones matcheadas */
+    matched_functions = FALSE;
+
+  /* Levanto la proxima funcion de 1 */
+    funcion1 = ( Funcion * ) funciones1_intermedias.Get ( 0 );
+
+    // nicolas 
+//    my_msg ( "?son patcheadas %x %x\n" , funcion1 -> address , funcion2 -> address );
+
+  /* Si la operacion sigue en curso y es una funcion que esta patcheada ( si fue cancelada, solo la paso a las irreconocidas ) */
+    if ( ( avanzar_progreso ( 1 ) == TRUE ) && ( es_funcion_patcheada ( funcion1 , funciones2 , &funcion2 ) == TRUE ) )
     {
-    /* Condicion invertida detectada */
-      condicion_invertida = TRUE;
+    /* Relaciono las 2 funciones */
+      asociar_funciones ( FALSE , funcion1 , funcion2 , funciones1_cambiadas , funciones2_cambiadas , funciones1_intermedias , funciones2_levantadas );
 
-//      my_msg ( "condicion invertida: %x - %x\n" , basic_block1 -> addr_inicial , basic_block2 -> addr_inicial );
+    /* Marco el flag de funciones matcheadas */
+      matched_functions = TRUE;
     }
-  /* Si NO es un camino confiable */
-    else if ( is_camino_confiable ( 1 , 0 , funcion_padre1 , funcion_padre2 , basic_block1 , basic_block2 ) == FALSE )
+
+  /* Si no pude matchear esta funcion */
+    if ( matched_functions == FALSE )
     {
-    /* No puedo seguir por este camino */
-      return ( FALSE );
+    /* Saco la funcion1 y la paso a la lista de irreconocidas */
+      funciones1_irreconocidas.Add ( funcion1 );
+      funciones1_intermedias.DeleteElement ( funcion1 );
     }
   }
 
-/* Busco en el basic block si estoy llamando a la funcion */
-  if ( basic_block1 -> funciones_hijas -> GetPos ( ( void * ) funcion1 -> address , &pos ) == TRUE )
+////////////////////////////////////////
+////////////////////////////////////////
+
+/* Recorro toda la lista de funciones intermedias */
+  for ( pos = 0 ; pos < funciones1_irreconocidas.Len () ; pos ++ )
   {
-  /* Si los basic blocks llaman a la misma cantidad de funciones */
-    if ( basic_block1 -> funciones_hijas -> Len () == basic_block2 -> funciones_hijas -> Len () )
+  /* Si la operacion fue cancelada, me quedo con lo asociado hasta ahora */
+    if ( is_operacion_cancelada () == TRUE )
     {
-    /* Levanto en la misma posicion de llamados en el basic block 2 */
-      funcion2_address = ( unsigned int ) basic_block2 -> funciones_hijas -> Get ( pos );
+      break;
+    }
 
-    /* Obtengo la funcion */
-      funcion_buscada = get_estructura_funcion ( funciones2 , funcion2_address ); 
+  /* Levanto la proxima funcion de 1 */
+    funcion1 = ( Funcion * ) funciones1_irreconocidas.Get ( pos );
+
+  /* Analizar esta funcion SI TIENE UN PADRE en la lista de cambiadas */
+    // nicolas
+
+  /* Si la funcion fue reconocida */
+    if ( es_funcion_patcheada ( funcion1 , funciones2 , &funcion2 ) == TRUE )
+    {
+    /* Relaciono las 2 funciones */
+      asociar_funciones ( FALSE , funcion1 , funcion2 , funciones1_cambiadas , funciones2_cambiadas , funciones1_irreconocidas , funciones2_levantadas );
+
+    /* Decremento la posicion en la lista para compensar la extraccion del elemento */
+      pos --;
+    }
+  }
+
+/* Termino la fase */
+  terminar_fase ();
+
+////////////////////////////////////////
+
+/* Reconozco las funciones que tienen la misma geometria */
+//  reconocer_funciones_con_misma_geometria ( funciones1_cambiadas , funciones2_cambiadas , funciones1_irreconocidas , funciones2_levantadas );
+
+////////////////////////////////////////
+
+// nicolas
+//  goto salto;
+
+/* Recorro todas las funciones que me quedaron sueltas */
+/* y las reconozco desde las funciones cambiadas */
+  do
+  {
+  /* Cuento la cantidad de pasadas */
+    pasada ++;
+
+  /* Arranco la fase */
+    iniciar_fase ( "patched pass %u" , pasada );
+
+  /* Seteo el contador de funciones reconocidas analizando las funciones patcheadas */
+    funciones_reconocidas = 0;
+    fijar_total_progreso ( funciones1_irreconocidas.Len () );
+
+  /* Recorro toda la lista de funciones intermedias */
+    for ( pos = 0 ; pos < funciones1_irreconocidas.Len () ; pos ++ )
+    {
+    /* Si la operacion fue cancelada, me quedo con lo asociado hasta ahora */
+      if ( avanzar_progreso ( 1 ) == FALSE )
+      {
+        break;
+      }
+
+    /* Levanto la proxima funcion de 1 */
+      funcion1 = ( Funcion * ) funciones1_irreconocidas.Get ( pos );
+
+    /* Analizar esta funcion SI TIENE UN PADRE en la lista de cambiadas */
+      // nicolas
+
+    /* Si la funcion fue reconocida */
+      if ( es_funcion_patcheada ( funcion1 , funciones2 , &funcion2 ) == TRUE )
+      {
+      /* Relaciono las 2 funciones */
+        asociar_funciones ( FALSE , funcion1 , funcion2 , funciones1_cambiadas , funciones2_cambiadas , funciones1_irreconocidas , funciones2_levantadas );
+
+      /* Incremento la cantidad de funciones reconocidas */
+        funciones_reconocidas ++;
+
+      /* Decremento la posicion en la lista para compensar la extraccion del elemento */
+        pos --;
+      }
+    }
+
+//  salto:;
+
+////////////////////////////////////////
+
+//  goto salto2;
+
+///* Recorro todas las funciones que me quedaron sueltas */
+///* y las reconozco desde las funciones hijas */
+//  /* Recorro todas las funciones huerfanas que no fueron reconocidas como identicas */
+//    for ( pos = 0 ; pos < funciones1_irreconocidas.Len () ; pos ++ )
+//    {
+//    /* Levanto la siguiente funcion */
+//      funcion1 = ( Funcion * ) funciones1_irreconocidas.Get ( pos );
+//
+//    /* Si reconozco la funcion a traves de los hijos */
+//      if ( get_funcion_equivalente_x_hijos ( funcion1 , funciones1 , funciones2 , &funcion2 ) == TRUE )
+//      {
+////        my_msg ( "reconocida %x\n" , funcion1 -> address );
+//
+//      /* Relaciono las 2 funciones */
+//        asociar_funciones ( FALSE , funcion1 , funcion2 , funciones1_cambiadas , funciones2_cambiadas , funciones1_irreconocidas , funciones2_levantadas );
+//
+//      /* Incremento la cantidad de funciones reconocidas */
+//        funciones_reconocidas ++;
+//
+//      /* Decremento la posicion en la lista para compensar la extraccion del elemento */
+//        pos --;
+//      }
+//    }
+
+//  salto2:;
+
+////////////////////////////////////////
+
+  /* Mensaje al usuario */
+    if ( funciones_reconocidas > 0 )
+    {
+//      my_msg ( "pasada %i: funciones reconocidas = %i\n" , pasada , funciones_reconocidas );
+    }
+
+  /* Termino la fase */
+    terminar_fase ();
+  }
+  while ( funciones_reconocidas > 0 );
+
+////////////////////////////////////////
+
+/* Reconozco todas las funciones a traves de vtables padres */
+  iniciar_fase ( "vtables" );
+  reconocer_funciones_x_vtables ( funciones1 , funciones2 , funciones1_irreconocidas , funciones2_levantadas , funciones1_cambiadas , funciones2_cambiadas );
+  terminar_fase ();
+
+/* Reconozco las funciones que quedaron a traves de sus vecinos en el call graph */
+  iniciar_fase ( "call graph" );
+  reconocer_funciones_x_call_graph ( funciones1 , funciones2 , funciones1_irreconocidas , funciones2_levantadas , funciones1_cambiadas , funciones2_cambiadas );
+  terminar_fase ();
+
+/* Le doy una ultima oportunidad a las que quedaron buscando las mas parecidas */
+  iniciar_fase ( "similarity" );
+  reconocer_funciones_x_similitud ( funciones1_irreconocidas , funciones2_levantadas , funciones1_cambiadas , funciones2_cambiadas );
+  terminar_fase ();
+
+////////////////////////////////////////
+
+/* Recorro todas las funciones que me quedaron sueltas en 2 */
+  while ( funciones2_levantadas.Len () > 0 )
+  {
+  /* Levanto la proxima funcion de 2 */
+    funcion2 = ( Funcion * ) funciones2_levantadas.Get ( 0 );
+
+  /* Saco la funcion1 y la paso a la lista de irreconocidas */
+    funciones2_irreconocidas.Add ( funcion2 );
+    funciones2_levantadas.DeleteElement ( funcion2 );
+  }
+
+////////////////////////////////////////
+
+/* Arranco la fase */
+  iniciar_fase ( "classification" );
+
+/* Recorro todas las funciones que cambiaron */
+/* e identifico las funciones IDENTICAS de un 1 basic block */
+  for ( cont = 0 ; cont < funciones1_cambiadas.Len () ; cont ++ )
+  {
+  /* Levanto el siguiente par asociado */
+    funcion1 = ( Funcion * ) funciones1_cambiadas.Get ( cont );
+    funcion2 = ( Funcion * ) funciones2_cambiadas.Get ( cont );
+
+  /* Cuento el par examinado */
+    fase_actual -> pares_examinados ++;
+
+  /* Si estan formadas por un solo basic block */
+    if ( funcion1 -> cantidad_basic_blocks == 1 )
+    {
+    /* Si las funciones son IDENTICAS */
+      if ( son_funciones_iguales ( funcion1 , funcion2 ) == TRUE )
+      {
+      /* Asumo que son identicas */
+        asociar_funciones ( TRUE , funcion1 , funcion2 , funciones1_reconocidas , funciones2_reconocidas , funciones1_cambiadas , funciones2_cambiadas );
+
+      /* Compenso la extraccion */
+        cont --;
+      }
+    }
+  }
+
+////////////////////////////////////////
+
+/* Discrimino los cambios importantes de los triviales */
+/* en las funciones cambiadas */
+  clasificar_funciones_cambiadas ( funciones1_cambiadas , funciones2_cambiadas , funciones1_matcheadas , funciones2_matcheadas );
+
+/* Emito las funciones que quedaron sin asociar */
+  for ( pos = 0 ; pos < funciones1_irreconocidas.Len () ; pos ++ )
+  {
+    emitir_registro_resultado ( "unmatched1" , ( Funcion * ) funciones1_irreconocidas.Get ( pos ) , NULL , 0 );
+  }
+
+  for ( pos = 0 ; pos < funciones2_irreconocidas.Len () ; pos ++ )
+  {
+    emitir_registro_resultado ( "unmatched2" , NULL , ( Funcion * ) funciones2_irreconocidas.Get ( pos ) , 0 );
+  }
+
+/* Termino la fase */
+  terminar_fase ();
+
+/* Cierro el stream de resultados */
+  cerrar_stream_resultados ();
+
+////////////////////////////////////////
+
+/* Separador */
+  my_msg ( "-------------------------------------------------------------\n" );
+  qfprintf ( f_log_file , "-------------------------------------------------------------\n" );
+  my_msg ( "-------------------------------------------------------------\n" );
+  qfprintf ( f_log_file , "-------------------------------------------------------------\n" );
+
+/* Imprimo el reporte */
+  my_msg ( "identical functions: %i\n" , funciones1_reconocidas.Len () );
+  qfprintf ( f_log_file , "identical functions: %i\n" , funciones1_reconocidas.Len () );
+
+/* Imprimo las funciones que son identicas */
+  for ( pos = 0 ; pos < funciones1_reconocidas.Len () ; pos ++ )
+  {
+  /* Levanto las funciones cambiadas de los 2 archivos */
+    funcion1 = ( Funcion * ) funciones1_reconocidas.Get ( pos );
+    funcion2 = ( Funcion * ) funciones2_reconocidas.Get ( pos );
+
+  /* Formateo el nombre de las funciones para poderlos imprimir */
+    get_formated_name ( funcion1 , funcion1_name , NAME_LEN , TRUE );
+    get_formated_name ( funcion2 , funcion2_name , NAME_LEN , TRUE );
+
+  /* Imprimo los pares */
+    qfprintf ( f_log_file , "%.8x %.48s - %.8x %.48s\n" , funcion1 -> address , funcion1_name , funcion2 -> address , funcion2_name );
+  }
+
+////////////////////
+
+/* Separador */
+  my_msg ( "-------------------------------------------------------------\n" );
+  qfprintf ( f_log_file , "-------------------------------------------------------------\n" );
+
+/* Imprimo el reporte */
+  my_msg ( "matched functions: %i\n" , funciones1_matcheadas.Len () + funciones1_geometricamente_identicas.Len () );
+  qfprintf ( f_log_file , "matched functions: %i\n" , funciones1_matcheadas.Len () + funciones1_geometricamente_identicas.Len () );
+
+/* Imprimo las funciones que cambiaron */
+  for ( pos = 0 ; pos < funciones1_matcheadas.Len () ; pos ++ )
+  {
+  /* Levanto las funciones cambiadas de los 2 archivos */
+    funcion1 = ( Funcion * ) funciones1_matcheadas.Get ( pos );
+    funcion2 = ( Funcion * ) funciones2_matcheadas.Get ( pos );
+
+  /* Formateo el nombre de las funciones */
+    get_formated_name ( funcion1 , funcion1_name , NAME_LEN , TRUE );
+    get_formated_name ( funcion2 , funcion2_name , NAME_LEN , TRUE );
+
+  /* Imprimo los pares */
+    qfprintf ( f_log_file , "[.] %.8x %.48s - %.8x %.48s\n" , funcion1 -> address , funcion1_name , funcion2 -> address , funcion2_name );
+  }
+
+/* Imprimo las funciones que cambiaron */
+  for ( pos = 0 ; pos < funciones1_geometricamente_identicas.Len () ; pos ++ )
+  {
+  /* Levanto las funciones cambiadas de los 2 archivos */
+    funcion1 = ( Funcion * ) funciones1_geometricamente_identicas.Get ( pos );
+    funcion2 = ( Funcion * ) funciones2_geometricamente_identicas.Get ( pos );
+
+  /* Formateo el nombre de las funciones */
+    get_formated_name ( funcion1 , funcion1_name , NAME_LEN , TRUE );
+    get_formated_name ( funcion2 , funcion2_name , NAME_LEN , TRUE );
+
+  /* Imprimo los pares */
+    qfprintf ( f_log_file , "[*] %.8x %.48s - %.8x %.48s\n" , funcion1 -> address , funcion1_name , funcion2 -> address , funcion2_name );
+  }
+
+////////////////////
+
+/* Separador */
+  my_msg ( "-------------------------------------------------------------\n" );
+  qfprintf ( f_log_file , "-------------------------------------------------------------\n" );
+
+  my_msg ( "unmatched functions1: %i\n" , funciones1_irreconocidas.Len () );
+  qfprintf ( f_log_file , "unmatched functions1: %i\n" , funciones1_irreconocidas.Len () );
+
+/* Imprimo las funciones que no pude reconocer para file1 */
+  for ( pos = 0 ; pos < funciones1_irreconocidas.Len () ; pos ++ )
+  {
+  /* Levanto las funciones cambiadas de los 2 archivos */
+    funcion1 = ( Funcion * ) funciones1_irreconocidas.Get ( pos );
+
+  /* Formateo el nombre de las funciones */
+    get_formated_name ( funcion1 , funcion1_name , NAME_LEN , TRUE );
+
+  /* Imprimo los pares */
+    qfprintf ( f_log_file , "%.8x %s\n" , funcion1 -> address , funcion1_name );
+  }
+
+////////////////////
+
+/* Separador */
+  my_msg ( "-------------------------------------------------------------\n" );
+  qfprintf ( f_log_file , "-------------------------------------------------------------\n" );
+
+  my_msg ( "unmatched functions2: %i\n" , funciones2_irreconocidas.Len () );
+  qfprintf ( f_log_file , "unmatched functions2: %i\n" , funciones2_irreconocidas.Len () );
+
+/* Imprimo las funciones que no pude reconocer para file2 */
+  for ( pos = 0 ; pos < funciones2_irreconocidas.Len () ; pos ++ )
+  {
+  /* Levanto las funciones cambiadas de los 2 archivos */
+    funcion2 = ( Funcion * ) funciones2_irreconocidas.Get ( pos );
+
+  /* Formateo el nombre de las funciones */
+    get_formated_name ( funcion2 , funcion2_name , NAME_LEN , TRUE );
+
+  /* Imprimo los pares */
+    qfprintf ( f_log_file , "%.8x %s\n" , funcion2 -> address , funcion2_name );
+  }
+
+////////////////////
+
+/* Separador */
+  my_msg ( "-------------------------------------------------------------\n" );
+  qfprintf ( f_log_file , "-------------------------------------------------------------\n" );
+
+/* Imprimo todas las funciones que cambiaron */
+  my_msg ( "changed functions: %i\n" , funciones1_cambiadas.Len () );
+  qfprintf ( f_log_file , "changed functions: %i\n" , funciones1_cambiadas.Len () );
+
+/* Recorro todas las funciones que cambiaron */
+  for ( pos = 0 ; pos < funciones1_cambiadas.Len () ; pos ++ )
+  {
+  /* Levanto las funciones cambiadas de los 2 archivos */
+    funcion1 = ( Funcion * ) funciones1_cambiadas.Get ( pos );
+    funcion2 = ( Funcion * ) funciones2_cambiadas.Get ( pos );
+
+  /* Formateo el nombre de las funciones */
+    get_formated_name ( funcion1 , funcion1_name , NAME_LEN , TRUE );
+    get_formated_name ( funcion2 , funcion2_name , NAME_LEN , TRUE );
+
+  /* Imprimo los pares */
+    qfprintf ( f_log_file , "[%c] %.8x %.48s - [%c] %.8x %.48s\n" , '.' , funcion1 -> address , funcion1_name , '.' , funcion2 -> address , funcion2_name );
+  }
+
+////////////////////
+
+/* Separador */
+  my_msg ( "-------------------------------------------------------------\n" );
+  qfprintf ( f_log_file , "-------------------------------------------------------------\n" );
+  my_msg ( "-------------------------------------------------------------\n" );
+  qfprintf ( f_log_file , "-------------------------------------------------------------\n" );
+
+/* Si la comparacion fue cancelada, lo dejo asentado en el log */
+  if ( terminar_operacion () == TRUE )
+  {
+    qfprintf ( f_log_file , "comparison cancelled in %s: partial results\n" , progreso.etapa );
+  }
+
+/* Aviso al usuario */
+  my_msg ( "logued output in %s\n" , log_file );
+
+/* Cierro el archivo de logueo */
+  qfclose ( f_log_file );
+
+/* Guardo las estadisticas de las fases al lado del log */
+  guardar_estadisticas ( log_file , filename1 , filename2 , GetTickCount () - initial_time );
+
+  return ( ret );
+}
+
+/****************************************************************************/ 
+
+int levantar_funciones_a_comparar ( char *filename , Analisis_Residente *residente , List &indice_funciones , List &funciones )
+{
+  Funcion *funcion;
+  unsigned int file_version;
+  unsigned int pos;
+  int ret = FALSE;
+  FILE *f;
+
+/* Mensaje al usuario */
+  my_msg ( "loading %s ...\n" , filename );
+
+/* Si el analisis ya esta en memoria ( servicio de comparacion ) */
+  if ( residente != NULL )
+  {
+  /* Recorro todas las funciones del analisis residente */
+    for ( pos = 0 ; pos < residente -> funciones.Len () ; pos ++ )
+    {
+    /* Levanto la siguiente funcion */
+      funcion = ( Funcion * ) residente -> funciones.Get ( pos );
+
+    /* Levanto el cuerpo si todavia no estaba en memoria ( queda residente ) */
+      levantar_funcion_por_demanda ( residente -> f , residente -> indice_funciones , residente -> funciones , residente -> posiciones , funcion );
+
+    /* Limpio lo que haya dejado una comparacion anterior */
+      funcion -> address_equivalente = BADADDR;
+      funcion -> identica = FALSE;
+      funcion -> patcheada = FALSE;
+
+    /* Presto la funcion a la comparacion ( el que libera es el residente ) */
+      indice_funciones.Add ( ( void * ) funcion -> address );
+      funciones.Add ( funcion );
+    }
+
+    ret = TRUE;
+  }
+/* Si hay que levantar el analisis del file */
+  else
+  {
+  /* Abro el archivo ( si no esta, lo reconstruyo desde el almacen ) */
+    f = abrir_analisis ( filename );
+
+  /* Si pude abrir el archivo */
+    if ( f != NULL )
+    {
+    /* Leo la version del file */
+      qfread ( f , ( void * ) &file_version , sizeof ( unsigned int ) );
+
+    /* Si la version coincide con la actual */
+      if ( file_version == turbodiff_version )
+      {
+      /* Levanto todas las funciones ( el usuario puede cancelarlo ) */
+        ret = levantar_funciones ( f , indice_funciones , funciones );
+      }
+    /* Si el analisis es de otra version */
+      else
+      {
+      /* Mensaje al usuario */
+        my_msg ( "ERROR: Different file versions, please take the analysis again\n" );
+      }
+
+    /* Cierro el archivo */
+      qfclose ( f );
+    }
+  }
+
+  return ( ret );
+}
+
+/****************************************************************************/
+
+void iniciar_operacion ( void )
+{
+  char *limite;
+
+/* Arranco la operacion sin cancelar */
+  memset ( &progreso , 0 , sizeof ( Progreso ) );
+  progreso.activa = TRUE;
+  progreso.ultimo_aviso = GetTickCount ();
+  progreso.ultimo_chequeo = progreso.ultimo_aviso;
+
+/* Si hay un limite de tiempo ( en segundos ) para la operacion */
+  limite = getenv ( "TURBODIFF_TIMEOUT" );
+
+  if ( ( limite != NULL ) && ( atoi ( limite ) > 0 ) )
+  {
+    progreso.limite = GetTickCount () + atoi ( limite ) * 1000;
+  }
+
+/* Muestro la ventana que le permite al usuario cancelar */
+  my_show_wait_box ( "turbodiff: working ..." );
+}
+
+/****************************************************************************/ 
+
+int terminar_operacion ( void )
+{
+/* Si no hay ninguna operacion en curso */
+  if ( progreso.activa == FALSE )
+  {
+    return ( FALSE );
+  }
+
+/* Cierro la ventana */
+  my_hide_wait_box ();
+
+/* Si la operacion fue cancelada */
+  if ( progreso.cancelada == TRUE )
+  {
+  /* Mensaje al usuario */
+    my_msg ( "operation cancelled in %s ( %u/%u )\n" , progreso.etapa , progreso.hechas , progreso.totales );
+  }
+
+/* Ya no hay ninguna operacion en curso */
+  progreso.activa = FALSE;
+
+  return ( progreso.cancelada );
+}
+
+/****************************************************************************/ 
+
+void iniciar_progreso ( char *etapa , unsigned int totales )
+{
+/* Arranco la etapa */
+  qstrncpy ( progreso.etapa , etapa , sizeof ( progreso.etapa ) );
+  progreso.hechas = 0;
+  progreso.totales = totales;
+}
+
+/****************************************************************************/ 
+
+void fijar_total_progreso ( unsigned int totales )
+{
+/* Seteo el total de la etapa ( recien se conoce despues de arrancarla ) */
+  progreso.totales = totales;
+}
+
+/****************************************************************************/ 
+
+void fijar_avance_progreso ( unsigned int hechas )
+{
+/* Seteo lo hecho de la etapa ( para las etapas que miden una posicion, como los bytes leidos ) */
+  progreso.hechas = hechas;
+}
+
+/****************************************************************************/ 
+
+int avanzar_progreso ( unsigned int unidades )
+{
+  unsigned int tiempo_actual;
+
+/* Si no hay ninguna operacion en curso */
+  if ( progreso.activa == FALSE )
+  {
+    return ( TRUE );
+  }
+
+/* Si la operacion ya fue cancelada */
+  if ( progreso.cancelada == TRUE )
+  {
+    return ( FALSE );
+  }
+
+/* Cuento las unidades hechas */
+  progreso.hechas += unidades;
+
+/* Tomo el tiempo actual */
+  tiempo_actual = GetTickCount ();
+
+/* Si todavia no es momento de preguntar por la cancelacion */
+  if ( tiempo_actual - progreso.ultimo_chequeo < PERIODO_CANCELACION )
+  {
+    return ( TRUE );
+  }
+
+  progreso.ultimo_chequeo = tiempo_actual;
+
+/* Si el usuario apreto cancelar o se paso el limite de tiempo */
+  if ( ( my_wasBreak () == TRUE ) || ( ( progreso.limite != 0 ) && ( ( int ) ( tiempo_actual - progreso.limite ) >= 0 ) ) )
+  {
+    cancelar_operacion ();
+    return ( FALSE );
+  }
+
+/* Si es momento de avisar el progreso */
+  if ( tiempo_actual - progreso.ultimo_aviso >= PERIODO_PROGRESO )
+  {
+    progreso.ultimo_aviso = tiempo_actual;
+
+  /* Si conozco el total de la etapa */
+    if ( progreso.totales > 0 )
+    {
+      my_replace_wait_box ( "turbodiff: %s %u/%u" , progreso.etapa , progreso.hechas , progreso.totales );
+      my_msg ( "%s: %u/%u\n" , progreso.etapa , progreso.hechas , progreso.totales );
+    }
+    else
+    {
+      my_replace_wait_box ( "turbodiff: %s %u" , progreso.etapa , progreso.hechas );
+      my_msg ( "%s: %u\n" , progreso.etapa , progreso.hechas );
+    }
+  }
+
+  return ( TRUE );
+}
+
+/****************************************************************************/ 
+
+void cancelar_operacion ( void )
+{
+/* Marco la operacion como cancelada ( las etapas cortan en su proximo avance ) */
+  progreso.cancelada = TRUE;
+}
+
+/****************************************************************************/ 
+
+int is_operacion_cancelada ( void )
+{
+  return ( ( progreso.activa == TRUE ) && ( progreso.cancelada == TRUE ) );
+}
+
+/****************************************************************************/ 
+
+void iniciar_fase ( char *format , ... )
+{
+  Estadistica_Fase *fase;
+  va_list va;
+
+/* Creo la estadistica de la nueva fase */
+  fase = ( Estadistica_Fase * ) malloc ( sizeof ( Estadistica_Fase ) );
+  memset ( fase , 0 , sizeof ( Estadistica_Fase ) );
+
+/* Armo el nombre de la fase */
+  va_start ( va , format );
+  qvsnprintf ( fase -> nombre , sizeof ( fase -> nombre ) , format , va );
+  va_end ( va );
+
+/* Tomo el tiempo de inicio de la fase */
+  fase -> tiempo = GetTickCount ();
+
+/* Agrego la fase a la lista */
+  estadisticas_fases.Add ( fase );
+
+/* Seteo la fase como la actual */
+  fase_actual = fase;
+
+/* La fase es la nueva etapa de la operacion */
+  iniciar_progreso ( fase -> nombre , 0 );
+}
+
+/****************************************************************************/ 
+
+void terminar_fase ( void )
+{
+/* Calculo el tiempo que tardo la fase */
+  fase_actual -> tiempo = GetTickCount () - fase_actual -> tiempo;
+
+/* Ya no hay ninguna fase ejecutandose */
+  fase_actual = &fase_nula;
+}
+
+/****************************************************************************/ 
+
+int guardar_estadisticas ( char *log_file , char *filename1 , char *filename2 , unsigned int tiempo_total )
+{
+  Estadistica_Fase *fase;
+  char json_file [ QMAXPATH ];
+  char string_escapado [ QMAXPATH * 2 ];
+  unsigned int pos;
+  FILE *f;
+
+/* Armo el nombre del file con las estadisticas */
+  qstrncpy ( json_file , log_file , QMAXPATH );
+  change_extension ( json_file , "json" );
+
+/* Si NO pude crear el archivo */
+  if ( ( f = qfopen ( json_file , "wt" ) ) == NULL )
+  {
+  /* Retorno ERROR */
+    return ( FALSE );
+  }
+
+/* Guardo los datos generales de la comparacion */
+  qfprintf ( f , "{\n" );
+  escapar_string_json ( filename1 , string_escapado , sizeof ( string_escapado ) );
+  qfprintf ( f , "  \"file1\": \"%s\",\n" , string_escapado );
+  escapar_string_json ( filename2 , string_escapado , sizeof ( string_escapado ) );
+  qfprintf ( f , "  \"file2\": \"%s\",\n" , string_escapado );
+  qfprintf ( f , "  \"time_ms\": %u,\n" , tiempo_total );
+  qfprintf ( f , "  \"phases\": [\n" );
+
+/* Guardo las estadisticas de todas las fases */
+  for ( pos = 0 ; pos < estadisticas_fases.Len () ; pos ++ )
+  {
+  /* Levanto la siguiente fase */
+    fase = ( Estadistica_Fase * ) estadisticas_fases.Get ( pos );
+
+  /* Guardo la fase */
+    qfprintf ( f , "    { \"name\": \"%s\", \"time_ms\": %u, \"pairs_examined\": %u, \"predicate_calls\": %u, \"matches\": %u }%s\n" , fase -> nombre , fase -> tiempo , fase -> pares_examinados , fase -> llamados_predicado , fase -> matcheos , ( pos + 1 < estadisticas_fases.Len () ) ? "," : "" );
+  }
+
+/* Cierro el objeto */
+  qfprintf ( f , "  ]\n" );
+  qfprintf ( f , "}\n" );
+
+/* Cierro el archivo */
+  qfclose ( f );
+
+/* Aviso al usuario */
+  my_msg ( "phase statistics in %s\n" , json_file );
+
+  return ( TRUE );
+}
+
+/****************************************************************************/ 
+
+void escapar_string_json ( char *origen , char *destino , unsigned int len )
+{
+  unsigned int pos1, pos2;
+
+/* Copio el string escapando los caracteres especiales */
+  for ( pos1 = 0 , pos2 = 0 ; ( origen [ pos1 ] != '\0' ) && ( pos2 + 2 < len ) ; pos1 ++ )
+  {
+  /* Si es un caracter que hay que escapar */
+    if ( ( origen [ pos1 ] == '\\' ) || ( origen [ pos1 ] == '"' ) )
+    {
+      destino [ pos2 ++ ] = '\\';
+    }
+
+  /* Si es un caracter de control, lo reemplazo por un espacio */
+    if ( ( unsigned char ) origen [ pos1 ] < 0x20 )
+    {
+      destino [ pos2 ++ ] = ' ';
+    }
+    else
+    {
+      destino [ pos2 ++ ] = origen [ pos1 ];
+    }
+  }
+
+/* Cierro el string */
+  destino [ pos2 ] = '\0';
+}
+
+/****************************************************************************/ 
+
+int abrir_stream_resultados ( char *log_file )
+{
+  char stream_file [ QMAXPATH ];
+
+/* El stream va al lado del log */
+  qstrncpy ( stream_file , log_file , QMAXPATH );
+  change_extension ( stream_file , "ndjson" );
+
+/* Creo el stream */
+  f_stream_resultados = qfopen ( stream_file , "wt" );
+
+/* Si no pude crearlo */
+  if ( f_stream_resultados == NULL )
+  {
+  /* Retorno ERROR */
+    return ( FALSE );
+  }
+
+/* Aviso al usuario */
+  my_msg ( "streaming results to %s\n" , stream_file );
+
+  return ( TRUE );
+}
+
+/****************************************************************************/ 
+
+void cerrar_stream_resultados ( void )
+{
+/* Si hay un stream abierto */
+  if ( f_stream_resultados != NULL )
+  {
+  /* Lo cierro */
+    qfclose ( f_stream_resultados );
+    f_stream_resultados = NULL;
+  }
+}
+
+/****************************************************************************/ 
+
+void emitir_registro_resultado ( char *categoria , Funcion *funcion1 , Funcion *funcion2 , unsigned int puntaje )
+{
+  char name1 [ NAME_LEN ];
+  char name2 [ NAME_LEN ];
+  char name1_escapado [ NAME_LEN * 2 ];
+  char name2_escapado [ NAME_LEN * 2 ];
+  char address1 [ 16 ];
+  char address2 [ 16 ];
+
+/* Si nadie pidio el stream */
+  if ( f_stream_resultados == NULL )
+  {
+    return;
+  }
+
+/* Armo los datos de funcion1 ( null si no la hay ) */
+  if ( funcion1 != NULL )
+  {
+    get_formated_name ( funcion1 , name1 , NAME_LEN , FALSE );
+    escapar_string_json ( name1 , name1_escapado , sizeof ( name1_escapado ) );
+    qsnprintf ( address1 , sizeof ( address1 ) , "\"%.8x\"" , funcion1 -> address );
+  }
+  else
+  {
+    name1_escapado [ 0 ] = '\0';
+    qstrncpy ( address1 , "null" , sizeof ( address1 ) );
+  }
+
+/* Armo los datos de funcion2 ( null si no la hay ) */
+  if ( funcion2 != NULL )
+  {
+    get_formated_name ( funcion2 , name2 , NAME_LEN , FALSE );
+    escapar_string_json ( name2 , name2_escapado , sizeof ( name2_escapado ) );
+    qsnprintf ( address2 , sizeof ( address2 ) , "\"%.8x\"" , funcion2 -> address );
+  }
+  else
+  {
+    name2_escapado [ 0 ] = '\0';
+    qstrncpy ( address2 , "null" , sizeof ( address2 ) );
+  }
+
+/* Emito un registro por linea */
+  qfprintf ( f_stream_resultados , "{ \"category\": \"%s\", \"address1\": %s, \"address2\": %s, \"name1\": \"%s\", \"name2\": \"%s\", \"phase\": \"%s\", \"score\": %u }\n" , categoria , address1 , address2 , name1_escapado , name2_escapado , fase_actual -> nombre , puntaje );
+
+/* Lo dejo disponible para quien este leyendo el stream */
+  qflush ( f_stream_resultados );
+}
+
+/****************************************************************************/ 
+
+void get_formated_name ( Funcion *funcion , char *name , unsigned int len , int fill )
+{
+/* Si la funcion tiene un nombre demangleado */
+  if ( strlen ( funcion -> demangled_name ) > 0 )
+  {
+  /* Escribo el nombre de la funcion en el buffer */
+    qstrncpy ( name , funcion -> demangled_name , len );
+  }
+/* Si la funcion NO tiene un nombre que se puede demanglear */
+  else
+  {
+  /* Escribo el nombre de la funcion en el buffer */
+    qstrncpy ( name , funcion -> name , len );
+  }
+
+/* Si tengo que completar el nombre de la funcion con espacios */
+  if ( fill == TRUE )
+  {
+  /* Relleno lo que falta con espacios en blanco */
+    memset ( &name [ strlen ( name ) ] , ' ' , len - strlen ( name ) - 1 );
+
+  /* Pongo el fin de string */
+    name [ len - 1 ] = '\x00';
+  }
+}
+
+/****************************************************************************/ 
+
+int levantar_funciones ( FILE *f , List &indice_funciones , List &funciones )
+{
+  Grafo_Programa *grafo;
+  Funcion *funcion;
+  unsigned int posicion_inicial;
+  unsigned int pos;
+  unsigned int cont;
+  int err;
+  int ret = TRUE;
+
+/* El progreso de la carga se mide en bytes del archivo */
+  posicion_inicial = qftell ( f );
+  qfseek ( f , 0 , SEEK_END );
+  fijar_total_progreso ( qftell ( f ) );
+  fijar_avance_progreso ( posicion_inicial );
+  qfseek ( f , posicion_inicial , SEEK_SET );
+
+/* Si la lista tenia un grafo armado, deja de ser valido */
+  grafo = get_grafo_de_lista ( funciones );
+
+  if ( grafo != NULL )
+  {
+    liberar_grafo_programa ( grafo );
+  }
+
+/* Mientras haya funciones por leer */
+  while ( 1 )
+  {
+  /* Alloco espacio para la funcion a cargar */
+    funcion = ( Funcion * ) malloc ( sizeof ( Funcion ) );
+
+  /* Levanto la funcion del archivo */
+    err = qfread ( f , funcion , sizeof ( Funcion ) );
+
+  /* Si llegue al final del archivo o la carga fue cancelada */
+    if ( ( err == 0 ) || ( avanzar_progreso ( 0 ) == FALSE ) )
+    {
+    /* Libero la funcion que no llegue a cargar */
+      free ( funcion );
+
+    /* Corto la busqueda */
+      break;
+    }
+
+  /* Levanto los basic blocks y las referencias de la funcion */
+    levantar_cuerpo_de_funcion ( f , funcion );
+
+  /* Genero la ecuacion que representa al grafo de la funcion */
+    funcion -> graph_ecuation = generar_ecuacion_de_grafo_de_funcion ( funcion );
+
+  /* Calculo la firma del grafo ( no depende del orden de los saltos ) */
+    funcion -> hash_grafo = calcular_hash_de_grafo ( funcion );
+
+  /* La funcion todavia no pertenece a ningun grafo de programa */
+    funcion -> grafo = NULL;
+
+  /* Agrego la direccion de la funcion a la lista */
+    indice_funciones.Add ( ( void * ) funcion -> address );
+
+  /* Agrego la funcion a la lista */
+    funciones.Add ( funcion );
+
+  /* Cuento los bytes levantados */
+    fijar_avance_progreso ( qftell ( f ) );
+  }
+
+/* Si la carga fue cancelada, las funciones levantadas no se usan para comparar */
+  if ( is_operacion_cancelada () == TRUE )
+  {
+  /* Dejo los basic blocks padres sin linkear ( sus funciones pueden no estar cargadas ) */
+    for ( pos = 0 ; pos < funciones.Len () ; pos ++ )
+    {
+      funcion = ( Funcion * ) funciones.Get ( pos );
+
+      for ( cont = 0 ; cont < funcion -> cantidad_referencias_padre ; cont ++ )
+      {
+        funcion -> basic_blocks_padres [ cont ].funcion = NULL;
+      }
+    }
+
+  /* Retorno ERROR */
+    return ( FALSE );
+  }
+
+/* Resuelvo todas las conexiones entre los basic blocks padres y sus funciones */
+/* Recorro toda la lista de funciones */
+  for ( pos = 0 ; pos < funciones.Len () ; pos ++ )
+  {
+  /* Linkeo los basic blocks padres de la siguiente funcion */
+    linkear_basic_blocks_padres ( indice_funciones , funciones , ( Funcion * ) funciones.Get ( pos ) );
+
+  /* Construyo el filtro de la funcion ( ya estan todas las funciones hijas ) */
+    construir_filtro_de_funcion ( indice_funciones , funciones , ( Funcion * ) funciones.Get ( pos ) );
+  }
+
+  return ( ret );
+}
+
+/****************************************************************************/
+
+int levantar_cuerpo_de_funcion ( FILE *f , Funcion *funcion )
+{
+  unsigned int cont, cont2;
+  unsigned int referencia_hija;
+  int ret = TRUE;
+
+/* Alloco espacio y guardo los basic blocks */
+  funcion -> basic_blocks = ( Basic_Block ** ) malloc ( sizeof ( Basic_Block * ) * funcion -> cantidad_basic_blocks );
+
+/* Levanto basic block a basic block */
+  for ( cont = 0 ; cont < funcion -> cantidad_basic_blocks ; cont ++ )
+  {
+  /* Alloco espacio para un basic block mas */
+    funcion -> basic_blocks [ cont ] = ( Basic_Block * ) malloc ( sizeof ( Basic_Block ) );
+
+  /* Levanto el basic block a la memoria */
+    qfread ( f , funcion -> basic_blocks [ cont ] , sizeof ( Basic_Block ) );
+
+  /* Creo la lista PERSISTENTE que contiene los basic blocks hijos */
+    funcion -> basic_blocks [ cont ] -> basic_blocks_hijos = new ( List );
+
+  /* Levanto la lista */
+    funcion -> basic_blocks [ cont ] -> basic_blocks_hijos -> Load ( f );
+
+  /* Inicializo la lista de llamados a funciones */
+    funcion -> basic_blocks [ cont ] -> funciones_hijas = new ( List );
+
+  /* Levanto los llamados a funciones del basic block */
+    for ( cont2 = 0 ; cont2 < funcion -> basic_blocks [ cont ] -> cantidad_referencias ; cont2 ++ )
+    {
+    /* Levanto el siguiente llamado */
+      qfread ( f , &referencia_hija , sizeof ( unsigned int ) ); 
+
+    /* Agrego el llamado a la lista */
+      funcion -> basic_blocks [ cont ] -> funciones_hijas -> Add ( ( void * ) referencia_hija );
+    }
+
+  /* Creo la lista PERSISTENTE para contener los punteros a funciones */
+    funcion -> basic_blocks [ cont ] -> ptr_funciones_hijas = new ( List );
+
+  /* Levanto los punteros a funciones ( vtables ) del basic block */
+    funcion -> basic_blocks [ cont ] -> ptr_funciones_hijas -> Load ( f );
+
+  /* Creo la lista con la cadena de basic blocks */
+    funcion -> basic_blocks [ cont ] -> cadena_basic_blocks = new ( List );
+
+  /* Levanto la cadena de basic blocks */
+    funcion -> basic_blocks [ cont ] -> cadena_basic_blocks -> Load ( f );
+
+  /* Creo la lista con las anclas del basic block */
+    funcion -> basic_blocks [ cont ] -> anclas = new ( List );
+
+  /* Levanto las anclas del basic block */
+    funcion -> basic_blocks [ cont ] -> anclas -> Load ( f );
+  }
+
+/* Levanto todas las referencias padre */
+  funcion -> basic_blocks_padres = ( Basic_Block_Padre * ) malloc ( funcion -> cantidad_referencias_padre * sizeof ( Basic_Block_Padre ) );
+  qfread ( f , funcion -> basic_blocks_padres , funcion -> cantidad_referencias_padre * sizeof ( Basic_Block_Padre ) );
+
+/* Levanto todas las referencias a traves de vtables */
+  funcion -> referencias_padre_x_vtable = new ( List );
+  funcion -> referencias_padre_x_vtable -> Load ( f );
+
+  return ( ret );
+}
+
+/****************************************************************************/
+
+void linkear_basic_blocks_padres ( List &indice_funciones , List &funciones , Funcion *funcion )
+{
+  Funcion *funcion_padre;
+  unsigned int pos;
+
+/* Recorro todos los basic blocks padres */
+  for ( pos = 0 ; pos < funcion -> cantidad_referencias_padre ; pos ++ )
+  {
+  /* Busco la funcion padre */
+    funcion_padre = get_estructura_funcion2 ( indice_funciones , funciones , funcion -> basic_blocks_padres [ pos ].direccion_funcion );
+
+  /* Mensaje para chequear ERRORES */  
+    if ( funcion_padre == NULL )
+    {
+      my_msg ( "Warning: parent function %x doesn't exist\n" , funcion -> basic_blocks_padres [ pos ].direccion_funcion );
+    }
+
+  /* Linkeo el basic block padre con la funcion padre */
+    funcion -> basic_blocks_padres [ pos ].funcion = funcion_padre;
+  }
+}
+
+/****************************************************************************/
+
+int levantar_indice_de_funciones ( FILE *f , List &indice_funciones , List &funciones , List &posiciones )
+{
+  Grafo_Programa *grafo;
+  Funcion *funcion;
+  int err;
+  int ret = TRUE;
+
+/* Si la lista tenia un grafo armado, deja de ser valido */
+  grafo = get_grafo_de_lista ( funciones );
+
+  if ( grafo != NULL )
+  {
+    liberar_grafo_programa ( grafo );
+  }
+
+/* Mientras haya funciones por leer */
+  while ( 1 )
+  {
+  /* Alloco espacio para la funcion a cargar */
+    funcion = ( Funcion * ) malloc ( sizeof ( Funcion ) );
+
+  /* Levanto SOLO la cabecera de la funcion */
+    err = qfread ( f , funcion , sizeof ( Funcion ) );
+
+  /* Si llegue al final del archivo */
+    if ( err == 0 )
+    {
+    /* Libero la funcion que no llegue a usar */
+      free ( funcion );
+
+    /* Corto la busqueda */
+      break;
+    }
+
+  /* Guardo la posicion del file donde empieza el cuerpo de la funcion */
+    posiciones.Add ( ( void * ) qftell ( f ) );
+
+  /* Salteo los basic blocks y las referencias de la funcion */
+    saltear_cuerpo_de_funcion ( f , funcion );
+
+  /* Marco a la funcion como NO levantada */
+    funcion -> basic_blocks = NULL;
+    funcion -> basic_blocks_padres = NULL;
+    funcion -> referencias_padre_x_vtable = NULL;
+    funcion -> graph_ecuation = NULL;
+    funcion -> hash_grafo = 0;
+    funcion -> grafo = NULL;
+    memset ( funcion -> filtro , 0 , sizeof ( funcion -> filtro ) );
+
+  /* Agrego la direccion de la funcion a la lista */
+    indice_funciones.Add ( ( void * ) funcion -> address );
+
+  /* Agrego la funcion a la lista */
+    funciones.Add ( funcion );
+  }
+
+  return ( ret );
+}
+
+/****************************************************************************/
+
+int saltear_cuerpo_de_funcion ( FILE *f , Funcion *funcion )
+{
+  Basic_Block basic_block;
+  unsigned int cont;
+  int ret = TRUE;
+
+/* Recorro basic block a basic block */
+  for ( cont = 0 ; cont < funcion -> cantidad_basic_blocks ; cont ++ )
+  {
+  /* Levanto el basic block para saber cuantos llamados tiene */
+    qfread ( f , &basic_block , sizeof ( Basic_Block ) );
+
+  /* Salteo los basic blocks hijos */
+    List::Skip ( f );
+
+  /* Salteo los llamados a funciones del basic block */
+    qfseek ( f , basic_block.cantidad_referencias * sizeof ( unsigned int ) , SEEK_CUR );
+
+  /* Salteo los punteros a funciones ( vtables ) del basic block */
+    List::Skip ( f );
+
+  /* Salteo la cadena de basic blocks */
+    List::Skip ( f );
+
+  /* Salteo las anclas del basic block */
+    List::Skip ( f );
+  }
+
+/* Salteo todas las referencias padre */
+  qfseek ( f , funcion -> cantidad_referencias_padre * sizeof ( Basic_Block_Padre ) , SEEK_CUR );
+
+/* Salteo todas las referencias a traves de vtables */
+  List::Skip ( f );
+
+  return ( ret );
+}
+
+/****************************************************************************/
+
+int levantar_funcion_por_demanda ( FILE *f , List &indice_funciones , List &funciones , List &posiciones , Funcion *funcion )
+{
+  unsigned int posicion;
+  unsigned int pos;
+  int ret = TRUE;
+
+/* Si la funcion ya fue levantada */
+  if ( funcion -> basic_blocks != NULL )
+  {
+  /* No hay nada que hacer */
+    return ( TRUE );
+  }
+
+/* Si la funcion NO esta en el indice */
+  if ( indice_funciones.GetPos ( ( void * ) funcion -> address , &pos ) == FALSE )
+  {
+  /* Retorno ERROR */
+    return ( FALSE );
+  }
+
+/* Obtengo la posicion del cuerpo de la funcion en el file */
+  posicion = ( unsigned int ) posiciones.Get ( pos );
+
+/* Me posiciono en el cuerpo de la funcion */
+  qfseek ( f , posicion , SEEK_SET );
+
+/* Levanto los basic blocks y las referencias de la funcion */
+  levantar_cuerpo_de_funcion ( f , funcion );
+
+/* Genero la ecuacion que representa al grafo de la funcion */
+  funcion -> graph_ecuation = generar_ecuacion_de_grafo_de_funcion ( funcion );
+
+/* Calculo la firma del grafo */
+  funcion -> hash_grafo = calcular_hash_de_grafo ( funcion );
+
+/* Linkeo los basic blocks padres con sus funciones */
+  linkear_basic_blocks_padres ( indice_funciones , funciones , funcion );
+
+/* Construyo el filtro de la funcion */
+  construir_filtro_de_funcion ( indice_funciones , funciones , funcion );
+
+  return ( ret );
+}
+
+/****************************************************************************/
+
+int asociar_funciones ( int identica , Funcion *funcion1 , Funcion *funcion2 , List &reconocidas1 , List &reconocidas2 , List &funciones1 , List &funciones2 )
+{
+  Referencia_Vtable *vtable1_padre;
+  Referencia_Vtable *vtable2_padre;
+  unsigned int cont1, cont2;
+  int ret = TRUE;
+
+/* Si la funcion es identica */
+  if ( identica == TRUE )
+  {
+  /* Seteo las funciones como identicas */
+    funcion1 -> identica = TRUE;
+    funcion2 -> identica = TRUE;
+  }
+/* Si la funcion esta patcheada */
+  else
+  {
+  /* Seteo las funciones como patcheadas */
+    funcion1 -> patcheada = TRUE;
+    funcion2 -> patcheada = TRUE;
+  }
+
+/* Relaciono las funciones */
+  funcion1 -> address_equivalente = funcion2 -> address;
+  funcion2 -> address_equivalente = funcion1 -> address;
+
+/* Cuento el matcheo en la fase actual */
+  fase_actual -> matcheos ++;
+
+/* Emito el par ( si hay un stream abierto ) */
+  if ( identica == TRUE )
+  {
+    emitir_registro_resultado ( "identical" , funcion1 , funcion2 , 100 );
+  }
+  else
+  {
+    emitir_registro_resultado ( "changed" , funcion1 , funcion2 , get_similitud_de_filtros ( funcion1 , funcion2 ) );
+  }
+
+/* Agrego las funciones en la listas */
+  reconocidas1.Add ( funcion1 );
+  reconocidas2.Add ( funcion2 );
+
+/* Saco las funciones de las otras listas */
+  funciones1.DeleteElement ( funcion1 );
+  funciones2.DeleteElement ( funcion2 );
+
+  return ( ret );
+}
+
+/****************************************************************************/
+
+int tienen_el_mismo_nombre ( Funcion *funcion1 , Funcion *funcion2 )
+{
+  int ret = FALSE;
+
+/* Cuento el llamado al predicado */
+  fase_actual -> llamados_predicado ++;
+
+/* Si las 2 funciones estan demangleadas */
+  if ( ( strlen ( funcion1 -> demangled_name ) > 0 ) && ( strlen ( funcion2 -> demangled_name ) > 0 ) )
+  {
+  /* Comparo los nombres demangleados */
+    if ( strncmp ( funcion1 -> demangled_name , funcion2 -> demangled_name , NAME_LEN ) == 0 )
+    {
+    /* Retorno OK */
+      ret = TRUE;
+    }
+  }
+/* Si las 2 funciones NO estan demangleadas, comparo el nombre sin demanglear */
+  else if ( strncmp ( funcion1 -> name , funcion2 -> name , NAME_LEN ) == 0 )
+  {
+  /* Retorno OK */
+    ret = TRUE;
+  }
+
+  return ( ret );
+}
+
+/****************************************************************************/
+
+int reconocer_funciones_con_misma_geometria ( List &funciones1_reconocidas , List &funciones2_reconocidas , List &funciones1 , List &funciones2 )
+{
+  Funcion *funcion1;
+  Funcion *funcion2;
+  unsigned int cont, cont2;
+  int ret = TRUE;
+
+/* Recorro todas las funciones de programa1 */
+  for ( cont = 0 ; cont < funciones1.Len () ; cont ++ )
+  {
+  /* Levanto la siguiente funcion */
+    funcion1 = ( Funcion * ) funciones1.Get ( cont );
+
+  /* Si la funcion no es confiable para asociarla con otra por su geometria */
+    if ( funcion1 -> cantidad_basic_blocks == 1 )
+    {
+    /* Sigo con otra funcion */
+      continue;
+    }
+
+  /* Recorro todas las funciones de programa2 */
+    for ( cont2 = 0 ; cont2 < funciones2.Len () ; cont2 ++ )
+    {
+    /* Levanto la siguiente funcion */
+      funcion2 = ( Funcion * ) funciones2.Get ( cont2 );
+
+    /* Si las 2 funciones tienen la misma geometria */
+      if ( strcmp ( funcion1 -> graph_ecuation , funcion2 -> graph_ecuation ) == 0 )
+      {
+//        my_msg ( "pareja formada: %x - %x\n" , funcion1 -> address , funcion2 -> address );
+
+      /* Relaciono las 2 funciones */
+        asociar_funciones ( FALSE , funcion1 , funcion2 , funciones1_reconocidas , funciones2_reconocidas , funciones1 , funciones2 );
+
+      /* Decremento la posicion en la lista para compensar la extraccion del elemento */
+        cont --;
+
+      /* Corto la busqueda */
+        break;
+      }
+    }
+  }
+
+  return ( ret );
+}
+
+/****************************************************************************/
+
+unsigned int reconocer_funciones_x_vtables ( List &funciones1 , List &funciones2 , List &funciones1_irreconocidas , List &funciones2_irreconocidas , List &funciones1_cambiadas , List &funciones2_cambiadas )
+{
+  Funcion *funcion1;
+  Funcion *funcion2;
+  Funcion *funcion1_padre;
+  Funcion *funcion2_padre;
+  Index orden2;
+  Index padres2;
+  Index padres_indexados;
+  Index ranuras;
+  List ranuras_alocadas;
+  unsigned int address_padre;
+  unsigned int address_anterior;
+  unsigned int cont1;
+  unsigned int cont;
+  unsigned int funciones_reconocidas = 0;
+
+/* Indexo la posicion de cada funcion irreconocida de programa2 */
+  for ( cont = 0 ; cont < funciones2_irreconocidas.Len () ; cont ++ )
+  {
+    funcion2 = ( Funcion * ) funciones2_irreconocidas.Get ( cont );
+    orden2.Add ( funcion2 -> address , ( void * ) cont );
+  }
+
+/* Junto los padres x vtable asociados de las funciones irreconocidas de programa1 */
+  for ( cont1 = 0 ; cont1 < funciones1_irreconocidas.Len () ; cont1 ++ )
+  {
+  /* Levanto la siguiente funcion en programa1 */
+    funcion1 = ( Funcion * ) funciones1_irreconocidas.Get ( cont1 );
+
+  /* Recorro todas las referencias padre x vtables */
+    for ( cont = 0 ; cont < funcion1 -> referencias_padre_x_vtable -> Len () ; cont ++ )
+    {
+    /* Obtengo la funcion padre */
+      address_padre = ( unsigned int ) funcion1 -> referencias_padre_x_vtable -> Get ( cont );
+      funcion1_padre = get_estructura_funcion ( funciones1 , address_padre );
+
+    /* Si la funcion padre se asocio con alguna */
+      if ( funcion1_padre -> identica == TRUE || funcion1_padre -> patcheada == TRUE )
+      {
+      /* Me guardo la pareja de la funcion padre */
+        padres2.Add ( funcion1_padre -> address_equivalente , NULL );
+      }
+    }
+  }
+
+/* Indexo de una vez las vtables de cada padre de programa2 asociado hasta ahora */
+/* ( los padres que se asocien durante la pasada se indexan cuando se los busca ) */
+  address_anterior = BADADDR;
+
+  for ( cont = 0 ; cont < padres2.Len () ; cont ++ )
+  {
+  /* Si el padre ya fue indexado */
+    if ( padres2.GetKey ( cont ) == address_anterior )
+    {
+      continue;
+    }
+
+  /* Marco el padre como indexado ( las claves llegan ordenadas ) */
+    address_anterior = padres2.GetKey ( cont );
+    padres_indexados.Add ( address_anterior , NULL );
+
+  /* Indexo las ranuras de sus vtables */
+    funcion2_padre = get_estructura_funcion ( funciones2 , address_anterior );
+    indexar_ranuras_de_vtables ( funcion2_padre , ranuras , ranuras_alocadas );
+  }
+
+/* Recorro todas las funciones irreconocidas */
+  fijar_total_progreso ( funciones1_irreconocidas.Len () );
+
+  for ( cont1 = 0 ; cont1 < funciones1_irreconocidas.Len () ; cont1 ++ )
+  {
+  /* Si la operacion fue cancelada, me quedo con lo asociado hasta ahora */
+    if ( avanzar_progreso ( 1 ) == FALSE )
+    {
+      break;
+    }
+
+  /* Levanto la siguiente funcion en programa1 */
+    funcion1 = ( Funcion * ) funciones1_irreconocidas.Get ( cont1 );
+
+  /* Si la funcion NO tiene referencias padre x vtable */
+    if ( funcion1 -> referencias_padre_x_vtable -> Len () == 0 )
+    {
+    /* Sigo buscando */
+      continue;
+    }
+
+  /* Busco la pareja en las mismas ranuras de las vtables equivalentes */
+    funcion2 = get_pareja_x_vtables ( funciones1 , funciones2 , ranuras , orden2 , padres_indexados , ranuras_alocadas , funcion1 );
+
+  /* Si encontre una funcion equivalente */
+    if ( funcion2 != NULL )
+    {
+//      my_msg ( "igual_x_vtable: %x - %x\n" , funcion1 -> address , funcion2 -> address );
+
+    /* Asocio las funciones */
+      asociar_funciones ( FALSE , funcion1 , funcion2 , funciones1_cambiadas , funciones2_cambiadas , funciones1_irreconocidas , funciones2_irreconocidas );
+
+    /* Compenso la extraccion de la lista */
+      cont1 --;
+
+    /* Aumento la cantidad de funciones reconocidas */
+      funciones_reconocidas ++;
+    }
+  }
+
+/* Libero las ranuras indexadas */
+  for ( cont = 0 ; cont < ranuras_alocadas.Len () ; cont ++ )
+  {
+    free ( ranuras_alocadas.Get ( cont ) );
+  }
+
+  return ( funciones_reconocidas );
+}
+
+/****************************************************************************/
+
+Funcion *get_pareja_x_vtables ( List &funciones1 , List &funciones2 , Index &ranuras , Index &orden2 , Index &padres_indexados , List &ranuras_alocadas , Funcion *funcion1 )
+{
+  Ranura_Vtable *ranura;
+  Funcion *funcion1_padre;
+  Funcion *funcion2_padre;
+  Funcion *funcion2;
+  Funcion *mejor_funcion = NULL;
+  Basic_Block *basic_block1_padre;
+  unsigned int mejor_orden = SIN_PAREJA;
+  unsigned int address_padre;
+  unsigned int clave;
+  unsigned int largo;
+  unsigned int cont, cont1;
+  unsigned int pos;
+  unsigned int pos_padre;
+  unsigned int pos_ranura;
+  unsigned int pos_orden;
+
+/* Cuento el llamado al predicado */
+  fase_actual -> llamados_predicado ++;
+
+/* Recorro todas las referencias padre x vtables */
+  for ( cont = 0 ; cont < funcion1 -> referencias_padre_x_vtable -> Len () ; cont ++ )
+  {
+  /* Levanto la siguiente direccion */
+    address_padre = ( unsigned int ) funcion1 -> referencias_padre_x_vtable -> Get ( cont );
+
+  /* Obtengo la funcion padre */
+    funcion1_padre = get_estructura_funcion ( funciones1 , address_padre );
+
+  /* Si la funcion padre NO se asocio con ninguna */
+    if ( funcion1_padre -> identica == FALSE && funcion1_padre -> patcheada == FALSE )
+    {
+      continue;
+    }
+
+  /* Obtengo la pareja de funcion1 padre */
+    funcion2_padre = get_estructura_funcion ( funciones2 , funcion1_padre -> address_equivalente );
+
+  /* Si el padre se asocio durante esta pasada, todavia no indexe sus vtables */
+    if ( padres_indexados.Find ( funcion2_padre -> address , &pos_padre ) == FALSE )
+    {
+    /* Marco el padre como indexado */
+      padres_indexados.Add ( funcion2_padre -> address , NULL );
+
+    /* Indexo las ranuras de sus vtables */
+      indexar_ranuras_de_vtables ( funcion2_padre , ranuras , ranuras_alocadas );
+    }
+
+  /* Recorro todos los basic blocks de funcion1 padre */
+    for ( cont1 = 0 ; cont1 < funcion1_padre -> cantidad_basic_blocks ; cont1 ++ )
+    {
+    /* Levanto el siguiente basic block */
+      basic_block1_padre = funcion1_padre -> basic_blocks [ cont1 ];
+
+    /* Si la funcion NO esta en la VTABLE de este basic block */
+      if ( basic_block1_padre -> ptr_funciones_hijas -> GetPos ( ( void * ) funcion1 -> address , &pos ) == FALSE )
+      {
+      /* Sigo buscando */
+        continue;
+      }
+
+    /* Busco la misma ranura en las vtables del mismo largo del padre equivalente */
+      largo = basic_block1_padre -> ptr_funciones_hijas -> Len ();
+      clave = get_clave_de_ranura ( funcion2_padre -> address , largo , pos );
+
+    /* Si no hay ranuras con esa clave */
+      if ( ranuras.Find ( clave , &pos_ranura ) == FALSE )
+      {
+        continue;
+      }
+
+    /* Recorro las ranuras con la misma clave */
+      for ( ; ( pos_ranura < ranuras.Len () ) && ( ranuras.GetKey ( pos_ranura ) == clave ) ; pos_ranura ++ )
+      {
+      /* Levanto la siguiente ranura */
+        ranura = ( Ranura_Vtable * ) ranuras.Get ( pos_ranura );
+
+      /* Si es una colision de la clave */
+        if ( ( ranura -> padre != funcion2_padre -> address ) || ( ranura -> largo != largo ) || ( ranura -> ranura != pos ) )
+        {
+          continue;
+        }
+
+      /* Si la funcion apuntada NO es una irreconocida de programa2 */
+        if ( orden2.Find ( ranura -> funcion , &pos_orden ) == FALSE )
+        {
+          continue;
+        }
+
+      /* Cuento el par examinado */
+        fase_actual -> pares_examinados ++;
+
+      /* Levanto la funcion apuntada */
+        funcion2 = get_estructura_funcion ( funciones2 , ranura -> funcion );
+
+      /* Si ya fue asociada o NO tiene referencias padre x vtable */
+        if ( ( funcion2 -> address_equivalente != BADADDR ) || ( funcion2 -> referencias_padre_x_vtable -> Len () == 0 ) )
+        {
+          continue;
+        }
+
+      /* Me quedo con la primera en el orden de las irreconocidas */
+        if ( ( unsigned int ) orden2.Get ( pos_orden ) < mejor_orden )
+        {
+          mejor_orden = ( unsigned int ) orden2.Get ( pos_orden );
+          mejor_funcion = funcion2;
+        }
+      }
+    }
+  }
+
+  return ( mejor_funcion );
+}
+
+/****************************************************************************/
+
+void indexar_ranuras_de_vtables ( Funcion *funcion_padre , Index &ranuras , List &ranuras_alocadas )
+{
+  Basic_Block *basic_block;
+  Ranura_Vtable *ranura;
+  unsigned int largo;
+  unsigned int cont, cont2;
+
+/* Recorro todos los basic blocks de la funcion padre */
+  for ( cont = 0 ; cont < funcion_padre -> cantidad_basic_blocks ; cont ++ )
+  {
+  /* Levanto el siguiente basic block */
+    basic_block = funcion_padre -> basic_blocks [ cont ];
+    largo = basic_block -> ptr_funciones_hijas -> Len ();
+
+  /* Si el basic block NO tiene asociada una VTABLE */
+    if ( largo == 0 )
+    {
+      continue;
+    }
+
+  /* Alloco las ranuras de la vtable */
+    ranura = ( Ranura_Vtable * ) malloc ( largo * sizeof ( Ranura_Vtable ) );
+    ranuras_alocadas.Add ( ( void * ) ranura );
+
+  /* Indexo cada ranura de la vtable */
+    for ( cont2 = 0 ; cont2 < largo ; cont2 ++ )
+    {
+      ranura [ cont2 ].padre = funcion_padre -> address;
+      ranura [ cont2 ].largo = largo;
+      ranura [ cont2 ].ranura = cont2;
+      ranura [ cont2 ].funcion = ( unsigned int ) basic_block -> ptr_funciones_hijas -> Get ( cont2 );
+      ranuras.Add ( get_clave_de_ranura ( funcion_padre -> address , largo , cont2 ) , ( void * ) &ranura [ cont2 ] );
+    }
+  }
+}
+
+/****************************************************************************/
+
+unsigned int get_clave_de_ranura ( unsigned int padre , unsigned int largo , unsigned int ranura )
+{
+  unsigned int clave = HASH_INICIAL;
+
+/* Mezclo el padre, el largo y la posicion */
+  clave = calcular_hash ( clave , &padre , sizeof ( unsigned int ) );
+  clave = calcular_hash ( clave , &largo , sizeof ( unsigned int ) );
+  clave = calcular_hash ( clave , &ranura , sizeof ( unsigned int ) );
+
+  return ( clave );
+}
+
+/****************************************************************************/
+
+unsigned int reconocer_funciones_x_call_graph ( List &funciones1 , List &funciones2 , List &funciones1_irreconocidas , List &funciones2_irreconocidas , List &funciones1_cambiadas , List &funciones2_cambiadas )
+{
+  Grafo_Disperso grafo1;
+  Grafo_Disperso grafo2;
+  Funcion *funcion1;
+  Funcion *funcion2;
+  Index direcciones2;
+  unsigned int *parejas1;
+  unsigned int *parejas2;
+  unsigned int *mejores1;
+  unsigned int *mejores2;
+  unsigned int *votos;
+  unsigned int funciones_reconocidas = 0;
+  unsigned int reconocidas_en_pasada;
+  unsigned int pasada;
+  unsigned int pos;
+  unsigned int pos2;
+
+/* Armo los call graphs de los 2 programas */
+  armar_grafo_disperso ( funciones1 , &grafo1 );
+  armar_grafo_disperso ( funciones2 , &grafo2 );
+
+/* Alloco las parejas, los mejores candidatos y los votos de cada nodo */
+  parejas1 = ( unsigned int * ) malloc ( ( grafo1.cantidad_nodos + 1 ) * sizeof ( unsigned int ) );
+  parejas2 = ( unsigned int * ) malloc ( ( grafo2.cantidad_nodos + 1 ) * sizeof ( unsigned int ) );
+  mejores1 = ( unsigned int * ) malloc ( ( grafo1.cantidad_nodos + 1 ) * sizeof ( unsigned int ) );
+  mejores2 = ( unsigned int * ) malloc ( ( grafo2.cantidad_nodos + 1 ) * sizeof ( unsigned int ) );
+  votos = ( unsigned int * ) malloc ( ( grafo1.cantidad_nodos + grafo2.cantidad_nodos + 1 ) * sizeof ( unsigned int ) );
+  memset ( votos , 0 , ( grafo1.cantidad_nodos + grafo2.cantidad_nodos + 1 ) * sizeof ( unsigned int ) );
+
+/* Indexo las funciones de programa2 por direccion */
+  for ( pos = 0 ; pos < funciones2.Len () ; pos ++ )
+  {
+    direcciones2.Add ( ( ( Funcion * ) funciones2.Get ( pos ) ) -> address , ( void * ) pos );
+  }
+
+/* Inicialmente ninguna funcion tiene pareja */
+  memset ( parejas2 , 0xff , ( grafo2.cantidad_nodos + 1 ) * sizeof ( unsigned int ) );
+
+/* Seteo las parejas de las funciones ya asociadas */
+  for ( pos = 0 ; pos < funciones1.Len () ; pos ++ )
+  {
+  /* Levanto la siguiente funcion */
+    funcion1 = ( Funcion * ) funciones1.Get ( pos );
+    parejas1 [ pos ] = SIN_PAREJA;
+
+  /* Si la funcion esta asociada con una de programa2 */
+    if ( ( funcion1 -> address_equivalente != BADADDR ) && ( direcciones2.Find ( funcion1 -> address_equivalente , &pos2 ) == TRUE ) )
+    {
+    /* Relaciono los nodos */
+      parejas1 [ pos ] = ( unsigned int ) direcciones2.Get ( pos2 );
+      parejas2 [ parejas1 [ pos ] ] = pos;
+    }
+  }
+
+/* Propago los matcheos hasta que no aparezcan nuevos */
+  fijar_total_progreso ( MAX_PASADAS_PROPAGACION );
+
+  for ( pasada = 0 ; pasada < MAX_PASADAS_PROPAGACION ; pasada ++ )
+  {
+  /* Si la operacion fue cancelada, me quedo con lo asociado hasta ahora */
+    if ( avanzar_progreso ( 1 ) == FALSE )
+    {
+      break;
+    }
+
+  /* Busco el mejor candidato de cada lado */
+    elegir_candidatos_x_vecinos ( &grafo1 , &grafo2 , funciones1 , funciones2 , parejas1 , parejas2 , mejores1 , votos );
+    elegir_candidatos_x_vecinos ( &grafo2 , &grafo1 , funciones2 , funciones1 , parejas2 , parejas1 , mejores2 , votos );
+
+  /* Inicializo el contador de la pasada */
+    reconocidas_en_pasada = 0;
+
+  /* Recorro todas las funciones de programa1 */
+    for ( pos = 0 ; pos < grafo1.cantidad_nodos ; pos ++ )
+    {
+    /* Si la funcion NO tiene candidato o NO es el mejor candidato de su candidato */
+      if ( ( mejores1 [ pos ] == SIN_PAREJA ) || ( mejores2 [ mejores1 [ pos ] ] != pos ) )
+      {
+      /* Sigo con la proxima */
+        continue;
+      }
+
+    /* Levanto las 2 funciones */
+      funcion1 = ( Funcion * ) funciones1.Get ( pos );
+      funcion2 = ( Funcion * ) funciones2.Get ( mejores1 [ pos ] );
+
+    /* Si las funciones no se parecen ( los votos solos pueden encadenar matcheos falsos ) */
+      fase_actual -> llamados_predicado ++;
+
+      if ( ( son_tamanos_compatibles ( funcion1 , funcion2 ) == FALSE ) || ( son_filtros_compatibles ( funcion1 , funcion2 ) == FALSE ) )
+      {
+      /* Sigo con la proxima */
+        continue;
+      }
+
+    /* Asocio las funciones */
+      asociar_funciones ( FALSE , funcion1 , funcion2 , funciones1_cambiadas , funciones2_cambiadas , funciones1_irreconocidas , funciones2_irreconocidas );
+
+    /* Relaciono los nodos */
+      parejas1 [ pos ] = mejores1 [ pos ];
+      parejas2 [ mejores1 [ pos ] ] = pos;
+
+    /* Aumento la cantidad de funciones reconocidas */
+      reconocidas_en_pasada ++;
+    }
+
+  /* Acumulo las funciones reconocidas */
+    funciones_reconocidas += reconocidas_en_pasada;
+
+  /* Si la pasada NO reconocio ninguna funcion */
+    if ( reconocidas_en_pasada == 0 )
+    {
+    /* El matcheo convergio */
+      break;
+    }
+  }
+
+/* Libero todo */
+  free ( parejas1 );
+  free ( parejas2 );
+  free ( mejores1 );
+  free ( mejores2 );
+  free ( votos );
+  liberar_grafo_disperso ( &grafo1 );
+  liberar_grafo_disperso ( &grafo2 );
+
+  return ( funciones_reconocidas );
+}
+
+/****************************************************************************/
+
+void elegir_candidatos_x_vecinos ( Grafo_Disperso *origen , Grafo_Disperso *destino , List &funciones_origen , List &funciones_destino , unsigned int *parejas_origen , unsigned int *parejas_destino , unsigned int *mejores , unsigned int *votos )
+{
+  List tocados;
+  Funcion *funcion_origen;
+  Funcion *candidato;
+  unsigned int *inicio_origen;
+  unsigned int *vecinos_origen;
+  unsigned int *inicio_destino;
+  unsigned int *vecinos_destino;
+  unsigned int vecino;
+  unsigned int pareja;
+  unsigned int puntaje;
+  unsigned int mejor_puntaje;
+  int empatado;
+  unsigned int direccion;
+  unsigned int nodo;
+  unsigned int cont, cont2;
+
+/* Recorro todos los nodos de origen */
+  for ( nodo = 0 ; nodo < origen -> cantidad_nodos ; nodo ++ )
+  {
+  /* Inicialmente el nodo no tiene candidato */
+    mejores [ nodo ] = SIN_PAREJA;
+
+  /* Si el nodo ya tiene pareja */
+    if ( parejas_origen [ nodo ] != SIN_PAREJA )
+    {
+    /* Sigo con el proximo */
+      continue;
+    }
+
+  /* Voto por los vecinos de las parejas de mis vecinos ( hijos y padres ) */
+    for ( direccion = 0 ; direccion < 2 ; direccion ++ )
+    {
+    /* Elijo las funciones llamadas o las que llaman */
+      inicio_origen = ( direccion == 0 ) ? origen -> inicio_hijos : origen -> inicio_padres;
+      vecinos_origen = ( direccion == 0 ) ? origen -> hijos : origen -> padres;
+      inicio_destino = ( direccion == 0 ) ? destino -> inicio_hijos : destino -> inicio_padres;
+      vecinos_destino = ( direccion == 0 ) ? destino -> hijos : destino -> padres;
+
+    /* Recorro los vecinos del nodo */
+      for ( cont = inicio_origen [ nodo ] ; cont < inicio_origen [ nodo + 1 ] ; cont ++ )
+      {
+      /* Levanto la pareja del vecino */
+        pareja = parejas_origen [ vecinos_origen [ cont ] ];
+
+      /* Si el vecino no tiene pareja o es una funcion con demasiados vecinos */
+        if ( ( pareja == SIN_PAREJA ) || ( inicio_destino [ pareja + 1 ] - inicio_destino [ pareja ] > MAX_GRADO_PROPAGACION ) )
+        {
+        /* No aporta evidencia */
+          continue;
+        }
+
+      /* Voto por los vecinos de la pareja que no tienen pareja */
+        for ( cont2 = inicio_destino [ pareja ] ; cont2 < inicio_destino [ pareja + 1 ] ; cont2 ++ )
+        {
+        /* Levanto el siguiente vecino */
+          vecino = vecinos_destino [ cont2 ];
+
+        /* Si el vecino ya tiene pareja */
+          if ( parejas_destino [ vecino ] != SIN_PAREJA )
+          {
+            continue;
+          }
+
+        /* Cuento el par examinado */
+          fase_actual -> pares_examinados ++;
+
+        /* Si es el primer voto del vecino */
+          if ( votos [ vecino ] == 0 )
+          {
+            tocados.Add ( ( void * ) vecino );
+          }
+
+        /* Sumo el voto */
+          votos [ vecino ] ++;
+        }
+      }
+    }
+
+  /* Busco el candidato con mas votos */
+    funcion_origen = ( Funcion * ) funciones_origen.Get ( nodo );
+    mejor_puntaje = 0;
+    empatado = FALSE;
+
+    for ( cont = 0 ; cont < tocados.Len () ; cont ++ )
+    {
+    /* Levanto el siguiente candidato */
+      vecino = ( unsigned int ) tocados.Get ( cont );
+      candidato = ( Funcion * ) funciones_destino.Get ( vecino );
+
+    /* Los votos pesan mas que la forma de la funcion */
+      puntaje = votos [ vecino ] * 4;
+
+    /* Desempato por la forma de la funcion */
+      fase_actual -> llamados_predicado ++;
+      puntaje += ( candidato -> cantidad_basic_blocks == funcion_origen -> cantidad_basic_blocks ) ? 2 : 0;
+      puntaje += ( candidato -> hash_grafo == funcion_origen -> hash_grafo ) ? 1 : 0;
+
+    /* Reseteo el voto para el proximo nodo */
+      votos [ vecino ] = 0;
+
+    /* Si es el mejor candidato hasta ahora */
+      if ( puntaje > mejor_puntaje )
+      {
+        mejor_puntaje = puntaje;
+        mejores [ nodo ] = vecino;
+        empatado = FALSE;
+      }
+    /* Si empata con el mejor */
+      else if ( puntaje == mejor_puntaje )
+      {
+        empatado = TRUE;
+      }
+    }
+
+  /* Si hay mas de un candidato igual de bueno, no elijo ninguno */
+    if ( empatado == TRUE )
+    {
+      mejores [ nodo ] = SIN_PAREJA;
+    }
+
+  /* Limpio los candidatos para el proximo nodo */
+    tocados.Clear ();
+  }
+}
+
+/****************************************************************************/
+
+void armar_grafo_disperso ( List &funciones , Grafo_Disperso *grafo )
+{
+  Funcion *funcion;
+  Basic_Block *basic_block;
+  Index direcciones;
+  List *referencias;
+  unsigned int *llenado;
+  unsigned int cantidad_conexiones = 0;
+  unsigned int siguiente_hijo = 0;
+  unsigned int pasada;
+  unsigned int pos;
+  unsigned int pos_hija;
+  unsigned int hija;
+  unsigned int cont, cont2, cont3;
+
+/* Seteo la cantidad de nodos */
+  grafo -> cantidad_nodos = funciones.Len ();
+
+/* Indexo las funciones por direccion */
+  for ( pos = 0 ; pos < funciones.Len () ; pos ++ )
+  {
+    direcciones.Add ( ( ( Funcion * ) funciones.Get ( pos ) ) -> address , ( void * ) pos );
+  }
+
+/* Alloco los inicios de cada nodo */
+  grafo -> inicio_hijos = ( unsigned int * ) malloc ( ( grafo -> cantidad_nodos + 1 ) * sizeof ( unsigned int ) );
+  grafo -> inicio_padres = ( unsigned int * ) malloc ( ( grafo -> cantidad_nodos + 1 ) * sizeof ( unsigned int ) );
+  llenado = ( unsigned int * ) malloc ( ( grafo -> cantidad_nodos + 1 ) * sizeof ( unsigned int ) );
+  memset ( grafo -> inicio_hijos , 0 , ( grafo -> cantidad_nodos + 1 ) * sizeof ( unsigned int ) );
+  memset ( grafo -> inicio_padres , 0 , ( grafo -> cantidad_nodos + 1 ) * sizeof ( unsigned int ) );
+  grafo -> hijos = NULL;
+  grafo -> padres = NULL;
+
+/* La primera pasada cuenta las conexiones y la segunda las guarda */
+  for ( pasada = 0 ; pasada < 2 ; pasada ++ )
+  {
+  /* Si ya conte las conexiones */
+    if ( pasada == 1 )
+    {
+    /* Convierto las cantidades en posiciones de inicio */
+      for ( pos = 0 , cont = 0 , cont2 = 0 ; pos <= grafo -> cantidad_nodos ; pos ++ )
+      {
+        cont3 = grafo -> inicio_hijos [ pos ];
+        grafo -> inicio_hijos [ pos ] = cont;
+        cont += cont3;
+
+        cont3 = grafo -> inicio_padres [ pos ];
+        grafo -> inicio_padres [ pos ] = cont2;
+        cont2 += cont3;
+      }
+
+    /* Alloco las conexiones */
+      grafo -> hijos = ( unsigned int * ) malloc ( ( cantidad_conexiones + 1 ) * sizeof ( unsigned int ) );
+      grafo -> padres = ( unsigned int * ) malloc ( ( cantidad_conexiones + 1 ) * sizeof ( unsigned int ) );
+
+    /* Los hijos se guardan en orden, los padres van a la proxima posicion libre de cada nodo */
+      memcpy ( llenado , grafo -> inicio_padres , ( grafo -> cantidad_nodos + 1 ) * sizeof ( unsigned int ) );
+    }
+
+  /* Recorro todas las funciones */
+    for ( pos = 0 ; pos < funciones.Len () ; pos ++ )
+    {
+    /* Levanto la siguiente funcion */
+      funcion = ( Funcion * ) funciones.Get ( pos );
+
+    /* Recorro todos los basic blocks */
+      for ( cont = 0 ; cont < funcion -> cantidad_basic_blocks ; cont ++ )
+      {
+      /* Levanto el siguiente basic block */
+        basic_block = funcion -> basic_blocks [ cont ];
+
+      /* Recorro los llamados y las vtables del basic block */
+        for ( cont2 = 0 ; cont2 < 2 ; cont2 ++ )
+        {
+          referencias = ( cont2 == 0 ) ? basic_block -> funciones_hijas : basic_block -> ptr_funciones_hijas;
+
+          for ( cont3 = 0 ; cont3 < referencias -> Len () ; cont3 ++ )
+          {
+          /* Si la funcion referenciada NO esta en el programa */
+            if ( direcciones.Find ( ( unsigned int ) referencias -> Get ( cont3 ) , &pos_hija ) == FALSE )
+            {
+              continue;
+            }
+
+          /* Obtengo el nodo de la funcion referenciada */
+            hija = ( unsigned int ) direcciones.Get ( pos_hija );
+
+          /* Si estoy contando */
+            if ( pasada == 0 )
+            {
+              grafo -> inicio_hijos [ pos ] ++;
+              grafo -> inicio_padres [ hija ] ++;
+              cantidad_conexiones ++;
+            }
+          /* Si estoy guardando */
+            else
+            {
+              grafo -> hijos [ siguiente_hijo ++ ] = hija;
+              grafo -> padres [ llenado [ hija ] ++ ] = pos;
+            }
+          }
+        }
+      }
+    }
+  }
+
+/* Libero el array auxiliar */
+  free ( llenado );
+}
+
+/****************************************************************************/
+
+void liberar_grafo_disperso ( Grafo_Disperso *grafo )
+{
+/* Libero los arrays del grafo */
+  free ( grafo -> inicio_hijos );
+  free ( grafo -> hijos );
+  free ( grafo -> inicio_padres );
+  free ( grafo -> padres );
+}
+
+/****************************************************************************/
+
+void armar_grafo_programa ( List &funciones , Grafo_Programa *grafo )
+{
+  Basic_Block *basic_block;
+  Funcion *funcion;
+  Funcion *funcion_llamada;
+  Index direcciones;
+  Index bloques;
+  unsigned int *siguiente_predecesor;
+  unsigned int primer_basic_block;
+  unsigned int address_hija;
+  unsigned int sucesor;
+  unsigned int cantidad;
+  unsigned int predecesores;
+  unsigned int pos;
+  unsigned int cont, cont2, cont3;
+  int repetido;
+
+/* Libero el grafo anterior */
+  liberar_grafo_programa ( grafo );
+
+/* Alloco la numeracion de las funciones */
+  grafo -> lista_funciones = &funciones;
+  grafo -> cantidad_funciones = funciones.Len ();
+  grafo -> funciones = ( Funcion ** ) malloc ( ( grafo -> cantidad_funciones + 1 ) * sizeof ( Funcion * ) );
+
+/* Numero las funciones */
+  for ( pos = 0 ; pos < funciones.Len () ; pos ++ )
+  {
+  /* Levanto la siguiente funcion */
+    funcion = ( Funcion * ) funciones.Get ( pos );
+
+  /* Le asigno el numero y cuento sus basic blocks */
+    grafo -> funciones [ pos ] = funcion;
+    grafo -> cantidad_basic_blocks += funcion -> cantidad_basic_blocks;
+
+  /* Indexo la funcion por direccion */
+    direcciones.Add ( funcion -> address , funcion );
+  }
+
+/* Dejo el indice de direcciones en orden Eytzinger ( la busqueda baja por el array ) */
+  grafo -> claves_eytzinger = ( unsigned int * ) malloc ( ( grafo -> cantidad_funciones + 1 ) * sizeof ( unsigned int ) );
+  grafo -> funciones_eytzinger = ( Funcion ** ) malloc ( ( grafo -> cantidad_funciones + 1 ) * sizeof ( Funcion * ) );
+  direcciones.Sort ();
+  llenar_indice_eytzinger ( grafo , direcciones , 0 , 1 );
+
+/* Alloco la numeracion de los basic blocks y el comienzo de sus conexiones */
+  grafo -> basic_blocks = ( Basic_Block ** ) malloc ( ( grafo -> cantidad_basic_blocks + 1 ) * sizeof ( Basic_Block * ) );
+  grafo -> inicio_sucesores = ( unsigned int * ) malloc ( ( grafo -> cantidad_basic_blocks + 1 ) * sizeof ( unsigned int ) );
+  grafo -> inicio_predecesores = ( unsigned int * ) malloc ( ( grafo -> cantidad_basic_blocks + 1 ) * sizeof ( unsigned int ) );
+  grafo -> inicio_llamados = ( unsigned int * ) malloc ( ( grafo -> cantidad_basic_blocks + 1 ) * sizeof ( unsigned int ) );
+  grafo -> checksums = ( unsigned int * ) malloc ( ( grafo -> cantidad_basic_blocks + 1 ) * sizeof ( unsigned int ) );
+
+/* Todavia no se visito ningun basic block */
+  grafo -> marcas_visita = ( unsigned int * ) calloc ( grafo -> cantidad_basic_blocks + 1 , sizeof ( unsigned int ) );
+  grafo -> epoca_visita = 1;
+
+/* Las conexiones del primer basic block arrancan al principio */
+  grafo -> inicio_sucesores [ 0 ] = 0;
+  grafo -> inicio_llamados [ 0 ] = 0;
+
+/* Numero los basic blocks ( los de cada funcion quedan contiguos ) */
+  cantidad = 0;
+
+  for ( pos = 0 ; pos < grafo -> cantidad_funciones ; pos ++ )
+  {
+  /* Levanto la siguiente funcion */
+    funcion = grafo -> funciones [ pos ];
+
+  /* Vinculo la funcion con el grafo */
+    funcion -> grafo = grafo;
+    funcion -> indice = pos;
+
+  /* Recorro todos los basic blocks de la funcion */
+    for ( cont = 0 ; cont < funcion -> cantidad_basic_blocks ; cont ++ )
+    {
+    /* Levanto el siguiente basic block */
+      basic_block = funcion -> basic_blocks [ cont ];
+
+    /* Le asigno el numero */
+      basic_block -> indice = cantidad;
+      grafo -> basic_blocks [ cantidad ] = basic_block;
+
+    /* Copio el checksum del basic block */
+      grafo -> checksums [ cantidad ] = basic_block -> checksum;
+
+    /* Cuento los sucesores y los llamados */
+      grafo -> inicio_sucesores [ cantidad + 1 ] = grafo -> inicio_sucesores [ cantidad ] + basic_block -> basic_blocks_hijos -> Len ();
+      grafo -> inicio_llamados [ cantidad + 1 ] = grafo -> inicio_llamados [ cantidad ] + basic_block -> funciones_hijas -> Len ();
+
+    /* Los predecesores se cuentan al resolver los sucesores */
+      grafo -> inicio_predecesores [ cantidad ] = 0;
+
+    /* Indexo el basic block por direccion */
+      bloques.Add ( basic_block -> addr_inicial , ( void * ) cantidad );
+
+    /* Paso al proximo numero */
+      cantidad ++;
+    }
+  }
+
+/* Ordeno el indice de basic blocks */
+  bloques.Sort ();
+
+/* Alloco las conexiones */
+  grafo -> sucesores = ( unsigned int * ) malloc ( ( grafo -> inicio_sucesores [ grafo -> cantidad_basic_blocks ] + 1 ) * sizeof ( unsigned int ) );
+  grafo -> predecesores = ( unsigned int * ) malloc ( ( grafo -> inicio_sucesores [ grafo -> cantidad_basic_blocks ] + 1 ) * sizeof ( unsigned int ) );
+  grafo -> llamados = ( unsigned int * ) malloc ( ( grafo -> inicio_llamados [ grafo -> cantidad_basic_blocks ] + 1 ) * sizeof ( unsigned int ) );
+
+/* Resuelvo los sucesores y los llamados de cada basic block */
+  for ( pos = 0 ; pos < grafo -> cantidad_funciones ; pos ++ )
+  {
+  /* Levanto la siguiente funcion */
+    funcion = grafo -> funciones [ pos ];
+
+  /* Si la funcion no tiene basic blocks */
+    if ( funcion -> cantidad_basic_blocks == 0 )
+    {
+    /* Sigo con la proxima */
+      continue;
+    }
+
+  /* Los sucesores tienen que estar dentro de la misma funcion */
+    primer_basic_block = funcion -> basic_blocks [ 0 ] -> indice;
+
+  /* Recorro todos los basic blocks de la funcion */
+    for ( cont = 0 ; cont < funcion -> cantidad_basic_blocks ; cont ++ )
+    {
+    /* Levanto el siguiente basic block */
+      basic_block = funcion -> basic_blocks [ cont ];
+
+    /* Recorro todos los basic blocks hijos */
+      for ( cont2 = 0 ; cont2 < basic_block -> basic_blocks_hijos -> Len () ; cont2 ++ )
+      {
+      /* Levanto la direccion del siguiente hijo */
+        address_hija = ( unsigned int ) basic_block -> basic_blocks_hijos -> Get ( cont2 );
+        sucesor = SIN_PAREJA;
+
+      /* Si hay basic blocks con esa direccion */
+        if ( bloques.Find ( address_hija , &cont3 ) == TRUE )
+        {
+        /* Busco el que pertenece a la misma funcion */
+          for ( ; ( cont3 < bloques.Len () ) && ( bloques.GetKey ( cont3 ) == address_hija ) ; cont3 ++ )
+          {
+          /* Si el basic block es de la funcion */
+            if ( ( ( unsigned int ) bloques.Get ( cont3 ) >= primer_basic_block ) && ( ( unsigned int ) bloques.Get ( cont3 ) < primer_basic_block + funcion -> cantidad_basic_blocks ) )
+            {
+            /* Me quedo con el sucesor */
+              sucesor = ( unsigned int ) bloques.Get ( cont3 );
+
+            /* Corto la busqueda */
+              break;
+            }
+          }
+        }
+
+      /* Guardo el sucesor en la misma posicion que el hijo */
+        grafo -> sucesores [ grafo -> inicio_sucesores [ basic_block -> indice ] + cont2 ] = sucesor;
+
+      /* Me fijo si ya conte este hijo ( 2 salidas al mismo lugar ) */
+        repetido = FALSE;
+
+        for ( cont3 = 0 ; cont3 < cont2 ; cont3 ++ )
+        {
+        /* Si es el mismo sucesor */
+          if ( grafo -> sucesores [ grafo -> inicio_sucesores [ basic_block -> indice ] + cont3 ] == sucesor )
+          {
+            repetido = TRUE;
+          }
+        }
+
+      /* Si el hijo existe y es la primera vez que lo veo */
+        if ( ( sucesor != SIN_PAREJA ) && ( repetido == FALSE ) )
+        {
+        /* Le cuento un predecesor mas */
+          grafo -> inicio_predecesores [ sucesor ] ++;
+        }
+      }
+
+    /* Recorro todas las funciones llamadas */
+      for ( cont2 = 0 ; cont2 < basic_block -> funciones_hijas -> Len () ; cont2 ++ )
+      {
+      /* Busco la funcion llamada en el grafo */
+        funcion_llamada = buscar_funcion_en_grafo ( grafo , ( unsigned int ) basic_block -> funciones_hijas -> Get ( cont2 ) );
+
+      /* Si la funcion llamada esta en el programa */
+        if ( funcion_llamada != NULL )
+        {
+          grafo -> llamados [ grafo -> inicio_llamados [ basic_block -> indice ] + cont2 ] = funcion_llamada -> indice;
+        }
+        else
+        {
+          grafo -> llamados [ grafo -> inicio_llamados [ basic_block -> indice ] + cont2 ] = SIN_PAREJA;
+        }
+      }
+    }
+  }
+
+/* Alloco la proxima posicion libre de los predecesores de cada basic block */
+  siguiente_predecesor = ( unsigned int * ) malloc ( ( grafo -> cantidad_basic_blocks + 1 ) * sizeof ( unsigned int ) );
+
+/* Acumulo los predecesores ( la cuenta pasa a ser el comienzo de cada basic block ) */
+  cantidad = 0;
+
+  for ( cont = 0 ; cont < grafo -> cantidad_basic_blocks ; cont ++ )
+  {
+  /* Levanto la cantidad de predecesores del basic block */
+    predecesores = grafo -> inicio_predecesores [ cont ];
+
+  /* Los predecesores del basic block arrancan donde terminan los anteriores */
+    grafo -> inicio_predecesores [ cont ] = cantidad;
+    siguiente_predecesor [ cont ] = cantidad;
+    cantidad += predecesores;
+  }
+
+/* Cierro el ultimo basic block */
+  grafo -> inicio_predecesores [ grafo -> cantidad_basic_blocks ] = cantidad;
+
+/* Lleno los predecesores ( quedan ordenados igual que los basic blocks de la funcion ) */
+  for ( cont = 0 ; cont < grafo -> cantidad_basic_blocks ; cont ++ )
+  {
+  /* Recorro los sucesores del basic block */
+    for ( cont2 = grafo -> inicio_sucesores [ cont ] ; cont2 < grafo -> inicio_sucesores [ cont + 1 ] ; cont2 ++ )
+    {
+    /* Levanto el siguiente sucesor */
+      sucesor = grafo -> sucesores [ cont2 ];
+
+    /* Si el hijo no existe */
+      if ( sucesor == SIN_PAREJA )
+      {
+        continue;
+      }
+
+    /* Si ya lo agregue como predecesor del hijo ( 2 salidas al mismo lugar ) */
+      if ( ( siguiente_predecesor [ sucesor ] > grafo -> inicio_predecesores [ sucesor ] ) && ( grafo -> predecesores [ siguiente_predecesor [ sucesor ] - 1 ] == cont ) )
+      {
+        continue;
+      }
+
+    /* Agrego el basic block como predecesor del hijo */
+      grafo -> predecesores [ siguiente_predecesor [ sucesor ] ] = cont;
+      siguiente_predecesor [ sucesor ] ++;
+    }
+  }
+
+/* Libero las posiciones libres */
+  free ( siguiente_predecesor );
+}
+
+/****************************************************************************/
+
+void liberar_grafo_programa ( Grafo_Programa *grafo )
+{
+  unsigned int pos;
+
+/* Desvinculo las funciones del grafo ( se liberan despues que el grafo ) */
+  for ( pos = 0 ; pos < grafo -> cantidad_funciones ; pos ++ )
+  {
+    grafo -> funciones [ pos ] -> grafo = NULL;
+  }
+
+/* Libero los arrays del grafo */
+  free ( grafo -> funciones );
+  free ( grafo -> basic_blocks );
+  free ( grafo -> inicio_sucesores );
+  free ( grafo -> sucesores );
+  free ( grafo -> inicio_predecesores );
+  free ( grafo -> predecesores );
+  free ( grafo -> inicio_llamados );
+  free ( grafo -> llamados );
+  free ( grafo -> checksums );
+  free ( grafo -> marcas_visita );
+  free ( grafo -> claves_eytzinger );
+  free ( grafo -> funciones_eytzinger );
+
+/* Dejo el grafo vacio */
+  grafo -> lista_funciones = NULL;
+  grafo -> cantidad_funciones = 0;
+  grafo -> cantidad_basic_blocks = 0;
+  grafo -> funciones = NULL;
+  grafo -> basic_blocks = NULL;
+  grafo -> inicio_sucesores = NULL;
+  grafo -> sucesores = NULL;
+  grafo -> inicio_predecesores = NULL;
+  grafo -> predecesores = NULL;
+  grafo -> inicio_llamados = NULL;
+  grafo -> llamados = NULL;
+  grafo -> checksums = NULL;
+  grafo -> marcas_visita = NULL;
+  grafo -> epoca_visita = 0;
+  grafo -> claves_eytzinger = NULL;
+  grafo -> funciones_eytzinger = NULL;
+}
+
+/****************************************************************************/
+
+Grafo_Programa *get_grafo_de_lista ( List &funciones )
+{
+  Grafo_Programa *grafo = NULL;
+
+/* Si la lista es la de alguno de los programas comparados */
+  if ( grafo_programa1.lista_funciones == &funciones )
+  {
+    grafo = &grafo_programa1;
+  }
+  else if ( grafo_programa2.lista_funciones == &funciones )
+  {
+    grafo = &grafo_programa2;
+  }
+
+  return ( grafo );
+}
+
+/****************************************************************************/
+
+Basic_Block *get_basic_block_hijo ( Funcion *funcion , Basic_Block *basic_block , unsigned int pos_hija )
+{
+  Grafo_Programa *grafo = ( Grafo_Programa * ) funcion -> grafo;
+  Basic_Block *basic_block_hijo = NULL;
+  unsigned int sucesor;
+
+/* Si la funcion pertenece a un grafo armado */
+  if ( grafo != NULL )
+  {
+  /* Si el hijo existe */
+    if ( grafo -> inicio_sucesores [ basic_block -> indice ] + pos_hija < grafo -> inicio_sucesores [ basic_block -> indice + 1 ] )
+    {
+    /* Levanto el sucesor ( mismo orden que basic_blocks_hijos ) */
+      sucesor = grafo -> sucesores [ grafo -> inicio_sucesores [ basic_block -> indice ] + pos_hija ];
+
+    /* Si el hijo esta dentro de la funcion */
+      if ( sucesor != SIN_PAREJA )
+      {
+        basic_block_hijo = grafo -> basic_blocks [ sucesor ];
+      }
+    }
+  }
+  else
+  {
+  /* Busco el basic block en toda la funcion */
+    basic_block_hijo = get_basic_block_from_array ( funcion -> basic_blocks , funcion -> cantidad_basic_blocks , ( unsigned int ) basic_block -> basic_blocks_hijos -> Get ( pos_hija ) );
+  }
+
+  return ( basic_block_hijo );
+}
+
+/****************************************************************************/
+
+Funcion *get_funcion_llamada ( List &funciones , Funcion *funcion , Basic_Block *basic_block , unsigned int pos )
+{
+  Grafo_Programa *grafo = ( Grafo_Programa * ) funcion -> grafo;
+  Funcion *funcion_llamada = NULL;
+  unsigned int llamado;
+
+/* Si la funcion pertenece al grafo armado con esta lista */
+  if ( ( grafo != NULL ) && ( grafo -> lista_funciones == &funciones ) )
+  {
+  /* Si el llamado existe */
+    if ( grafo -> inicio_llamados [ basic_block -> indice ] + pos < grafo -> inicio_llamados [ basic_block -> indice + 1 ] )
+    {
+    /* Levanto la funcion llamada ( resuelta al armar el grafo ) */
+      llamado = grafo -> llamados [ grafo -> inicio_llamados [ basic_block -> indice ] + pos ];
+
+    /* Si la funcion llamada esta en el programa */
+      if ( llamado != SIN_PAREJA )
+      {
+        funcion_llamada = grafo -> funciones [ llamado ];
+      }
+    }
+  }
+  else
+  {
+  /* Busco la funcion por direccion */
+    funcion_llamada = get_estructura_funcion ( funciones , ( unsigned int ) basic_block -> funciones_hijas -> Get ( pos ) );
+  }
+
+  return ( funcion_llamada );
+}
+
+/****************************************************************************/
+
+unsigned int llenar_indice_eytzinger ( Grafo_Programa *grafo , Index &direcciones , unsigned int pos , unsigned int nodo )
+{
+/* Si el nodo esta fuera del arbol */
+  if ( nodo > grafo -> cantidad_funciones )
+  {
+    return ( pos );
+  }
+
+/* Recorro el arbol en orden: hijo izquierdo, nodo, hijo derecho */
+  pos = llenar_indice_eytzinger ( grafo , direcciones , pos , nodo * 2 );
+
+  grafo -> claves_eytzinger [ nodo ] = direcciones.GetKey ( pos );
+  grafo -> funciones_eytzinger [ nodo ] = ( Funcion * ) direcciones.Get ( pos );
+  pos ++;
+
+  pos = llenar_indice_eytzinger ( grafo , direcciones , pos , nodo * 2 + 1 );
+
+  return ( pos );
+}
+
+/****************************************************************************/
+
+Funcion *buscar_funcion_en_grafo ( Grafo_Programa *grafo , unsigned int address )
+{
+  unsigned int nodo = 1;
+
+/* Bajo por el arbol quedandome con el camino hacia la primera clave >= address */
+  while ( nodo <= grafo -> cantidad_funciones )
+  {
+    nodo = nodo * 2 + ( ( grafo -> claves_eytzinger [ nodo ] < address ) ? 1 : 0 );
+  }
+
+/* Deshago los pasos a la derecha del final ( el ultimo paso a la izquierda es el encontrado ) */
+  while ( nodo & 1 )
+  {
+    nodo = nodo >> 1;
+  }
+
+  nodo = nodo >> 1;
+
+/* Si encontre la direccion */
+  if ( ( nodo != 0 ) && ( grafo -> claves_eytzinger [ nodo ] == address ) )
+  {
+    return ( grafo -> funciones_eytzinger [ nodo ] );
+  }
+
+  return ( NULL );
+}
+
+/****************************************************************************/
+
+void liberar_marcas_de_recorrido ( Funcion *funcion )
+{
+  Grafo_Programa *grafo = ( Grafo_Programa * ) funcion -> grafo;
+
+/* Si la funcion NO pertenece a un grafo armado */
+  if ( grafo == NULL )
+  {
+  /* Limpio las marcas dentro de los basic blocks */
+    liberar_basic_blocks ( funcion );
+  }
+  else
+  {
+  /* Paso a una nueva epoca ( las marcas viejas dejan de contar ) */
+    grafo -> epoca_visita ++;
+
+  /* Si el contador dio la vuelta */
+    if ( grafo -> epoca_visita == 0 )
+    {
+    /* Limpio todas las marcas y arranco de nuevo */
+      memset ( grafo -> marcas_visita , 0 , ( grafo -> cantidad_basic_blocks + 1 ) * sizeof ( unsigned int ) );
+      grafo -> epoca_visita = 1;
+    }
+  }
+}
+
+/****************************************************************************/
+
+void marcar_basic_block_visitado ( Funcion *funcion , Basic_Block *basic_block )
+{
+  Grafo_Programa *grafo = ( Grafo_Programa * ) funcion -> grafo;
+
+/* Marco el basic block donde corresponda */
+  if ( grafo == NULL )
+  {
+    basic_block -> visitado = TRUE;
+  }
+  else
+  {
+    grafo -> marcas_visita [ basic_block -> indice ] = grafo -> epoca_visita;
+  }
+}
+
+/****************************************************************************/
+
+int is_basic_block_visitado ( Funcion *funcion , Basic_Block *basic_block )
+{
+  Grafo_Programa *grafo = ( Grafo_Programa * ) funcion -> grafo;
+  int ret;
+
+/* Leo la marca de donde corresponda */
+  if ( grafo == NULL )
+  {
+    ret = basic_block -> visitado;
+  }
+  else
+  {
+    ret = ( grafo -> marcas_visita [ basic_block -> indice ] == grafo -> epoca_visita );
+  }
+
+  return ( ret );
+}
+
+/****************************************************************************/
+
+unsigned int *get_checksums_de_funcion ( Funcion *funcion )
+{
+  Grafo_Programa *grafo = ( Grafo_Programa * ) funcion -> grafo;
+  unsigned int *checksums = NULL;
+
+/* Si la funcion pertenece a un grafo armado y tiene basic blocks */
+  if ( ( grafo != NULL ) && ( funcion -> cantidad_basic_blocks > 0 ) )
+  {
+  /* Los checksums de la funcion son contiguos en el grafo */
+    checksums = &grafo -> checksums [ funcion -> basic_blocks [ 0 ] -> indice ];
+  }
+
+  return ( checksums );
+}
+
+/****************************************************************************/
+
+unsigned int reconocer_funciones_x_similitud ( List &funciones1_irreconocidas , List &funciones2_irreconocidas , List &funciones1_cambiadas , List &funciones2_cambiadas )
+{
+  Funcion **punteros1;
+  Funcion **punteros2;
+  Index baldes [ BANDAS_LSH ];
+  Index pares;
+  List pares1;
+  List pares2;
+  List tocados;
+  unsigned int mejores [ CANDIDATOS_LSH ];
+  unsigned int coincidencias_mejores [ CANDIDATOS_LSH ];
+  unsigned int *firmas1;
+  unsigned int *firmas2;
+  unsigned int *votos;
+  unsigned char *usadas1;
+  unsigned char *usadas2;
+  unsigned int cantidad1;
+  unsigned int cantidad2;
+  unsigned int coincidencias;
+  unsigned int clave;
+  unsigned int funciones_reconocidas = 0;
+  unsigned int banda;
+  unsigned int revisados;
+  unsigned int candidato;
+  unsigned int pos;
+  unsigned int cont, cont2;
+
+/* Me quedo con las funciones que todavia no tienen pareja */
+  cantidad1 = funciones1_irreconocidas.Len ();
+  cantidad2 = funciones2_irreconocidas.Len ();
+
+/* Si alguno de los lados NO tiene funciones */
+  if ( ( cantidad1 == 0 ) || ( cantidad2 == 0 ) )
+  {
+  /* No hay nada que comparar */
+    return ( 0 );
+  }
+
+/* Alloco las firmas y los flags de cada lado */
+  punteros1 = ( Funcion ** ) malloc ( cantidad1 * sizeof ( Funcion * ) );
+  punteros2 = ( Funcion ** ) malloc ( cantidad2 * sizeof ( Funcion * ) );
+  firmas1 = ( unsigned int * ) malloc ( cantidad1 * CANTIDAD_MINHASH * sizeof ( unsigned int ) );
+  firmas2 = ( unsigned int * ) malloc ( cantidad2 * CANTIDAD_MINHASH * sizeof ( unsigned int ) );
+  votos = ( unsigned int * ) malloc ( cantidad2 * sizeof ( unsigned int ) );
+  usadas1 = ( unsigned char * ) malloc ( cantidad1 );
+  usadas2 = ( unsigned char * ) malloc ( cantidad2 );
+  memset ( votos , 0 , cantidad2 * sizeof ( unsigned int ) );
+  memset ( usadas1 , FALSE , cantidad1 );
+  memset ( usadas2 , FALSE , cantidad2 );
+
+/* Calculo las firmas de programa2 y las reparto en los baldes de cada banda */
+  for ( pos = 0 ; pos < cantidad2 ; pos ++ )
+  {
+  /* Si la operacion fue cancelada, no tiene sentido seguir armando los baldes */
+    if ( is_operacion_cancelada () == TRUE )
+    {
+      break;
+    }
+
+  /* Levanto la siguiente funcion */
+    punteros2 [ pos ] = ( Funcion * ) funciones2_irreconocidas.Get ( pos );
+
+  /* Calculo la firma */
+    calcular_minhash_de_funcion ( punteros2 [ pos ] , &firmas2 [ pos * CANTIDAD_MINHASH ] );
+
+  /* Si la funcion no es confiable para compararla por similitud */
+    if ( punteros2 [ pos ] -> cantidad_basic_blocks < 2 )
+    {
+      continue;
+    }
+
+  /* Agrego la funcion al balde de cada banda */
+    for ( banda = 0 ; banda < BANDAS_LSH ; banda ++ )
+    {
+      clave = calcular_hash ( HASH_INICIAL + banda , &firmas2 [ pos * CANTIDAD_MINHASH + banda * FILAS_LSH ] , FILAS_LSH * sizeof ( unsigned int ) );
+      baldes [ banda ].Add ( clave , ( void * ) pos );
+    }
+  }
+
+/* Ordeno los baldes */
+  for ( banda = 0 ; banda < BANDAS_LSH ; banda ++ )
+  {
+    baldes [ banda ].Sort ();
+  }
+
+/* Busco los candidatos de cada funcion de programa1 */
+  fijar_total_progreso ( cantidad1 );
+
+  for ( pos = 0 ; pos < cantidad1 ; pos ++ )
+  {
+  /* Si la operacion fue cancelada, asocio solo los candidatos encontrados hasta ahora */
+    if ( avanzar_progreso ( 1 ) == FALSE )
+    {
+      break;
+    }
+
+  /* Levanto la siguiente funcion */
+    punteros1 [ pos ] = ( Funcion * ) funciones1_irreconocidas.Get ( pos );
+
+  /* Si la funcion no es confiable para compararla por similitud */
+    if ( punteros1 [ pos ] -> cantidad_basic_blocks < 2 )
+    {
+      continue;
+    }
+
+  /* Calculo la firma */
+    calcular_minhash_de_funcion ( punteros1 [ pos ] , &firmas1 [ pos * CANTIDAD_MINHASH ] );
+
+  /* Junto las funciones que caen en el mismo balde en alguna banda */
+    for ( banda = 0 ; banda < BANDAS_LSH ; banda ++ )
+    {
+      clave = calcular_hash ( HASH_INICIAL + banda , &firmas1 [ pos * CANTIDAD_MINHASH + banda * FILAS_LSH ] , FILAS_LSH * sizeof ( unsigned int ) );
+
+    /* Si el balde esta vacio */
+      if ( baldes [ banda ].Find ( clave , &cont ) == FALSE )
+      {
+        continue;
+      }
+
+    /* Recorro el balde ( los baldes enormes no discriminan nada ) */
+      for ( revisados = 0 ; ( cont < baldes [ banda ].Len () ) && ( baldes [ banda ].GetKey ( cont ) == clave ) && ( revisados < MAX_BALDE_LSH ) ; cont ++ , revisados ++ )
+      {
+        candidato = ( unsigned int ) baldes [ banda ].Get ( cont );
+
+      /* Si es la primera vez que veo al candidato */
+        if ( votos [ candidato ] == 0 )
+        {
+          tocados.Add ( ( void * ) candidato );
+        }
+
+        votos [ candidato ] ++;
+      }
+    }
+
+  /* Inicializo los mejores candidatos */
+    for ( cont = 0 ; cont < CANDIDATOS_LSH ; cont ++ )
+    {
+      coincidencias_mejores [ cont ] = 0;
+    }
+
+  /* Estimo la similitud con cada candidato */
+    for ( cont = 0 ; cont < tocados.Len () ; cont ++ )
+    {
+    /* Levanto el siguiente candidato */
+      candidato = ( unsigned int ) tocados.Get ( cont );
+      votos [ candidato ] = 0;
+
+    /* Cuento el par examinado */
+      fase_actual -> pares_examinados ++;
+
+    /* Cuento las posiciones iguales de las firmas */
+      for ( cont2 = 0 , coincidencias = 0 ; cont2 < CANTIDAD_MINHASH ; cont2 ++ )
+      {
+        if ( firmas1 [ pos * CANTIDAD_MINHASH + cont2 ] == firmas2 [ candidato * CANTIDAD_MINHASH + cont2 ] )
+        {
+          coincidencias ++;
+        }
+      }
+
+    /* Inserto el candidato entre los mejores ( ordenados de mayor a menor ) */
+      for ( cont2 = CANDIDATOS_LSH ; ( cont2 > 0 ) && ( coincidencias_mejores [ cont2 - 1 ] < coincidencias ) ; cont2 -- )
+      {
+        if ( cont2 < CANDIDATOS_LSH )
+        {
+          mejores [ cont2 ] = mejores [ cont2 - 1 ];
+          coincidencias_mejores [ cont2 ] = coincidencias_mejores [ cont2 - 1 ];
+        }
+      }
+
+      if ( cont2 < CANDIDATOS_LSH )
+      {
+        mejores [ cont2 ] = candidato;
+        coincidencias_mejores [ cont2 ] = coincidencias;
+      }
+    }
+
+  /* Limpio los candidatos para la proxima funcion */
+    tocados.Clear ();
+
+  /* Propongo los mejores candidatos que se parecen lo suficiente */
+    for ( cont = 0 ; ( cont < CANDIDATOS_LSH ) && ( coincidencias_mejores [ cont ] >= MIN_COINCIDENCIAS_MINHASH ) ; cont ++ )
+    {
+    /* Ordeno los pares de mas parecidos a menos parecidos */
+      pares.Add ( CANTIDAD_MINHASH - coincidencias_mejores [ cont ] , ( void * ) pares1.Len () );
+      pares1.Add ( ( void * ) pos );
+      pares2.Add ( ( void * ) mejores [ cont ] );
+    }
+  }
+
+/* Asocio los pares empezando por los mas parecidos */
+  pares.Sort ();
+
+  for ( cont = 0 ; cont < pares.Len () ; cont ++ )
+  {
+  /* Levanto el siguiente par */
+    pos = ( unsigned int ) pares.Get ( cont );
+    cont2 = ( unsigned int ) pares1.Get ( pos );
+    candidato = ( unsigned int ) pares2.Get ( pos );
+
+  /* Si alguna de las funciones ya fue asociada */
+    if ( ( usadas1 [ cont2 ] == TRUE ) || ( usadas2 [ candidato ] == TRUE ) )
+    {
+      continue;
+    }
+
+  /* Marco las funciones como usadas */
+    usadas1 [ cont2 ] = TRUE;
+    usadas2 [ candidato ] = TRUE;
+
+  /* Asocio las funciones */
+    fase_actual -> llamados_predicado ++;
+    asociar_funciones ( FALSE , punteros1 [ cont2 ] , punteros2 [ candidato ] , funciones1_cambiadas , funciones2_cambiadas , funciones1_irreconocidas , funciones2_irreconocidas );
+
+  /* Aumento la cantidad de funciones reconocidas */
+    funciones_reconocidas ++;
+  }
+
+/* Libero todo */
+  free ( punteros1 );
+  free ( punteros2 );
+  free ( firmas1 );
+  free ( firmas2 );
+  free ( votos );
+  free ( usadas1 );
+  free ( usadas2 );
+
+  return ( funciones_reconocidas );
+}
+
+/****************************************************************************/
+
+void calcular_minhash_de_funcion ( Funcion *funcion , unsigned int *firma )
+{
+  Basic_Block *basic_block;
+  unsigned int *elementos;
+  unsigned int caracteristicas [ 2 ];
+  unsigned int cantidad_elementos = 0;
+  unsigned int ocurrencia = 0;
+  unsigned int elemento;
+  unsigned int valor;
+  unsigned int cont, cont2;
+
+/* Cada basic block aporta su checksum y sus instrucciones con sus llamados */
+  elementos = ( unsigned int * ) malloc ( ( funcion -> cantidad_basic_blocks * 2 + 1 ) * sizeof ( unsigned int ) );
+
+  for ( cont = 0 ; cont < funcion -> cantidad_basic_blocks ; cont ++ )
+  {
+  /* Levanto el siguiente basic block */
+    basic_block = funcion -> basic_blocks [ cont ];
+
+  /* Agrego el checksum */
+    elementos [ cantidad_elementos ++ ] = basic_block -> checksum;
+
+  /* Agrego la cantidad de instrucciones y de llamados */
+    caracteristicas [ 0 ] = basic_block -> longitud;
+    caracteristicas [ 1 ] = basic_block -> funciones_hijas -> Len ();
+    elementos [ cantidad_elementos ++ ] = calcular_hash ( HASH_PRIMO , caracteristicas , sizeof ( caracteristicas ) );
+  }
+
+/* Ordeno los elementos para numerar los repetidos ( es un multiconjunto ) */
+  qsort ( elementos , cantidad_elementos , sizeof ( unsigned int ) , comparar_valores );
+
+/* Inicializo la firma */
+  for ( cont2 = 0 ; cont2 < CANTIDAD_MINHASH ; cont2 ++ )
+  {
+    firma [ cont2 ] = 0xffffffff;
+  }
+
+/* Recorro todos los elementos */
+  for ( cont = 0 ; cont < cantidad_elementos ; cont ++ )
+  {
+  /* Numero las apariciones de un mismo valor */
+    ocurrencia = ( ( cont > 0 ) && ( elementos [ cont ] == elementos [ cont - 1 ] ) ) ? ocurrencia + 1 : 0;
+    caracteristicas [ 0 ] = elementos [ cont ];
+    caracteristicas [ 1 ] = ocurrencia;
+    elemento = calcular_hash ( HASH_INICIAL , caracteristicas , sizeof ( caracteristicas ) );
+
+  /* Me quedo con el minimo de cada funcion de hash */
+    for ( cont2 = 0 ; cont2 < CANTIDAD_MINHASH ; cont2 ++ )
+    {
+      valor = calcular_hash ( HASH_INICIAL + cont2 , &elemento , sizeof ( elemento ) );
+
+      if ( valor < firma [ cont2 ] )
+      {
+        firma [ cont2 ] = valor;
+      }
+    }
+  }
+
+/* Libero los elementos */
+  free ( elementos );
+}
+
+/****************************************************************************/
+
+int comparar_valores ( const void *valor1 , const void *valor2 )
+{
+/* Comparo los 2 valores */
+  if ( * ( unsigned int * ) valor1 < * ( unsigned int * ) valor2 )
+  {
+    return ( -1 );
+  }
+  else if ( * ( unsigned int * ) valor1 > * ( unsigned int * ) valor2 )
+  {
+    return ( 1 );
+  }
+
+  return ( 0 );
+}
+
+/****************************************************************************/
+
+unsigned int reconocer_funciones_x_anclas ( List &funciones1 , List &funciones2 , List &funciones1_irreconocidas , List &funciones2_irreconocidas , List &funciones1_cambiadas , List &funciones2_cambiadas )
+{
+  Basic_Block *basic_block;
+  Funcion *funcion1;
+  Funcion *funcion2;
+  Index anclas1;
+  Index anclas2;
+  unsigned int funciones_reconocidas = 0;
+  unsigned int ancla;
+  unsigned int cont, cont2, cont3;
+  int asociada;
+
+/* Armo los indices invertidos de anclas de los 2 programas */
+  indexar_anclas ( funciones1 , anclas1 );
+  indexar_anclas ( funciones2 , anclas2 );
+
+/* Recorro todas las funciones de 1 que todavia no tienen pareja */
+  fijar_total_progreso ( funciones1_irreconocidas.Len () );
+
+  for ( cont = 0 ; cont < funciones1_irreconocidas.Len () ; cont ++ )
+  {
+  /* Si la operacion fue cancelada, me quedo con lo asociado hasta ahora */
+    if ( avanzar_progreso ( 1 ) == FALSE )
+    {
+      break;
+    }
+
+  /* Levanto la proxima funcion de 1 */
+    funcion1 = ( Funcion * ) funciones1_irreconocidas.Get ( cont );
+    asociada = FALSE;
+
+  /* Recorro las anclas de todos sus basic blocks */
+    for ( cont2 = 0 ; ( cont2 < funcion1 -> cantidad_basic_blocks ) && ( asociada == FALSE ) ; cont2 ++ )
+    {
+      basic_block = funcion1 -> basic_blocks [ cont2 ];
+
+      for ( cont3 = 0 ; cont3 < basic_block -> anclas -> Len () ; cont3 ++ )
+      {
+        ancla = ( unsigned int ) basic_block -> anclas -> Get ( cont3 );
+
+      /* Cuento el par examinado */
+        fase_actual -> pares_examinados ++;
+
+      /* Si el ancla NO es exclusiva de esta funcion en programa1 */
+        if ( get_duena_de_ancla ( anclas1 , ancla ) != funcion1 )
+        {
+          continue;
+        }
+
+      /* Busco la unica funcion de programa2 que usa el ancla */
+        funcion2 = get_duena_de_ancla ( anclas2 , ancla );
+
+      /* Si el ancla NO es exclusiva o la funcion ya tiene pareja */
+        if ( ( funcion2 == NULL ) || ( funcion2 -> address_equivalente != BADADDR ) )
+        {
+          continue;
+        }
+
+      /* Relaciono las 2 funciones */
+        asociar_funciones ( FALSE , funcion1 , funcion2 , funciones1_cambiadas , funciones2_cambiadas , funciones1_irreconocidas , funciones2_irreconocidas );
+
+      /* Compenso la extraccion de la funcion */
+        cont --;
+
+      /* Aumento la cantidad de funciones reconocidas */
+        funciones_reconocidas ++;
+        asociada = TRUE;
+        break;
+      }
+    }
+  }
+
+  return ( funciones_reconocidas );
+}
+
+/****************************************************************************/
+
+void indexar_anclas ( List &funciones , Index &anclas )
+{
+  Basic_Block *basic_block;
+  Funcion *funcion;
+  unsigned int pos;
+  unsigned int cont, cont2;
+
+/* Recorro todas las funciones del programa */
+  for ( pos = 0 ; pos < funciones.Len () ; pos ++ )
+  {
+  /* Levanto la siguiente funcion */
+    funcion = ( Funcion * ) funciones.Get ( pos );
+
+  /* Agrego las anclas de todos sus basic blocks */
+    for ( cont = 0 ; cont < funcion -> cantidad_basic_blocks ; cont ++ )
+    {
+      basic_block = funcion -> basic_blocks [ cont ];
+
+      for ( cont2 = 0 ; cont2 < basic_block -> anclas -> Len () ; cont2 ++ )
+      {
+        anclas.Add ( ( unsigned int ) basic_block -> anclas -> Get ( cont2 ) , funcion );
+      }
+    }
+  }
+
+/* Ordeno el indice por ancla */
+  anclas.Sort ();
+}
+
+/****************************************************************************/
+
+Funcion *get_duena_de_ancla ( Index &anclas , unsigned int ancla )
+{
+  Funcion *funcion = NULL;
+  unsigned int pos;
+
+/* Si nadie usa el ancla */
+  if ( anclas.Find ( ancla , &pos ) == FALSE )
+  {
+    return ( NULL );
+  }
+
+/* La primera funcion que usa el ancla */
+  funcion = ( Funcion * ) anclas.Get ( pos );
+
+/* Si otra funcion tambien usa el ancla, NO es una ancla rara */
+/* ( las repeticiones de una misma funcion quedan juntas en el indice ) */
+  for ( pos ++ ; ( pos < anclas.Len () ) && ( anclas.GetKey ( pos ) == ancla ) ; pos ++ )
+  {
+    if ( anclas.Get ( pos ) != funcion )
+    {
+      funcion = NULL;
+      break;
+    }
+  }
+
+  return ( funcion );
+}
+
+/****************************************************************************/
+
+void construir_filtro_de_funcion ( List &indice_funciones , List &funciones , Funcion *funcion )
+{
+  Basic_Block *basic_block;
+  Funcion *funcion_hija;
+  unsigned int cont, cont2;
+
+/* Inicializo el filtro */
+  memset ( funcion -> filtro , 0 , sizeof ( funcion -> filtro ) );
+
+/* Recorro todos los basic blocks */
+  for ( cont = 0 ; cont < funcion -> cantidad_basic_blocks ; cont ++ )
+  {
+  /* Levanto el siguiente basic block */
+    basic_block = funcion -> basic_blocks [ cont ];
+
+  /* Agrego el checksum del basic block */
+    agregar_a_filtro ( funcion -> filtro , basic_block -> checksum );
+
+  /* Agrego el checksum de las funciones llamadas ( la direccion cambia entre versiones ) */
+    for ( cont2 = 0 ; cont2 < basic_block -> funciones_hijas -> Len () ; cont2 ++ )
+    {
+      funcion_hija = get_estructura_funcion2 ( indice_funciones , funciones , ( unsigned int ) basic_block -> funciones_hijas -> Get ( cont2 ) );
+
+      if ( funcion_hija != NULL )
+      {
+        agregar_a_filtro ( funcion -> filtro , funcion_hija -> checksum ^ HASH_PRIMO );
+      }
+    }
+  }
+}
+
+/****************************************************************************/
+
+void agregar_a_filtro ( unsigned int *filtro , unsigned int valor )
+{
+  unsigned int bit;
+
+/* Prendo 2 bits por valor */
+  bit = calcular_hash ( HASH_INICIAL , &valor , sizeof ( valor ) ) % BITS_FILTRO;
+  filtro [ bit / 32 ] |= 1 << ( bit % 32 );
+
+  bit = calcular_hash ( HASH_PRIMO , &valor , sizeof ( valor ) ) % BITS_FILTRO;
+  filtro [ bit / 32 ] |= 1 << ( bit % 32 );
+}
+
+/****************************************************************************/
+
+int son_filtros_compatibles ( Funcion *funcion1 , Funcion *funcion2 )
+{
+  unsigned int bits1 = 0;
+  unsigned int bits2 = 0;
+  unsigned int bits_comunes = 0;
+  unsigned int cont;
+  int ret = TRUE;
+
+/* Cuento los bits prendidos en cada filtro y en los 2 */
+  for ( cont = 0 ; cont < PALABRAS_FILTRO ; cont ++ )
+  {
+    bits1 += contar_bits ( funcion1 -> filtro [ cont ] );
+    bits2 += contar_bits ( funcion2 -> filtro [ cont ] );
+    bits_comunes += contar_bits ( funcion1 -> filtro [ cont ] & funcion2 -> filtro [ cont ] );
+  }
+
+/* Las funciones chicas ( o sin filtro ) no tienen bits suficientes para descartarlas */
+  if ( ( bits1 < MIN_BITS_FILTRO ) || ( bits2 < MIN_BITS_FILTRO ) )
+  {
+    return ( TRUE );
+  }
+
+/* Si los filtros se solapan muy poco respecto del mas chico */
+  if ( bits_comunes * 100 < ( ( bits1 < bits2 ) ? bits1 : bits2 ) * MIN_SOLAPAMIENTO_FILTRO )
+  {
+    ret = FALSE;
+  }
+
+  return ( ret );
+}
+
+/****************************************************************************/
+
+int son_tamanos_compatibles ( Funcion *funcion1 , Funcion *funcion2 )
+{
+  unsigned int menor;
+  unsigned int mayor;
+  int ret = TRUE;
+
+/* Ordeno las cantidades de basic blocks de las 2 funciones */
+  menor = ( funcion1 -> cantidad_basic_blocks < funcion2 -> cantidad_basic_blocks ) ? funcion1 -> cantidad_basic_blocks : funcion2 -> cantidad_basic_blocks;
+  mayor = ( funcion1 -> cantidad_basic_blocks < funcion2 -> cantidad_basic_blocks ) ? funcion2 -> cantidad_basic_blocks : funcion1 -> cantidad_basic_blocks;
+
+/* Si una funcion es demasiado mas grande que la otra */
+  if ( mayor > menor * MAX_PROPORCION_BLOQUES )
+  {
+    ret = FALSE;
+  }
+
+  return ( ret );
+}
+
+/****************************************************************************/
+
+unsigned int contar_bits ( unsigned int valor )
+{
+  unsigned int bits = 0;
+
+/* Apago el bit prendido mas bajo hasta que no quede ninguno */
+  while ( valor != 0 )
+  {
+    valor &= valor - 1;
+    bits ++;
+  }
+
+  return ( bits );
+}
+
+/****************************************************************************/
+
+int son_funciones_iguales ( Funcion *funcion1 , Funcion *funcion2 )
+{
+  int ret = FALSE;
+
+/* Cuento el llamado al predicado */
+  fase_actual -> llamados_predicado ++;
+
+/* Si las funciones tienen la misma longitud */
+  if ( funcion1 -> longitud == funcion2 -> longitud )
+  {
+  /* Si tienen el mismo checksum */
+    if ( funcion1 -> checksum == funcion2 -> checksum )
+    {
+    /* Si tienen la misma geometria ( sin importar el orden de los saltos ) */
+      if ( funcion1 -> hash_grafo == funcion2 -> hash_grafo )
+      {
+      /* Asumo que las funciones son iguales */
+        ret = TRUE;
+      }
+    }
+  }
+
+  return ( ret );
+}
+
+/****************************************************************************/
+
+unsigned int get_similitud_de_filtros ( Funcion *funcion1 , Funcion *funcion2 )
+{
+  unsigned int bits_union = 0;
+  unsigned int bits_comunes = 0;
+  unsigned int cont;
+
+/* Cuento los bits prendidos en los 2 filtros y en alguno de ellos */
+  for ( cont = 0 ; cont < PALABRAS_FILTRO ; cont ++ )
+  {
+    bits_union += contar_bits ( funcion1 -> filtro [ cont ] | funcion2 -> filtro [ cont ] );
+    bits_comunes += contar_bits ( funcion1 -> filtro [ cont ] & funcion2 -> filtro [ cont ] );
+  }
+
+/* Si ninguna funcion tiene filtro, no hay nada que comparar */
+  if ( bits_union == 0 )
+  {
+    return ( 0 );
+  }
+
+/* Retorno el porcentaje de bits en comun ( Jaccard ) */
+  return ( ( bits_comunes * 100 ) / bits_union );
+}
+
+/****************************************************************************/
+
+int son_funciones_cuasi_identicas ( Funcion *funcion1 , Funcion *funcion2 )
+{
+  int ret = FALSE;
+
+/* Cuento el llamado al predicado */
+  fase_actual -> llamados_predicado ++;
+
+/* Si las funciones tienen mas de un basic block */
+  if ( funcion1 -> cantidad_basic_blocks > 1 )
+  {
+  /* Si las funciones tienen la misma longitud */
+    if ( ( funcion1 -> longitud > 0 ) && ( funcion1 -> longitud == funcion2 -> longitud ) )
+    {
+    /* Si las funciones tienen el mismo grafo ( sin importar el orden de los saltos ) */
+      if ( funcion1 -> hash_grafo == funcion2 -> hash_grafo )
+      {
+      /* Asumo que las funciones son iguales pero con cambios triviales */
+        ret = TRUE;
+      }
+    }
+  }
+
+  return ( ret );
+}
+
+/****************************************************************************/
+
+int es_funcion_patcheada ( Funcion *funcion1 , List &funciones_2 , Funcion **funcion2 )
+{
+  Basic_Block_Padre *basic_block_padre;
+  Funcion *funcion_padre1;
+  Funcion *funcion_padre2;
+  unsigned int cont;
+  int ret = FALSE;
+
+/* Cuento el llamado al predicado */
+  fase_actual -> llamados_predicado ++;
+
+/* Recorro todas las funciones padres de funcion1 */
+  for ( cont = 0 ; cont < funcion1 -> cantidad_referencias_padre ; cont ++ )
+  {
+  /* Obtengo el basic block donde es llamada la funcion */
+    basic_block_padre = &funcion1 -> basic_blocks_padres [ cont ];
+
+  /* Obtengo la funcion padre que llama a la funcion */
+    funcion_padre1 = ( Funcion * ) basic_block_padre -> funcion;
+
+  /* Si la funcion padre fue relacionada con otra funcion en programa2 */
+    if ( ( funcion_padre1 -> identica == TRUE ) || ( funcion_padre1 -> patcheada == TRUE ) )
+    {
+    /* Obtengo la funcion padre de 2 */
+      funcion_padre2 = get_estructura_funcion ( funciones_2 , funcion_padre1 -> address_equivalente );
+
+    /* Si los padres casi no comparten contenido, recorrerlos no es confiable */
+      if ( son_filtros_compatibles ( funcion_padre1 , funcion_padre2 ) == FALSE )
+      {
+      /* Sigo con el proximo padre */
+        continue;
+      }
+
+    /* Cuento el par de padres examinado */
+      fase_actual -> pares_examinados ++;
+
+    /* Busco en las funciones padres el basic block en comun */
+      ret = get_funcion_equivalente_x_grafo ( 0 , funcion_padre1 , funcion1 , NULL , funciones_2 , funcion_padre2 , funcion2 , NULL );
+
+    /* Si encontre la funcion equivalente */
+      if ( ret == TRUE )
+      {
+      /* Salgo */
+        break;
+      }
+    }
+  }
+
+  return ( ret );
+}
+
+/****************************************************************************/
+
+int get_funcion_equivalente_x_grafo ( int nivel , Funcion *funcion_padre1 , Funcion *funcion1 , Basic_Block *basic_block1 , List &funciones2 , Funcion *funcion_padre2 , Funcion **funcion2 , Basic_Block *basic_block2 )
+{
+  List basic_blocks_padres1;
+  List basic_blocks_padres2;
+  Funcion *funcion_buscada;
+  Basic_Block *basic_block_padre1;
+  Basic_Block *basic_block_padre2;
+  Basic_Block *basic_block_hijo1;
+  Basic_Block *basic_block_hijo2;
+  int condicion_invertida = FALSE;
+  unsigned int funcion2_address;
+  unsigned int pos_hija1;
+  unsigned int pos_hija2;
+  unsigned int cont, cont2;
+  unsigned int pos;
+  int ret = FALSE;
+
+/* Si estoy en el primer nivel */
+  if ( nivel == 0 )
+  {
+  /* Marco como libre a todos los basic blocks de las funciones padres */
+    liberar_marcas_de_recorrido ( funcion_padre1 );
+    liberar_marcas_de_recorrido ( funcion_padre2 );
+
+  /* Levanto los basic blocks iniciales */
+    basic_block1 = funcion_padre1 -> basic_blocks [ 0 ];
+    basic_block2 = funcion_padre2 -> basic_blocks [ 0 ];
+  }
+
+/* Marco los basic blocks como visitados */
+  marcar_basic_block_visitado ( funcion_padre1 , basic_block1 );
+  marcar_basic_block_visitado ( funcion_padre2 , basic_block2 );
+
+/* Si los basic blocks tienen checksums distintos */
+  if ( basic_block1 -> checksum != basic_block2 -> checksum )
+  {
+  /* Si tengo una condicion invertida */
+    if ( is_condicion_invertida ( funcion_padre1 , funcion_padre2 , basic_block1 , basic_block2 ) == TRUE )
+    {
+    /* Condicion invertida detectada */
+      condicion_invertida = TRUE;
+
+//      my_msg ( "condicion invertida: %x - %x\n" , basic_block1 -> addr_inicial , basic_block2 -> addr_inicial );
+    }
+  /* Si NO es un camino confiable */
+    else if ( is_camino_confiable ( 1 , 0 , funcion_padre1 , funcion_padre2 , basic_block1 , basic_block2 ) == FALSE )
+    {
+    /* No puedo seguir por este camino */
+      return ( FALSE );
+    }
+  }
+
+/* Busco en el basic block si estoy llamando a la funcion */
+  if ( basic_block1 -> funciones_hijas -> GetPos ( ( void * ) funcion1 -> address , &pos ) == TRUE )
+  {
+  /* Si los basic blocks llaman a la misma cantidad de funciones */
+    if ( basic_block1 -> funciones_hijas -> Len () == basic_block2 -> funciones_hijas -> Len () )
+    {
+    /* Levanto en la misma posicion de llamados en el basic block 2 */
+      funcion2_address = ( unsigned int ) basic_block2 -> funciones_hijas -> Get ( pos );
+
+    /* Obtengo la funcion */
+      funcion_buscada = get_funcion_llamada ( funciones2 , funcion_padre2 , basic_block2 , pos );
 
     /* Si encontre la funcion equivalente */
       if ( funcion_buscada != NULL )
       {
-      /* Si la funcion NO fue matcheada con otra */
-        if ( ( funcion_buscada -> identica == FALSE ) && ( funcion_buscada -> patcheada == FALSE ) )
+      /* Si la funcion NO fue matcheada con otra */
+        if ( ( funcion_buscada -> identica == FALSE ) && ( funcion_buscada -> patcheada == FALSE ) )
+        {
+        /* Retorno la funcion */
+          *funcion2 = funcion_buscada;
+
+        /* Retorno OK */
+          return ( TRUE );
+        }
+      /* La funcion padre esta MAL asociada */
+        else
+        {
+        /* Mensaje para mi */
+//          my_msg ( "warning: possible bad asociation %x - %x\n" , funcion_padre1 -> address , funcion_padre2 -> address );
+          my_msg ( "warning: possible bad asociation %x - %x\n" , funcion1 -> address , funcion_buscada -> address );
+  
+        /* NO PUEDO SEGUIR AVANZANDO */
+          return ( FALSE );
+        }
+      }
+    }
+  }
+
+/* Avanzo por todos los caminos hijos */
+  for ( cont = 0 ; cont < basic_block1 -> basic_blocks_hijos -> Len () ; cont ++ )
+  {
+  /* Si NO hay condicion invertida */
+    if ( condicion_invertida == FALSE )
+    {
+    /* Levanto las posiciones de los siguientes hijos */
+      pos_hija1 = cont;
+      pos_hija2 = cont;
+    }
+  /* Si tengo una condicion invertida */
+    else
+    {
+    /* Si estoy llendo por el camino del positivo */
+      if ( cont == 0 )
+      {
+      /* Levanto las posiciones de los siguientes hijos */
+        pos_hija1 = cont;
+        pos_hija2 = cont + 1;
+      }
+      else
+      {
+      /* Levanto las posiciones de los siguientes hijos */
+        pos_hija1 = cont;
+        pos_hija2 = cont - 1;
+      }
+    }
+
+  /* Obtengo los basic block hijos */
+    basic_block_hijo1 = get_basic_block_hijo ( funcion_padre1 , basic_block1 , pos_hija1 );
+    basic_block_hijo2 = get_basic_block_hijo ( funcion_padre2 , basic_block2 , pos_hija2 );
+
+  /* Si los 2 basic blocks estan LIBRES */
+    if ( ( is_basic_block_visitado ( funcion_padre1 , basic_block_hijo1 ) == FALSE ) && ( is_basic_block_visitado ( funcion_padre2 , basic_block_hijo2 ) == FALSE ) )
+    {
+    /* Avanzo por este camino */
+      ret = get_funcion_equivalente_x_grafo ( nivel + 1 , funcion_padre1 , funcion1 , basic_block_hijo1 , funciones2 , funcion_padre2 , funcion2 , basic_block_hijo2 );
+
+    /* Si encontre la funcion */
+      if ( ret == TRUE )
+      {
+      /* Retorno OK */
+        return ( TRUE );
+      }
+    }
+  }
+
+/* Dejo para mas adelante recorrer la funcion hacia arriba */
+  return ( ret );
+
+/////////////////////////////////////////////
+
+/* Si NO pude encontrar la funcion */
+  if ( ret == FALSE )
+  {
+  /* Obtengo todos los basic blocks padres */
+    get_basic_blocks_padres ( funcion_padre1 , basic_block1 , basic_blocks_padres1 );
+    get_basic_blocks_padres ( funcion_padre2 , basic_block2 , basic_blocks_padres2 );
+
+  /* Recorro todos los basic blocks padres 1 */
+    for ( cont = 0 ; cont < basic_blocks_padres1.Len () ; cont ++ )
+    {
+    /* Levanto el siguiente basic block */
+      basic_block_padre1 = ( Basic_Block * ) basic_blocks_padres1.Get ( cont );
+
+    /* Si el basic block fue visitado */
+      if ( is_basic_block_visitado ( funcion_padre1 , basic_block_padre1 ) == TRUE )
+      {
+      /* Sigo buscando */
+        continue;
+      }
+
+    /* Recorro todos los basic blocks padres de 2 */
+      for ( cont2 = 0 ; cont2 < basic_blocks_padres2.Len () ; cont2 ++ )
+      {
+      /* Levanto el siguiente basic block */
+        basic_block_padre2 = ( Basic_Block * ) basic_blocks_padres2.Get ( cont2 );
+
+      /* Si el basic block fue visitado */
+        if ( is_basic_block_visitado ( funcion_padre2 , basic_block_padre2 ) == TRUE )
+        {
+        /* Sigo buscando */
+          continue;
+        }
+
+      /* Si los 2 basic blocks tienen el mismo checksum */
+        if ( basic_block_padre1 -> checksum == basic_block_padre2 -> checksum )
+        {
+        /* Si los 2 basic blocks tienen la misma cantidad de hijos */
+          if ( basic_block_padre1 -> funciones_hijas -> Len () == basic_block_padre2 -> funciones_hijas -> Len () )
+          {
+          /* Avanzo hacia arriba por este camino */
+            ret = get_funcion_equivalente_x_grafo ( nivel + 1 , funcion_padre1 , funcion1 , basic_block_padre1 , funciones2 , funcion_padre2 , funcion2 , basic_block_padre2 );
+
+          /* Si encontre la funcion */
+            if ( ret == TRUE )
+            {
+            /* Retorno OK */
+              return ( TRUE );
+            }
+          }
+        }
+      }
+    }
+  }
+
+  return ( ret );
+}
+
+/****************************************************************************/
+
+int is_condicion_invertida ( Funcion *funcion1 , Funcion *funcion2 , Basic_Block *basic_block1 , Basic_Block *basic_block2 )
+{
+  Basic_Block *basic_block_hijo11;
+  Basic_Block *basic_block_hijo12;
+  Basic_Block *basic_block_hijo21;
+  Basic_Block *basic_block_hijo22;
+  int ret = FALSE;
+
+/* Si los basic blocks tienen checksums distintos */
+  if ( basic_block1 -> checksum != basic_block2 -> checksum )
+  {
+  /* Si los basic blocks tienen la misma longitud */
+    if ( basic_block1 -> longitud == basic_block2 -> longitud )
+    {
+    /* Si los basic blocks actuales tienen 2 hijos */
+      if ( ( basic_block1 -> basic_blocks_hijos -> Len () == 2 ) && ( basic_block1 -> basic_blocks_hijos -> Len () == basic_block2 -> basic_blocks_hijos -> Len () ) )
+      {
+      /* Obtengo los basic blocks hijos de 1 */
+        basic_block_hijo11 = get_basic_block_hijo ( funcion1 , basic_block1 , 0 );
+        basic_block_hijo12 = get_basic_block_hijo ( funcion1 , basic_block1 , 1 );
+
+      /* Obtengo los basic blocks hijos de 2 */
+        basic_block_hijo21 = get_basic_block_hijo ( funcion2 , basic_block2 , 0 );
+        basic_block_hijo22 = get_basic_block_hijo ( funcion2 , basic_block2 , 1 );
+
+      /* Si los basic blocks tienen checksums distintos */
+        if ( basic_block_hijo11 -> checksum != basic_block_hijo21 -> checksum )
+        {
+        /* Si las referencias estan cruzadas */
+          if ( ( basic_block_hijo11 -> checksum == basic_block_hijo22 -> checksum ) && ( basic_block_hijo12 -> checksum == basic_block_hijo21 -> checksum ) )
+          {
+          /* Condicion invertida detectada */
+            ret = TRUE;
+          }
+        }
+      }
+    }
+  }
+
+  return ( ret );
+}
+
+/****************************************************************************/
+
+int is_camino_confiable ( unsigned int profundidad_maxima, unsigned int profundidad , Funcion *funcion1 , Funcion *funcion2 , Basic_Block *basic_block1 , Basic_Block *basic_block2 )
+{
+  Basic_Block *basic_block_hijo1;
+  Basic_Block *basic_block_hijo2;
+  unsigned int cont;
+  int ret = FALSE;
+
+/* Si los basic blocks actuales son IDENTICOS */
+  if ( basic_block1 -> checksum == basic_block2 -> checksum )
+  {
+  /* Retorno OK */
+    return ( TRUE );
+  }
+
+/* Si llegue a la profundidad maxima */
+  if ( profundidad == profundidad_maxima )
+  {
+  /* Chequeo que los basic blocks coincidan */
+    if ( basic_block1 -> checksum == basic_block2 -> checksum )
+    {
+    /* Retorno OK */
+      return ( TRUE );
+    }
+    else
+    {
+    /* Retorno ERROR */
+      return ( FALSE );
+    }
+  }
+
+/* Si los basic blocks tienen distinta cantidad de hijos */
+  if ( basic_block1 -> basic_blocks_hijos -> Len () != basic_block2 -> basic_blocks_hijos -> Len () )
+  {
+  /* Retorno ERROR */
+    return ( FALSE );
+  }
+
+/* Recorro todas las conexiones hijas */
+  for ( cont = 0 ; cont < basic_block1 -> basic_blocks_hijos -> Len () ; cont ++ )
+  {
+  /* Levanto los siguientes basic blocks hijos */
+    basic_block_hijo1 = get_basic_block_hijo ( funcion1 , basic_block1 , cont );
+    basic_block_hijo2 = get_basic_block_hijo ( funcion2 , basic_block2 , cont );
+
+  /* Avanzo por este camino */
+    ret = is_camino_confiable ( profundidad_maxima , profundidad + 1 , funcion1 , funcion2 , basic_block_hijo1 , basic_block_hijo2 );
+
+  /* Si el camino NO es confiable */
+    if ( ret == FALSE )
+    {
+    /* Retorno ERROR */
+      return ( FALSE );
+    }
+  }
+
+  return ( ret );
+}
+
+/****************************************************************************/
+
+int get_funcion_equivalente_x_hijos ( Funcion *funcion1 , List &funciones1 , List &funciones2 , Funcion **funcion2 )
+{
+  int ret;
+
+/* Intento resolver por padres en comun de los hijos */
+  ret = get_funcion_equivalente_x_hijos_x_padres_en_comun ( funcion1 , funciones1 , funciones2 , funcion2 );
+
+/* Si no lo pude sacar, intento resolverlo buscando un hijo que le falte este padre */
+  if ( ret == FALSE )
+  {
+    ret = get_funcion_equivalente_x_hijos_x_unico_padre ( funcion1 , funciones1 , funciones2 , funcion2 );
+
+    if ( ret == TRUE )
+    {
+//      my_msg ( "un solo padre: %x - %x\n" , funcion1 -> address , ( *funcion2 ) -> address );
+    }
+  }
+
+  return ( ret );
+}
+
+/****************************************************************************/
+
+int get_funcion_equivalente_x_hijos_x_padres_en_comun ( Funcion *funcion1 , List &funciones1 , List &funciones2 , Funcion **funcion2 )
+{
+  List funciones_padre2;
+  List funciones_padre2_interseccion;
+  Basic_Block *basic_block;
+  Basic_Block_Padre *basic_block_padre2;
+  Funcion *funcion_hija;
+  Funcion *funcion_hija2;
+  Funcion *funcion_padre2;
+  unsigned int cont, cont2, cont3;
+  int primera_iteracion = TRUE;
+  int ret = FALSE;
+
+/* Recorro todos los basic blocks */
+  for ( cont = 0 ; cont < funcion1 -> cantidad_basic_blocks ; cont ++ )
+  {
+  /* Levanto el siguiente basic block */
+    basic_block = funcion1 -> basic_blocks [ cont ];
+
+  /* Recorro todas las referencias hijas del basic block */
+    for ( cont2 = 0 ; cont2 < basic_block -> funciones_hijas -> Len () ; cont2 ++ )
+    {
+    /* Levanto la siguiente funcion */
+      funcion_hija = get_funcion_llamada ( funciones1 , funcion1 , basic_block , cont2 );
+
+    /* Si la funcion existe */
+      if ( funcion_hija != NULL )
+      {
+      /* Si la funcion hija fue reconocida */
+        if ( ( funcion_hija -> identica == TRUE ) || ( funcion_hija -> patcheada == TRUE ) )
+        {
+        /* Levanto la funcion hija en programa 2 */
+          funcion_hija2 = get_estructura_funcion ( funciones2 , funcion_hija -> address_equivalente );
+
+        /* Recorro todos los basic blocks padres */
+          for ( cont3 = 0 ; cont3 < funcion_hija2 -> cantidad_referencias_padre ; cont3 ++ )
+          {
+          /* Levanto el proximo basic block padre */
+            basic_block_padre2 = &funcion_hija2 -> basic_blocks_padres [ cont3 ];
+
+          /* Levanto la funcion a la que pertenece */
+            funcion_padre2 = ( Funcion * ) basic_block_padre2 -> funcion;
+
+          /* Si la funcion padre de funcion2 no fue reconocida */  
+            if ( ( funcion_padre2 -> identica == FALSE ) && ( funcion_padre2 -> patcheada == FALSE ) )
+            {
+            /* Si es la primera iteracion, armo la lista inicial */
+              if ( primera_iteracion == TRUE )
+              {
+              /* Si la funcion no fue agregada ( una funcion puede llamar varias veces a otra ) */
+                if ( funciones_padre2.Find ( funcion_padre2 ) == FALSE )
+                {
+                /* Agrego el elemento a la lista */
+                  funciones_padre2.Add ( funcion_padre2 );
+                }
+              }
+            /* Comienzo a quedarme con los elementos en comun */
+              else
+              {
+              /* Si la funcion padre esta en la lista anterior */
+                if ( funciones_padre2.Find ( funcion_padre2 ) == TRUE )
+                {
+                /* Si la funcion no fue agregada ( una funcion puede llamar varias veces a otra ) */
+                  if ( funciones_padre2_interseccion.Find ( funcion_padre2 ) == FALSE )
+                  {
+                 /* Agrego el elemento a la lista */
+                    funciones_padre2_interseccion.Add ( funcion_padre2 );
+                  }
+                }
+              }
+            }
+          }
+
+        /* Si no es la primera vez, libero la lista vieja */
+          if ( primera_iteracion == FALSE )
+          {
+            funciones_padre2.Clear ();
+
+          /* Paso la lista de intersecciones a la lista comun */
+            for ( cont3 = 0 ; cont3 < funciones_padre2_interseccion.Len () ; cont3 ++ )
+            {
+            /* Levanto el siguiente elemento y lo agrego a la lista */
+              funciones_padre2.Add ( funciones_padre2_interseccion.Get ( cont3 ) );
+            }
+
+          /* Libero la lista de intersecciones */
+            funciones_padre2_interseccion.Clear ();
+          }
+        }
+//      /* No puedo confiar si no tengo todas las funciones hijas reconocidas */
+//        else
+//        {
+//          my_msg ( "me quede sin padres en funcion %x - hijo %x\n" , funcion1 -> address , funcion_hija -> address );
+//
+//        /* No pude encontrar la funcion equivalente */
+//          return ( FALSE );
+//        }
+
+      /* Anulo la condicion despues de procesar la primera funcion hija */
+        primera_iteracion = FALSE;
+      }
+    /* Algo no esta bien */
+      else
+      {
+        my_msg ( "inconsistencia en la funcion %x, bb %x, hija %x\n" , funcion1 -> address , basic_block -> addr_inicial , ( unsigned int ) basic_block -> funciones_hijas -> Get ( cont2 ) );
+      }
+    }
+  }
+
+/* Si me quedo el padre en comun */
+  if ( funciones_padre2.Len () == 1 )
+  {
+//    my_msg ( "wiiiiiiiiiiiiiiiiiiiii\n" );
+
+  /* Retorno la funcion equivalente en programa 2 */
+    *funcion2 = ( Funcion * ) funciones_padre2.Get ( 0 );
+
+  /* Retorno OK */
+    ret = TRUE;
+  }
+  else
+  {
+//    my_msg ( "saliendo con %i padres \n" , funciones_padre2.Len () );
+  }
+
+  return ( ret );
+}
+
+/****************************************************************************/
+
+int get_funcion_equivalente_x_hijos_x_unico_padre ( Funcion *funcion1 , List &funciones1 , List &funciones2 , Funcion **funcion2 )
+{
+  Basic_Block *basic_block;
+  Basic_Block_Padre *basic_block_padre2;
+  Funcion *funcion_hija;
+  Funcion *funcion_hija2;
+  Funcion *funcion_padre2;
+  Funcion *funcion2_candidata;
+  unsigned int cont, cont2, cont3;
+  int padre_detectado = FALSE;
+  int ret = FALSE;
+
+/* Recorro todos los basic blocks */
+  for ( cont = 0 ; cont < funcion1 -> cantidad_basic_blocks ; cont ++ )
+  {
+  /* Levanto el siguiente basic block */
+    basic_block = funcion1 -> basic_blocks [ cont ];
+
+  /* Recorro todas las referencias hijas del basic block */
+    for ( cont2 = 0 ; cont2 < basic_block -> funciones_hijas -> Len () ; cont2 ++ )
+    {
+    /* Levanto la siguiente funcion */
+      funcion_hija = get_funcion_llamada ( funciones1 , funcion1 , basic_block , cont2 );
+
+    /* Si la funcion existe */
+      if ( funcion_hija != NULL )
+      {
+      /* Si la funcion hija fue reconocida */
+        if ( ( funcion_hija -> identica == TRUE ) || ( funcion_hija -> patcheada == TRUE ) )
+        {
+        /* Levanto la funcion hija en programa 2 */
+          funcion_hija2 = get_estructura_funcion ( funciones2 , funcion_hija -> address_equivalente );
+
+        /* Recorro todos los basic blocks padres */
+          for ( cont3 = 0 ; cont3 < funcion_hija2 -> cantidad_referencias_padre ; cont3 ++ )
+          {
+          /* Levanto el proximo basic block padre */
+            basic_block_padre2 = &funcion_hija2 -> basic_blocks_padres [ cont3 ];
+
+          /* Levanto la funcion a la que pertenece */
+            funcion_padre2 = ( Funcion * ) basic_block_padre2 -> funcion;
+
+          /* Si la funcion padre de funcion2 no fue reconocida */
+            if ( ( funcion_padre2 -> identica == FALSE ) && ( funcion_padre2 -> patcheada == FALSE ) )
+            {
+            /* Si es el primer candidato */
+              if ( padre_detectado == FALSE )
+              {
+              /* Aca tengo un candidato */
+                funcion2_candidata = funcion_padre2;
+
+              /* Para que no vuelva a entrar */
+                padre_detectado = TRUE;
+
+              /* Marco la salida como OK */
+                ret = TRUE;
+              }
+            /* Si tengo mas de un candidato NO me sirve */
+              else
+              {
+                return ( FALSE );
+              }
+            }
+          }
+        }
+      }
+    }
+  }
+
+/* Si encontre un candidato */
+  if ( ret == TRUE )
+  {
+  /* Retorno la funcion par que encontre */
+    *funcion2 = funcion2_candidata;
+  }
+
+  return ( ret );
+}
+
+/****************************************************************************/
+
+int clasificar_funciones_cambiadas ( List &funciones1_cambiadas , List &funciones2_cambiadas , List &funciones1_matcheadas , List &funciones2_matcheadas )
+{
+  Funcion *funcion1;
+  Funcion *funcion2;
+  unsigned int cont;
+  int ret = TRUE;
+
+/* Recorro todas las funciones cambiadas */
+  for ( cont = 0 ; cont < funciones1_cambiadas.Len () ; cont ++ )
+  {
+  /* Levanto funcion1 */
+    funcion1 = ( Funcion * ) funciones1_cambiadas.Get ( cont );
+
+  /* Levanto funcion2 */
+    funcion2 = ( Funcion * ) funciones2_cambiadas.Get ( cont );
+
+  /* Si las 2 funciones tienen la misma cantida de instrucciones y son geometricamente identicas */
+    if ( son_funciones_cuasi_identicas ( funcion1 , funcion2 ) == TRUE )
+    {
+    /* Saco las funciones de la lista de cambiadas */
+      funciones1_cambiadas.Delete ( cont );
+      funciones2_cambiadas.Delete ( cont );
+
+    /* Agrego las funciones a la lista de funciones con cambios triviales */
+      funciones1_matcheadas.Add ( ( void * ) funcion1 );
+      funciones2_matcheadas.Add ( ( void * ) funcion2 );
+
+    /* Cuento la reclasificacion */
+      fase_actual -> matcheos ++;
+
+    /* Emito la nueva categoria del par */
+      emitir_registro_resultado ( "matched" , funcion1 , funcion2 , get_similitud_de_filtros ( funcion1 , funcion2 ) );
+
+    /* Complemento la extraccion del elemento */
+      cont --;
+    }
+  /* Si las 2 funciones tienen el mismo grafo, puedo asumir que NO tiene cambios importantes */
+    else if ( strcmp ( funcion1 -> graph_ecuation , funcion2 -> graph_ecuation ) == 0 )
+    {
+    /* Saco las funciones de la lista de cambiadas */
+      funciones1_cambiadas.Delete ( cont );
+      funciones2_cambiadas.Delete ( cont );
+
+    /* Agrego las funciones a la lista de funciones con cambios triviales */
+      funciones1_geometricamente_identicas.Add ( ( void * ) funcion1 );
+      funciones2_geometricamente_identicas.Add ( ( void * ) funcion2 );
+
+    /* Cuento la reclasificacion */
+      fase_actual -> matcheos ++;
+
+    /* Emito la nueva categoria del par */
+      emitir_registro_resultado ( "matched_graph" , funcion1 , funcion2 , get_similitud_de_filtros ( funcion1 , funcion2 ) );
+
+    /* Complemento la extraccion del elemento */
+      cont --;
+    }
+  }
+
+  return ( ret );
+}
+
+/****************************************************************************/
+
+unsigned int reutilizar_comparacion_previa ( char *file1 , char *file2 )
+{
+  Funcion *funcion1;
+  Funcion *funcion2;
+  unsigned int match_value;
+  unsigned int address1;
+  unsigned int address2;
+  unsigned int reutilizadas = 0;
+  unsigned int pos;
+
+/* Si NO hay una comparacion previa de estos 2 files */
+  if ( levantar_resultados ( file1 , file2 ) == FALSE )
+  {
+  /* Mensaje al usuario */
+    my_msg ( "previous comparison not found, comparing from scratch\n" );
+
+  /* No hay nada para reusar */
+    return ( 0 );
+  }
+
+/* Si la comparacion previa fue guardada sin huellas */
+  if ( ( huellas1.Len () == 0 ) || ( huellas2.Len () == 0 ) )
+  {
+  /* Mensaje al usuario */
+    my_msg ( "previous comparison without fingerprints, comparing from scratch\n" );
+  }
+
+/* Recorro todos los matcheos de la comparacion previa */
+  for ( pos = 0 ; pos < matcheo_1_2.Len () ; pos ++ )
+  {
+  /* Obtengo el valor de matcheo */
+    match_value = ( unsigned int ) matcheo_1_2.Get ( pos );
+
+  /* Si son funciones UNMATCHEDs, las vuelvo a comparar */
+    if ( ( match_value == UNMATCHED1_MATCH ) || ( match_value == UNMATCHED2_MATCH ) )
+    {
+      continue;
+    }
+
+  /* Obtengo la direccion de las funciones matcheadas */
+    address1 = ( unsigned int ) resultado1.Get ( pos );
+    address2 = ( unsigned int ) resultado2.Get ( pos );
+
+  /* Busco las funciones en los analisis actuales */
+    funcion1 = get_estructura_funcion2 ( indice_funciones1 , funciones1 , address1 );
+    funcion2 = get_estructura_funcion2 ( indice_funciones2 , funciones2 , address2 );
+
+  /* Si alguna de las funciones ya no existe */
+    if ( ( funcion1 == NULL ) || ( funcion2 == NULL ) )
+    {
+      continue;
+    }
+
+  /* Si alguna de las funciones cambio desde la comparacion previa */
+    if ( ( es_huella_vigente ( indice_huellas1 , huellas1 , funcion1 ) == FALSE ) || ( es_huella_vigente ( indice_huellas2 , huellas2 , funcion2 ) == FALSE ) )
+    {
+      continue;
+    }
+
+  /* Si las funciones eran identicas */
+    if ( match_value == IDENTICAL_MATCH )
+    {
+    /* Relaciono las funciones */
+      asociar_funciones ( TRUE , funcion1 , funcion2 , funciones1_reconocidas , funciones2_reconocidas , funciones1_levantadas , funciones2_levantadas );
+    }
+  /* Si eran funciones cambiadas ( se vuelven a clasificar al final ) */
+    else
+    {
+    /* Relaciono las funciones */
+      asociar_funciones ( FALSE , funcion1 , funcion2 , funciones1_cambiadas , funciones2_cambiadas , funciones1_levantadas , funciones2_levantadas );
+    }
+
+  /* Incremento la cantidad de matcheos reusados */
+    reutilizadas ++;
+  }
+
+/* Limpio los resultados previos ( los nuevos se arman al final ) */
+  matcheo_1_2.Clear ();
+  resultado1.Clear ();
+  resultado2.Clear ();
+
+/* Libero las huellas de los 2 files */
+  liberar_huellas ();
+
+  return ( reutilizadas );
+}
+
+/****************************************************************************/
+
+int es_huella_vigente ( List &indice_huellas , List &huellas , Funcion *funcion )
+{
+  Huella_Funcion *huella_previa;
+  Huella_Funcion huella;
+  unsigned int pos;
+  int ret = FALSE;
+
+/* Si la funcion tenia huella en la comparacion previa */
+  if ( indice_huellas.GetPos ( ( void * ) funcion -> address , &pos ) == TRUE )
+  {
+  /* Levanto la huella previa */
+    huella_previa = ( Huella_Funcion * ) huellas.Get ( pos );
+
+  /* Calculo la huella actual de la funcion */
+    calcular_huella_de_funcion ( funcion , &huella );
+
+  /* Si la funcion NO cambio */
+    if ( memcmp ( huella_previa , &huella , sizeof ( Huella_Funcion ) ) == 0 )
+    {
+    /* Retorno OK */
+      ret = TRUE;
+    }
+  }
+
+  return ( ret );
+}
+
+/****************************************************************************/
+
+int armar_resultados ( void )
+{
+  Funcion *funcion1;
+  Funcion *funcion2;
+  unsigned int cont;
+  int ret = TRUE;
+
+/* Empiezo con los resultados vacios */
+  matcheo_1_2.Clear ();
+  resultado1.Clear ();
+  resultado2.Clear ();
+  liberar_filas_resultados ();
+
+/* Funciones identicas */
+  for ( cont = 0 ; cont < funciones1_reconocidas.Len () ; cont ++ )
+  {
+  /* Levanto las funciones IDENTICAS */
+    funcion1 = ( Funcion * ) funciones1_reconocidas.Get ( cont );
+    funcion2 = ( Funcion * ) funciones2_reconocidas.Get ( cont );
+
+  /* Agrego el tipo de matcheo a la lista */
+    matcheo_1_2.Add ( ( void * ) IDENTICAL_MATCH );
+
+  /* Agrego la direccion de las funciones a las listas */
+    resultado1.Add ( ( void * ) funcion1 -> address );
+    resultado2.Add ( ( void * ) funcion2 -> address );
+
+  /* Agrego la fila que muestra el chooser */
+    agregar_fila_resultado ( IDENTICAL_MATCH , funcion1 , funcion2 );
+  }
+
+//////////////////////////////
+
+/* Funciones con grafo identico, misma cantidad de instrucciones */
+  for ( cont = 0 ; cont < funciones1_matcheadas.Len () ; cont ++ )
+  {
+  /* Levanto las funciones MATCHEADAS */
+    funcion1 = ( Funcion * ) funciones1_matcheadas.Get ( cont );
+    funcion2 = ( Funcion * ) funciones2_matcheadas.Get ( cont );
+
+  /* Agrego el tipo de matcheo a la lista */
+    matcheo_1_2.Add ( ( void * ) CHANGED_1_MATCH );
+
+  /* Agrego la direccion de las funciones a las listas */
+    resultado1.Add ( ( void * ) funcion1 -> address );
+    resultado2.Add ( ( void * ) funcion2 -> address );
+
+  /* Agrego la fila que muestra el chooser */
+    agregar_fila_resultado ( CHANGED_1_MATCH , funcion1 , funcion2 );
+  }
+
+//////////////////////////////
+
+/* Funciones con grafo identico */
+  for ( cont = 0 ; cont < funciones1_geometricamente_identicas.Len () ; cont ++ )
+  {
+  /* Levanto las funciones GEOMETRICAMENTE IDENTICAS */
+    funcion1 = ( Funcion * ) funciones1_geometricamente_identicas.Get ( cont );
+    funcion2 = ( Funcion * ) funciones2_geometricamente_identicas.Get ( cont );
+
+  /* Agrego el tipo de matcheo a la lista */
+    matcheo_1_2.Add ( ( void * ) CHANGED_2_MATCH );
+
+  /* Agrego la direccion de las funciones a las listas */
+    resultado1.Add ( ( void * ) funcion1 -> address );
+    resultado2.Add ( ( void * ) funcion2 -> address );
+
+  /* Agrego la fila que muestra el chooser */
+    agregar_fila_resultado ( CHANGED_2_MATCH , funcion1 , funcion2 );
+  }
+
+//////////////////////////////
+
+/* Funciones con grafo distinto */
+  for ( cont = 0 ; cont < funciones1_cambiadas.Len () ; cont ++ )
+  {
+  /* Levanto las funciones MATCHEADAS POR CALL GRAPH */
+    funcion1 = ( Funcion * ) funciones1_cambiadas.Get ( cont );
+    funcion2 = ( Funcion * ) funciones2_cambiadas.Get ( cont );
+
+  /* Agrego el tipo de matcheo a la lista */
+    matcheo_1_2.Add ( ( void * ) CHANGED_3_MATCH );
+
+  /* Agrego la direccion de las funciones a las listas */
+    resultado1.Add ( ( void * ) funcion1 -> address );
+    resultado2.Add ( ( void * ) funcion2 -> address );
+
+  /* Agrego la fila que muestra el chooser */
+    agregar_fila_resultado ( CHANGED_3_MATCH , funcion1 , funcion2 );
+  }
+
+//////////////////////////////
+
+/* Funciones de programa 1 que no pudieron asociarse */
+  for ( cont = 0 ; cont < funciones1_irreconocidas.Len () ; cont ++ )
+  {
+  /* Levanto las funciones GEOMETRICAMENTE IDENTICAS */
+    funcion1 = ( Funcion * ) funciones1_irreconocidas.Get ( cont );
+
+  /* Agrego el tipo de matcheo a la lista */
+    matcheo_1_2.Add ( ( void * ) UNMATCHED1_MATCH );
+
+  /* Agrego la direccion de las funciones a las listas */
+    resultado1.Add ( ( void * ) funcion1 -> address );
+    resultado2.Add ( ( void * ) NULL );
+
+  /* Agrego la fila que muestra el chooser */
+    agregar_fila_resultado ( UNMATCHED1_MATCH , funcion1 , NULL );
+  }
+
+//////////////////////////////
+
+/* Funciones de programa2 que no pudieron asociarse */
+  for ( cont = 0 ; cont < funciones2_irreconocidas.Len () ; cont ++ )
+  {
+  /* Levanto las funciones GEOMETRICAMENTE IDENTICAS */
+    funcion2 = ( Funcion * ) funciones2_irreconocidas.Get ( cont );
+
+  /* Agrego la direccion de las funciones a las listas */
+    matcheo_1_2.Add ( ( void * ) UNMATCHED2_MATCH );
+
+  /* Agrego la direccion de las funciones a las listas */
+    resultado1.Add ( ( void * ) NULL );
+    resultado2.Add ( ( void * ) funcion2 -> address );
+
+  /* Agrego la fila que muestra el chooser */
+    agregar_fila_resultado ( UNMATCHED2_MATCH , NULL , funcion2 );
+  }
+
+//////////////////////////////
+
+  return ( ret );
+}
+
+/****************************************************************************/
+
+void agregar_fila_resultado ( unsigned int match_value , Funcion *funcion1 , Funcion *funcion2 )
+{
+  Fila_Resultado *fila;
+  char name [ NAME_LEN ];
+
+/* Alloco la fila */
+  fila = ( Fila_Resultado * ) malloc ( sizeof ( Fila_Resultado ) );
+
+/* Guardo el matcheo y las funciones */
+  fila -> match_value = match_value;
+  fila -> funcion1 = funcion1;
+  fila -> funcion2 = funcion2;
+
+/* Si hay funcion de programa1 */
+  if ( funcion1 != NULL )
+  {
+  /* Formateo la direccion y el nombre */
+    qsnprintf ( fila -> direccion1 , sizeof ( fila -> direccion1 ) , "%x" , funcion1 -> address );
+    get_formated_name ( funcion1 , name , NAME_LEN , FALSE );
+    fila -> nombre1 = ( char * ) malloc ( strlen ( name ) + 1 );
+    strcpy ( fila -> nombre1 , name );
+  }
+  else
+  {
+  /* Dejo las columnas vacias */
+    qstrncpy ( fila -> direccion1 , "-" , sizeof ( fila -> direccion1 ) );
+    fila -> nombre1 = NULL;
+  }
+
+/* Si hay funcion de programa2 */
+  if ( funcion2 != NULL )
+  {
+  /* Formateo la direccion y el nombre */
+    qsnprintf ( fila -> direccion2 , sizeof ( fila -> direccion2 ) , "%x" , funcion2 -> address );
+    get_formated_name ( funcion2 , name , NAME_LEN , FALSE );
+    fila -> nombre2 = ( char * ) malloc ( strlen ( name ) + 1 );
+    strcpy ( fila -> nombre2 , name );
+  }
+  else
+  {
+  /* Dejo las columnas vacias */
+    qstrncpy ( fila -> direccion2 , "-" , sizeof ( fila -> direccion2 ) );
+    fila -> nombre2 = NULL;
+  }
+
+/* Agrego la fila a la tabla */
+  filas_resultados.Add ( ( void * ) fila );
+}
+
+/****************************************************************************/
+
+void liberar_filas_resultados ( void )
+{
+  Fila_Resultado *fila;
+  unsigned int pos;
+
+/* Libero todas las filas */
+  for ( pos = 0 ; pos < filas_resultados.Len () ; pos ++ )
+  {
+  /* Levanto la siguiente fila */
+    fila = ( Fila_Resultado * ) filas_resultados.Get ( pos );
+
+  /* Libero los nombres y la fila */
+    free ( fila -> nombre1 );
+    free ( fila -> nombre2 );
+    free ( fila );
+  }
+
+/* Vacio la tabla */
+  filas_resultados.Clear ();
+}
+
+/****************************************************************************/
+
+int guardar_resultados ( char *file1 , char *file2 )
+{
+  char result_file [ QMAXPATH ];
+  char file2_copy [ QMAXPATH ];
+  char *file2_name;
+  char *point;
+  FILE *f;
+  int ret;
+
+/* Me hago una copia del nombre completo de file1 */
+  qstrncpy ( result_file , file1 , QMAXPATH );
+
+/* Ubico el nombre de file2 */
+  file2_name = strrchr ( file2 , '\\' );
+
+/* Hago una copia del nombre file2 */
+  qstrncpy ( file2_copy , file2_name + 1 , QMAXPATH );
+
+/* Ubico el punto que separa el nombre de la extension */
+  point = strrchr ( file2_copy , '.' );
+
+/* Cierro el string donde esta el punto */
+  *point = '\0';
+
+/* Armo el nombre del file donde van a ir a parar los resultados */
+  change_extension ( result_file , file2_copy );
+
+/* Abro el archivo */
+  f = qfopen ( result_file , "wb" );
+
+/* Si pude abrir el archivo */
+  if ( f != NULL )
+  {
+  /* Guardo las listas en el file */
+    matcheo_1_2.Save ( f );
+    resultado1.Save ( f );
+    resultado2.Save ( f );
+
+  /* Guardo las huellas para poder hacer comparaciones incrementales */
+    guardar_huellas ( f , funciones1 );
+    guardar_huellas ( f , funciones2 );
+
+  /* Cierro el archivo */
+    qfclose ( f );
+
+  /* Retorno OK */
+    ret = TRUE;
+  }
+  else
+  {
+  /* Retorno ERROR */
+    ret = FALSE;
+  }
+
+  return ( ret );
+}
+
+/****************************************************************************/
+
+int levantar_resultados ( char *file1 , char *file2 )
+{
+  char result_file [ QMAXPATH ];
+  char file2_copy [ QMAXPATH ];
+  char *file2_name;
+  char *point;
+  Funcion *funcion1;
+  Funcion *funcion2;
+  unsigned int match_value;
+  unsigned int pos;
+  FILE *f;
+  int ret;
+
+/* Me hago una copia del nombre completo de file1 */
+  qstrncpy ( result_file , file1 , QMAXPATH );
+
+/* Ubico el nombre de file2 */
+  file2_name = strrchr ( file2 , '\\' );
+
+/* Hago una copia del nombre file2 */
+  qstrncpy ( file2_copy , file2_name + 1 , QMAXPATH );
+
+/* Ubico el punto que separa el nombre de la extension */
+  point = strrchr ( file2_copy , '.' );
+
+/* Cierro el string donde esta el punto */
+  *point = '\0';
+
+/* Armo el nombre del file donde van a ir a parar los resultados */
+  change_extension ( result_file , file2_copy );
+
+/* Abro el archivo */
+  f = qfopen ( result_file , "rb" );
+
+/* Si pude abrir el archivo */
+  if ( f != NULL )
+  {
+  /* Levanto las listas desde el file */
+    matcheo_1_2.Load ( f );
+    resultado1.Load ( f );
+    resultado2.Load ( f );
+
+  /* Levanto las huellas ( los resultados viejos no las tienen ) */
+    levantar_huellas ( f , indice_huellas1 , huellas1 );
+    levantar_huellas ( f , indice_huellas2 , huellas2 );
+
+  /* Cierro el archivo */
+    qfclose ( f );
+
+  /* Armo las filas que muestra el chooser */
+    liberar_filas_resultados ();
+
+    for ( pos = 0 ; pos < matcheo_1_2.Len () ; pos ++ )
+    {
+    /* Busco las funciones matcheadas en los analisis levantados */
+      funcion1 = get_estructura_funcion2 ( indice_funciones1 , funciones1 , ( unsigned int ) resultado1.Get ( pos ) );
+      funcion2 = get_estructura_funcion2 ( indice_funciones2 , funciones2 , ( unsigned int ) resultado2.Get ( pos ) );
+
+    /* Levanto el matcheo guardado */
+      match_value = ( unsigned int ) matcheo_1_2.Get ( pos );
+
+    /* Si ninguna de las funciones esta en los analisis */
+      if ( ( funcion1 == NULL ) && ( funcion2 == NULL ) )
+      {
+        continue;
+      }
+
+    /* Si falta la funcion de programa2, la muestro como no matcheada ( no se puede diffear ) */
+      if ( funcion2 == NULL )
+      {
+        match_value = UNMATCHED1_MATCH;
+      }
+    /* Si falta la funcion de programa1 */
+      else if ( funcion1 == NULL )
+      {
+        match_value = UNMATCHED2_MATCH;
+      }
+
+    /* Agrego la fila con el matcheo guardado */
+      agregar_fila_resultado ( match_value , funcion1 , funcion2 );
+    }
+
+  /* Retorno OK */
+    ret = TRUE;
+  }
+  else
+  {
+  /* Retorno ERROR */
+    ret = FALSE;
+  }
+
+  return ( ret );
+}
+
+/****************************************************************************/
+
+int guardar_huellas ( FILE *f , List &funciones )
+{
+  Huella_Funcion huella;
+  unsigned int cantidad_huellas;
+  unsigned int pos;
+  int ret = TRUE;
+
+/* Guardo la cantidad de huellas */
+  cantidad_huellas = funciones.Len ();
+  qfwrite ( f , &cantidad_huellas , sizeof ( unsigned int ) );
+
+/* Recorro todas las funciones */
+  for ( pos = 0 ; pos < funciones.Len () ; pos ++ )
+  {
+  /* Calculo la huella de la siguiente funcion */
+    calcular_huella_de_funcion ( ( Funcion * ) funciones.Get ( pos ) , &huella );
+
+  /* Guardo la huella */
+    qfwrite ( f , &huella , sizeof ( Huella_Funcion ) );
+  }
+
+  return ( ret );
+}
+
+/****************************************************************************/
+
+int levantar_huellas ( FILE *f , List &indice_huellas , List &huellas )
+{
+  Huella_Funcion *huella;
+  unsigned int cantidad_huellas;
+  unsigned int pos;
+  int ret = TRUE;
+
+/* Si NO hay huellas guardadas */
+  if ( qfread ( f , &cantidad_huellas , sizeof ( unsigned int ) ) != sizeof ( unsigned int ) )
+  {
+  /* Retorno ERROR */
+    return ( FALSE );
+  }
+
+/* Levanto todas las huellas */
+  for ( pos = 0 ; pos < cantidad_huellas ; pos ++ )
+  {
+  /* Alloco espacio para la siguiente huella */
+    huella = ( Huella_Funcion * ) malloc ( sizeof ( Huella_Funcion ) );
+
+  /* Levanto la huella */
+    qfread ( f , huella , sizeof ( Huella_Funcion ) );
+
+  /* Agrego la huella a las listas */
+    indice_huellas.Add ( ( void * ) huella -> address );
+    huellas.Add ( huella );
+  }
+
+  return ( ret );
+}
+
+/****************************************************************************/
+
+void liberar_huellas ( void )
+{
+  unsigned int pos;
+
+/* Libero las huellas de los 2 files */
+  for ( pos = 0 ; pos < huellas1.Len () ; pos ++ )
+  {
+    free ( huellas1.Get ( pos ) );
+  }
+
+  for ( pos = 0 ; pos < huellas2.Len () ; pos ++ )
+  {
+    free ( huellas2.Get ( pos ) );
+  }
+
+/* Limpio las listas de huellas */
+  indice_huellas1.Clear ();
+  huellas1.Clear ();
+  indice_huellas2.Clear ();
+  huellas2.Clear ();
+}
+
+/****************************************************************************/
+
+void calcular_huella_de_funcion ( Funcion *funcion , Huella_Funcion *huella )
+{
+  Basic_Block *basic_block;
+  unsigned int hash = HASH_INICIAL;
+  unsigned int valor;
+  unsigned int cont, cont2;
+
+/* Copio los datos generales de la funcion */
+  huella -> address = funcion -> address;
+  huella -> checksum = funcion -> checksum;
+  huella -> checksum_real = funcion -> checksum_real;
+  huella -> longitud = funcion -> longitud;
+  huella -> cantidad_basic_blocks = funcion -> cantidad_basic_blocks;
+  huella -> conexiones_internas = funcion -> conexiones_internas;
+
+/* Agrego la forma del grafo ( no depende de las direcciones ) */
+  hash = calcular_hash ( hash , &funcion -> hash_grafo , sizeof ( unsigned int ) );
+
+/* Recorro todos los basic blocks de la funcion */
+  for ( cont = 0 ; cont < funcion -> cantidad_basic_blocks ; cont ++ )
+  {
+  /* Levanto el siguiente basic block */
+    basic_block = funcion -> basic_blocks [ cont ];
+
+  /* Agrego los datos del basic block al hash ( la posicion relativa al inicio de la funcion ) */
+    valor = basic_block -> addr_inicial - funcion -> address;
+    hash = calcular_hash ( hash , &valor , sizeof ( unsigned int ) );
+    hash = calcular_hash ( hash , &basic_block -> longitud , sizeof ( unsigned int ) );
+    hash = calcular_hash ( hash , &basic_block -> checksum , sizeof ( unsigned int ) );
+
+  /* Agrego las conexiones con los basic blocks hijos ( relativas al inicio de la funcion ) */
+    for ( cont2 = 0 ; cont2 < basic_block -> basic_blocks_hijos -> Len () ; cont2 ++ )
+    {
+      valor = ( unsigned int ) basic_block -> basic_blocks_hijos -> Get ( cont2 ) - funcion -> address;
+      hash = calcular_hash ( hash , &valor , sizeof ( unsigned int ) );
+    }
+
+  /* Agrego la cantidad de llamados a funciones */
+    valor = basic_block -> funciones_hijas -> Len ();
+    hash = calcular_hash ( hash , &valor , sizeof ( unsigned int ) );
+
+  /* Agrego las funciones llamadas ( si cambia a quien llama, la funcion cambio aunque su cuerpo no ) */
+    for ( cont2 = 0 ; cont2 < basic_block -> funciones_hijas -> Len () ; cont2 ++ )
+    {
+      valor = ( unsigned int ) basic_block -> funciones_hijas -> Get ( cont2 );
+      hash = calcular_hash ( hash , &valor , sizeof ( unsigned int ) );
+    }
+  }
+
+/* Guardo el hash del cuerpo de la funcion */
+  huella -> hash_cuerpo = hash;
+}
+
+/****************************************************************************/
+
+unsigned int calcular_hash ( unsigned int hash , void *datos , unsigned int len )
+{
+  unsigned char *bytes = ( unsigned char * ) datos;
+  unsigned int cont;
+
+/* Mezclo byte a byte ( FNV-1a ) */
+  for ( cont = 0 ; cont < len ; cont ++ )
+  {
+    hash = ( hash ^ bytes [ cont ] ) * HASH_PRIMO;
+  }
+
+  return ( hash );
+}
+
+/****************************************************************************/
+
+int mostrar_resultados ( char *file1 , char *file2 )
+{
+  Fila_Resultado *fila;
+  Funcion *funcion1;
+  Funcion *funcion2;
+  int pos = 0;
+  int ret = TRUE;
+
+/* Espero que el usuario elija alguna opcion */
+  while ( ( pos = mostrar_funciones ( pos + 1 ) ) != -1 )
+  {
+  /* Levanto la fila elegida */
+    fila = ( Fila_Resultado * ) filas_resultados.Get ( pos );
+
+  /* Si NO son funciones UNMATCHEDs */
+    if ( ( fila -> match_value != UNMATCHED1_MATCH ) && ( fila -> match_value != UNMATCHED2_MATCH ) )
+    {
+    /* Levanto las funciones */
+      funcion1 = fila -> funcion1;
+      funcion2 = fila -> funcion2;
+
+    /* Si las funciones fueron levantadas por demanda */
+      if ( ( file_por_demanda1 != NULL ) && ( file_por_demanda2 != NULL ) )
+      {
+      /* Levanto los cuerpos de las 2 funciones */
+        levantar_funcion_por_demanda ( file_por_demanda1 , indice_funciones1 , funciones1 , posiciones_funciones1 , funcion1 );
+        levantar_funcion_por_demanda ( file_por_demanda2 , indice_funciones2 , funciones2 , posiciones_funciones2 , funcion2 );
+      }
+
+    /* Diffeo las 2 funciones */
+      diffear_y_mostrar_funciones ( file1 , file2 , funcion1 , funcion2 );
+    }
+    else
+    {
+    /* Mensaje al usuario */
+      my_msg ( "Don't choose unmatched functions !\n" );
+    }
+  }
+
+  return ( ret );
+}
+
+/****************************************************************************/
+/****************************************************************************/
+
+void idaapi armar_columnas ( void *obj , unsigned int columna , char *arrptr [] )
+{
+  char *match_types [] = { "identical" , "suspicious +" , "suspicious ++" , "changed" , "unmatched 1" , "unmatched 2" };
+  Fila_Resultado *fila;
+
+/* Si es la primera llamada */
+/* Armo el nombre de las columnas */
+  if ( columna == 0 )
+  {
+    qstrncpy ( arrptr [ 0 ] , "category" , QMAXPATH );
+    qstrncpy ( arrptr [ 1 ] , "address" , QMAXPATH );  
+    qstrncpy ( arrptr [ 2 ] , "name" , QMAXPATH );  
+    qstrncpy ( arrptr [ 3 ] , "address" , QMAXPATH );  
+    qstrncpy ( arrptr [ 4 ] , "name" , QMAXPATH );  
+  }
+/* Lleno el contenido de las columnas */
+  else
+  {
+  /* Levanto la fila ( normalizando la posicion ) */
+    fila = ( Fila_Resultado * ) filas_resultados.Get ( columna - 1 );
+
+  /* Pongo la categoria */
+    qsnprintf ( arrptr [ 0 ] , 14 , match_types [ fila -> match_value ] );
+
+  /* Pongo la direccion y el nombre de funcion1 */
+    qsnprintf ( arrptr [ 1 ] , 10 , "%s" , fila -> direccion1 );
+    qsnprintf ( arrptr [ 2 ] , NAME_LEN , "%s" , ( fila -> nombre1 != NULL ) ? fila -> nombre1 : "-" );
+
+  /* Pongo la direccion y el nombre de funcion2 */
+    qsnprintf ( arrptr [ 3 ] , 10 , "%s" , fila -> direccion2 );
+    qsnprintf ( arrptr [ 4 ] , NAME_LEN , "%s" , ( fila -> nombre2 != NULL ) ? fila -> nombre2 : "-" );
+  }
+}
+
+/****************************************************************************/
+
+unsigned int idaapi retornar_size ( void *obj )
+{
+  return ( filas_resultados.Len () );
+}
+
+/****************************************************************************/
+
+void idaapi enter_function ( void *obj , unsigned int columna )
+{
+  my_msg ( "columna: %i\n" , columna );
+}
+
+/****************************************************************************/
+
+void idaapi destroy_function ( void *obj )
+{
+}
+
+/****************************************************************************/
+
+unsigned int mostrar_funciones ( unsigned int pos )
+{
+  int anchos [] = { 14 , 10 , 30 , 10 , 30 };
+  unsigned int ret;
+
+  ret = my_choose (
+            true,
+            -1, -1, -1, -1,
+            NULL,                         // node
+            5,                            // numero de columnas
+            anchos,                       // ancho de columnas
+            ( void * ) retornar_size,     // callback a funcion que retorna n de lineas
+            ( void * ) armar_columnas,    // callback description
+//            "hola manola",              // Titulo
+//            -1,
+//            1,
+//            NULL,
+//            NULL,
+//            NULL,
+//            NULL,
+            ( void * ) enter_function,    // enter callback
+            ( void * ) destroy_function,   // destroy callback
+//            NULL,
+//            NULL
+              pos
+          );
+
+/* Retorno la posicion donde el usuario apreto ENTER */
+  return ( ret - 1 );
+}
+
+/****************************************************************************/
+
+int diffear_funciones ( int comparar_por_pares , char *file1 , char *file2 )
+{
+  unsigned int file1_version;
+  unsigned int file2_version;
+  unsigned int address1;
+  unsigned int address2;
+  Funcion *funcion1;
+  Funcion *funcion2;
+  FILE *f1;
+  FILE *f2;
+  int ret = FALSE;
+
+/* Intento abrir los 2 files de analisis */
+  f1 = abrir_analisis ( file1 );
+  f2 = abrir_analisis ( file2 );
+
+/* Si NO pude abrir alguno de los files */
+  if ( f1 == NULL || f2 == NULL )
+  {
+  /* Mensaje de ERROR al usuario */
+    my_msg ( "ERROR: analized files don't exist !\n" );
+
+  /* Salgo */
+    return ( FALSE );
+  }
+
+/* Leo la version de los files */
+  qfread ( f1 , ( void * ) &file1_version , sizeof ( unsigned int ) );
+  qfread ( f2 , ( void * ) &file2_version , sizeof ( unsigned int ) );
+
+/* Si alguna de las versiones NO coincide con la actual */
+  if ( ( file1_version != turbodiff_version ) || ( file2_version != turbodiff_version ) )
+  {
+  /* Mensaje al usuario */
+    my_msg ( "ERROR: Different file versions, please take the analysis again\n" );
+
+  /* Retorno ERROR */
+    return ( FALSE );
+  }
+
+/* Descarto lo levantado por una comparacion anterior ( las posiciones no son de estos archivos ) */
+  reiniciar_comparacion ();
+
+/* Mensaje al usuario */
+  my_msg ( "loading functions to compare ...\n" );
+
+/* Levanto SOLO los indices de los 2 archivos ( los cuerpos se levantan por demanda ) */
+  levantar_indice_de_funciones ( f1 , indice_funciones1 , funciones1 , posiciones_funciones1 );
+  levantar_indice_de_funciones ( f2 , indice_funciones2 , funciones2 , posiciones_funciones2 );
+
+/* Me guardo los files para levantar las funciones elegidas */
+  file_por_demanda1 = f1;
+  file_por_demanda2 = f2;
+
+/* Si quiero comparar las funciones via la lista de matcheos */
+  if ( comparar_por_pares == TRUE )
+  {
+  /* Levanto los resultados */
+    levantar_resultados ( file1 , file2 );
+
+  /* Muestro los resultados */
+    mostrar_resultados ( file1 , file2 );
+
+  /* Libero las huellas levantadas con los resultados ( aca no se usan ) */
+    liberar_huellas ();
+  }
+  else
+  {
+  /* Pido al usuario las funciones a comparar */
+    while ( my_AskUsingForm ( funciones_a_comparar , &address1 , &address2 ) == 1 )
+    {
+    /* Levanto las funciones analizadas */
+      funcion1 = get_estructura_funcion2 ( indice_funciones1 , funciones1 , address1 );    
+      funcion2 = get_estructura_funcion2 ( indice_funciones2 , funciones2 , address2 );    
+  
+    /* Si pude obtener las 2 funciones */
+      if ( ( funcion1 != NULL ) && ( funcion2 != NULL ) )
+      {
+      /* Levanto los cuerpos de las 2 funciones */
+        levantar_funcion_por_demanda ( f1 , indice_funciones1 , funciones1 , posiciones_funciones1 , funcion1 );
+        levantar_funcion_por_demanda ( f2 , indice_funciones2 , funciones2 , posiciones_funciones2 , funcion2 );
+
+      /* Diffeo las 2 funciones y las muestro */
+        diffear_y_mostrar_funciones ( file1 , file2 , funcion1 , funcion2 );
+      }
+    /* Si alguna funcion no pudo ser localizada */
+      else
+      {
+      /* Mensaje de ERROR al usuario */
+        my_msg ( "ERROR: the function %x or function %x don't exist !\n" , address1 , address2 );
+      }
+    }
+  }
+
+/* Cierro los 2 files */
+  qfclose ( f1 );
+  qfclose ( f2 );
+
+/* Ya no hay files para levantar funciones por demanda */
+  file_por_demanda1 = NULL;
+  file_por_demanda2 = NULL;
+
+  return ( ret );
+}
+
+/****************************************************************************/
+
+int diffear_y_mostrar_funciones ( char *file1 , char *file2 , Funcion *funcion1 , Funcion *funcion2 )
+{
+  char file1_dis [ QMAXPATH ];
+  char file2_dis [ QMAXPATH ];
+  int ret = TRUE;
+
+/* Asocio los basic blocks de las 2 funciones ( el usuario puede cancelarlo ) */
+  iniciar_operacion ();
+  iniciar_progreso ( "block diff" , funcion1 -> cantidad_basic_blocks * 2 );
+  diffear_funcion_por_grafo ( funcion1 , funcion2 );
+  terminar_operacion ();
+
+/* Hago una copia del nombre de los files */
+  qstrncpy ( file1_dis , file1 , QMAXPATH );
+  qstrncpy ( file2_dis , file2 , QMAXPATH );
+
+/* Reemplazo el nombre de los files */
+  change_extension ( file1_dis , "dis" );
+  change_extension ( file2_dis , "dis" );
+
+/* Genero los 2 archivos con los grafos */
+  armar_grafo_salida ( "turbodiff - 1" , "graph1.gdl" , file1_dis , funcion1 );
+  armar_grafo_salida ( "turbodiff - 2" , "graph2.gdl" , file2_dis , funcion2 );
+
+/* Muestro el grafo de la funcion1 en el wingraph32.exe */
+  mostrar_grafo ( "graph1.gdl" );
+
+/* Realizo una demora para que NO se intercalen los grafos */
+  Sleep ( 250 );
+
+/* Muestro el grafo de la funcion2 en el wingraph32.exe */
+  mostrar_grafo ( "graph2.gdl" );
+
+  return ( ret );
+}
+
+/****************************************************************************/
+
+int diffear_funcion_por_grafo ( Funcion *funcion1 , Funcion *funcion2 )
+{
+  Basic_Block *basic_block1;
+  Basic_Block *basic_block2;
+  Basic_Block *candidato;
+  Index dominados2;
+  Index asociados2;
+  unsigned int *checksums_copiados = NULL;
+  unsigned int *checksums2;
+  unsigned int change_type;
+  unsigned int actual_id = 0;
+  unsigned int ids_indexados = SIN_PAREJA;
+  unsigned int cantidad_candidatos;
+  unsigned int dominador2;
+  unsigned int cont, cont1, cont2;
+  unsigned int pos;
+  int ret = TRUE;
+
+/* Obtengo los checksums contiguos de funcion2 */
+  checksums2 = get_checksums_de_funcion ( funcion2 );
+
+/* Si la funcion no esta en un grafo ( levantada por demanda ), los copio aparte */
+/* para que la pasada de todos contra todos no toque los basic blocks descartados */
+  if ( ( checksums2 == NULL ) && ( funcion2 -> cantidad_basic_blocks > 0 ) )
+  {
+  /* Alloco la copia */
+    checksums_copiados = ( unsigned int * ) malloc ( funcion2 -> cantidad_basic_blocks * sizeof ( unsigned int ) );
+
+  /* Copio el checksum de cada basic block */
+    for ( cont = 0 ; cont < funcion2 -> cantidad_basic_blocks ; cont ++ )
+    {
+      checksums_copiados [ cont ] = funcion2 -> basic_blocks [ cont ] -> checksum;
+    }
+
+  /* Uso la copia */
+    checksums2 = checksums_copiados;
+  }
+
+/* Reseteo todos los basic blocks */
+  for ( cont = 0 ; cont < funcion1 -> cantidad_basic_blocks ; cont ++ )
+  {
+  /* Levanto el siguiente basic block */
+    basic_block1 = funcion1 -> basic_blocks [ cont ];
+
+  /* Reseteo las properties que me interesan */
+    basic_block1 -> association_id = -1;
+    basic_block1 -> change_type = -1;
+  }
+
+/* Reseteo todos los basic blocks */
+  for ( cont = 0 ; cont < funcion2 -> cantidad_basic_blocks ; cont ++ )
+  {
+  /* Levanto el siguiente basic block */
+    basic_block2 = funcion2 -> basic_blocks [ cont ];
+
+  /* Reseteo las properties que me interesan */
+    basic_block2 -> association_id = -1;
+    basic_block2 -> change_type = -1;
+  }
+
+/* Limpio las marcas de visita */
+  liberar_marcas_de_recorrido ( funcion1 );
+  liberar_marcas_de_recorrido ( funcion2 );
+
+/* Levanto el basic block raiz de cada funcion */
+  basic_block1 = funcion1 -> basic_blocks [ 0 ];
+  basic_block2 = funcion2 -> basic_blocks [ 0 ];
+
+/* Recorro el grafo asociando basic blocks desde el basic block raiz */
+  diffear_funcion_recorriendo_grafo ( funcion1 , funcion2 , basic_block1 , basic_block2 , &actual_id );
+
+/////////////////////////////////////////
+
+/* Indexo los basic blocks de funcion2 por su dominador inmediato */
+  for ( cont2 = 0 ; cont2 < funcion2 -> cantidad_basic_blocks ; cont2 ++ )
+  {
+    if ( funcion2 -> basic_blocks [ cont2 ] -> dominador != SIN_DOMINADOR )
+    {
+      dominados2.Add ( ( unsigned int ) funcion2 -> basic_blocks [ cont2 ] -> dominador , ( void * ) cont2 );
+    }
+  }
+
+  dominados2.Sort ();
+
+/* Anclo los basic blocks cuyos dominadores inmediatos ya estan asociados entre si */
+  for ( cont1 = 0 ; cont1 < funcion1 -> cantidad_basic_blocks ; cont1 ++ )
+  {
+  /* Si el diff fue cancelado, me quedo con los basic blocks asociados hasta ahora */
+    if ( avanzar_progreso ( 1 ) == FALSE )
+    {
+      break;
+    }
+
+  /* Levanto el siguiente basic block */
+    basic_block1 = funcion1 -> basic_blocks [ cont1 ];
+
+  /* Si el basic block ya tiene ID o su dominador no fue asociado */
+    if ( ( basic_block1 -> association_id != -1 ) || ( basic_block1 -> dominador == SIN_DOMINADOR ) || ( funcion1 -> basic_blocks [ basic_block1 -> dominador ] -> association_id == -1 ) )
+    {
+    /* Sigo buscando */
+      continue;
+    }
+
+  /* Si hubo asociaciones nuevas, reindexo los basic blocks asociados de funcion2 */
+    if ( ids_indexados != actual_id )
+    {
+      asociados2.Clear ();
+
+      for ( cont2 = 0 ; cont2 < funcion2 -> cantidad_basic_blocks ; cont2 ++ )
+      {
+        if ( funcion2 -> basic_blocks [ cont2 ] -> association_id != -1 )
+        {
+          asociados2.Add ( ( unsigned int ) funcion2 -> basic_blocks [ cont2 ] -> association_id , ( void * ) cont2 );
+        }
+      }
+
+      asociados2.Sort ();
+      ids_indexados = actual_id;
+    }
+
+  /* Busco el dominador equivalente en funcion2 */
+    if ( asociados2.Find ( ( unsigned int ) funcion1 -> basic_blocks [ basic_block1 -> dominador ] -> association_id , &pos ) == FALSE )
+    {
+      continue;
+    }
+
+    dominador2 = ( unsigned int ) asociados2.Get ( pos );
+
+  /* Si el dominador equivalente NO domina a ningun basic block */
+    if ( dominados2.Find ( dominador2 , &pos ) == FALSE )
+    {
+      continue;
+    }
+
+  /* Busco SOLO entre los dominados por el basic block equivalente */
+    candidato = NULL;
+    cantidad_candidatos = 0;
+
+    for ( ; ( pos < dominados2.Len () ) && ( dominados2.GetKey ( pos ) == dominador2 ) ; pos ++ )
+    {
+    /* Levanto el siguiente basic block */
+      basic_block2 = funcion2 -> basic_blocks [ ( unsigned int ) dominados2.Get ( pos ) ];
+
+    /* Si el basic block ya tiene ID */
+      if ( basic_block2 -> association_id != -1 )
+      {
+      /* Sigo buscando */
+        continue;
+      }
+
+    /* Si los basic blocks tienen el mismo contenido y estan en el mismo nivel de loops */
+      if ( ( basic_block1 -> checksum == basic_block2 -> checksum ) && ( basic_block1 -> longitud == basic_block2 -> longitud ) && ( basic_block1 -> profundidad_loop == basic_block2 -> profundidad_loop ) )
+      {
+      /* Me guardo el candidato */
+        candidato = basic_block2;
+        cantidad_candidatos ++;
+      }
+    }
+
+  /* Si el candidato es el UNICO entre los dominados ( sino el ancla es ambigua ) */
+    if ( cantidad_candidatos == 1 )
+    {
+    /* Recorro el grafo asociando basic blocks desde este par */
+      diffear_funcion_recorriendo_grafo ( funcion1 , funcion2 , basic_block1 , candidato , &actual_id );
+    }
+  }
+
+/////////////////////////////////////////
+
+/* Recorro todos los basic blocks de funcion1 */
+  for ( cont1 = 0 ; cont1 < funcion1 -> cantidad_basic_blocks ; cont1 ++ )
+  {
+  /* Si el diff fue cancelado, me quedo con los basic blocks asociados hasta ahora */
+    if ( avanzar_progreso ( 1 ) == FALSE )
+    {
+      break;
+    }
+
+  /* Levanto el siguiente basic block */
+    basic_block1 = funcion1 -> basic_blocks [ cont1 ];
+
+  /* Si el basic block ya tiene ID */
+    if ( basic_block1 -> association_id != -1 )
+    {
+    /* Sigo buscando */
+      continue;
+    }
+
+  /* Recorro todos los basic blocks de funcion1 */
+    for ( cont2 = 0 ; cont2 < funcion2 -> cantidad_basic_blocks ; cont2 ++ )
+    {
+    /* Si el checksum no coincide, descarto el par sin tocar el basic block */
+      if ( ( checksums2 != NULL ) && ( checksums2 [ cont2 ] != basic_block1 -> checksum ) )
+      {
+        continue;
+      }
+
+    /* Levanto el siguiente basic block */
+      basic_block2 = funcion2 -> basic_blocks [ cont2 ];
+
+    /* Si el basic block ya tiene ID */
+      if ( basic_block2 -> association_id != -1 )
+      {
+      /* Sigo buscando */
+        continue;
+      }
+
+    /* Si los basic blocks tienen el mismo checksum */
+      if ( basic_block1 -> checksum == basic_block2 -> checksum )
+      {
+      /* Si los basic blocks tienen la misma cantidad de instrucciones */
+        if ( basic_block1 -> longitud == basic_block2 -> longitud )
+        {
+        /* Si los basic blocks tienen la misma cantidad de bytes */
+          if ( basic_block1 -> longitud_en_bytes == basic_block2 -> longitud_en_bytes )
+          {
+          /* Si los basic blocks NO tienen la misma estructura de loops, no vale la pena calcular probabilidades */
+            if ( ( basic_block1 -> profundidad_loop != basic_block2 -> profundidad_loop ) || ( basic_block1 -> cabecera_loop != basic_block2 -> cabecera_loop ) )
+            {
+              continue;
+            }
+
+          /* Si las probabilidades son buenas */
+            if ( get_porcentaje_equivalencia ( 1 , 0 , funcion1 , funcion2 , basic_block1 , basic_block2 ) >= 50 )
+            {
+            /* Recorro el grafo asociando basic blocks desde el basic block raiz */
+              diffear_funcion_recorriendo_grafo ( funcion1 , funcion2 , basic_block1 , basic_block2 , &actual_id );
+            }
+          }
+        }
+      }
+    }
+  }
+
+/////////////////////////////////////////
+
+/* Levanto el basic block raiz de cada funcion */
+  basic_block1 = funcion1 -> basic_blocks [ 0 ];
+  basic_block2 = funcion2 -> basic_blocks [ 0 ];
+
+/* Por las dudas, chequeo los basic blocks raices */
+  if ( ( basic_block1 -> association_id == -1 ) && ( basic_block2 -> association_id == -1 ) )
+  {
+  /* Si la probabilidad es buena */
+    if ( get_porcentaje_equivalencia ( 1 , 0 , funcion1 , funcion2 , basic_block1 , basic_block2 ) > 50 )
+    {
+    /* Averiguo el tipo de cambio en el basic block */
+      change_type = get_change_type ( basic_block1 , basic_block2 );
+
+    /* Asocio los basic blocks ( los pinto de amarillo ) */
+      basic_block1 -> association_id = actual_id;
+      basic_block1 -> change_type = change_type;
+      basic_block2 -> association_id = actual_id;
+      basic_block2 -> change_type = change_type;
+  
+    /* Incremento el ID actual */
+      actual_id ++;
+    }
+  }
+
+/* Libero la copia de los checksums */
+  free ( checksums_copiados );
+
+/////////////////////////////////////////
+
+/* Recorro el grafo hacia abajo asociando con la ayuda de IDs */
+  diffear_funcion_usando_ids ( funcion1 , funcion2 , &actual_id );
+
+/////////////////////////////////////////
+
+/* Intento matchear libremente basic blocks por la mejor probabilidad */
+  diffear_funcion_por_mejor_probabilidad ( funcion1 , funcion2 , &actual_id );
+
+  return ( ret );
+}
+
+/****************************************************************************/
+
+int diffear_funcion_recorriendo_grafo ( Funcion *funcion1 , Funcion *funcion2 , Basic_Block *basic_block1 , Basic_Block *basic_block2 , unsigned int *actual_id )
+{
+  List basic_blocks_padres1;
+  List basic_blocks_padres2;
+  Basic_Block *basic_block_padre1;
+  Basic_Block *basic_block_padre2;
+  Basic_Block *basic_block_hijo1;
+  Basic_Block *basic_block_hijo2;
+  unsigned int cont, cont1, cont2;
+  unsigned int change_type;
+  int asociacion_ok = FALSE;
+  int ret = TRUE;
+
+/* Si los basic blocks tienen la misma cantidad de salidas */
+  if ( basic_block1 -> basic_blocks_hijos -> Len () == basic_block2 -> basic_blocks_hijos -> Len () )
+  {
+  /* Si los basic blocks tienen la misma longitud en instrucciones */
+    if ( basic_block1 -> longitud == basic_block2 -> longitud )
+    {
+    /* Si los basic blocks tienen la misma longitud en bytes */
+      if ( basic_block1 -> longitud_en_bytes == basic_block2 -> longitud_en_bytes )
+      {
+      /* Si los basic blocks tienen el mismo checksum */
+        if ( basic_block1 -> checksum == basic_block2 -> checksum )
         {
-        /* Retorno la funcion */
-          *funcion2 = funcion_buscada;
+        /* Asocio los basic blocks ( los pinto de blanco ) */
+          basic_block1 -> association_id = *actual_id;
+          basic_block1 -> change_type = 0;
+          basic_block2 -> association_id = *actual_id;
+          basic_block2 -> change_type = 0;
+
+        /* Incremento el ID actual */
+          ( *actual_id ) ++;
+
+        /* Marco el flag de que los pude asociar */
+          asociacion_ok = TRUE;
+        }
+      /* Si los basic blocks NO tienen el mismo checksum */
+        else
+        {
+        /* Asocio los basic blocks ( los pinto de verde ) */
+          basic_block1 -> association_id = *actual_id;
+          basic_block1 -> change_type = 1;
+          basic_block2 -> association_id = *actual_id;
+          basic_block2 -> change_type = 1;
+  
+        /* Incremento el ID actual */
+          ( *actual_id ) ++;
+
+        /* Marco el flag de que los pude asociar */
+          asociacion_ok = TRUE;
+        }
+      }
+    }
+  /* Si es un camino confiable */
+    else if ( is_camino_confiable ( 1 , 0 , funcion1 , funcion2 , basic_block1 , basic_block2 ) == TRUE )
+    {
+    /* Averiguo el tipo de cambio en el basic block */
+      change_type = get_change_type ( basic_block1 , basic_block2 );
+
+    /* Asocio los basic blocks ( los pinto de amarillo ) */
+      basic_block1 -> association_id = *actual_id;
+      basic_block1 -> change_type = change_type;
+      basic_block2 -> association_id = *actual_id;
+      basic_block2 -> change_type = change_type;
+  
+    /* Incremento el ID actual */
+      ( *actual_id ) ++;
+
+    /* Marco el flag de que los pude asociar */
+      asociacion_ok = TRUE;
+    }
+  }
+
+/* Si NO los pude asociar */
+  if ( asociacion_ok == FALSE )
+  {
+  /* Dejo de avanzar por este camino */
+    return ( FALSE );
+  }
+
+/* Marco los basic blocks como visitados */
+  marcar_basic_block_visitado ( funcion1 , basic_block1 );
+  marcar_basic_block_visitado ( funcion2 , basic_block2 );
+
+/* Si los basic blocks tienen dintinta cantidad de basic blocks hijos */
+  if ( basic_block1 -> basic_blocks_hijos -> Len () != basic_block2 -> basic_blocks_hijos -> Len () )
+  {
+  /* Este camino deja de ser confiable */
+    return ( FALSE );
+  }
+
+///////////////////////////////////////////
+
+/* Recorro el grafo hacia abajo */
+
+/* Recorro todos los basic blocks hijos del basic block donde estoy parado */
+  for ( cont = 0 ; cont < basic_block1 -> basic_blocks_hijos -> Len () ; cont ++ )
+  {
+  /* Levanto los basic blocks hijos */
+    basic_block_hijo1 = get_basic_block_hijo ( funcion1 , basic_block1 , cont );
+    basic_block_hijo2 = get_basic_block_hijo ( funcion2 , basic_block2 , cont );
+
+  /* Si los basic blocks NO fueron visitados */
+    if ( ( is_basic_block_visitado ( funcion1 , basic_block_hijo1 ) == FALSE ) && ( is_basic_block_visitado ( funcion2 , basic_block_hijo2 ) == FALSE ) )
+    {
+    /* Avanzo por este camino */
+      diffear_funcion_recorriendo_grafo ( funcion1 , funcion2 , basic_block_hijo1 , basic_block_hijo2 , actual_id );
+    }
+  }
+
+///////////////////////////////////////////
+
+/* Recorro el grafo hacia arriba */
+
+/* Obtengo todos los basic blocks padres de este */
+  get_basic_blocks_padres ( funcion1 , basic_block1 , basic_blocks_padres1 );
+  get_basic_blocks_padres ( funcion2 , basic_block2 , basic_blocks_padres2 );
+
+/* Intento avanzar hacia arriba por el camino de los identicos */
+  for ( cont1 = 0 ; cont1 < basic_blocks_padres1.Len () ; cont1 ++ )
+  {
+  /* Levanto el siguiente basic block padre */
+    basic_block_padre1 = ( Basic_Block * ) basic_blocks_padres1.Get ( cont1 );
+
+  /* Recorro todos los basic blocks padres de 2 */
+    for ( cont2 = 0 ; cont2 < basic_blocks_padres2.Len () ; cont2 ++ )
+    {
+    /* Levanto el siguiente basic block padre */
+      basic_block_padre2 = ( Basic_Block * ) basic_blocks_padres2.Get ( cont2 );
+
+    /* Si los 2 basic blocks tienen el mismo checksum */
+      if ( basic_block_padre1 -> checksum == basic_block_padre2 -> checksum )
+      {
+      /* Si los basic blocks NO fueron visitados */
+        if ( ( is_basic_block_visitado ( funcion1 , basic_block_padre1 ) == FALSE ) && ( is_basic_block_visitado ( funcion2 , basic_block_padre2 ) == FALSE ) )
+        {
+        /* Intento asociar estos basic blocks */
+//          diffear_funcion_recorriendo_grafo ( funcion1 , funcion2 , basic_block_padre1 , basic_block_padre2 , actual_id );
+        }
+      }
+    }
+  }
+
+///////////////////////////////////////////
+
+/* Intento avanzar hacia arriba por el camino de los basic blocks verdes */
+  for ( cont1 = 0 ; cont1 < basic_blocks_padres1.Len () ; cont1 ++ )
+  {
+  /* Levanto el siguiente basic block padre */
+    basic_block_padre1 = ( Basic_Block * ) basic_blocks_padres1.Get ( cont1 );
+
+  /* Recorro todos los basic blocks padres de 2 */
+    for ( cont2 = 0 ; cont2 < basic_blocks_padres2.Len () ; cont2 ++ )
+    {
+    /* Levanto el siguiente basic block padre */
+      basic_block_padre2 = ( Basic_Block * ) basic_blocks_padres2.Get ( cont2 );
+
+    /* Si los 2 basic blocks tienen el mismo checksum */
+      if ( basic_block_padre1 -> longitud_en_bytes == basic_block_padre2 -> longitud_en_bytes )
+      {
+      /* Si los basic blocks NO fueron visitados */
+        if ( ( is_basic_block_visitado ( funcion1 , basic_block_padre1 ) == FALSE ) && ( is_basic_block_visitado ( funcion2 , basic_block_padre2 ) == FALSE ) )
+        {
+        /* Intento asociar estos basic blocks */
+          diffear_funcion_recorriendo_grafo ( funcion1 , funcion2 , basic_block_padre1 , basic_block_padre2 , actual_id );
+        }
+      }
+    }
+  }
+
+  return ( ret );
+}
+
+/****************************************************************************/
+
+int diffear_funcion_usando_ids ( Funcion *funcion1 , Funcion *funcion2 , unsigned int *actual_id )
+{
+  Basic_Block *basic_block1;
+  Basic_Block *basic_block2;
+  Basic_Block *basic_block_hijo1;
+  Basic_Block *basic_block_hijo2;
+  int cont1, cont2;
+  unsigned int resultado1;
+  unsigned int resultado2;
+  unsigned int change_type;
+  int ret = TRUE;
+
+/* Recorro todos los basic blocks buscando los que estan asociados */
+  for ( cont1 = 0 ; cont1 < funcion1 -> cantidad_basic_blocks ; cont1 ++ )
+  {
+  /* Levanto el siguiente basic block */
+    basic_block1 = funcion1 -> basic_blocks [ cont1 ];
+
+  /* Si el basic block NO tiene ID sigo buscando */
+    if ( basic_block1 -> association_id == -1 )
+    {
+    /* Sigo buscando */
+      continue;
+    }
+
+  /* Obtengo el basic block PAR */
+    basic_block2 = get_basic_block_by_association_id ( funcion2 , basic_block1 -> association_id );
+
+  /* Si tienen la misma cantidad de basic blocks hijos */
+    if ( basic_block1 -> basic_blocks_hijos -> Len () == basic_block2 -> basic_blocks_hijos -> Len () )
+    {
+    /* Recorro todos los basic block hijos */
+      for ( cont2 = 0 ; cont2 < basic_block1 -> basic_blocks_hijos -> Len () ; cont2 ++ )
+      {
+      /* Levanto los basic blocks hijos */
+        basic_block_hijo1 = get_basic_block_hijo ( funcion1 , basic_block1 , cont2 );
+        basic_block_hijo2 = get_basic_block_hijo ( funcion2 , basic_block2 , cont2 );
+
+      /* Si los basic blocks NO fueron asociados */
+        if ( ( basic_block_hijo1 -> association_id == -1 ) && ( basic_block_hijo2 -> association_id == -1 ) )
+        {
+        /* Avanzo un nivel en el grafo */
+          resultado1 = get_porcentaje_equivalencia ( 1 , 0 , funcion1 , funcion2 , basic_block_hijo1 , basic_block_hijo2 );
+
+        /* Avanzo dos niveles en el grafo */
+          resultado2 = get_porcentaje_equivalencia ( 2 , 0 , funcion1 , funcion2 , basic_block_hijo1 , basic_block_hijo2 );
+
+        /* Si el resultado2 me da mejor o igual resultado que 1 */
+          if ( ( resultado1 <= resultado2 ) && ( resultado2 >= 50 ) )
+          {
+          /* Averiguo el tipo de cambio en el basic block */
+            change_type = get_change_type ( basic_block_hijo1 , basic_block_hijo2 );
+
+          /* Asocio los basic blocks ( los pinto de amarillo ) */
+            basic_block_hijo1 -> association_id = *actual_id;
+            basic_block_hijo1 -> change_type = change_type;
+            basic_block_hijo2 -> association_id = *actual_id;
+            basic_block_hijo2 -> change_type = change_type;
+
+          /* Incremento el ID actual */
+            ( *actual_id ) ++;
+
+          /* Reinicio la busqueda */
+            cont1 = -1;
 
-        /* Retorno OK */
-          return ( TRUE );
-        }
-      /* La funcion padre esta MAL asociada */
-        else
-        {
-        /* Mensaje para mi */
-//          my_msg ( "warning: possible bad asociation %x - %x\n" , funcion_padre1 -> address , funcion_padre2 -> address );
-          my_msg ( "warning: possible bad asociation %x - %x\n" , funcion1 -> address , funcion_buscada -> address );
-  
-        /* NO PUEDO SEGUIR AVANZANDO */
-          return ( FALSE );
+          /* Sigo buscando */
+            break;
+          }
         }
       }
     }
   }
 
-/* Avanzo por todos los caminos hijos */
-  for ( cont = 0 ; cont < basic_block1 -> basic_blocks_hijos -> Len () ; cont ++ )
+  return ( ret );
+}
+
+/****************************************************************************/
+
+int diffear_funcion_por_mejor_probabilidad ( Funcion *funcion1 , Funcion *funcion2 , unsigned int *actual_id )
+{
+  Basic_Block *basic_block1;
+  Basic_Block *basic_block2;
+  Basic_Block *basic_block_candidato;
+  unsigned int mejor_probabilidad;
+  unsigned int repeticiones;
+  unsigned int probabilidad;
+  unsigned int change_type;
+  int cont1, cont2;
+  int ret = TRUE;
+
+/* Recorro todos los basic blocks de funcion1 */
+  for ( cont1 = 0 ; cont1 < ( int ) funcion1 -> cantidad_basic_blocks ; cont1 ++ )
   {
-  /* Si NO hay condicion invertida */
-    if ( condicion_invertida == FALSE )
+  /* Levanto el siguiente basic block */
+    basic_block1 = funcion1 -> basic_blocks [ cont1 ];
+
+  /* Si el basic block ya tiene ID */
+    if ( basic_block1 -> association_id != -1 )
     {
-    /* Levanto las siguientes direcciones hijas */
-      address_hija1 = ( unsigned int ) basic_block1 -> basic_blocks_hijos -> Get ( cont );
-      address_hija2 = ( unsigned int ) basic_block2 -> basic_blocks_hijos -> Get ( cont );
+    /* Sigo buscando */
+      continue;
     }
-  /* Si tengo una condicion invertida */
-    else
+
+  /* Inicializo las variables */
+    basic_block_candidato = NULL;
+    mejor_probabilidad = 0;
+    repeticiones = 0;
+
+  /* Recorro todos los basic blocks de funcion2 */
+    for ( cont2 = 0 ; cont2 < ( int ) funcion2 -> cantidad_basic_blocks ; cont2 ++ )
     {
-    /* Si estoy llendo por el camino del positivo */
-      if ( cont == 0 )
+    /* Levanto el siguiente basic block */
+      basic_block2 = funcion2 -> basic_blocks [ cont2 ];
+
+    /* Si el basic block ya tiene ID */
+      if ( basic_block2 -> association_id != -1 )
+      {
+      /* Sigo buscando */
+        continue;
+      }
+
+    /* Obtengo la probabilidad */
+      probabilidad = get_porcentaje_equivalencia ( 1 , 0 , funcion1 , funcion2 , basic_block1 , basic_block2 );
+
+    /* Si la probabilidad que tengo es mejor que la anterior */
+      if ( probabilidad > mejor_probabilidad )
       {
-      /* Levanto las siguientes direcciones hijas */
-        address_hija1 = ( unsigned int ) basic_block1 -> basic_blocks_hijos -> Get ( cont );
-        address_hija2 = ( unsigned int ) basic_block2 -> basic_blocks_hijos -> Get ( cont + 1 );
+      /* Tengo un nuevo candidato */
+        basic_block_candidato = basic_block2;
+
+      /* Seteo la nueva probabilidad */
+        mejor_probabilidad = probabilidad;
+
+      /* Seteo la cantidad de veces que esta probabilidad se repite */
+        repeticiones = 1;
       }
-      else
+    /* Si la probabilidad que tengo es igual a la anterior */
+      else if ( probabilidad == mejor_probabilidad )
       {
-      /* Levanto las siguientes direcciones hijas */
-        address_hija1 = ( unsigned int ) basic_block1 -> basic_blocks_hijos -> Get ( cont );
-        address_hija2 = ( unsigned int ) basic_block2 -> basic_blocks_hijos -> Get ( cont - 1 );
+      /* Incremento la cantidad de veces que esta probabilidad se repite */
+        repeticiones ++;
       }
     }
 
-  /* Obtengo los basic block hijos */
-    basic_block_hijo1 = get_basic_block_from_array ( funcion_padre1 -> basic_blocks , funcion_padre1 -> cantidad_basic_blocks , address_hija1 );
-    basic_block_hijo2 = get_basic_block_from_array ( funcion_padre2 -> basic_blocks , funcion_padre2 -> cantidad_basic_blocks , address_hija2 );
-
-  /* Si los 2 basic blocks estan LIBRES */
-    if ( ( basic_block_hijo1 -> visitado == FALSE ) && ( basic_block_hijo2 -> visitado == FALSE ) )
+  /* Si encontre algun basic block */
+    if ( basic_block_candidato != NULL )
     {
-    /* Avanzo por este camino */
-      ret = get_funcion_equivalente_x_grafo ( nivel + 1 , funcion_padre1 , funcion1 , basic_block_hijo1 , funciones2 , funcion_padre2 , funcion2 , basic_block_hijo2 );
-
-    /* Si encontre la funcion */
-      if ( ret == TRUE )
+    /* Si la probabilidad es buena */
+      if ( mejor_probabilidad > 50 )
       {
-      /* Retorno OK */
-        return ( TRUE );
+      /* Si solo hubo una sola probabilidad con este valor */
+        if ( repeticiones == 1 )
+        {
+        /* Averiguo el tipo de cambio en el basic block */
+          change_type = get_change_type ( basic_block1 , basic_block_candidato );
+
+        /* Asocio los basic blocks ( los pinto de amarillo ) */
+          basic_block1 -> association_id = *actual_id;
+          basic_block1 -> change_type = change_type;
+          basic_block_candidato -> association_id = *actual_id;
+          basic_block_candidato -> change_type = change_type;
+
+        /* Incremento el ID actual */
+          ( *actual_id ) ++;
+
+        /* Empiezo a procesar desde el primer basic block de funcion1 */
+          cont1 = -1;
+        }
       }
     }
   }
 
-/* Dejo para mas adelante recorrer la funcion hacia arriba */
   return ( ret );
+}
 
-/////////////////////////////////////////////
+/****************************************************************************/
 
-/* Si NO pude encontrar la funcion */
-  if ( ret == FALSE )
+unsigned int get_porcentaje_equivalencia ( unsigned int maxima_profundidad , unsigned int profundidad , Funcion *funcion1 , Funcion *funcion2 , Basic_Block *basic_block1 , Basic_Block *basic_block2 )
+{
+  unsigned int caminos_correctos;
+  unsigned int caminos_inciertos;
+  unsigned int caminos_erroneos;
+  unsigned int topes_encontrados;
+  unsigned int resultado;
+
+/* Inicializo las variables estadisticas */
+  caminos_correctos = 0;
+  caminos_inciertos = 0;
+  caminos_erroneos = 0;
+
+/* Averiguo el porcentaje de equivalencia */
+  recorrer_camino_de_equivalencia ( maxima_profundidad , profundidad , funcion1 , funcion2 , basic_block1 , basic_block2 , &caminos_correctos , &caminos_inciertos , &caminos_erroneos );
+
+/* Calculo la cantidad de veces que tuve que retroceder */
+  topes_encontrados = caminos_correctos + caminos_inciertos + caminos_erroneos;
+
+/* Si NO me da cero */
+  if ( topes_encontrados > 0 )
   {
-  /* Obtengo todos los basic blocks padres */
-    get_basic_blocks_padres ( funcion_padre1 , basic_block1 , basic_blocks_padres1 );
-    get_basic_blocks_padres ( funcion_padre2 , basic_block2 , basic_blocks_padres2 );
+  /* Calculo el porcentaje */
+    resultado = ( caminos_correctos * 100 ) / topes_encontrados;
+    resultado += ( ( caminos_inciertos * 100 ) / 2 ) / topes_encontrados;
+  }
 
-  /* Recorro todos los basic blocks padres 1 */
-    for ( cont = 0 ; cont < basic_blocks_padres1.Len () ; cont ++ )
-    {
-    /* Levanto el siguiente basic block */
-      basic_block_padre1 = ( Basic_Block * ) basic_blocks_padres1.Get ( cont );
+  return ( resultado );
+}
 
-    /* Si el basic block fue visitado */
-      if ( basic_block_padre1 -> visitado == TRUE )
-      {
-      /* Sigo buscando */
-        continue;
-      }
+/****************************************************************************/
 
-    /* Recorro todos los basic blocks padres de 2 */
-      for ( cont2 = 0 ; cont2 < basic_blocks_padres2.Len () ; cont2 ++ )
-      {
-      /* Levanto el siguiente basic block */
-        basic_block_padre2 = ( Basic_Block * ) basic_blocks_padres2.Get ( cont2 );
+int recorrer_camino_de_equivalencia ( unsigned int maxima_profundidad , unsigned int profundidad , Funcion *funcion1 , Funcion *funcion2 , Basic_Block *basic_block1 , Basic_Block *basic_block2 , unsigned int *caminos_correctos , unsigned int *caminos_inciertos , unsigned int *caminos_erroneos )
+{
+  Basic_Block *basic_block_hijo1;
+  Basic_Block *basic_block_hijo2;
+  unsigned int cont;
+  int ret = TRUE;
 
-      /* Si el basic block fue visitado */
-        if ( basic_block_padre2 -> visitado == TRUE )
-        {
-        /* Sigo buscando */
-          continue;
-        }
+/* Si los basic blocks estan identificados */
+  if ( ( basic_block1 -> association_id != -1 ) && ( basic_block1 -> association_id == basic_block2 -> association_id ) )
+  {
+  /* Incremento la cantidad de caminos correctos */
+    ( *caminos_correctos ) ++;
 
-      /* Si los 2 basic blocks tienen el mismo checksum */
-        if ( basic_block_padre1 -> checksum == basic_block_padre2 -> checksum )
-        {
-        /* Si los 2 basic blocks tienen la misma cantidad de hijos */
-          if ( basic_block_padre1 -> funciones_hijas -> Len () == basic_block_padre2 -> funciones_hijas -> Len () )
-          {
-          /* Avanzo hacia arriba por este camino */
-            ret = get_funcion_equivalente_x_grafo ( nivel + 1 , funcion_padre1 , funcion1 , basic_block_padre1 , funciones2 , funcion_padre2 , funcion2 , basic_block_padre2 );
+  /* Dejo de avanzar por este camino */
+    return ( ret );
+  }
+/* Si hay una CONDICION INVERTIDA */
+  else if ( is_reverted_condition ( funcion1 , funcion2 , basic_block1 , basic_block2 ) == TRUE )
+  {
+  /* Incremento la cantidad de caminos correctos */
+    ( *caminos_correctos ) ++;
 
-          /* Si encontre la funcion */
-            if ( ret == TRUE )
-            {
-            /* Retorno OK */
-              return ( TRUE );
-            }
-          }
-        }
-      }
-    }
+  /* Dejo de avanzar por este camino */
+    return ( ret );
+  }
+/* Si los basic blocks tienen distinto ID */
+  else if ( basic_block1 -> association_id != basic_block2 -> association_id )
+  {
+  /* Incremento la cantidad de caminos que me llevan a basic blocks con distintos IDs */
+    ( *caminos_erroneos ) ++;
+
+  /* Dejo de avanzar por este camino */
+    return ( ret );
+  }
+/* Si los basic blocks tienen distinta cantidad de basic blocks hijos */
+  else if ( basic_block1 -> basic_blocks_hijos -> Len () != basic_block2 -> basic_blocks_hijos -> Len () )
+  {
+  /* Incremento la cantidad de caminos que me llevan a basic blocks con distintos IDs */
+    ( *caminos_erroneos ) ++;
+
+  /* Dejo de avanzar por este camino */
+    return ( ret );
+  }
+/* Si llegue a la maxima profundidad sin encontrar basic blocks identificados */
+  else if ( profundidad == maxima_profundidad )
+  {
+  /* Incremento la cantidad de caminos que no se a donde llevan */
+    ( *caminos_inciertos ) ++;
+
+  /* Dejo de avanzar por este camino */
+    return ( ret );
+  }
+
+/* Recorro todos los basic block hijos de este */
+  for ( cont = 0 ; cont < basic_block1 -> basic_blocks_hijos -> Len () ; cont ++ )
+  {
+  /* Levanto los basic blocks hijos */
+    basic_block_hijo1 = get_basic_block_hijo ( funcion1 , basic_block1 , cont );
+    basic_block_hijo2 = get_basic_block_hijo ( funcion2 , basic_block2 , cont );
+
+  /* Avanzo por este camino */
+    recorrer_camino_de_equivalencia ( maxima_profundidad , profundidad + 1 , funcion1 , funcion2 , basic_block_hijo1 , basic_block_hijo2 , caminos_correctos , caminos_inciertos , caminos_erroneos );
   }
 
   return ( ret );
@@ -4677,46 +11493,34 @@ int get_funcion_equivalente_x_grafo ( int nivel , Funcion *funcion_padre1 , Func
 
 /****************************************************************************/
 
-int is_condicion_invertida ( Funcion *funcion1 , Funcion *funcion2 , Basic_Block *basic_block1 , Basic_Block *basic_block2 )
+int is_reverted_condition ( Funcion *funcion1 , Funcion *funcion2 , Basic_Block *basic_block1 , Basic_Block *basic_block2 )
 {
   Basic_Block *basic_block_hijo11;
   Basic_Block *basic_block_hijo12;
   Basic_Block *basic_block_hijo21;
   Basic_Block *basic_block_hijo22;
-  unsigned int address_hija1;
-  unsigned int address_hija2;
   int ret = FALSE;
 
-/* Si los basic blocks tienen checksums distintos */
-  if ( basic_block1 -> checksum != basic_block2 -> checksum )
+/* Si los basic blocks tienen 2 salidas */
+  if ( ( basic_block1 -> basic_blocks_hijos -> Len () == 2 ) && ( basic_block2 -> basic_blocks_hijos -> Len () == 2 ) )
   {
-  /* Si los basic blocks tienen la misma longitud */
-    if ( basic_block1 -> longitud == basic_block2 -> longitud )
+  /* Obtengo los basic blocks hijos cruzados */
+    basic_block_hijo11 = get_basic_block_hijo ( funcion1 , basic_block1 , 0 );
+    basic_block_hijo12 = get_basic_block_hijo ( funcion1 , basic_block1 , 1 );
+    basic_block_hijo21 = get_basic_block_hijo ( funcion2 , basic_block2 , 0 );
+    basic_block_hijo22 = get_basic_block_hijo ( funcion2 , basic_block2 , 1 );
+
+  /* Si todos los basic blocks fueron asociados */
+    if ( ( basic_block_hijo11 -> association_id != -1 ) && ( basic_block_hijo12 -> association_id != -1 ) && ( basic_block_hijo21 -> association_id != -1 ) && ( basic_block_hijo22 -> association_id != -1 ) )
     {
-    /* Si los basic blocks actuales tienen 2 hijos */
-      if ( ( basic_block1 -> basic_blocks_hijos -> Len () == 2 ) && ( basic_block1 -> basic_blocks_hijos -> Len () == basic_block2 -> basic_blocks_hijos -> Len () ) )
+    /* Si detecto el primer cruce */
+      if ( basic_block_hijo11 -> association_id == basic_block_hijo22 -> association_id )
       {
-      /* Obtengo los basic blocks hijos de 1 */
-        address_hija1 = ( unsigned int ) basic_block1 -> basic_blocks_hijos -> Get ( 0 );
-        basic_block_hijo11 = get_basic_block_from_array ( funcion1 -> basic_blocks , funcion1 -> cantidad_basic_blocks , address_hija1 );
-        address_hija1 = ( unsigned int ) basic_block1 -> basic_blocks_hijos -> Get ( 1 );
-        basic_block_hijo12 = get_basic_block_from_array ( funcion1 -> basic_blocks , funcion1 -> cantidad_basic_blocks , address_hija1 );
-
-      /* Obtengo los basic blocks hijos de 2 */
-        address_hija2 = ( unsigned int ) basic_block2 -> basic_blocks_hijos -> Get ( 0 );
-        basic_block_hijo21 = get_basic_block_from_array ( funcion2 -> basic_blocks , funcion2 -> cantidad_basic_blocks , address_hija2 );
-        address_hija2 = ( unsigned int ) basic_block2 -> basic_blocks_hijos -> Get ( 1 );
-        basic_block_hijo22 = get_basic_block_from_array ( funcion2 -> basic_blocks , funcion2 -> cantidad_basic_blocks , address_hija2 );
-
-      /* Si los basic blocks tienen checksums distintos */
-        if ( basic_block_hijo11 -> checksum != basic_block_hijo21 -> checksum )
+      /* Si detecto el segundo cruce */
+        if ( basic_block_hijo12 -> association_id == basic_block_hijo21 -> association_id )
         {
-        /* Si las referencias estan cruzadas */
-          if ( ( basic_block_hijo11 -> checksum == basic_block_hijo22 -> checksum ) && ( basic_block_hijo12 -> checksum == basic_block_hijo21 -> checksum ) )
-          {
-          /* Condicion invertida detectada */
-            ret = TRUE;
-          }
+        /* Condicion invertida detectada */
+          ret = TRUE;
         }
       }
     }
@@ -4727,1865 +11531,2293 @@ int is_condicion_invertida ( Funcion *funcion1 , Funcion *funcion2 , Basic_Block
 
 /****************************************************************************/
 
-int is_camino_confiable ( unsigned int profundidad_maxima, unsigned int profundidad , Funcion *funcion1 , Funcion *funcion2 , Basic_Block *basic_block1 , Basic_Block *basic_block2 )
+unsigned int get_change_type ( Basic_Block *basic_block1 , Basic_Block *basic_block2 )
 {
-  Basic_Block *basic_block_hijo1;
-  Basic_Block *basic_block_hijo2;
-  unsigned int address_hija1;
-  unsigned int address_hija2;
-  unsigned int cont;
-  int ret = FALSE;
+  unsigned int change_type;
 
-/* Si los basic blocks actuales son IDENTICOS */
+/* Si tienen el checksum IDENTICO */
   if ( basic_block1 -> checksum == basic_block2 -> checksum )
   {
-  /* Retorno OK */
-    return ( TRUE );
-  }
-
-/* Si llegue a la profundidad maxima */
-  if ( profundidad == profundidad_maxima )
-  {
-  /* Chequeo que los basic blocks coincidan */
-    if ( basic_block1 -> checksum == basic_block2 -> checksum )
-    {
-    /* Retorno OK */
-      return ( TRUE );
-    }
-    else
-    {
-    /* Retorno ERROR */
-      return ( FALSE );
-    }
+  /* Pinto el basic block de BLANCO */
+    change_type = 0;
   }
-
-/* Si los basic blocks tienen distinta cantidad de hijos */
-  if ( basic_block1 -> basic_blocks_hijos -> Len () != basic_block2 -> basic_blocks_hijos -> Len () )
+/* Si tienen la misma cantidad de instrucciones */
+  else if ( basic_block1 -> longitud == basic_block2 -> longitud )
   {
-  /* Retorno ERROR */
-    return ( FALSE );
+  /* Pinto el basic block de VERDE */
+    change_type = 1;
   }
-
-/* Recorro todas las conexiones hijas */
-  for ( cont = 0 ; cont < basic_block1 -> basic_blocks_hijos -> Len () ; cont ++ )
+  else
   {
-  /* Levanto la direccion de los siguientes basic blocks hijos */
-    address_hija1 = ( unsigned int ) basic_block1 -> basic_blocks_hijos -> Get ( cont );
-    address_hija2 = ( unsigned int ) basic_block2 -> basic_blocks_hijos -> Get ( cont );
-
-  /* Levanto los siguientes basic blocks hijos */
-    basic_block_hijo1 = get_basic_block_from_array ( funcion1 -> basic_blocks , funcion1 -> cantidad_basic_blocks , address_hija1 );
-    basic_block_hijo2 = get_basic_block_from_array ( funcion2 -> basic_blocks , funcion2 -> cantidad_basic_blocks , address_hija2 );
-
-  /* Avanzo por este camino */
-    ret = is_camino_confiable ( profundidad_maxima , profundidad + 1 , funcion1 , funcion2 , basic_block_hijo1 , basic_block_hijo2 );
-
-  /* Si el camino NO es confiable */
-    if ( ret == FALSE )
-    {
-    /* Retorno ERROR */
-      return ( FALSE );
-    }
+  /* Pinto el basic block de AMARILLO */
+    change_type = 2;
   }
 
-  return ( ret );
+  return ( change_type );
 }
 
 /****************************************************************************/
 
-int get_funcion_equivalente_x_hijos ( Funcion *funcion1 , List &funciones1 , List &funciones2 , Funcion **funcion2 )
+int armar_grafo_salida ( char *file , char *output_file , char *disasm_file , Funcion *funcion )
 {
-  int ret;
-
-/* Intento resolver por padres en comun de los hijos */
-  ret = get_funcion_equivalente_x_hijos_x_padres_en_comun ( funcion1 , funciones1 , funciones2 , funcion2 );
+  Basic_Block *basic_block;
+  String desensamblado;
+  char basic_block_content [ MAX_DISASM ];
+  char basic_block_label [ 256 ];
+  char vertical_order [ 64 ];
+  char name [ NAME_LEN ];
+  unsigned int cont;
+  unsigned int cont2;
+  int ret = TRUE;
+  FILE *fout;
+  FILE *fdis;
 
-/* Si no lo pude sacar, intento resolverlo buscando un hijo que le falte este padre */
-  if ( ret == FALSE )
+/* Reseteo la profundidad de todos los basic blocks */
+  for ( cont = 0 ; cont < funcion -> cantidad_basic_blocks ; cont ++ )
   {
-    ret = get_funcion_equivalente_x_hijos_x_unico_padre ( funcion1 , funciones1 , funciones2 , funcion2 );
+  /* Levanto el siguiente basic block */
+    basic_block = funcion -> basic_blocks [ cont ]; 
 
-    if ( ret == TRUE )
-    {
-//      my_msg ( "un solo padre: %x - %x\n" , funcion1 -> address , ( *funcion2 ) -> address );
-    }
+  /* Seteo la MINIMA profundidad del basic block */
+    basic_block -> profundidad = -1;
   }
 
-  return ( ret );
-}
+/* Seteo la profundidad de los basic blocks */
+  setear_maxima_profundidad_hacia_abajo ( 0 , funcion , funcion -> basic_blocks [ 0 ] );
 
-/****************************************************************************/
+/* Creo el archivo donde voy a guardar el grafo */
+  fout = qfopen ( output_file , "w" );
 
-int get_funcion_equivalente_x_hijos_x_padres_en_comun ( Funcion *funcion1 , List &funciones1 , List &funciones2 , Funcion **funcion2 )
-{
-  List funciones_padre2;
-  List funciones_padre2_interseccion;
-  Basic_Block *basic_block;
-  Basic_Block_Padre *basic_block_padre2;
-  Funcion *funcion_hija;
-  Funcion *funcion_hija2;
-  Funcion *funcion_padre2;
-  unsigned int cont, cont2, cont3;
-  int primera_iteracion = TRUE;
-  int ret = FALSE;
+/* Obtengo el nombre de la funcion */
+  get_formated_name ( funcion , name , NAME_LEN , FALSE );
 
-/* Recorro todos los basic blocks */
-  for ( cont = 0 ; cont < funcion1 -> cantidad_basic_blocks ; cont ++ )
+/* Genero la salida para graficar el grafo */
+  qfprintf ( fout , "graph:\n" );
+  qfprintf ( fout , "{\n" );
+  qfprintf ( fout , "title: \"%s - %s\"\n" , file , name );
+  qfprintf ( fout , "manhattan_edges: yes\n" );
+  qfprintf ( fout , "layoutalgorithm: mindepth\n" );
+  qfprintf ( fout , "finetuning: no\n" );
+  qfprintf ( fout , "layout_downfactor: 100\n" );
+  qfprintf ( fout , "layout_upfactor: 0\n" );
+  qfprintf ( fout , "layout_nearfactor: 10\n" );
+  qfprintf ( fout , "xlspace: 12\n" );
+  qfprintf ( fout , "yspace: 30\n" );
+  qfprintf ( fout , "\n" );
+
+/* Abro el archivo con el desensamblado */
+  fdis = qfopen ( disasm_file , "rb" );
+
+/* Escribo todos los basic blocks como nodos */
+  for ( cont = 0 ; cont < funcion -> cantidad_basic_blocks ; cont ++ )
   {
   /* Levanto el siguiente basic block */
-    basic_block = funcion1 -> basic_blocks [ cont ];
+    basic_block = funcion -> basic_blocks [ cont ];
 
-  /* Recorro todas las referencias hijas del basic block */
-    for ( cont2 = 0 ; cont2 < basic_block -> funciones_hijas -> Len () ; cont2 ++ )
+  /* Transformo la direccion del basic block en una etiqueta */
+//    qsnprintf ( basic_block_label , 256 , "%x:%u-%u:%u:%i" , basic_block -> addr_inicial , basic_block -> profundidad , basic_block -> profundidad2 , basic_block -> peso , basic_block -> id );
+    qsnprintf ( basic_block_label , 256 , "%x: chk=%x" , basic_block -> addr_inicial , basic_block -> checksum );
+//    qsnprintf ( basic_block_label , 256 , "%x" , basic_block -> addr_inicial );
+
+  /* Me posiciono en la direccion del file que indica el basic block */
+    qfseek ( fdis , basic_block -> pos_file_disasm , SEEK_SET );
+
+  /* Reinicializo el objeto string */
+    desensamblado.Reset ();
+
+  /* Levanto las instrucciones del basic block */
+    desensamblado.Load ( fdis );
+
+  /* Saco el ultimo fin de linea de la ultima instruccion */
+    desensamblado.Truncate ( desensamblado.Len () - 1 );
+
+  /* Seteo el orden vertical donde se va a ubicar el basic block */
+    qsnprintf ( vertical_order , 64 , "vertical_order: %i " , basic_block -> profundidad );
+
+  /* Si el basic block NO pudo ser asociado, significa que cambio mucho */
+    if ( basic_block -> association_id == -1 )
     {
-    /* Levanto la siguiente funcion */
-      funcion_hija = get_estructura_funcion ( funciones1 , ( unsigned int ) basic_block -> funciones_hijas -> Get ( cont2 ) );
+    /* direccion + instrucciones */
+      qsnprintf ( basic_block_content , MAX_DISASM , "%s\n\n%s" , basic_block_label , desensamblado.Get () );
 
-    /* Si la funcion existe */
-      if ( funcion_hija != NULL )
-      {
-      /* Si la funcion hija fue reconocida */
-        if ( ( funcion_hija -> identica == TRUE ) || ( funcion_hija -> patcheada == TRUE ) )
-        {
-        /* Levanto la funcion hija en programa 2 */
-          funcion_hija2 = get_estructura_funcion ( funciones2 , funcion_hija -> address_equivalente );
+    /* Declaro el nodo en el grafo */
+      qfprintf ( fout , "node: { title: \"%x\" label: \"%s\" color: red textcolor: black bordercolor: black %s" , basic_block -> addr_inicial , basic_block_content , vertical_order );
+    }
+  /* Si el basic block tuvo cambios en la longitud */
+    else if ( basic_block -> change_type == 2 )
+    {
+    /* ID + direccion + instrucciones */
+      qsnprintf ( basic_block_content , MAX_DISASM , "ID_%i\n%s\n\n%s" , basic_block -> association_id , basic_block_label , desensamblado.Get () );
 
-        /* Recorro todos los basic blocks padres */
-          for ( cont3 = 0 ; cont3 < funcion_hija2 -> cantidad_referencias_padre ; cont3 ++ )
-          {
-          /* Levanto el proximo basic block padre */
-            basic_block_padre2 = &funcion_hija2 -> basic_blocks_padres [ cont3 ];
+    /* Declaro el nodo en el grafo */
+      qfprintf ( fout , "node: { title: \"%x\" label: \"%s\" color: %s textcolor: black bordercolor: black %s" , basic_block -> addr_inicial , basic_block_content , "yellow" , vertical_order );
+    }
+  /* Si el basic block no cambio o tuvo cambios triviales */
+    else
+    {
+    /* ID + direccion + instrucciones */
+      qsnprintf ( basic_block_content , MAX_DISASM , "ID_%i\n%s\n\n%s" , basic_block -> association_id , basic_block_label , desensamblado.Get () );
 
-          /* Levanto la funcion a la que pertenece */
-            funcion_padre2 = ( Funcion * ) basic_block_padre2 -> funcion;
+    /* Declaro el nodo en el grafo */
+      qfprintf ( fout , "node: { title: \"%x\" label: \"%s\" color: %s textcolor: black bordercolor: black %s" , basic_block -> addr_inicial , basic_block_content , ( basic_block -> change_type == 0 ) ? "white":"green" , vertical_order );
+    }
 
-          /* Si la funcion padre de funcion2 no fue reconocida */  
-            if ( ( funcion_padre2 -> identica == FALSE ) && ( funcion_padre2 -> patcheada == FALSE ) )
-            {
-            /* Si es la primera iteracion, armo la lista inicial */
-              if ( primera_iteracion == TRUE )
-              {
-              /* Si la funcion no fue agregada ( una funcion puede llamar varias veces a otra ) */
-                if ( funciones_padre2.Find ( funcion_padre2 ) == FALSE )
-                {
-                /* Agrego el elemento a la lista */
-                  funciones_padre2.Add ( funcion_padre2 );
-                }
-              }
-            /* Comienzo a quedarme con los elementos en comun */
-              else
-              {
-              /* Si la funcion padre esta en la lista anterior */
-                if ( funciones_padre2.Find ( funcion_padre2 ) == TRUE )
-                {
-                /* Si la funcion no fue agregada ( una funcion puede llamar varias veces a otra ) */
-                  if ( funciones_padre2_interseccion.Find ( funcion_padre2 ) == FALSE )
-                  {
-                 /* Agrego el elemento a la lista */
-                    funciones_padre2_interseccion.Add ( funcion_padre2 );
-                  }
-                }
-              }
-            }
-          }
+  /* Cierro el basic block */
+    qfprintf ( fout , "}\n" );
+  }
 
-        /* Si no es la primera vez, libero la lista vieja */
-          if ( primera_iteracion == FALSE )
-          {
-            funciones_padre2.Clear ();
+/* Dejo un espacio en blanco */
+  qfprintf ( fout , "\n" );
 
-          /* Paso la lista de intersecciones a la lista comun */
-            for ( cont3 = 0 ; cont3 < funciones_padre2_interseccion.Len () ; cont3 ++ )
-            {
-            /* Levanto el siguiente elemento y lo agrego a la lista */
-              funciones_padre2.Add ( funciones_padre2_interseccion.Get ( cont3 ) );
-            }
+/* Escribo todas las conexiones entre los nodos */
+  for ( cont = 0 ; cont < funcion -> cantidad_basic_blocks ; cont ++ )
+  {
+  /* Levanto el siguiente basic block */
+    basic_block = funcion -> basic_blocks [ cont ];
 
-          /* Libero la lista de intersecciones */
-            funciones_padre2_interseccion.Clear ();
-          }
-        }
-//      /* No puedo confiar si no tengo todas las funciones hijas reconocidas */
-//        else
-//        {
-//          my_msg ( "me quede sin padres en funcion %x - hijo %x\n" , funcion1 -> address , funcion_hija -> address );
-//
-//        /* No pude encontrar la funcion equivalente */
-//          return ( FALSE );
-//        }
+  /* Si el basic block tiene 2 salidas ( TRUE - FALSE ) */
+    if ( basic_block -> basic_blocks_hijos -> Len () == 2 )
+    {
+    /* Declaro el enlace POSITIVO en el grafo */
+      qfprintf ( fout , "edge: { sourcename: \"%x\" targetname: \"%x\" color: green }\n" , basic_block -> addr_inicial , ( unsigned int ) basic_block -> basic_blocks_hijos -> Get ( 0 ) );
 
-      /* Anulo la condicion despues de procesar la primera funcion hija */
-        primera_iteracion = FALSE;
-      }
-    /* Algo no esta bien */
-      else
+    /* Declaro el enlace NEGATIVO en el grafo */
+      qfprintf ( fout , "edge: { sourcename: \"%x\" targetname: \"%x\" color: red }\n" , basic_block -> addr_inicial , ( unsigned int ) basic_block -> basic_blocks_hijos -> Get ( 1 ) );
+    }
+  /* Si tiene cero, uno o mas de 2 basic blocks hijos */
+    else
+    {
+    /* Recorro todas las conexiones hacia otros basic blocks hijos */
+      for ( cont2 = 0 ; cont2 < basic_block -> basic_blocks_hijos -> Len () ; cont2 ++ )
       {
-        my_msg ( "inconsistencia en la funcion %x, bb %x, hija %x\n" , funcion1 -> address , basic_block -> addr_inicial , ( unsigned int ) basic_block -> funciones_hijas -> Get ( cont2 ) );
+      /* Declaro el enlace en el grafo */
+        qfprintf ( fout , "edge: { sourcename: \"%x\" targetname: \"%x\" color: blue }\n" , basic_block -> addr_inicial , ( unsigned int ) basic_block -> basic_blocks_hijos -> Get ( cont2 ) );
       }
     }
   }
 
-/* Si me quedo el padre en comun */
-  if ( funciones_padre2.Len () == 1 )
-  {
-//    my_msg ( "wiiiiiiiiiiiiiiiiiiiii\n" );
+/* Fin del grafo */
+  qfprintf ( fout , "}\n" );
 
-  /* Retorno la funcion equivalente en programa 2 */
-    *funcion2 = ( Funcion * ) funciones_padre2.Get ( 0 );
+/* Cierro el file */
+  qfclose ( fout );
 
-  /* Retorno OK */
-    ret = TRUE;
-  }
-  else
-  {
-//    my_msg ( "saliendo con %i padres \n" , funciones_padre2.Len () );
-  }
+/* Cierro el file de desensamblado */
+  qfclose ( fdis );
 
   return ( ret );
 }
 
 /****************************************************************************/
 
-int get_funcion_equivalente_x_hijos_x_unico_padre ( Funcion *funcion1 , List &funciones1 , List &funciones2 , Funcion **funcion2 )
+void mostrar_grafo ( char *output_file )
 {
-  Basic_Block *basic_block;
-  Basic_Block_Padre *basic_block_padre2;
-  Funcion *funcion_hija;
-  Funcion *funcion_hija2;
-  Funcion *funcion_padre2;
-  Funcion *funcion2_candidata;
-  unsigned int cont, cont2, cont3;
-  int padre_detectado = FALSE;
-  int ret = FALSE;
-
-/* Recorro todos los basic blocks */
-  for ( cont = 0 ; cont < funcion1 -> cantidad_basic_blocks ; cont ++ )
-  {
-  /* Levanto el siguiente basic block */
-    basic_block = funcion1 -> basic_blocks [ cont ];
-
-  /* Recorro todas las referencias hijas del basic block */
-    for ( cont2 = 0 ; cont2 < basic_block -> funciones_hijas -> Len () ; cont2 ++ )
-    {
-    /* Levanto la siguiente funcion */
-      funcion_hija = get_estructura_funcion ( funciones1 , ( unsigned int ) basic_block -> funciones_hijas -> Get ( cont2 ) );
-
-    /* Si la funcion existe */
-      if ( funcion_hija != NULL )
-      {
-      /* Si la funcion hija fue reconocida */
-        if ( ( funcion_hija -> identica == TRUE ) || ( funcion_hija -> patcheada == TRUE ) )
-        {
-        /* Levanto la funcion hija en programa 2 */
-          funcion_hija2 = get_estructura_funcion ( funciones2 , funcion_hija -> address_equivalente );
-
-        /* Recorro todos los basic blocks padres */
-          for ( cont3 = 0 ; cont3 < funcion_hija2 -> cantidad_referencias_padre ; cont3 ++ )
-          {
-          /* Levanto el proximo basic block padre */
-            basic_block_padre2 = &funcion_hija2 -> basic_blocks_padres [ cont3 ];
+  char ida_path [ MAX_PATH ];
+  char wingraph_line [ MAX_PATH * 2 ];
+  char *pathname;
 
-          /* Levanto la funcion a la que pertenece */
-            funcion_padre2 = ( Funcion * ) basic_block_padre2 -> funcion;
+/* Averiguo la ruta del IDA */
+  GetModuleFileName ( GetModuleHandle ( NULL ) , ida_path , MAX_PATH );
 
-          /* Si la funcion padre de funcion2 no fue reconocida */
-            if ( ( funcion_padre2 -> identica == FALSE ) && ( funcion_padre2 -> patcheada == FALSE ) )
-            {
-            /* Si es el primer candidato */
-              if ( padre_detectado == FALSE )
-              {
-              /* Aca tengo un candidato */
-                funcion2_candidata = funcion_padre2;
+/* Busco la ultima barra */
+  pathname = strrchr ( ida_path , '\\' );
 
-              /* Para que no vuelva a entrar */
-                padre_detectado = TRUE;
+/* Si encontro la ultima barra */
+  if ( pathname != NULL )
+  {
+  /* Reemplazo 'idag.exe' por 'wingraph.exe' */
+    qsnprintf ( pathname , MAX_PATH - strlen ( ida_path ) , "\\%s" , "wingraph32.exe -remove" );
 
-              /* Marco la salida como OK */
-                ret = TRUE;
-              }
-            /* Si tengo mas de un candidato NO me sirve */
-              else
-              {
-                return ( FALSE );
-              }
-            }
-          }
-        }
-      }
-    }
-  }
+  /* Armo el path completo para pasarle al graficador de IDA */
+    qsnprintf ( wingraph_line , MAX_PATH * 2 , "%s %s" , ida_path , output_file );
 
-/* Si encontre un candidato */
-  if ( ret == TRUE )
-  {
-  /* Retorno la funcion par que encontre */
-    *funcion2 = funcion2_candidata;
+  /* Muestro el grafo */
+    WinExec ( wingraph_line , SW_SHOW );
   }
-
-  return ( ret );
 }
 
 /****************************************************************************/
 
-int clasificar_funciones_cambiadas ( List &funciones1_cambiadas , List &funciones2_cambiadas , List &funciones1_matcheadas , List &funciones2_matcheadas )
+int buscar_funciones_equivalentes ( char *file1 , char *file2 )
 {
+  List *indice_a_recorrer;
+  List *funciones_a_recorrer;
+  List *posiciones_a_recorrer;
   Funcion *funcion1;
   Funcion *funcion2;
+  unsigned int address1 = 0;
+  unsigned int address2 = 0;
   unsigned int cont;
+  unsigned int matcheds;
   int ret = TRUE;
+  FILE *file_a_recorrer;
+  FILE *f1;
+  FILE *f2;
 
-/* Recorro todas las funciones cambiadas */
-  for ( cont = 0 ; cont < funciones1_cambiadas.Len () ; cont ++ )
+/* Intento abrir los 2 files de relevamiento */
+  f1 = abrir_analisis ( file1 );
+  f2 = abrir_analisis ( file2 );
+
+/* Si NO pude abrir alguno de los files */
+  if ( f1 == NULL || f2 == NULL )
   {
-  /* Levanto funcion1 */
-    funcion1 = ( Funcion * ) funciones1_cambiadas.Get ( cont );
+  /* Mensaje de ERROR al usuario */
+    my_msg ( "ERROR: analized files don't exist !\n" );
 
-  /* Levanto funcion2 */
-    funcion2 = ( Funcion * ) funciones2_cambiadas.Get ( cont );
+  /* Salgo */
+    return ( FALSE );
+  }
 
-  /* Si las 2 funciones tienen la misma cantida de instrucciones y son geometricamente identicas */
-    if ( son_funciones_cuasi_identicas ( funcion1 , funcion2 ) == TRUE )
+/* Descarto lo levantado por una comparacion anterior ( las posiciones no son de estos archivos ) */
+  reiniciar_comparacion ();
+
+/* Mensaje al usuario */
+  my_msg ( "loading analized files ...\n" );
+
+/* Levanto SOLO los indices de los 2 archivos ( los cuerpos se levantan por demanda ) */
+  levantar_indice_de_funciones ( f1 , indice_funciones1 , funciones1 , posiciones_funciones1 );
+  levantar_indice_de_funciones ( f2 , indice_funciones2 , funciones2 , posiciones_funciones2 );
+
+/* Mientras el usuario ingrese direcciones */
+//  while ( my_askaddr ( ( unsigned long int * ) &address , "This option searchs an equivalent function in the second file" ) == TRUE )
+
+  while ( my_AskUsingForm ( funciones_a_buscar , &address1 , &address2 ) == TRUE )
+  {
+  /* Si la direccion es del file1 */
+    if ( address1 != 0 )
     {
-    /* Saco las funciones de la lista de cambiadas */
-      funciones1_cambiadas.Delete ( cont );
-      funciones2_cambiadas.Delete ( cont );
+    /* Lista de funciones a usar */
+      file_a_recorrer = f2;
+      indice_a_recorrer = &indice_funciones2;
+      funciones_a_recorrer = &funciones2;
+      posiciones_a_recorrer = &posiciones_funciones2;
 
-    /* Agrego las funciones a la lista de funciones con cambios triviales */
-      funciones1_matcheadas.Add ( ( void * ) funcion1 );
-      funciones2_matcheadas.Add ( ( void * ) funcion2 );
+    /* Busco la funcion ingresada por el usuario */
+      funcion1 = get_estructura_funcion2 ( indice_funciones1 , funciones1 , address1 );
 
-    /* Complemento la extraccion del elemento */
-      cont --;
+    /* Si la funcion existe, levanto su cuerpo */
+      if ( funcion1 != NULL )
+      {
+        levantar_funcion_por_demanda ( f1 , indice_funciones1 , funciones1 , posiciones_funciones1 , funcion1 );
+      }
+    }
+  /* Si la direccion es del file2 */
+    else
+    {
+    /* Lista de funciones a usar */
+      file_a_recorrer = f1;
+      indice_a_recorrer = &indice_funciones1;
+      funciones_a_recorrer = &funciones1;
+      posiciones_a_recorrer = &posiciones_funciones1;
+
+    /* Busco la funcion ingresada por el usuario */
+      funcion1 = get_estructura_funcion2 ( indice_funciones2 , funciones2 , address2 );
+
+    /* Si la funcion existe, levanto su cuerpo */
+      if ( funcion1 != NULL )
+      {
+        levantar_funcion_por_demanda ( f2 , indice_funciones2 , funciones2 , posiciones_funciones2 , funcion1 );
+      }
+    }
+
+  /* Si la direccion ingresada por el usuario NO existe */
+    if ( funcion1 == NULL )
+    {
+    /* Mensaje de ERROR */
+      my_msg ( "ERROR: the function doesn't exist\n" );
+
+    /* Reinicializo las direcciones a buscar */
+      address1 = 0;  
+      address2 = 0;  
+
+    /* Continuo pidiendo direcciones */
+      continue;
+    }
+
+  /* Inicializo el contador de matcheos */
+    matcheds = 0;
+
+  /* Mensaje al usuario */
+    my_msg ( "searching equivalent functions of %x\n" , funcion1 -> address );
+
+  /* Recorro todas las funciones de programa2 */
+    for ( cont = 0 ; cont < funciones_a_recorrer -> Len () ; cont ++ )
+    {
+    /* Levanto la siguiente funcion */
+      funcion2 = ( Funcion * ) funciones_a_recorrer -> Get ( cont );
+
+    /* Si la geometria de la cabecera NO coincide, las ecuaciones no pueden ser iguales */
+      if ( ( funcion1 -> cantidad_basic_blocks != funcion2 -> cantidad_basic_blocks ) || ( funcion1 -> conexiones_internas != funcion2 -> conexiones_internas ) )
+      {
+      /* Paso a la siguiente funcion sin levantarla */
+        continue;
+      }
+
+    /* Levanto el cuerpo de la funcion candidata */
+      levantar_funcion_por_demanda ( file_a_recorrer , *indice_a_recorrer , *funciones_a_recorrer , *posiciones_a_recorrer , funcion2 );
+
+    /* Si las 2 funciones tienen la misma geometria */
+      if ( strcmp ( funcion1 -> graph_ecuation , funcion2 -> graph_ecuation ) == 0 )
+      {
+      /* Imprimo la posible funcion equivalente */
+        my_msg ( "equivalent matched: %x\n" , funcion2 -> address );
+
+      /* Incremento el contador de matcheos */
+        matcheds ++;
+      }
+    }
+
+  /* Si NO encontre funciones equivalentes */
+    if ( matcheds == 0 )
+    {
+    /* Mensaje al usuario */
+      my_msg ( "equivalent function not found\n" );
     }
-  /* Si las 2 funciones tienen el mismo grafo, puedo asumir que NO tiene cambios importantes */
-    else if ( strcmp ( funcion1 -> graph_ecuation , funcion2 -> graph_ecuation ) == 0 )
+    else
     {
-    /* Saco las funciones de la lista de cambiadas */
-      funciones1_cambiadas.Delete ( cont );
-      funciones2_cambiadas.Delete ( cont );
-
-    /* Agrego las funciones a la lista de funciones con cambios triviales */
-      funciones1_geometricamente_identicas.Add ( ( void * ) funcion1 );
-      funciones2_geometricamente_identicas.Add ( ( void * ) funcion2 );
-
-    /* Complemento la extraccion del elemento */
-      cont --;
+    /* Fin de la busqueda */
+      my_msg ( "done\n" );
     }
+
+  /* Reinicializo las direcciones a buscar */
+    address1 = 0;  
+    address2 = 0;  
   }
 
+/* Cierro los 2 files */
+  qfclose ( f1 );
+  qfclose ( f2 );
+
   return ( ret );
 }
 
 /****************************************************************************/
 
-int armar_resultados ( void )
+int buscar_en_corpus ( void )
 {
-  Funcion *funcion1;
-  Funcion *funcion2;
-  unsigned int cont;
+  char file_actual [ QMAXPATH ];
+  char file_corpus [ QMAXPATH ];
+  unsigned int file_version;
+  unsigned int address = 0;
+  Funcion *funcion;
+  Corpus corpus;
+  int reconstruir = 0;
   int ret = TRUE;
+  FILE *f;
 
-/* Funciones identicas */
-  for ( cont = 0 ; cont < funciones1_reconocidas.Len () ; cont ++ )
-  {
-  /* Levanto las funciones IDENTICAS */
-    funcion1 = ( Funcion * ) funciones1_reconocidas.Get ( cont );
-    funcion2 = ( Funcion * ) funciones2_reconocidas.Get ( cont );
-
-  /* Agrego el tipo de matcheo a la lista */
-    matcheo_1_2.Add ( ( void * ) IDENTICAL_MATCH );
-
-  /* Agrego la direccion de las funciones a las listas */
-    resultado1.Add ( ( void * ) funcion1 -> address );
-    resultado2.Add ( ( void * ) funcion2 -> address );
-  }
-
-//////////////////////////////
+/* Obtengo el analisis del IDB actual */
+  get_actual_idb_name ( file_actual );
+  change_extension ( file_actual , "ana" );
+  armar_path_en_directorio ( file_actual , ARCHIVO_CORPUS , file_corpus );
 
-/* Funciones con grafo identico, misma cantidad de instrucciones */
-  for ( cont = 0 ; cont < funciones1_matcheadas.Len () ; cont ++ )
+/* Pido al usuario la primera funcion a buscar */
+  if ( my_AskUsingForm ( funcion_a_buscar_en_corpus , &address , &reconstruir ) != TRUE )
   {
-  /* Levanto las funciones MATCHEADAS */
-    funcion1 = ( Funcion * ) funciones1_matcheadas.Get ( cont );
-    funcion2 = ( Funcion * ) funciones2_matcheadas.Get ( cont );
-
-  /* Agrego el tipo de matcheo a la lista */
-    matcheo_1_2.Add ( ( void * ) CHANGED_1_MATCH );
-
-  /* Agrego la direccion de las funciones a las listas */
-    resultado1.Add ( ( void * ) funcion1 -> address );
-    resultado2.Add ( ( void * ) funcion2 -> address );
+    return ( FALSE );
   }
 
-//////////////////////////////
-
-/* Funciones con grafo identico */
-  for ( cont = 0 ; cont < funciones1_geometricamente_identicas.Len () ; cont ++ )
+/* Si el usuario lo pidio o el corpus todavia no existe, lo armo */
+  if ( ( reconstruir != 0 ) || ( levantar_corpus ( file_corpus , &corpus ) == FALSE ) )
   {
-  /* Levanto las funciones GEOMETRICAMENTE IDENTICAS */
-    funcion1 = ( Funcion * ) funciones1_geometricamente_identicas.Get ( cont );
-    funcion2 = ( Funcion * ) funciones2_geometricamente_identicas.Get ( cont );
-
-  /* Agrego el tipo de matcheo a la lista */
-    matcheo_1_2.Add ( ( void * ) CHANGED_2_MATCH );
+  /* Indexo todos los analisis del directorio */
+    if ( indexar_corpus ( file_actual ) == FALSE )
+    {
+      my_msg ( "ERROR: cannot build the corpus index\n" );
+      return ( FALSE );
+    }
 
-  /* Agrego la direccion de las funciones a las listas */
-    resultado1.Add ( ( void * ) funcion1 -> address );
-    resultado2.Add ( ( void * ) funcion2 -> address );
+  /* Levanto el corpus recien armado */
+    if ( levantar_corpus ( file_corpus , &corpus ) == FALSE )
+    {
+      my_msg ( "ERROR: cannot load %s\n" , file_corpus );
+      return ( FALSE );
+    }
   }
 
-//////////////////////////////
+/* Abro el analisis actual ( de ahi salen las claves de la funcion buscada ) */
+  f = abrir_analisis ( file_actual );
 
-/* Funciones con grafo distinto */
-  for ( cont = 0 ; cont < funciones1_cambiadas.Len () ; cont ++ )
+/* Si NO pude abrir el analisis o es de otra version */
+  if ( ( f == NULL ) || ( qfread ( f , &file_version , sizeof ( unsigned int ) ) != sizeof ( unsigned int ) ) || ( file_version != turbodiff_version ) )
   {
-  /* Levanto las funciones MATCHEADAS POR CALL GRAPH */
-    funcion1 = ( Funcion * ) funciones1_cambiadas.Get ( cont );
-    funcion2 = ( Funcion * ) funciones2_cambiadas.Get ( cont );
-
-  /* Agrego el tipo de matcheo a la lista */
-    matcheo_1_2.Add ( ( void * ) CHANGED_3_MATCH );
-
-  /* Agrego la direccion de las funciones a las listas */
-    resultado1.Add ( ( void * ) funcion1 -> address );
-    resultado2.Add ( ( void * ) funcion2 -> address );
-  }
-
-//////////////////////////////
+  /* Mensaje al usuario */
+    my_msg ( "ERROR: please take the analysis of this idb first\n" );
 
-/* Funciones de programa 1 que no pudieron asociarse */
-  for ( cont = 0 ; cont < funciones1_irreconocidas.Len () ; cont ++ )
-  {
-  /* Levanto las funciones GEOMETRICAMENTE IDENTICAS */
-    funcion1 = ( Funcion * ) funciones1_irreconocidas.Get ( cont );
+  /* Libero el corpus */
+    liberar_corpus ( &corpus );
 
-  /* Agrego el tipo de matcheo a la lista */
-    matcheo_1_2.Add ( ( void * ) UNMATCHED1_MATCH );
+    if ( f != NULL )
+    {
+      qfclose ( f );
+    }
 
-  /* Agrego la direccion de las funciones a las listas */
-    resultado1.Add ( ( void * ) funcion1 -> address );
-    resultado2.Add ( ( void * ) NULL );
+    return ( FALSE );
   }
 
-//////////////////////////////
+/* Descarto lo levantado por una comparacion anterior ( las posiciones no son de este archivo ) */
+  reiniciar_comparacion ();
 
-/* Funciones de programa2 que no pudieron asociarse */
-  for ( cont = 0 ; cont < funciones2_irreconocidas.Len () ; cont ++ )
+/* Levanto SOLO el indice del analisis actual */
+  levantar_indice_de_funciones ( f , indice_funciones1 , funciones1 , posiciones_funciones1 );
+
+/* Mientras el usuario ingrese direcciones */
+  do
   {
-  /* Levanto las funciones GEOMETRICAMENTE IDENTICAS */
-    funcion2 = ( Funcion * ) funciones2_irreconocidas.Get ( cont );
+  /* Busco la funcion pedida */
+    funcion = get_estructura_funcion2 ( indice_funciones1 , funciones1 , address );
 
-  /* Agrego la direccion de las funciones a las listas */
-    matcheo_1_2.Add ( ( void * ) UNMATCHED2_MATCH );
+  /* Si la funcion NO existe */
+    if ( funcion == NULL )
+    {
+      my_msg ( "ERROR: the function doesn't exist\n" );
+      continue;
+    }
 
-  /* Agrego la direccion de las funciones a las listas */
-    resultado1.Add ( ( void * ) NULL );
-    resultado2.Add ( ( void * ) funcion2 -> address );
+  /* Levanto su cuerpo y la busco en el corpus */
+    levantar_funcion_por_demanda ( f , indice_funciones1 , funciones1 , posiciones_funciones1 , funcion );
+
+    if ( consultar_corpus ( &corpus , funcion ) == 0 )
+    {
+      my_msg ( "function not found in the corpus\n" );
+    }
   }
+  while ( my_AskUsingForm ( funcion_a_buscar_en_corpus , &address , &reconstruir ) == TRUE );
 
-//////////////////////////////
+/* Libero el analisis actual y el corpus */
+  qfclose ( f );
+  liberar_funciones ( indice_funciones1 , funciones1 );
+  posiciones_funciones1.Clear ();
+  liberar_corpus ( &corpus );
 
   return ( ret );
 }
 
 /****************************************************************************/
 
-int guardar_resultados ( char *file1 , char *file2 )
+int indexar_corpus ( char *file_actual )
 {
-  char result_file [ QMAXPATH ];
-  char file2_copy [ QMAXPATH ];
-  char *file2_name;
-  char *point;
+  WIN32_FIND_DATA datos_busqueda;
+  HANDLE busqueda;
+  Entrada_Corpus entrada;
+  Clave_Corpus clave;
+  List indice_funciones_corpus;
+  List funciones_corpus;
+  List nombres;
+  Index tablas [ TABLAS_CORPUS ];
+  char patron [ 16 ];
+  char file_patron [ QMAXPATH ];
+  char file_analisis [ QMAXPATH ];
+  char file_corpus [ QMAXPATH ];
+  char *extensiones [ 2 ] = { "ana" , EXTENSION_MANIFIESTO };
+  char *nombre;
+  unsigned int file_version;
+  unsigned int cantidad_archivos = 0;
+  unsigned int cantidad_entradas = 0;
+  unsigned int cantidad_claves;
+  unsigned int extension;
+  unsigned int banda;
+  unsigned int tabla;
+  unsigned int pos;
+  int ya_indexado;
+  FILE *f_corpus;
   FILE *f;
-  int ret;
-
-/* Me hago una copia del nombre completo de file1 */
-  qstrncpy ( result_file , file1 , QMAXPATH );
-
-/* Ubico el nombre de file2 */
-  file2_name = strrchr ( file2 , '\\' );
-
-/* Hago una copia del nombre file2 */
-  qstrncpy ( file2_copy , file2_name + 1 , QMAXPATH );
-
-/* Ubico el punto que separa el nombre de la extension */
-  point = strrchr ( file2_copy , '.' );
-
-/* Cierro el string donde esta el punto */
-  *point = '\0';
-
-/* Armo el nombre del file donde van a ir a parar los resultados */
-  change_extension ( result_file , file2_copy );
-
-/* Abro el archivo */
-  f = qfopen ( result_file , "wb" );
-
-/* Si pude abrir el archivo */
-  if ( f != NULL )
-  {
-  /* Guardo las listas en el file */
-    matcheo_1_2.Save ( f );
-    resultado1.Save ( f );
-    resultado2.Save ( f );
 
-  /* Cierro el archivo */
-    qfclose ( f );
+/* Creo el indice del corpus */
+  armar_path_en_directorio ( file_actual , ARCHIVO_CORPUS , file_corpus );
+  f_corpus = qfopen ( file_corpus , "wb" );
 
-  /* Retorno OK */
-    ret = TRUE;
-  }
-  else
+/* Si no pude crear el indice */
+  if ( f_corpus == NULL )
   {
   /* Retorno ERROR */
-    ret = FALSE;
+    return ( FALSE );
   }
 
-  return ( ret );
-}
+/* Guardo la version y dejo lugar para las cantidades */
+  qfwrite ( f_corpus , ( void * ) &turbodiff_version , sizeof ( unsigned int ) );
+  qfwrite ( f_corpus , &cantidad_archivos , sizeof ( unsigned int ) );
+  qfwrite ( f_corpus , &cantidad_entradas , sizeof ( unsigned int ) );
 
-/****************************************************************************/
+/* El corpus son los analisis del directorio, y los builds guardados SOLO en el almacen */
+  for ( extension = 0 ; extension < 2 ; extension ++ )
+  {
+  /* Busco los files con la siguiente extension */
+    qsnprintf ( patron , sizeof ( patron ) , "*.%s" , extensiones [ extension ] );
+    armar_path_en_directorio ( file_actual , patron , file_patron );
+    busqueda = FindFirstFile ( file_patron , &datos_busqueda );
 
-int levantar_resultados ( char *file1 , char *file2 )
-{
-  char result_file [ QMAXPATH ];
-  char file2_copy [ QMAXPATH ];
-  char *file2_name;
-  char *point;
-  FILE *f;
-  int ret;
+  /* Recorro todos los files encontrados */
+    while ( busqueda != INVALID_HANDLE_VALUE )
+    {
+    /* Armo el path del analisis ( los manifiestos se abren por su .ana ) */
+      armar_path_en_directorio ( file_actual , datos_busqueda.cFileName , file_analisis );
+      change_extension ( file_analisis , "ana" );
 
-/* Me hago una copia del nombre completo de file1 */
-  qstrncpy ( result_file , file1 , QMAXPATH );
+    /* Si es un manifiesto cuyo .ana existe, ya lo indexe con los analisis */
+      ya_indexado = FALSE;
 
-/* Ubico el nombre de file2 */
-  file2_name = strrchr ( file2 , '\\' );
+      if ( extension == 1 )
+      {
+        f = qfopen ( file_analisis , "rb" );
 
-/* Hago una copia del nombre file2 */
-  qstrncpy ( file2_copy , file2_name + 1 , QMAXPATH );
+        if ( f != NULL )
+        {
+          ya_indexado = TRUE;
+          qfclose ( f );
+        }
+      }
 
-/* Ubico el punto que separa el nombre de la extension */
-  point = strrchr ( file2_copy , '.' );
+      f = NULL;
 
-/* Cierro el string donde esta el punto */
-  *point = '\0';
+    /* Si todavia no indexe este build */
+      if ( ya_indexado == FALSE )
+      {
+      /* Abro el analisis ( o lo reconstruyo desde el almacen ) */
+        f = abrir_analisis ( file_analisis );
 
-/* Armo el nombre del file donde van a ir a parar los resultados */
-  change_extension ( result_file , file2_copy );
+      /* Si el analisis tiene la version actual */
+        if ( ( f != NULL ) && ( qfread ( f , &file_version , sizeof ( unsigned int ) ) == sizeof ( unsigned int ) ) && ( file_version == turbodiff_version ) )
+        {
+        /* Mensaje al usuario */
+          my_msg ( "indexing %s ...\n" , file_analisis );
 
-/* Abro el archivo */
-  f = qfopen ( result_file , "rb" );
+        /* Levanto todas las funciones del analisis */
+          levantar_funciones ( f , indice_funciones_corpus , funciones_corpus );
 
-/* Si pude abrir el archivo */
-  if ( f != NULL )
-  {
-  /* Levanto las listas desde el file */
-    matcheo_1_2.Load ( f );
-    resultado1.Load ( f );
-    resultado2.Load ( f );
+        /* Guardo las claves de cada funcion */
+          for ( pos = 0 ; pos < funciones_corpus.Len () ; pos ++ )
+          {
+            armar_entrada_de_corpus ( ( Funcion * ) funciones_corpus.Get ( pos ) , cantidad_archivos , &entrada );
+            qfwrite ( f_corpus , &entrada , sizeof ( Entrada_Corpus ) );
 
-  /* Cierro el archivo */
-    qfclose ( f );
+          /* Agrego la entrada a las tablas de busqueda */
+            tablas [ TABLA_CORPUS_GRAFO ].Add ( entrada.hash_grafo , ( void * ) cantidad_entradas );
+            tablas [ TABLA_CORPUS_CHECKSUM ].Add ( entrada.checksum , ( void * ) cantidad_entradas );
 
-  /* Retorno OK */
-    ret = TRUE;
-  }
-  else
-  {
-  /* Retorno ERROR */
-    ret = FALSE;
-  }
+          /* Las funciones de un solo basic block no son confiables para compararlas por similitud */
+            if ( entrada.cantidad_basic_blocks >= 2 )
+            {
+              for ( banda = 0 ; banda < BANDAS_LSH ; banda ++ )
+              {
+                tablas [ TABLA_CORPUS_BANDAS + banda ].Add ( entrada.bandas [ banda ] , ( void * ) cantidad_entradas );
+              }
+            }
 
-  return ( ret );
-}
+            cantidad_entradas ++;
+          }
 
-/****************************************************************************/
+        /* Libero las funciones del analisis */
+          liberar_funciones ( indice_funciones_corpus , funciones_corpus );
 
-int mostrar_resultados ( char *file1 , char *file2 )
-{
-  Funcion *funcion1;
-  Funcion *funcion2;
-  unsigned int match_value;
-  unsigned int address1;
-  unsigned int address2;
-  int pos = 0;
-  int ret = TRUE;
+        /* Me guardo el nombre del analisis ( van despues de las entradas ) */
+          nombre = ( char * ) calloc ( QMAXPATH , sizeof ( char ) );
+          qstrncpy ( nombre , datos_busqueda.cFileName , QMAXPATH );
+          change_extension ( nombre , "ana" );
+          nombres.Add ( ( void * ) nombre );
+          cantidad_archivos ++;
+        }
+      }
 
-/* Espero que el usuario elija alguna opcion */
-  while ( ( pos = mostrar_funciones ( pos + 1 ) ) != -1 )
-  {
-  /* Obtengo el valor de matcheo */
-    match_value = ( unsigned int ) matcheo_1_2.Get ( pos );
+    /* Cierro el analisis */
+      if ( f != NULL )
+      {
+        qfclose ( f );
+      }
+
+    /* Si no hay mas files */
+      if ( FindNextFile ( busqueda , &datos_busqueda ) == FALSE )
+      {
+      /* Termino la busqueda */
+        FindClose ( busqueda );
+        break;
+      }
+    }
+  }
 
-  /* Si NO son funciones UNMATCHEDs */
-    if ( ( match_value != UNMATCHED1_MATCH ) && ( match_value != UNMATCHED2_MATCH ) )
-    {
-    /* Obtengo la direccion de las funciones matcheadas */
-      address1 = ( unsigned int ) resultado1.Get ( pos );
-      address2 = ( unsigned int ) resultado2.Get ( pos );
+/* Guardo los nombres de los analisis */
+  for ( pos = 0 ; pos < nombres.Len () ; pos ++ )
+  {
+    nombre = ( char * ) nombres.Get ( pos );
+    qfwrite ( f_corpus , nombre , QMAXPATH );
+    free ( nombre );
+  }
 
-    /* Levanto las funciones */
-      funcion1 = get_estructura_funcion ( funciones1 , address1 );
-      funcion2 = get_estructura_funcion ( funciones2 , address2 );
+/* Guardo las tablas ya ordenadas ( la busqueda las usa sin reordenarlas ) */
+  for ( tabla = 0 ; tabla < TABLAS_CORPUS ; tabla ++ )
+  {
+    tablas [ tabla ].Sort ();
+    cantidad_claves = tablas [ tabla ].Len ();
+    qfwrite ( f_corpus , &cantidad_claves , sizeof ( unsigned int ) );
 
-    /* Diffeo las 2 funciones */
-      diffear_y_mostrar_funciones ( file1 , file2 , funcion1 , funcion2 );
-    }
-    else
+    for ( pos = 0 ; pos < cantidad_claves ; pos ++ )
     {
-    /* Mensaje al usuario */
-      my_msg ( "Don't choose unmatched functions !\n" );
+      clave.clave = tablas [ tabla ].GetKey ( pos );
+      clave.entrada = ( unsigned int ) tablas [ tabla ].Get ( pos );
+      qfwrite ( f_corpus , &clave , sizeof ( Clave_Corpus ) );
     }
   }
 
-  return ( ret );
+/* Completo las cantidades */
+  qfseek ( f_corpus , sizeof ( unsigned int ) , SEEK_SET );
+  qfwrite ( f_corpus , &cantidad_archivos , sizeof ( unsigned int ) );
+  qfwrite ( f_corpus , &cantidad_entradas , sizeof ( unsigned int ) );
+
+/* Cierro el indice */
+  qfclose ( f_corpus );
+
+/* Mensaje al usuario */
+  my_msg ( "corpus index: %u functions from %u analysis files\n" , cantidad_entradas , cantidad_archivos );
+
+  return ( TRUE );
 }
 
-/****************************************************************************/
 /****************************************************************************/
 
-void idaapi armar_columnas ( void *obj , unsigned int columna , char *arrptr [] )
+void armar_entrada_de_corpus ( Funcion *funcion , unsigned int archivo , Entrada_Corpus *entrada )
 {
-  char *match_types [] = { "identical" , "suspicious +" , "suspicious ++" , "changed" , "unmatched 1" , "unmatched 2" };
-  char *match_type;
-  char name1 [ 256 ];
-  char name2 [ 256 ];
-  Funcion *funcion1;
-  Funcion *funcion2;
-  unsigned int address1;
-  unsigned int address2;
-  unsigned int match_value;
-  unsigned int pos;
+  unsigned int firma [ CANTIDAD_MINHASH ];
+  unsigned int banda;
 
-/* Si es la primera llamada */
-/* Armo el nombre de las columnas */
-  if ( columna == 0 )
+/* Datos generales de la funcion */
+  entrada -> archivo = archivo;
+  entrada -> address = funcion -> address;
+  entrada -> hash_grafo = funcion -> hash_grafo;
+  entrada -> checksum = funcion -> checksum;
+  entrada -> cantidad_basic_blocks = funcion -> cantidad_basic_blocks;
+
+/* Calculo la firma y la clave de cada banda ( igual que en la comparacion por similitud ) */
+  calcular_minhash_de_funcion ( funcion , firma );
+
+  for ( banda = 0 ; banda < BANDAS_LSH ; banda ++ )
   {
-    qstrncpy ( arrptr [ 0 ] , "category" , QMAXPATH );
-    qstrncpy ( arrptr [ 1 ] , "address" , QMAXPATH );  
-    qstrncpy ( arrptr [ 2 ] , "name" , QMAXPATH );  
-    qstrncpy ( arrptr [ 3 ] , "address" , QMAXPATH );  
-    qstrncpy ( arrptr [ 4 ] , "name" , QMAXPATH );  
+    entrada -> bandas [ banda ] = calcular_hash ( HASH_INICIAL + banda , &firma [ banda * FILAS_LSH ] , FILAS_LSH * sizeof ( unsigned int ) );
   }
-/* Lleno el contenido de las columnas */
-  else
-  {
-  /* Normalizo al posicion */
-    pos = columna - 1;
+}
 
-  /* Valor de matcheo */
-    match_value = ( unsigned int ) matcheo_1_2.Get ( pos );
+/****************************************************************************/
 
-  /* Obtengo el tipo de matcheo */
-    match_type = match_types [ match_value ];
+int levantar_corpus ( char *file_corpus , Corpus *corpus )
+{
+  unsigned int file_version;
+  unsigned int tabla;
+  int ret = TRUE;
+  FILE *f;
 
-  /* Obtengo la direccion de las funciones matcheadas */
-    address1 = ( unsigned int ) resultado1.Get ( pos );
-    address2 = ( unsigned int ) resultado2.Get ( pos );
+/* Dejo el corpus vacio */
+  memset ( corpus , 0 , sizeof ( Corpus ) );
 
-  /* Levanto las funciones */
-    funcion1 = get_estructura_funcion ( funciones1 , address1 );
-    funcion2 = get_estructura_funcion ( funciones2 , address2 );
+/* Abro el indice del corpus */
+  f = qfopen ( file_corpus , "rb" );
 
-  /* Pongo la categoria */
-    qsnprintf ( arrptr [ 0 ] , 14 , match_type );
+/* Si el indice NO existe */
+  if ( f == NULL )
+  {
+  /* Retorno ERROR */
+    return ( FALSE );
+  }
 
-  /* Si es una funcion de programa2 que no matcheo */
-    if ( match_value != UNMATCHED2_MATCH )
-    {
-    /* Obtengo el nombre de la funcion */
-      get_formated_name ( funcion1 , name1 , 256 , FALSE );
+/* Si el indice es de otra version */
+  if ( ( qfread ( f , &file_version , sizeof ( unsigned int ) ) != sizeof ( unsigned int ) ) || ( file_version != turbodiff_version ) )
+  {
+  /* Cierro el indice */
+    qfclose ( f );
 
-    /* Pongo la direccion de funcion1 */
-      qsnprintf ( arrptr [ 1 ] , 10 , "%x" , funcion1 -> address );
+  /* Retorno ERROR */
+    return ( FALSE );
+  }
 
-    /* Pongo la direccion de funcion1 */
-      qsnprintf ( arrptr [ 2 ] , NAME_LEN , "%s" , name1 );
-    }
-    else
-    {
-    /* Pongo la direccion de funcion1 */
-      qsnprintf ( arrptr [ 1 ] , 10 , "-" );
+/* Levanto las cantidades */
+  qfread ( f , &corpus -> cantidad_archivos , sizeof ( unsigned int ) );
+  qfread ( f , &corpus -> cantidad_entradas , sizeof ( unsigned int ) );
 
-    /* Pongo la direccion de funcion1 */
-      qsnprintf ( arrptr [ 2 ] , NAME_LEN , "-" );
-    }
+/* Levanto las entradas y los nombres de los analisis */
+  corpus -> entradas = ( Entrada_Corpus * ) malloc ( ( corpus -> cantidad_entradas + 1 ) * sizeof ( Entrada_Corpus ) );
+  corpus -> archivos = ( char ( * ) [ QMAXPATH ] ) malloc ( ( corpus -> cantidad_archivos + 1 ) * QMAXPATH );
+  qfread ( f , corpus -> entradas , corpus -> cantidad_entradas * sizeof ( Entrada_Corpus ) );
+  qfread ( f , corpus -> archivos , corpus -> cantidad_archivos * QMAXPATH );
 
-  /* Si es una funcion de programa1 que no matcheo */
-    if ( match_value != UNMATCHED1_MATCH )
+/* Levanto las tablas de busqueda ( ya vienen ordenadas por clave ) */
+  for ( tabla = 0 ; tabla < TABLAS_CORPUS ; tabla ++ )
+  {
+  /* Si el indice esta incompleto */
+    if ( qfread ( f , &corpus -> cantidad_claves [ tabla ] , sizeof ( unsigned int ) ) != sizeof ( unsigned int ) )
     {
-    /* Obtengo el nombre de la funcion */
-      get_formated_name ( funcion2 , name2 , 256 , FALSE );
+      ret = FALSE;
+      break;
+    }
 
-    /* Pongo la direccion de funcion2 */
-      qsnprintf ( arrptr [ 3 ] , 10 , "%x" , funcion2 -> address );
+    corpus -> claves [ tabla ] = ( Clave_Corpus * ) malloc ( ( corpus -> cantidad_claves [ tabla ] + 1 ) * sizeof ( Clave_Corpus ) );
 
-    /* Pongo la direccion de funcion2 */
-      qsnprintf ( arrptr [ 4 ] , NAME_LEN , "%s" , name2 );
-    }
-    else
+    if ( qfread ( f , corpus -> claves [ tabla ] , corpus -> cantidad_claves [ tabla ] * sizeof ( Clave_Corpus ) ) != ( int ) ( corpus -> cantidad_claves [ tabla ] * sizeof ( Clave_Corpus ) ) )
     {
-    /* Pongo la direccion de funcion2 */
-      qsnprintf ( arrptr [ 3 ] , 10 , "-" );
-
-    /* Pongo la direccion de funcion2 */
-      qsnprintf ( arrptr [ 4 ] , NAME_LEN , "-" );
+      ret = FALSE;
+      break;
     }
   }
-}
 
-/****************************************************************************/
+/* Cierro el indice */
+  qfclose ( f );
 
-unsigned int idaapi retornar_size ( void *obj )
-{
-  return ( resultado1.Len () );
+/* Si el indice estaba incompleto, hay que volver a armarlo */
+  if ( ret == FALSE )
+  {
+    liberar_corpus ( corpus );
+  }
+
+  return ( ret );
 }
 
 /****************************************************************************/
 
-void idaapi enter_function ( void *obj , unsigned int columna )
+void liberar_corpus ( Corpus *corpus )
 {
-  my_msg ( "columna: %i\n" , columna );
-}
+  unsigned int tabla;
 
-/****************************************************************************/
+/* Libero las entradas, los nombres y las tablas */
+  free ( corpus -> entradas );
+  free ( corpus -> archivos );
 
-void idaapi destroy_function ( void *obj )
-{
+  for ( tabla = 0 ; tabla < TABLAS_CORPUS ; tabla ++ )
+  {
+    free ( corpus -> claves [ tabla ] );
+  }
+
+/* Dejo el corpus vacio */
+  memset ( corpus , 0 , sizeof ( Corpus ) );
 }
 
 /****************************************************************************/
 
-unsigned int mostrar_funciones ( unsigned int pos )
+unsigned int consultar_corpus ( Corpus *corpus , Funcion *funcion )
 {
-  int anchos [] = { 14 , 10 , 30 , 10 , 30 };
-  unsigned int ret;
+  Entrada_Corpus *entrada;
+  List entradas;
+  List votos;
+  unsigned int candidatos;
+  unsigned int voto;
+  unsigned int pos;
 
-  ret = my_choose (
-            true,
-            -1, -1, -1, -1,
-            NULL,                         // node
-            5,                            // numero de columnas
-            anchos,                       // ancho de columnas
-            ( void * ) retornar_size,     // callback a funcion que retorna n de lineas
-            ( void * ) armar_columnas,    // callback description
-//            "hola manola",              // Titulo
-//            -1,
-//            1,
-//            NULL,
-//            NULL,
-//            NULL,
-//            NULL,
-            ( void * ) enter_function,    // enter callback
-            ( void * ) destroy_function,   // destroy callback
-//            NULL,
-//            NULL
-              pos
-          );
+/* Busco los mejores candidatos */
+  candidatos = rankear_corpus ( corpus , funcion , entradas , votos );
 
-/* Retorno la posicion donde el usuario apreto ENTER */
-  return ( ret - 1 );
+/* Mensaje al usuario */
+  my_msg ( "searching %x in the corpus: %u candidates\n" , funcion -> address , candidatos );
+
+/* Muestro los mejores candidatos */
+  for ( pos = 0 ; pos < entradas.Len () ; pos ++ )
+  {
+    entrada = ( Entrada_Corpus * ) entradas.Get ( pos );
+    voto = ( unsigned int ) votos.Get ( pos );
+
+    my_msg ( "  %s: %x%s%s ( %u/%u bands )\n" , corpus -> archivos [ entrada -> archivo ] , entrada -> address ,
+             ( voto & VOTO_CORPUS_CHECKSUM ) ? " same checksum" : "" ,
+             ( voto & VOTO_CORPUS_GRAFO ) ? " same graph" : "" ,
+             voto & ( VOTO_CORPUS_GRAFO - 1 ) , BANDAS_LSH );
+  }
+
+  return ( candidatos );
 }
 
 /****************************************************************************/
 
-int diffear_funciones ( int comparar_por_pares , char *file1 , char *file2 )
+unsigned int rankear_corpus ( Corpus *corpus , Funcion *funcion , List &entradas , List &votos_entradas )
 {
-  unsigned int file1_version;
-  unsigned int file2_version;
-  unsigned int address1;
-  unsigned int address2;
-  Funcion *funcion1;
-  Funcion *funcion2;
-  FILE *f1;
-  FILE *f2;
-  int ret = FALSE;
+  Entrada_Corpus buscada;
+  Index ranking;
+  List tocados;
+  unsigned int *votos;
+  unsigned int banda;
+  unsigned int pos;
 
-/* Intento abrir los 2 files de analisis */
-  f1 = qfopen ( file1 , "rb" );
-  f2 = qfopen ( file2 , "rb" );
+/* Armo las claves de la funcion buscada */
+  armar_entrada_de_corpus ( funcion , 0 , &buscada );
 
-/* Si NO pude abrir alguno de los files */
-  if ( f1 == NULL || f2 == NULL )
+/* Alloco los votos de cada entrada */
+  votos = ( unsigned int * ) calloc ( corpus -> cantidad_entradas + 1 , sizeof ( unsigned int ) );
+
+/* Voto las entradas con el mismo checksum y el mismo grafo */
+  votar_entradas_de_corpus ( corpus , TABLA_CORPUS_CHECKSUM , buscada.checksum , VOTO_CORPUS_CHECKSUM , votos , tocados );
+  votar_entradas_de_corpus ( corpus , TABLA_CORPUS_GRAFO , buscada.hash_grafo , VOTO_CORPUS_GRAFO , votos , tocados );
+
+/* Si la funcion es confiable para buscarla por similitud */
+  if ( buscada.cantidad_basic_blocks >= 2 )
   {
-  /* Mensaje de ERROR al usuario */
-    my_msg ( "ERROR: analized files don't exist !\n" );
+  /* Voto las entradas que caen en el mismo balde en cada banda */
+    for ( banda = 0 ; banda < BANDAS_LSH ; banda ++ )
+    {
+      votar_entradas_de_corpus ( corpus , TABLA_CORPUS_BANDAS + banda , buscada.bandas [ banda ] , 1 , votos , tocados );
+    }
+  }
 
-  /* Salgo */
-    return ( FALSE );
+/* Ordeno los candidatos de mayor a menor cantidad de votos */
+  for ( pos = 0 ; pos < tocados.Len () ; pos ++ )
+  {
+    ranking.Add ( ~votos [ ( unsigned int ) tocados.Get ( pos ) ] , tocados.Get ( pos ) );
   }
 
-/* Leo la version de los files */
-  qfread ( f1 , ( void * ) &file1_version , sizeof ( unsigned int ) );
-  qfread ( f2 , ( void * ) &file2_version , sizeof ( unsigned int ) );
+  ranking.Sort ();
 
-/* Si alguna de las versiones NO coincide con la actual */
-  if ( ( file1_version != turbodiff_version ) || ( file2_version != turbodiff_version ) )
+/* Me quedo con los mejores candidatos */
+  for ( pos = 0 ; ( pos < ranking.Len () ) && ( pos < MAX_RESULTADOS_CORPUS ) ; pos ++ )
   {
-  /* Mensaje al usuario */
-    my_msg ( "ERROR: Different file versions, please take the analysis again\n" );
-
-  /* Retorno ERROR */
-    return ( FALSE );
+    entradas.Add ( ( void * ) &corpus -> entradas [ ( unsigned int ) ranking.Get ( pos ) ] );
+    votos_entradas.Add ( ( void * ) votos [ ( unsigned int ) ranking.Get ( pos ) ] );
   }
 
-/* Mensaje al usuario */
-  my_msg ( "loading functions to compare ...\n" );
+/* Libero los votos */
+  free ( votos );
 
-/* Levanto los 2 archivos */
-  levantar_funciones ( f1 , indice_funciones1 , funciones1 );
-  levantar_funciones ( f2 , indice_funciones2 , funciones2 );
+  return ( ranking.Len () );
+}
 
-/* Si quiero comparar las funciones via la lista de matcheos */
-  if ( comparar_por_pares == TRUE )
-  {
-  /* Levanto los resultados */
-    levantar_resultados ( file1 , file2 );
+/****************************************************************************/
 
-  /* Muestro los resultados */
-    mostrar_resultados ( file1 , file2 );
-  }
-  else
+void votar_entradas_de_corpus ( Corpus *corpus , unsigned int tabla , unsigned int clave , unsigned int voto , unsigned int *votos , List &tocados )
+{
+  Clave_Corpus *claves = corpus -> claves [ tabla ];
+  unsigned int cota_minima = 0;
+  unsigned int cota_maxima = corpus -> cantidad_claves [ tabla ];
+  unsigned int revisados;
+  unsigned int entrada;
+  unsigned int pos;
+
+/* Busco la primera clave mayor o igual a la buscada */
+  while ( cota_minima < cota_maxima )
   {
-  /* Pido al usuario las funciones a comparar */
-    while ( my_AskUsingForm ( funciones_a_comparar , &address1 , &address2 ) == 1 )
+    pos = ( cota_minima + cota_maxima ) / 2;
+
+    if ( claves [ pos ].clave < clave )
     {
-    /* Levanto las funciones analizadas */
-      funcion1 = get_estructura_funcion2 ( indice_funciones1 , funciones1 , address1 );    
-      funcion2 = get_estructura_funcion2 ( indice_funciones2 , funciones2 , address2 );    
-  
-    /* Si pude obtener las 2 funciones */
-      if ( ( funcion1 != NULL ) && ( funcion2 != NULL ) )
-      {
-      /* Diffeo las 2 funciones y las muestro */
-        diffear_y_mostrar_funciones ( file1 , file2 , funcion1 , funcion2 );
-      }
-    /* Si alguna funcion no pudo ser localizada */
-      else
-      {
-      /* Mensaje de ERROR al usuario */
-        my_msg ( "ERROR: the function %x or function %x don't exist !\n" , address1 , address2 );
-      }
+      cota_minima = pos + 1;
+    }
+    else
+    {
+      cota_maxima = pos;
     }
   }
 
-/* Cierro los 2 files */
-  qfclose ( f1 );
-  qfclose ( f2 );
+/* Recorro las entradas con esa clave ( las claves muy repetidas no discriminan nada ) */
+  for ( pos = cota_minima , revisados = 0 ; ( pos < corpus -> cantidad_claves [ tabla ] ) && ( claves [ pos ].clave == clave ) && ( revisados < MAX_BALDE_LSH ) ; pos ++ , revisados ++ )
+  {
+    entrada = claves [ pos ].entrada;
 
-  return ( ret );
+  /* Si es la primera vez que voto la entrada */
+    if ( votos [ entrada ] == 0 )
+    {
+      tocados.Add ( ( void * ) entrada );
+    }
+
+    votos [ entrada ] += voto;
+  }
 }
 
 /****************************************************************************/
 
-int diffear_y_mostrar_funciones ( char *file1 , char *file2 , Funcion *funcion1 , Funcion *funcion2 )
+int ejecutar_servicio ( void )
 {
-  char file1_dis [ QMAXPATH ];
-  char file2_dis [ QMAXPATH ];
+  char pedido [ MAX_PEDIDO_SERVICIO ];
+  char file_corpus [ QMAXPATH ];
+  Analisis_Residente *analisis;
+  OVERLAPPED overlapped;
+  List residentes;
+  Corpus corpus;
+  unsigned int pos;
+  DWORD transferidos;
+  HANDLE evento;
+  HANDLE pipe;
+  BOOL resultado;
+  int conectado;
+  int seguir = TRUE;
   int ret = TRUE;
 
-/* Asocio los basic blocks de las 2 funciones */
-  diffear_funcion_por_grafo ( funcion1 , funcion2 );
+/* Todavia no hay ningun corpus cargado */
+  memset ( &corpus , 0 , sizeof ( Corpus ) );
+  file_corpus [ 0 ] = '\0';
 
-/* Hago una copia del nombre de los files */
-  qstrncpy ( file1_dis , file1 , QMAXPATH );
-  qstrncpy ( file2_dis , file2 , QMAXPATH );
+/* Creo el evento que avisa cuando termina cada operacion sobre el pipe */
+  evento = CreateEvent ( NULL , TRUE , FALSE , NULL );
 
-/* Reemplazo el nombre de los files */
-  change_extension ( file1_dis , "dis" );
-  change_extension ( file2_dis , "dis" );
+/* Mensaje al usuario */
+  my_msg ( "diff service: listening on %s\n" , PIPE_SERVICIO );
 
-/* Genero los 2 archivos con los grafos */
-  armar_grafo_salida ( "turbodiff - 1" , "graph1.gdl" , file1_dis , funcion1 );
-  armar_grafo_salida ( "turbodiff - 2" , "graph2.gdl" , file2_dis , funcion2 );
+/* Atiendo un cliente por vez hasta que alguno pida terminar o el usuario cancele */
+  while ( seguir == TRUE )
+  {
+  /* Creo una instancia del pipe ( las esperas no bloquean la UI ) */
+    pipe = CreateNamedPipe ( PIPE_SERVICIO , PIPE_ACCESS_DUPLEX | FILE_FLAG_OVERLAPPED , PIPE_TYPE_MESSAGE | PIPE_READMODE_MESSAGE | PIPE_WAIT | PIPE_REJECT_REMOTE_CLIENTS , 1 , MAX_PEDIDO_SERVICIO , MAX_PEDIDO_SERVICIO , 0 , NULL );
 
-/* Muestro el grafo de la funcion1 en el wingraph32.exe */
-  mostrar_grafo ( "graph1.gdl" );
+  /* Si no pude crear el pipe */
+    if ( pipe == INVALID_HANDLE_VALUE )
+    {
+    /* Mensaje de ERROR */
+      my_msg ( "ERROR: cannot create %s\n" , PIPE_SERVICIO );
+
+    /* Retorno ERROR */
+      ret = FALSE;
+      break;
+    }
+
+  /* Espero a que se conecte un cliente */
+    memset ( &overlapped , 0 , sizeof ( OVERLAPPED ) );
+    overlapped.hEvent = evento;
+    resultado = ConnectNamedPipe ( pipe , &overlapped );
+
+  /* Si el cliente se conecto antes de que empezara a esperarlo */
+    if ( ( resultado == FALSE ) && ( GetLastError () == ERROR_PIPE_CONNECTED ) )
+    {
+      conectado = TRUE;
+    }
+    else
+    {
+      conectado = esperar_pipe ( pipe , &overlapped , resultado , &transferidos );
+    }
+
+  /* Si no se conecto ningun cliente */
+    if ( conectado == FALSE )
+    {
+    /* Si el usuario cancelo el servicio */
+      if ( GetLastError () == ERROR_OPERATION_ABORTED )
+      {
+        seguir = FALSE;
+      }
+
+      CloseHandle ( pipe );
+      continue;
+    }
+
+  /* Cada mensaje del cliente es un pedido */
+    while ( leer_pedido_servicio ( pipe , evento , pedido ) == TRUE )
+    {
+    /* Atiendo el pedido */
+      if ( atender_pedido ( pipe , residentes , &corpus , file_corpus , pedido ) == FALSE )
+      {
+      /* El cliente pidio terminar el servicio */
+        seguir = FALSE;
+        break;
+      }
+    }
+
+  /* Si el usuario cancelo el servicio mientras esperaba un pedido */
+    if ( GetLastError () == ERROR_OPERATION_ABORTED )
+    {
+      seguir = FALSE;
+    }
+
+  /* Desconecto al cliente */
+    FlushFileBuffers ( pipe );
+    DisconnectNamedPipe ( pipe );
+    CloseHandle ( pipe );
+  }
+
+/* Libero el evento */
+  CloseHandle ( evento );
 
-/* Realizo una demora para que NO se intercalen los grafos */
-  Sleep ( 250 );
+/* Libero los analisis residentes y el corpus */
+  for ( pos = 0 ; pos < residentes.Len () ; pos ++ )
+  {
+    analisis = ( Analisis_Residente * ) residentes.Get ( pos );
+    liberar_analisis_residente ( analisis );
+  }
 
-/* Muestro el grafo de la funcion2 en el wingraph32.exe */
-  mostrar_grafo ( "graph2.gdl" );
+  liberar_corpus ( &corpus );
+
+/* Mensaje al usuario */
+  my_msg ( "diff service: stopped\n" );
 
   return ( ret );
 }
 
 /****************************************************************************/
 
-int diffear_funcion_por_grafo ( Funcion *funcion1 , Funcion *funcion2 )
+int leer_pedido_servicio ( HANDLE pipe , HANDLE evento , char *pedido )
 {
-  Basic_Block *basic_block1;
-  Basic_Block *basic_block2;
-  unsigned int change_type;
-  unsigned int actual_id = 0;
-  unsigned int cont, cont1, cont2;
-  int ret = TRUE;
+  char descarte [ MAX_PEDIDO_SERVICIO ];
+  OVERLAPPED overlapped;
+  DWORD leidos;
+  BOOL resultado;
+  int ret;
 
-/* Reseteo todos los basic blocks */
-  for ( cont = 0 ; cont < funcion1 -> cantidad_basic_blocks ; cont ++ )
+/* Leo mensajes hasta tener un pedido completo */
+  while ( 1 )
   {
-  /* Levanto el siguiente basic block */
-    basic_block1 = funcion1 -> basic_blocks [ cont ];
+  /* Leo el siguiente mensaje del cliente */
+    memset ( &overlapped , 0 , sizeof ( OVERLAPPED ) );
+    overlapped.hEvent = evento;
+    resultado = ReadFile ( pipe , pedido , MAX_PEDIDO_SERVICIO - 1 , &leidos , &overlapped );
+    ret = esperar_pipe ( pipe , &overlapped , resultado , &leidos );
 
-  /* Reseteo las properties que me interesan */
-    basic_block1 -> visitado = FALSE;
-    basic_block1 -> association_id = -1;
-    basic_block1 -> change_type = -1;
-  }
+  /* Si el mensaje entro completo */
+    if ( ret == TRUE )
+    {
+    /* Cierro el pedido */
+      pedido [ leidos ] = '\0';
+      break;
+    }
 
-/* Reseteo todos los basic blocks */
-  for ( cont = 0 ; cont < funcion2 -> cantidad_basic_blocks ; cont ++ )
-  {
-  /* Levanto el siguiente basic block */
-    basic_block2 = funcion2 -> basic_blocks [ cont ];
+  /* Si se corto la conexion o el usuario cancelo */
+    if ( GetLastError () != ERROR_MORE_DATA )
+    {
+      break;
+    }
 
-  /* Reseteo las properties que me interesan */
-    basic_block2 -> visitado = FALSE;
-    basic_block2 -> association_id = -1;
-    basic_block2 -> change_type = -1;
+  /* El pedido no entra, descarto el resto del mensaje */
+    do
+    {
+      memset ( &overlapped , 0 , sizeof ( OVERLAPPED ) );
+      overlapped.hEvent = evento;
+      resultado = ReadFile ( pipe , descarte , MAX_PEDIDO_SERVICIO , &leidos , &overlapped );
+      ret = esperar_pipe ( pipe , &overlapped , resultado , &leidos );
+    }
+    while ( ( ret == FALSE ) && ( GetLastError () == ERROR_MORE_DATA ) );
+
+  /* Si se corto la conexion mientras descartaba */
+    if ( ret == FALSE )
+    {
+      break;
+    }
+
+  /* Le aviso al cliente y espero el proximo pedido */
+    responder_pedido ( pipe , "error|request too long\n" );
   }
 
-/* Levanto el basic block raiz de cada funcion */
-  basic_block1 = funcion1 -> basic_blocks [ 0 ];
-  basic_block2 = funcion2 -> basic_blocks [ 0 ];
+  return ( ret );
+}
 
-/* Recorro el grafo asociando basic blocks desde el basic block raiz */
-  diffear_funcion_recorriendo_grafo ( funcion1 , funcion2 , basic_block1 , basic_block2 , &actual_id );
+/****************************************************************************/
 
-/////////////////////////////////////////
+int esperar_pipe ( HANDLE pipe , OVERLAPPED *overlapped , BOOL resultado , DWORD *transferidos )
+{
+  int propia;
+  int cancelada = FALSE;
 
-/* Recorro todos los basic blocks de funcion1 */
-  for ( cont1 = 0 ; cont1 < funcion1 -> cantidad_basic_blocks ; cont1 ++ )
+/* Si la operacion fallo en el momento ( no quedo pendiente ) */
+  if ( ( resultado == FALSE ) && ( GetLastError () != ERROR_IO_PENDING ) )
   {
-  /* Levanto el siguiente basic block */
-    basic_block1 = funcion1 -> basic_blocks [ cont1 ];
+    return ( FALSE );
+  }
 
-  /* Si el basic block ya tiene ID */
-    if ( basic_block1 -> association_id != -1 )
+/* Si la operacion quedo pendiente */
+  if ( resultado == FALSE )
+  {
+  /* Si no hay otra operacion en curso, muestro la ventana que permite cancelar el servicio */
+    propia = ( progreso.activa == FALSE );
+
+    if ( propia == TRUE )
     {
-    /* Sigo buscando */
-      continue;
+      iniciar_operacion ();
+      iniciar_progreso ( "diff service" , 0 );
+      my_replace_wait_box ( "turbodiff: diff service listening on %s" , PIPE_SERVICIO );
+
+    /* Esperar a los clientes no tiene limite de tiempo */
+      progreso.limite = 0;
     }
 
-  /* Recorro todos los basic blocks de funcion1 */
-    for ( cont2 = 0 ; cont2 < funcion2 -> cantidad_basic_blocks ; cont2 ++ )
+  /* Espero de a poco para poder atender la cancelacion */
+    while ( WaitForSingleObject ( overlapped -> hEvent , PERIODO_CANCELACION ) == WAIT_TIMEOUT )
     {
-    /* Levanto el siguiente basic block */
-      basic_block2 = funcion2 -> basic_blocks [ cont2 ];
-
-    /* Si el basic block ya tiene ID */
-      if ( basic_block2 -> association_id != -1 )
+    /* Si el usuario apreto cancelar */
+      if ( my_wasBreak () == TRUE )
       {
-      /* Sigo buscando */
-        continue;
+        cancelar_operacion ();
       }
 
-    /* Si los basic blocks tienen el mismo checksum */
-      if ( basic_block1 -> checksum == basic_block2 -> checksum )
+    /* Si la operacion fue cancelada, aborto la espera */
+      if ( is_operacion_cancelada () == TRUE )
       {
-      /* Si los basic blocks tienen la misma cantidad de instrucciones */
-        if ( basic_block1 -> longitud == basic_block2 -> longitud )
-        {
-        /* Si los basic blocks tienen la misma cantidad de bytes */
-          if ( basic_block1 -> longitud_en_bytes == basic_block2 -> longitud_en_bytes )
-          {
-          /* Si las probabilidades son buenas */
-            if ( get_porcentaje_equivalencia ( 1 , 0 , funcion1 , funcion2 , basic_block1 , basic_block2 ) >= 50 )
-            {
-            /* Recorro el grafo asociando basic blocks desde el basic block raiz */
-              diffear_funcion_recorriendo_grafo ( funcion1 , funcion2 , basic_block1 , basic_block2 , &actual_id );
-            }
-          }
-        }
+        CancelIo ( pipe );
+        cancelada = TRUE;
+        break;
       }
     }
-  }
-
-/////////////////////////////////////////
-
-/* Levanto el basic block raiz de cada funcion */
-  basic_block1 = funcion1 -> basic_blocks [ 0 ];
-  basic_block2 = funcion2 -> basic_blocks [ 0 ];
 
-/* Por las dudas, chequeo los basic blocks raices */
-  if ( ( basic_block1 -> association_id == -1 ) && ( basic_block2 -> association_id == -1 ) )
-  {
-  /* Si la probabilidad es buena */
-    if ( get_porcentaje_equivalencia ( 1 , 0 , funcion1 , funcion2 , basic_block1 , basic_block2 ) > 50 )
+  /* Cierro la ventana */
+    if ( propia == TRUE )
     {
-    /* Averiguo el tipo de cambio en el basic block */
-      change_type = get_change_type ( basic_block1 , basic_block2 );
-
-    /* Asocio los basic blocks ( los pinto de amarillo ) */
-      basic_block1 -> association_id = actual_id;
-      basic_block1 -> change_type = change_type;
-      basic_block2 -> association_id = actual_id;
-      basic_block2 -> change_type = change_type;
-  
-    /* Incremento el ID actual */
-      actual_id ++;
+      terminar_operacion ();
     }
   }
 
-/////////////////////////////////////////
-
-/* Recorro el grafo hacia abajo asociando con la ayuda de IDs */
-  diffear_funcion_usando_ids ( funcion1 , funcion2 , &actual_id );
-
-/////////////////////////////////////////
-
-/* Intento matchear libremente basic blocks por la mejor probabilidad */
-  diffear_funcion_por_mejor_probabilidad ( funcion1 , funcion2 , &actual_id );
-
-  return ( ret );
+/* Levanto el resultado ( si la cancele, espero a que termine de abortar: ERROR_OPERATION_ABORTED ) */
+  return ( GetOverlappedResult ( pipe , overlapped , transferidos , cancelada ) );
 }
 
 /****************************************************************************/
 
-int diffear_funcion_recorriendo_grafo ( Funcion *funcion1 , Funcion *funcion2 , Basic_Block *basic_block1 , Basic_Block *basic_block2 , unsigned int *actual_id )
+int atender_pedido ( HANDLE pipe , List &residentes , Corpus *corpus , char *file_corpus , char *pedido )
 {
-  List basic_blocks_padres1;
-  List basic_blocks_padres2;
-  Basic_Block *basic_block_padre1;
-  Basic_Block *basic_block_padre2;
-  Basic_Block *basic_block_hijo1;
-  Basic_Block *basic_block_hijo2;
-  unsigned int address_hija1;
-  unsigned int address_hija2;
-  unsigned int cont, cont1, cont2;
-  unsigned int change_type;
-  int asociacion_ok = FALSE;
+  char *campos [ MAX_CAMPOS_SERVICIO ];
+  char file_corpus_pedido [ QMAXPATH ];
+  Analisis_Residente *analisis1;
+  Analisis_Residente *analisis2;
+  unsigned int cantidad_campos;
+  unsigned int pos;
   int ret = TRUE;
 
-/* Si los basic blocks tienen la misma cantidad de salidas */
-  if ( basic_block1 -> basic_blocks_hijos -> Len () == basic_block2 -> basic_blocks_hijos -> Len () )
+/* Separo los campos del pedido ( "comando|parametro|..." ) */
+  cantidad_campos = partir_pedido ( pedido , campos , MAX_CAMPOS_SERVICIO );
+
+/* Si el pedido esta vacio */
+  if ( cantidad_campos == 0 )
   {
-  /* Si los basic blocks tienen la misma longitud en instrucciones */
-    if ( basic_block1 -> longitud == basic_block2 -> longitud )
+    responder_pedido ( pipe , "error|empty request\n" );
+  }
+/* Si el cliente quiere terminar el servicio */
+  else if ( strcmp ( campos [ 0 ] , "quit" ) == 0 )
+  {
+    responder_pedido ( pipe , "ok\n" );
+    ret = FALSE;
+  }
+/* Si el cliente quiere dejar un analisis en memoria ( lo recarga si ya estaba ) */
+  else if ( ( strcmp ( campos [ 0 ] , "load" ) == 0 ) && ( cantidad_campos == 2 ) )
+  {
+    analisis1 = get_analisis_residente ( residentes , campos [ 1 ] , TRUE );
+
+    if ( analisis1 != NULL )
     {
-    /* Si los basic blocks tienen la misma longitud en bytes */
-      if ( basic_block1 -> longitud_en_bytes == basic_block2 -> longitud_en_bytes )
+      responder_pedido ( pipe , "ok|%u\n" , analisis1 -> funciones.Len () );
+    }
+    else
+    {
+      responder_pedido ( pipe , "error|cannot load %s\n" , campos [ 1 ] );
+    }
+  }
+/* Si el cliente quiere sacar un analisis de memoria */
+  else if ( ( strcmp ( campos [ 0 ] , "unload" ) == 0 ) && ( cantidad_campos == 2 ) )
+  {
+  /* Busco el analisis entre los residentes */
+    for ( pos = 0 ; pos < residentes.Len () ; pos ++ )
+    {
+      analisis1 = ( Analisis_Residente * ) residentes.Get ( pos );
+
+    /* Si es el analisis pedido */
+      if ( strcmp ( analisis1 -> nombre , campos [ 1 ] ) == 0 )
       {
-      /* Si los basic blocks tienen el mismo checksum */
-        if ( basic_block1 -> checksum == basic_block2 -> checksum )
-        {
-        /* Asocio los basic blocks ( los pinto de blanco ) */
-          basic_block1 -> association_id = *actual_id;
-          basic_block1 -> change_type = 0;
-          basic_block2 -> association_id = *actual_id;
-          basic_block2 -> change_type = 0;
+        liberar_analisis_residente ( analisis1 );
+        residentes.Delete ( pos );
+        break;
+      }
+    }
 
-        /* Incremento el ID actual */
-          ( *actual_id ) ++;
+    responder_pedido ( pipe , "ok\n" );
+  }
+/* Si el cliente quiere comparar 2 analisis completos */
+  else if ( ( strcmp ( campos [ 0 ] , "compare" ) == 0 ) && ( cantidad_campos == 4 ) )
+  {
+  /* Uso los analisis residentes ( solo se levantan los que no estaban en memoria ) */
+    analisis1 = get_analisis_residente ( residentes , campos [ 1 ] , FALSE );
+    analisis2 = get_analisis_residente ( residentes , campos [ 2 ] , FALSE );
 
-        /* Marco el flag de que los pude asociar */
-          asociacion_ok = TRUE;
-        }
-      /* Si los basic blocks NO tienen el mismo checksum */
-        else
-        {
-        /* Asocio los basic blocks ( los pinto de verde ) */
-          basic_block1 -> association_id = *actual_id;
-          basic_block1 -> change_type = 1;
-          basic_block2 -> association_id = *actual_id;
-          basic_block2 -> change_type = 1;
-  
-        /* Incremento el ID actual */
-          ( *actual_id ) ++;
+  /* Si se compara un analisis contra si mismo, el segundo lado se levanta del file */
+  /* ( la comparacion marca las funciones de cada lado y no pueden ser las mismas ) */
+    if ( analisis2 == analisis1 )
+    {
+      analisis2 = NULL;
+    }
 
-        /* Marco el flag de que los pude asociar */
-          asociacion_ok = TRUE;
-        }
-      }
+    if ( ( analisis1 != NULL ) && ( comparar_files ( campos [ 1 ] , campos [ 2 ] , campos [ 3 ] , FALSE , FALSE , FALSE , analisis1 , analisis2 ) == TRUE ) )
+    {
+      responder_pedido ( pipe , "ok|%u\n" , matcheo_1_2.Len () );
     }
-  /* Si es un camino confiable */
-    else if ( is_camino_confiable ( 1 , 0 , funcion1 , funcion2 , basic_block1 , basic_block2 ) == TRUE )
+    else
     {
-    /* Averiguo el tipo de cambio en el basic block */
-      change_type = get_change_type ( basic_block1 , basic_block2 );
+      responder_pedido ( pipe , "error|cannot compare %s and %s\n" , campos [ 1 ] , campos [ 2 ] );
+    }
 
-    /* Asocio los basic blocks ( los pinto de amarillo ) */
-      basic_block1 -> association_id = *actual_id;
-      basic_block1 -> change_type = change_type;
-      basic_block2 -> association_id = *actual_id;
-      basic_block2 -> change_type = change_type;
-  
-    /* Incremento el ID actual */
-      ( *actual_id ) ++;
+  /* Devuelvo las funciones a los residentes ( las sigue liberando el residente ) */
+    if ( analisis1 != NULL )
+    {
+      indice_funciones1.Clear ();
+      funciones1.Clear ();
+    }
 
-    /* Marco el flag de que los pude asociar */
-      asociacion_ok = TRUE;
+    if ( analisis2 != NULL )
+    {
+      indice_funciones2.Clear ();
+      funciones2.Clear ();
     }
+
+  /* Libero la comparacion para el proximo pedido */
+    reiniciar_comparacion ();
   }
+/* Si el cliente quiere diffear 2 funciones */
+  else if ( ( strcmp ( campos [ 0 ] , "diff" ) == 0 ) && ( cantidad_campos == 5 ) )
+  {
+    analisis1 = get_analisis_residente ( residentes , campos [ 1 ] , FALSE );
+    analisis2 = get_analisis_residente ( residentes , campos [ 3 ] , FALSE );
 
-/* Si NO los pude asociar */
-  if ( asociacion_ok == FALSE )
+    if ( ( analisis1 != NULL ) && ( analisis2 != NULL ) )
+    {
+      servir_diff ( pipe , analisis1 , strtoul ( campos [ 2 ] , NULL , 16 ) , analisis2 , strtoul ( campos [ 4 ] , NULL , 16 ) );
+    }
+    else
+    {
+      responder_pedido ( pipe , "error|cannot load the analysis files\n" );
+    }
+  }
+/* Si el cliente quiere buscar una funcion en el corpus */
+  else if ( ( strcmp ( campos [ 0 ] , "search" ) == 0 ) && ( cantidad_campos == 3 ) )
   {
-  /* Dejo de avanzar por este camino */
-    return ( FALSE );
+    analisis1 = get_analisis_residente ( residentes , campos [ 1 ] , FALSE );
+
+  /* El corpus es el del directorio del analisis */
+    armar_path_en_directorio ( campos [ 1 ] , ARCHIVO_CORPUS , file_corpus_pedido );
+
+  /* Si el corpus cargado es de otro directorio */
+    if ( strcmp ( file_corpus , file_corpus_pedido ) != 0 )
+    {
+    /* Cambio el corpus residente */
+      liberar_corpus ( corpus );
+      file_corpus [ 0 ] = '\0';
+
+      if ( levantar_corpus ( file_corpus_pedido , corpus ) == TRUE )
+      {
+        qstrncpy ( file_corpus , file_corpus_pedido , QMAXPATH );
+      }
+    }
+
+    if ( ( analisis1 != NULL ) && ( file_corpus [ 0 ] != '\0' ) )
+    {
+      servir_busqueda ( pipe , corpus , file_corpus , analisis1 , strtoul ( campos [ 2 ] , NULL , 16 ) );
+    }
+    else
+    {
+      responder_pedido ( pipe , "error|cannot load the analysis or the corpus index\n" );
+    }
+  }
+  else
+  {
+    responder_pedido ( pipe , "error|unknown request %s\n" , campos [ 0 ] );
   }
 
-/* Marco los basic blocks como visitados */
-  basic_block1 -> visitado = TRUE;
-  basic_block2 -> visitado = TRUE;
+  return ( ret );
+}
 
-/* Si los basic blocks tienen dintinta cantidad de basic blocks hijos */
-  if ( basic_block1 -> basic_blocks_hijos -> Len () != basic_block2 -> basic_blocks_hijos -> Len () )
+/****************************************************************************/
+
+unsigned int partir_pedido ( char *pedido , char **campos , unsigned int max_campos )
+{
+  unsigned int cantidad_campos = 0;
+  char *separador;
+
+/* Saco el fin de linea */
+  while ( ( strlen ( pedido ) > 0 ) && ( ( pedido [ strlen ( pedido ) - 1 ] == '\n' ) || ( pedido [ strlen ( pedido ) - 1 ] == '\r' ) ) )
   {
-  /* Este camino deja de ser confiable */
-    return ( FALSE );
+    pedido [ strlen ( pedido ) - 1 ] = '\0';
   }
 
-///////////////////////////////////////////
-
-/* Recorro el grafo hacia abajo */
+/* Si el pedido esta vacio */
+  if ( pedido [ 0 ] == '\0' )
+  {
+    return ( 0 );
+  }
 
-/* Recorro todos los basic blocks hijos del basic block donde estoy parado */
-  for ( cont = 0 ; cont < basic_block1 -> basic_blocks_hijos -> Len () ; cont ++ )
+/* Corto el pedido en cada separador */
+  while ( cantidad_campos < max_campos )
   {
-  /* Levanto las direcciones de los proximos basic blocks hijos */
-    address_hija1 = ( unsigned int ) basic_block1 -> basic_blocks_hijos -> Get ( cont );
-    address_hija2 = ( unsigned int ) basic_block2 -> basic_blocks_hijos -> Get ( cont );
+    campos [ cantidad_campos ] = pedido;
+    cantidad_campos ++;
 
-  /* Levanto los basic blocks hijos */
-    basic_block_hijo1 = get_basic_block_from_array ( funcion1 -> basic_blocks , funcion1 -> cantidad_basic_blocks , address_hija1 );
-    basic_block_hijo2 = get_basic_block_from_array ( funcion2 -> basic_blocks , funcion2 -> cantidad_basic_blocks , address_hija2 );
+  /* Busco el proximo separador */
+    separador = strchr ( pedido , '|' );
 
-  /* Si los basic blocks NO fueron visitados */
-    if ( ( basic_block_hijo1 -> visitado == FALSE ) && ( basic_block_hijo2 -> visitado == FALSE ) )
+  /* Si es el ultimo campo */
+    if ( separador == NULL )
     {
-    /* Avanzo por este camino */
-      diffear_funcion_recorriendo_grafo ( funcion1 , funcion2 , basic_block_hijo1 , basic_block_hijo2 , actual_id );
+      break;
     }
+
+  /* Cierro el campo y sigo con el proximo */
+    *separador = '\0';
+    pedido = separador + 1;
   }
 
-///////////////////////////////////////////
+  return ( cantidad_campos );
+}
 
-/* Recorro el grafo hacia arriba */
+/****************************************************************************/
 
-/* Obtengo todos los basic blocks padres de este */
-  get_basic_blocks_padres ( funcion1 , basic_block1 , basic_blocks_padres1 );
-  get_basic_blocks_padres ( funcion2 , basic_block2 , basic_blocks_padres2 );
+int responder_pedido ( HANDLE pipe , const char *format , ... )
+{
+  char respuesta [ MAX_PEDIDO_SERVICIO ];
+  OVERLAPPED overlapped;
+  DWORD escritos;
+  va_list va;
+  int ret;
 
-/* Intento avanzar hacia arriba por el camino de los identicos */
-  for ( cont1 = 0 ; cont1 < basic_blocks_padres1.Len () ; cont1 ++ )
+/* Armo la linea de respuesta */
+  va_start ( va , format );
+  qvsnprintf ( respuesta , MAX_PEDIDO_SERVICIO , format , va );
+  va_end ( va );
+
+/* Se la mando al cliente ( el pipe es asincronico ) */
+  memset ( &overlapped , 0 , sizeof ( OVERLAPPED ) );
+  overlapped.hEvent = CreateEvent ( NULL , TRUE , FALSE , NULL );
+  ret = WriteFile ( pipe , respuesta , strlen ( respuesta ) , &escritos , &overlapped );
+  ret = esperar_pipe ( pipe , &overlapped , ret , &escritos );
+  CloseHandle ( overlapped.hEvent );
+
+  return ( ret );
+}
+
+/****************************************************************************/
+
+Analisis_Residente *get_analisis_residente ( List &residentes , char *file , int recargar )
+{
+  Analisis_Residente *analisis;
+  unsigned int file_version;
+  unsigned int pos;
+  FILE *f;
+
+/* Busco el analisis entre los residentes */
+  for ( pos = 0 ; pos < residentes.Len () ; pos ++ )
   {
-  /* Levanto el siguiente basic block padre */
-    basic_block_padre1 = ( Basic_Block * ) basic_blocks_padres1.Get ( cont1 );
+    analisis = ( Analisis_Residente * ) residentes.Get ( pos );
 
-  /* Recorro todos los basic blocks padres de 2 */
-    for ( cont2 = 0 ; cont2 < basic_blocks_padres2.Len () ; cont2 ++ )
+  /* Si es el analisis pedido */
+    if ( strcmp ( analisis -> nombre , file ) == 0 )
     {
-    /* Levanto el siguiente basic block padre */
-      basic_block_padre2 = ( Basic_Block * ) basic_blocks_padres2.Get ( cont2 );
-
-    /* Si los 2 basic blocks tienen el mismo checksum */
-      if ( basic_block_padre1 -> checksum == basic_block_padre2 -> checksum )
+    /* Si no hace falta volver a levantarlo */
+      if ( recargar == FALSE )
       {
-      /* Si los basic blocks NO fueron visitados */
-        if ( ( basic_block_padre1 -> visitado == FALSE ) && ( basic_block_padre2 -> visitado == FALSE ) )
-        {
-        /* Intento asociar estos basic blocks */
-//          diffear_funcion_recorriendo_grafo ( funcion1 , funcion2 , basic_block_padre1 , basic_block_padre2 , actual_id );
-        }
+        return ( analisis );
       }
+
+    /* Lo saco para levantarlo de nuevo */
+      liberar_analisis_residente ( analisis );
+      residentes.Delete ( pos );
+      break;
     }
   }
 
-///////////////////////////////////////////
+/* Abro el analisis */
+  f = abrir_analisis ( file );
 
-/* Intento avanzar hacia arriba por el camino de los basic blocks verdes */
-  for ( cont1 = 0 ; cont1 < basic_blocks_padres1.Len () ; cont1 ++ )
+/* Si NO pude abrir el analisis o es de otra version */
+  if ( ( f == NULL ) || ( qfread ( f , &file_version , sizeof ( unsigned int ) ) != sizeof ( unsigned int ) ) || ( file_version != turbodiff_version ) )
   {
-  /* Levanto el siguiente basic block padre */
-    basic_block_padre1 = ( Basic_Block * ) basic_blocks_padres1.Get ( cont1 );
-
-  /* Recorro todos los basic blocks padres de 2 */
-    for ( cont2 = 0 ; cont2 < basic_blocks_padres2.Len () ; cont2 ++ )
+    if ( f != NULL )
     {
-    /* Levanto el siguiente basic block padre */
-      basic_block_padre2 = ( Basic_Block * ) basic_blocks_padres2.Get ( cont2 );
-
-    /* Si los 2 basic blocks tienen el mismo checksum */
-      if ( basic_block_padre1 -> longitud_en_bytes == basic_block_padre2 -> longitud_en_bytes )
-      {
-      /* Si los basic blocks NO fueron visitados */
-        if ( ( basic_block_padre1 -> visitado == FALSE ) && ( basic_block_padre2 -> visitado == FALSE ) )
-        {
-        /* Intento asociar estos basic blocks */
-          diffear_funcion_recorriendo_grafo ( funcion1 , funcion2 , basic_block_padre1 , basic_block_padre2 , actual_id );
-        }
-      }
+      qfclose ( f );
     }
+
+  /* Retorno ERROR */
+    return ( NULL );
   }
 
-  return ( ret );
+/* Mensaje al usuario */
+  my_msg ( "diff service: loading %s ...\n" , file );
+
+/* Levanto SOLO el indice ( los cuerpos se levantan por demanda y quedan en memoria ) */
+  analisis = new ( Analisis_Residente );
+  qstrncpy ( analisis -> nombre , file , QMAXPATH );
+  analisis -> f = f;
+  levantar_indice_de_funciones ( f , analisis -> indice_funciones , analisis -> funciones , analisis -> posiciones );
+
+/* Lo agrego a los residentes */
+  residentes.Add ( ( void * ) analisis );
+
+  return ( analisis );
 }
 
 /****************************************************************************/
 
-int diffear_funcion_usando_ids ( Funcion *funcion1 , Funcion *funcion2 , unsigned int *actual_id )
+void liberar_analisis_residente ( Analisis_Residente *analisis )
+{
+/* Cierro el file y libero las funciones */
+  qfclose ( analisis -> f );
+  liberar_funciones ( analisis -> indice_funciones , analisis -> funciones );
+  analisis -> posiciones.Clear ();
+
+/* Libero el analisis */
+  delete ( analisis );
+}
+
+/****************************************************************************/
+
+int servir_diff ( HANDLE pipe , Analisis_Residente *analisis1 , unsigned int address1 , Analisis_Residente *analisis2 , unsigned int address2 )
 {
   Basic_Block *basic_block1;
   Basic_Block *basic_block2;
-  Basic_Block *basic_block_hijo1;
-  Basic_Block *basic_block_hijo2;
-  unsigned int address_hija1;
-  unsigned int address_hija2;
-  int cont1, cont2;
-  unsigned int resultado1;
-  unsigned int resultado2;
-  unsigned int change_type;
-  int ret = TRUE;
+  Funcion *funcion1;
+  Funcion *funcion2;
+  Index asociados2;
+  unsigned int posicion;
+  unsigned int pos;
 
-/* Recorro todos los basic blocks buscando los que estan asociados */
-  for ( cont1 = 0 ; cont1 < funcion1 -> cantidad_basic_blocks ; cont1 ++ )
+/* Busco las 2 funciones */
+  funcion1 = get_estructura_funcion2 ( analisis1 -> indice_funciones , analisis1 -> funciones , address1 );
+  funcion2 = get_estructura_funcion2 ( analisis2 -> indice_funciones , analisis2 -> funciones , address2 );
+
+/* Si alguna funcion no existe */
+  if ( ( funcion1 == NULL ) || ( funcion2 == NULL ) )
   {
-  /* Levanto el siguiente basic block */
-    basic_block1 = funcion1 -> basic_blocks [ cont1 ];
+    responder_pedido ( pipe , "error|the function %x or function %x don't exist\n" , address1 , address2 );
+    return ( FALSE );
+  }
 
-  /* Si el basic block NO tiene ID sigo buscando */
-    if ( basic_block1 -> association_id == -1 )
+/* Levanto los cuerpos de las 2 funciones ( si no estaban levantados ) */
+  levantar_funcion_por_demanda ( analisis1 -> f , analisis1 -> indice_funciones , analisis1 -> funciones , analisis1 -> posiciones , funcion1 );
+  levantar_funcion_por_demanda ( analisis2 -> f , analisis2 -> indice_funciones , analisis2 -> funciones , analisis2 -> posiciones , funcion2 );
+
+/* Asocio los basic blocks de las 2 funciones */
+  diffear_funcion_por_grafo ( funcion1 , funcion2 );
+
+/* Indexo los basic blocks de funcion2 por su asociacion */
+  for ( pos = 0 ; pos < funcion2 -> cantidad_basic_blocks ; pos ++ )
+  {
+    basic_block2 = funcion2 -> basic_blocks [ pos ];
+
+  /* Si el basic block fue asociado */
+    if ( basic_block2 -> association_id != -1 )
     {
-    /* Sigo buscando */
-      continue;
+      asociados2.Add ( basic_block2 -> association_id , ( void * ) basic_block2 );
     }
+    else
+    {
+    /* Basic block que solo esta en funcion2 */
+      responder_pedido ( pipe , "block||%x|-1\n" , basic_block2 -> addr_inicial );
+    }
+  }
 
-  /* Obtengo el basic block PAR */
-    basic_block2 = get_basic_block_by_association_id ( funcion2 , basic_block1 -> association_id );
+/* Respondo una linea por cada basic block de funcion1 ( "block|address1|address2|change_type" ) */
+  for ( pos = 0 ; pos < funcion1 -> cantidad_basic_blocks ; pos ++ )
+  {
+    basic_block1 = funcion1 -> basic_blocks [ pos ];
 
-  /* Si tienen la misma cantidad de basic blocks hijos */
-    if ( basic_block1 -> basic_blocks_hijos -> Len () == basic_block2 -> basic_blocks_hijos -> Len () )
+  /* Si el basic block fue asociado */
+    if ( ( basic_block1 -> association_id != -1 ) && ( asociados2.Find ( basic_block1 -> association_id , &posicion ) == TRUE ) )
     {
-    /* Recorro todos los basic block hijos */
-      for ( cont2 = 0 ; cont2 < basic_block1 -> basic_blocks_hijos -> Len () ; cont2 ++ )
-      {
-      /* Levanto las direcciones hijas */
-        address_hija1 = ( unsigned int ) basic_block1 -> basic_blocks_hijos -> Get ( cont2 );
-        address_hija2 = ( unsigned int ) basic_block2 -> basic_blocks_hijos -> Get ( cont2 );
+      basic_block2 = ( Basic_Block * ) asociados2.Get ( posicion );
+      responder_pedido ( pipe , "block|%x|%x|%i\n" , basic_block1 -> addr_inicial , basic_block2 -> addr_inicial , basic_block1 -> change_type );
+    }
+    else
+    {
+    /* Basic block que solo esta en funcion1 */
+      responder_pedido ( pipe , "block|%x||-1\n" , basic_block1 -> addr_inicial );
+    }
+  }
 
-      /* Levanto los basic blocks hijos */
-        basic_block_hijo1 = get_basic_block_from_array ( funcion1 -> basic_blocks , funcion1 -> cantidad_basic_blocks , address_hija1 );
-        basic_block_hijo2 = get_basic_block_from_array ( funcion2 -> basic_blocks , funcion2 -> cantidad_basic_blocks , address_hija2 );
+/* Fin de la respuesta */
+  responder_pedido ( pipe , "ok|%u|%u\n" , funcion1 -> cantidad_basic_blocks , funcion2 -> cantidad_basic_blocks );
 
-      /* Si los basic blocks NO fueron asociados */
-        if ( ( basic_block_hijo1 -> association_id == -1 ) && ( basic_block_hijo2 -> association_id == -1 ) )
-        {
-        /* Avanzo un nivel en el grafo */
-          resultado1 = get_porcentaje_equivalencia ( 1 , 0 , funcion1 , funcion2 , basic_block_hijo1 , basic_block_hijo2 );
+  return ( TRUE );
+}
 
-        /* Avanzo dos niveles en el grafo */
-          resultado2 = get_porcentaje_equivalencia ( 2 , 0 , funcion1 , funcion2 , basic_block_hijo1 , basic_block_hijo2 );
+/****************************************************************************/
 
-        /* Si el resultado2 me da mejor o igual resultado que 1 */
-          if ( ( resultado1 <= resultado2 ) && ( resultado2 >= 50 ) )
-          {
-          /* Averiguo el tipo de cambio en el basic block */
-            change_type = get_change_type ( basic_block_hijo1 , basic_block_hijo2 );
+int servir_busqueda ( HANDLE pipe , Corpus *corpus , char *file_corpus , Analisis_Residente *analisis , unsigned int address )
+{
+  Entrada_Corpus *entrada;
+  Funcion *funcion;
+  List entradas;
+  List votos;
+  unsigned int candidatos;
+  unsigned int pos;
 
-          /* Asocio los basic blocks ( los pinto de amarillo ) */
-            basic_block_hijo1 -> association_id = *actual_id;
-            basic_block_hijo1 -> change_type = change_type;
-            basic_block_hijo2 -> association_id = *actual_id;
-            basic_block_hijo2 -> change_type = change_type;
+/* Busco la funcion */
+  funcion = get_estructura_funcion2 ( analisis -> indice_funciones , analisis -> funciones , address );
 
-          /* Incremento el ID actual */
-            ( *actual_id ) ++;
+/* Si la funcion no existe */
+  if ( funcion == NULL )
+  {
+    responder_pedido ( pipe , "error|the function %x doesn't exist\n" , address );
+    return ( FALSE );
+  }
 
-          /* Reinicio la busqueda */
-            cont1 = -1;
+/* Levanto su cuerpo y la busco en el corpus */
+  levantar_funcion_por_demanda ( analisis -> f , analisis -> indice_funciones , analisis -> funciones , analisis -> posiciones , funcion );
+  candidatos = rankear_corpus ( corpus , funcion , entradas , votos );
 
-          /* Sigo buscando */
-            break;
-          }
-        }
-      }
-    }
+/* Respondo una linea por candidato ( "match|analisis|address|votos" ) */
+  for ( pos = 0 ; pos < entradas.Len () ; pos ++ )
+  {
+    entrada = ( Entrada_Corpus * ) entradas.Get ( pos );
+    responder_pedido ( pipe , "match|%s|%x|%u\n" , corpus -> archivos [ entrada -> archivo ] , entrada -> address , ( unsigned int ) votos.Get ( pos ) );
   }
 
-  return ( ret );
+/* Fin de la respuesta */
+  responder_pedido ( pipe , "ok|%u\n" , candidatos );
+
+  return ( TRUE );
 }
 
 /****************************************************************************/
+/****************************************************************************/ 
 
-int diffear_funcion_por_mejor_probabilidad ( Funcion *funcion1 , Funcion *funcion2 , unsigned int *actual_id )
+int ejecutar_benchmark ( unsigned int nivel )
 {
-  Basic_Block *basic_block1;
-  Basic_Block *basic_block2;
-  Basic_Block *basic_block_candidato;
-  unsigned int mejor_probabilidad;
-  unsigned int repeticiones;
-  unsigned int probabilidad;
-  unsigned int change_type;
-  int cont1, cont2;
+  Parametros_Sinteticos parametros;
+  Funcion *funcion2;
+  List verdad1;
+  List verdad2;
+  char directorio [ QMAXPATH ];
+  char file1 [ QMAXPATH ];
+  char file2 [ QMAXPATH ];
+  char log_file [ QMAXPATH ];
+  unsigned int cantidad_funciones;
+  unsigned int limite;
+  unsigned int initial_time;
+  unsigned int final_time;
+  unsigned int correctas;
+  unsigned int predichas;
+  unsigned int precision;
+  unsigned int recall;
+  unsigned int pos;
+  unsigned int cont;
   int ret = TRUE;
 
-/* Recorro todos los basic blocks de funcion1 */
-  for ( cont1 = 0 ; cont1 < ( int ) funcion1 -> cantidad_basic_blocks ; cont1 ++ )
-  {
-  /* Levanto el siguiente basic block */
-    basic_block1 = funcion1 -> basic_blocks [ cont1 ];
-
-  /* Si el basic block ya tiene ID */
-    if ( basic_block1 -> association_id != -1 )
-    {
-    /* Sigo buscando */
-      continue;
-    }
+/* Obtengo el directorio temporal */
+  GetTempPath ( QMAXPATH , directorio );
 
-  /* Inicializo las variables */
-    basic_block_candidato = NULL;
-    mejor_probabilidad = 0;
-    repeticiones = 0;
+/* Armo los nombres de los files del benchmark */
+  qsnprintf ( file1 , QMAXPATH , "%sturbodiff_bench1.ana" , directorio );
+  qsnprintf ( file2 , QMAXPATH , "%sturbodiff_bench2.ana" , directorio );
+  qsnprintf ( log_file , QMAXPATH , "%sturbodiff_bench.txt" , directorio );
 
-  /* Recorro todos los basic blocks de funcion2 */
-    for ( cont2 = 0 ; cont2 < ( int ) funcion2 -> cantidad_basic_blocks ; cont2 ++ )
-    {
-    /* Levanto el siguiente basic block */
-      basic_block2 = funcion2 -> basic_blocks [ cont2 ];
+/* Calculo la cantidad maxima de funciones a comparar */
+  for ( cont = BENCHMARK_MIN_ARG , limite = BENCHMARK_MIN_FUNCIONES ; cont < nivel ; cont ++ )
+  {
+    limite = limite * 10;
+  }
 
-    /* Si el basic block ya tiene ID */
-      if ( basic_block2 -> association_id != -1 )
-      {
-      /* Sigo buscando */
-        continue;
-      }
+/* Seteo la forma de los programas generados */
+  parametros.max_basic_blocks = 24;
+  parametros.max_llamados = 4;
+  parametros.porcentaje_saltos = 40;
+  parametros.porcentaje_vtables = 5;
 
-    /* Obtengo la probabilidad */
-      probabilidad = get_porcentaje_equivalencia ( 1 , 0 , funcion1 , funcion2 , basic_block1 , basic_block2 );
+/* Seteo como cambia la version siguiente ( el resto de las funciones se borra ) */
+  parametros.porcentaje_identicas = 80;
+  parametros.porcentaje_patcheadas = 10;
+  parametros.porcentaje_movidas = 5;
+  parametros.porcentaje_nuevas = 5;
 
-    /* Si la probabilidad que tengo es mejor que la anterior */
-      if ( probabilidad > mejor_probabilidad )
-      {
-      /* Tengo un nuevo candidato */
-        basic_block_candidato = basic_block2;
+/* Comparo programas cada vez mas grandes */
+  for ( cantidad_funciones = BENCHMARK_MIN_FUNCIONES ; cantidad_funciones <= limite ; cantidad_funciones = cantidad_funciones * 10 )
+  {
+  /* Mensaje al usuario */
+    my_msg ( "benchmark: generating %u functions ...\n" , cantidad_funciones );
 
-      /* Seteo la nueva probabilidad */
-        mejor_probabilidad = probabilidad;
+  /* Genero las 2 versiones del programa ( la semilla fija hace repetible la corrida ) */
+    parametros.cantidad_funciones = cantidad_funciones;
+    generar_analisis_sintetico ( file1 , file2 , &parametros , cantidad_funciones , verdad1 , verdad2 );
 
-      /* Seteo la cantidad de veces que esta probabilidad se repite */
-        repeticiones = 1;
-      }
-    /* Si la probabilidad que tengo es igual a la anterior */
-      else if ( probabilidad == mejor_probabilidad )
-      {
-      /* Incremento la cantidad de veces que esta probabilidad se repite */
-        repeticiones ++;
-      }
-    }
+  /* Tomo el tiempo actual */
+    initial_time = GetTickCount ();
 
-  /* Si encontre algun basic block */
-    if ( basic_block_candidato != NULL )
+  /* Levanto y comparo los 2 analisis */
+    if ( comparar_files ( file1 , file2 , log_file , FALSE , FALSE , FALSE , NULL , NULL ) == FALSE )
     {
-    /* Si la probabilidad es buena */
-      if ( mejor_probabilidad > 50 )
-      {
-      /* Si solo hubo una sola probabilidad con este valor */
-        if ( repeticiones == 1 )
-        {
-        /* Averiguo el tipo de cambio en el basic block */
-          change_type = get_change_type ( basic_block1 , basic_block_candidato );
+    /* Mensaje de ERROR */
+      my_msg ( "benchmark: cannot compare %s and %s\n" , file1 , file2 );
+
+    /* Retorno ERROR */
+      ret = FALSE;
+      break;
+    }
 
-        /* Asocio los basic blocks ( los pinto de amarillo ) */
-          basic_block1 -> association_id = *actual_id;
-          basic_block1 -> change_type = change_type;
-          basic_block_candidato -> association_id = *actual_id;
-          basic_block_candidato -> change_type = change_type;
+  /* Tomo el tiempo final */
+    final_time = GetTickCount ();
 
-        /* Incremento el ID actual */
-          ( *actual_id ) ++;
+  /* Inicializo los contadores */
+    correctas = 0;
+    predichas = 0;
 
-        /* Empiezo a procesar desde el primer basic block de funcion1 */
-          cont1 = -1;
-        }
+  /* Recorro todas las funciones de la version siguiente */
+    for ( pos = 0 ; pos < funciones2.Len () ; pos ++ )
+    {
+    /* Levanto la siguiente funcion */
+      funcion2 = ( Funcion * ) funciones2.Get ( pos );
+
+    /* Si el differ NO asocio la funcion */
+      if ( funcion2 -> address_equivalente == BADADDR )
+      {
+      /* Sigo con la proxima */
+        continue;
       }
-    }
-  }
 
-  return ( ret );
-}
+    /* Cuento la asociacion */
+      predichas ++;
 
-/****************************************************************************/
+    /* Si la asociacion coincide con la verdad */
+      if ( verdad2.GetPos ( ( void * ) funcion2 -> address , &cont ) == TRUE )
+      {
+        if ( ( unsigned int ) verdad1.Get ( cont ) == funcion2 -> address_equivalente )
+        {
+        /* Cuento la asociacion correcta */
+          correctas ++;
+        }
+      }
+    }
 
-unsigned int get_porcentaje_equivalencia ( unsigned int maxima_profundidad , unsigned int profundidad , Funcion *funcion1 , Funcion *funcion2 , Basic_Block *basic_block1 , Basic_Block *basic_block2 )
-{
-  unsigned int caminos_correctos;
-  unsigned int caminos_inciertos;
-  unsigned int caminos_erroneos;
-  unsigned int topes_encontrados;
-  unsigned int resultado;
+  /* Calculo la precision y el recall ( en milesimas ) */
+    precision = ( predichas > 0 ) ? ( correctas * 1000 ) / predichas : 1000;
+    recall = ( verdad2.Len () > 0 ) ? ( correctas * 1000 ) / verdad2.Len () : 1000;
 
-/* Inicializo las variables estadisticas */
-  caminos_correctos = 0;
-  caminos_inciertos = 0;
-  caminos_erroneos = 0;
+  /* Imprimo el resultado */
+    my_msg ( "benchmark: %u functions, elapsed time: %u.%u sec., peak memory: %u KB, precision: %u.%u%%, recall: %u.%u%%\n" , cantidad_funciones , ( final_time - initial_time ) / 1000 , ( final_time - initial_time ) % 1000 , get_memoria_maxima () , precision / 10 , precision % 10 , recall / 10 , recall % 10 );
 
-/* Averiguo el porcentaje de equivalencia */
-  recorrer_camino_de_equivalencia ( maxima_profundidad , profundidad , funcion1 , funcion2 , basic_block1 , basic_block2 , &caminos_correctos , &caminos_inciertos , &caminos_erroneos );
+  /* Libero la comparacion para la proxima corrida */
+    verdad1.Clear ();
+    verdad2.Clear ();
+    reiniciar_comparacion ();
+  }
 
-/* Calculo la cantidad de veces que tuve que retroceder */
-  topes_encontrados = caminos_correctos + caminos_inciertos + caminos_erroneos;
+/* Libero lo que haya quedado de una corrida fallida */
+  reiniciar_comparacion ();
 
-/* Si NO me da cero */
-  if ( topes_encontrados > 0 )
-  {
-  /* Calculo el porcentaje */
-    resultado = ( caminos_correctos * 100 ) / topes_encontrados;
-    resultado += ( ( caminos_inciertos * 100 ) / 2 ) / topes_encontrados;
-  }
+/* Mensaje al usuario */
+  my_msg ( "done\n" );
 
-  return ( resultado );
+  return ( ret );
 }
 
-/****************************************************************************/
+/****************************************************************************/ 
 
-int recorrer_camino_de_equivalencia ( unsigned int maxima_profundidad , unsigned int profundidad , Funcion *funcion1 , Funcion *funcion2 , Basic_Block *basic_block1 , Basic_Block *basic_block2 , unsigned int *caminos_correctos , unsigned int *caminos_inciertos , unsigned int *caminos_erroneos )
+int generar_analisis_sintetico ( char *file1 , char *file2 , Parametros_Sinteticos *parametros , unsigned int semilla , List &verdad1 , List &verdad2 )
 {
-  Basic_Block *basic_block_hijo1;
-  Basic_Block *basic_block_hijo2;
-  unsigned int address_hija1;
-  unsigned int address_hija2;
-  unsigned int cont;
+  Funcion_Sintetica *funcion_sintetica;
+  Funcion_Sintetica *copia;
+  List sinteticas1;
+  List sinteticas2;
+  List movidas;
+  List indice_funciones_sinteticas;
+  List funciones_sinteticas;
+  unsigned int *direcciones1;
+  unsigned int *direcciones2;
+  unsigned int siguiente_id;
+  unsigned int porcentaje;
+  unsigned int pos;
   int ret = TRUE;
 
-/* Si los basic blocks estan identificados */
-  if ( ( basic_block1 -> association_id != -1 ) && ( basic_block1 -> association_id == basic_block2 -> association_id ) )
+/* Genero la primera version del programa */
+  for ( pos = 0 ; pos < parametros -> cantidad_funciones ; pos ++ )
   {
-  /* Incremento la cantidad de caminos correctos */
-    ( *caminos_correctos ) ++;
-
-  /* Dejo de avanzar por este camino */
-    return ( ret );
+    sinteticas1.Add ( crear_funcion_sintetica ( pos , parametros , &semilla ) );
   }
-/* Si hay una CONDICION INVERTIDA */
-  else if ( is_reverted_condition ( funcion1 , funcion2 , basic_block1 , basic_block2 ) == TRUE )
-  {
-  /* Incremento la cantidad de caminos correctos */
-    ( *caminos_correctos ) ++;
 
-  /* Dejo de avanzar por este camino */
-    return ( ret );
-  }
-/* Si los basic blocks tienen distinto ID */
-  else if ( basic_block1 -> association_id != basic_block2 -> association_id )
-  {
-  /* Incremento la cantidad de caminos que me llevan a basic blocks con distintos IDs */
-    ( *caminos_erroneos ) ++;
+/* Las funciones nuevas tienen ids que no existen en la primera version */
+  siguiente_id = parametros -> cantidad_funciones;
 
-  /* Dejo de avanzar por este camino */
-    return ( ret );
-  }
-/* Si los basic blocks tienen distinta cantidad de basic blocks hijos */
-  else if ( basic_block1 -> basic_blocks_hijos -> Len () != basic_block2 -> basic_blocks_hijos -> Len () )
+/* Genero la version siguiente a partir de la primera */
+  for ( pos = 0 ; pos < sinteticas1.Len () ; pos ++ )
   {
-  /* Incremento la cantidad de caminos que me llevan a basic blocks con distintos IDs */
-    ( *caminos_erroneos ) ++;
+  /* Levanto la siguiente funcion */
+    funcion_sintetica = ( Funcion_Sintetica * ) sinteticas1.Get ( pos );
 
-  /* Dejo de avanzar por este camino */
-    return ( ret );
+  /* Decido que le pasa a la funcion en la version siguiente */
+    porcentaje = numero_aleatorio ( &semilla , 100 );
+
+  /* Si la funcion queda igual */
+    if ( porcentaje < parametros -> porcentaje_identicas )
+    {
+      sinteticas2.Add ( duplicar_funcion_sintetica ( funcion_sintetica ) );
+    }
+  /* Si la funcion se patchea */
+    else if ( porcentaje < parametros -> porcentaje_identicas + parametros -> porcentaje_patcheadas )
+    {
+      copia = duplicar_funcion_sintetica ( funcion_sintetica );
+      patchear_funcion_sintetica ( copia , &semilla );
+      sinteticas2.Add ( copia );
+    }
+  /* Si la funcion se mueve al final del programa */
+    else if ( porcentaje < parametros -> porcentaje_identicas + parametros -> porcentaje_patcheadas + parametros -> porcentaje_movidas )
+    {
+      movidas.Add ( duplicar_funcion_sintetica ( funcion_sintetica ) );
+    }
+
+  /* Si aparece una funcion nueva en este lugar */
+    if ( numero_aleatorio ( &semilla , 100 ) < parametros -> porcentaje_nuevas )
+    {
+      sinteticas2.Add ( crear_funcion_sintetica ( siguiente_id ++ , parametros , &semilla ) );
+    }
   }
-/* Si llegue a la maxima profundidad sin encontrar basic blocks identificados */
-  else if ( profundidad == maxima_profundidad )
+
+/* Agrego las funciones movidas al final */
+  sinteticas2.Append ( &movidas );
+
+/* Creo las tablas con la direccion de cada id en cada version */
+  direcciones1 = ( unsigned int * ) malloc ( siguiente_id * sizeof ( unsigned int ) );
+  direcciones2 = ( unsigned int * ) malloc ( siguiente_id * sizeof ( unsigned int ) );
+  memset ( direcciones1 , 0 , siguiente_id * sizeof ( unsigned int ) );
+  memset ( direcciones2 , 0 , siguiente_id * sizeof ( unsigned int ) );
+
+/* Armo y guardo el analisis de la primera version */
+  materializar_funciones_sinteticas ( sinteticas1 , direcciones1 , indice_funciones_sinteticas , funciones_sinteticas );
+  guardar_funciones ( file1 , funciones_sinteticas );
+  liberar_funciones ( indice_funciones_sinteticas , funciones_sinteticas );
+
+/* Armo y guardo el analisis de la version siguiente */
+  materializar_funciones_sinteticas ( sinteticas2 , direcciones2 , indice_funciones_sinteticas , funciones_sinteticas );
+  guardar_funciones ( file2 , funciones_sinteticas );
+  liberar_funciones ( indice_funciones_sinteticas , funciones_sinteticas );
+
+/* Armo la verdad ( en el orden de la version siguiente, que esta ordenada por direccion ) */
+  for ( pos = 0 ; pos < sinteticas2.Len () ; pos ++ )
   {
-  /* Incremento la cantidad de caminos que no se a donde llevan */
-    ( *caminos_inciertos ) ++;
+  /* Levanto la siguiente funcion */
+    funcion_sintetica = ( Funcion_Sintetica * ) sinteticas2.Get ( pos );
 
-  /* Dejo de avanzar por este camino */
-    return ( ret );
+  /* Si la funcion existe en las 2 versiones */
+    if ( direcciones1 [ funcion_sintetica -> id ] != 0 )
+    {
+    /* Agrego el par a la verdad */
+      verdad1.Add ( ( void * ) direcciones1 [ funcion_sintetica -> id ] );
+      verdad2.Add ( ( void * ) direcciones2 [ funcion_sintetica -> id ] );
+    }
   }
 
-/* Recorro todos los basic block hijos de este */
-  for ( cont = 0 ; cont < basic_block1 -> basic_blocks_hijos -> Len () ; cont ++ )
+/* Libero las funciones sinteticas */
+  for ( pos = 0 ; pos < sinteticas1.Len () ; pos ++ )
   {
-  /* Levanto las direcciones hijas */
-    address_hija1 = ( unsigned int ) basic_block1 -> basic_blocks_hijos -> Get ( cont );
-    address_hija2 = ( unsigned int ) basic_block2 -> basic_blocks_hijos -> Get ( cont );
-
-  /* Levanto los basic blocks hijos */
-    basic_block_hijo1 = get_basic_block_from_array ( funcion1 -> basic_blocks , funcion1 -> cantidad_basic_blocks , address_hija1 );
-    basic_block_hijo2 = get_basic_block_from_array ( funcion2 -> basic_blocks , funcion2 -> cantidad_basic_blocks , address_hija2 );
+    liberar_funcion_sintetica ( ( Funcion_Sintetica * ) sinteticas1.Get ( pos ) );
+  }
 
-  /* Avanzo por este camino */
-    recorrer_camino_de_equivalencia ( maxima_profundidad , profundidad + 1 , funcion1 , funcion2 , basic_block_hijo1 , basic_block_hijo2 , caminos_correctos , caminos_inciertos , caminos_erroneos );
+  for ( pos = 0 ; pos < sinteticas2.Len () ; pos ++ )
+  {
+    liberar_funcion_sintetica ( ( Funcion_Sintetica * ) sinteticas2.Get ( pos ) );
   }
 
+/* Libero las tablas de direcciones */
+  free ( direcciones1 );
+  free ( direcciones2 );
+
   return ( ret );
 }
 
-/****************************************************************************/
+/****************************************************************************/ 
 
-int is_reverted_condition ( Funcion *funcion1 , Funcion *funcion2 , Basic_Block *basic_block1 , Basic_Block *basic_block2 )
+Funcion_Sintetica *crear_funcion_sintetica ( unsigned int id , Parametros_Sinteticos *parametros , unsigned int *semilla )
 {
-  Basic_Block *basic_block_hijo11;
-  Basic_Block *basic_block_hijo12;
-  Basic_Block *basic_block_hijo21;
-  Basic_Block *basic_block_hijo22;
-  unsigned int address_hija11;
-  unsigned int address_hija12;
-  unsigned int address_hija21;
-  unsigned int address_hija22;
-  int ret = FALSE;
+  Funcion_Sintetica *funcion;
+  unsigned int cantidad;
+  unsigned int cont;
 
-/* Si los basic blocks tienen 2 salidas */
-  if ( ( basic_block1 -> basic_blocks_hijos -> Len () == 2 ) && ( basic_block2 -> basic_blocks_hijos -> Len () == 2 ) )
+/* Creo la funcion */
+  funcion = ( Funcion_Sintetica * ) malloc ( sizeof ( Funcion_Sintetica ) );
+  funcion -> id = id;
+
+/* La mayoria de las funciones tienen pocos basic blocks */
+  funcion -> cantidad_basic_blocks = 1 + numero_aleatorio ( semilla , numero_aleatorio ( semilla , parametros -> max_basic_blocks ) + 1 );
+
+/* Creo los basic blocks */
+  funcion -> longitudes = ( unsigned int * ) malloc ( funcion -> cantidad_basic_blocks * sizeof ( unsigned int ) );
+  funcion -> checksums = ( unsigned int * ) malloc ( funcion -> cantidad_basic_blocks * sizeof ( unsigned int ) );
+  funcion -> saltos = ( int * ) malloc ( funcion -> cantidad_basic_blocks * sizeof ( int ) );
+
+/* Recorro todos los basic blocks */
+  for ( cont = 0 ; cont < funcion -> cantidad_basic_blocks ; cont ++ )
   {
-  /* Obtengo las direcciones de los basic blocks hijos */
-    address_hija11 = ( unsigned int ) basic_block1 -> basic_blocks_hijos -> Get ( 0 );
-    address_hija12 = ( unsigned int ) basic_block1 -> basic_blocks_hijos -> Get ( 1 );
-    address_hija21 = ( unsigned int ) basic_block2 -> basic_blocks_hijos -> Get ( 0 );
-    address_hija22 = ( unsigned int ) basic_block2 -> basic_blocks_hijos -> Get ( 1 );
+  /* Seteo la cantidad de instrucciones y el checksum */
+    funcion -> longitudes [ cont ] = 1 + numero_aleatorio ( semilla , 12 );
+    funcion -> checksums [ cont ] = numero_aleatorio ( semilla , 0xffffff );
 
-  /* Obtengo los basic blocks hijos cruzados */
-    basic_block_hijo11 = get_basic_block_from_array ( funcion1 -> basic_blocks , funcion1 -> cantidad_basic_blocks , address_hija11 );
-    basic_block_hijo12 = get_basic_block_from_array ( funcion1 -> basic_blocks , funcion1 -> cantidad_basic_blocks , address_hija12 );
-    basic_block_hijo21 = get_basic_block_from_array ( funcion2 -> basic_blocks , funcion2 -> cantidad_basic_blocks , address_hija21 );
-    basic_block_hijo22 = get_basic_block_from_array ( funcion2 -> basic_blocks , funcion2 -> cantidad_basic_blocks , address_hija22 );
+  /* Inicialmente el basic block solo sigue con el proximo */
+    funcion -> saltos [ cont ] = SIN_SALTO;
 
-  /* Si todos los basic blocks fueron asociados */
-    if ( ( basic_block_hijo11 -> association_id != -1 ) && ( basic_block_hijo12 -> association_id != -1 ) && ( basic_block_hijo21 -> association_id != -1 ) && ( basic_block_hijo22 -> association_id != -1 ) )
+  /* Si el basic block termina con un salto condicional */
+    if ( ( cont + 1 < funcion -> cantidad_basic_blocks ) && ( numero_aleatorio ( semilla , 100 ) < parametros -> porcentaje_saltos ) )
     {
-    /* Si detecto el primer cruce */
-      if ( basic_block_hijo11 -> association_id == basic_block_hijo22 -> association_id )
+    /* Si es el salto de un loop */
+      if ( numero_aleatorio ( semilla , 10 ) == 0 )
       {
-      /* Si detecto el segundo cruce */
-        if ( basic_block_hijo12 -> association_id == basic_block_hijo21 -> association_id )
-        {
-        /* Condicion invertida detectada */
-          ret = TRUE;
-        }
+        funcion -> saltos [ cont ] = numero_aleatorio ( semilla , cont + 1 );
+      }
+    /* Si es un salto hacia adelante */
+      else if ( cont + 2 < funcion -> cantidad_basic_blocks )
+      {
+        funcion -> saltos [ cont ] = cont + 2 + numero_aleatorio ( semilla , funcion -> cantidad_basic_blocks - cont - 2 );
       }
     }
   }
 
-  return ( ret );
-}
-
-/****************************************************************************/
-
-unsigned int get_change_type ( Basic_Block *basic_block1 , Basic_Block *basic_block2 )
-{
-  unsigned int change_type;
+/* Creo los llamados a otras funciones */
+  funcion -> llamados_desde = new ( List );
+  funcion -> llamados_a = new ( List );
+  cantidad = numero_aleatorio ( semilla , parametros -> max_llamados + 1 );
 
-/* Si tienen el checksum IDENTICO */
-  if ( basic_block1 -> checksum == basic_block2 -> checksum )
-  {
-  /* Pinto el basic block de BLANCO */
-    change_type = 0;
-  }
-/* Si tienen la misma cantidad de instrucciones */
-  else if ( basic_block1 -> longitud == basic_block2 -> longitud )
+  for ( cont = 0 ; cont < cantidad ; cont ++ )
   {
-  /* Pinto el basic block de VERDE */
-    change_type = 1;
+    funcion -> llamados_desde -> Add ( ( void * ) numero_aleatorio ( semilla , funcion -> cantidad_basic_blocks ) );
+    funcion -> llamados_a -> Add ( ( void * ) numero_aleatorio ( semilla , parametros -> cantidad_funciones ) );
   }
-  else
+
+/* Creo la vtable que referencia la funcion ( si tiene ) */
+  funcion -> vtable = new ( List );
+
+  if ( numero_aleatorio ( semilla , 100 ) < parametros -> porcentaje_vtables )
   {
-  /* Pinto el basic block de AMARILLO */
-    change_type = 2;
+    cantidad = 2 + numero_aleatorio ( semilla , 7 );
+
+    for ( cont = 0 ; cont < cantidad ; cont ++ )
+    {
+      funcion -> vtable -> Add ( ( void * ) numero_aleatorio ( semilla , parametros -> cantidad_funciones ) );
+    }
   }
 
-  return ( change_type );
+  return ( funcion );
 }
 
-/****************************************************************************/
+/****************************************************************************/ 
 
-int armar_grafo_salida ( char *file , char *output_file , char *disasm_file , Funcion *funcion )
+Funcion_Sintetica *duplicar_funcion_sintetica ( Funcion_Sintetica *funcion )
 {
-  Basic_Block *basic_block;
-  String desensamblado;
-  char basic_block_content [ MAX_DISASM ];
-  char basic_block_label [ 256 ];
-  char vertical_order [ 64 ];
-  char name [ NAME_LEN ];
-  unsigned int cont;
-  unsigned int cont2;
-  int ret = TRUE;
-  FILE *fout;
-  FILE *fdis;
+  Funcion_Sintetica *copia;
+  unsigned int len;
+
+/* Copio la funcion */
+  copia = ( Funcion_Sintetica * ) malloc ( sizeof ( Funcion_Sintetica ) );
+  memcpy ( copia , funcion , sizeof ( Funcion_Sintetica ) );
+
+/* Copio los basic blocks */
+  len = funcion -> cantidad_basic_blocks * sizeof ( unsigned int );
+  copia -> longitudes = ( unsigned int * ) malloc ( len );
+  copia -> checksums = ( unsigned int * ) malloc ( len );
+  copia -> saltos = ( int * ) malloc ( len );
+  memcpy ( copia -> longitudes , funcion -> longitudes , len );
+  memcpy ( copia -> checksums , funcion -> checksums , len );
+  memcpy ( copia -> saltos , funcion -> saltos , len );
+
+/* Copio los llamados y la vtable */
+  copia -> llamados_desde = new ( List );
+  copia -> llamados_desde -> Append ( funcion -> llamados_desde );
+  copia -> llamados_a = new ( List );
+  copia -> llamados_a -> Append ( funcion -> llamados_a );
+  copia -> vtable = new ( List );
+  copia -> vtable -> Append ( funcion -> vtable );
+
+  return ( copia );
+}
 
-/* Reseteo la profundidad de todos los basic blocks */
-  for ( cont = 0 ; cont < funcion -> cantidad_basic_blocks ; cont ++ )
+/****************************************************************************/ 
+
+void patchear_funcion_sintetica ( Funcion_Sintetica *funcion , unsigned int *semilla )
+{
+  unsigned int cantidad;
+  unsigned int pos;
+
+/* Cambio el contenido de algun basic block */
+  pos = numero_aleatorio ( semilla , funcion -> cantidad_basic_blocks );
+  funcion -> checksums [ pos ] ^= 1 + numero_aleatorio ( semilla , 0xffff );
+  funcion -> longitudes [ pos ] ++;
+
+/* La mitad de los patches agrega un basic block al final de la funcion */
+  if ( numero_aleatorio ( semilla , 2 ) == 0 )
   {
-  /* Levanto el siguiente basic block */
-    basic_block = funcion -> basic_blocks [ cont ]; 
+  /* Hago espacio para un basic block mas */
+    cantidad = funcion -> cantidad_basic_blocks + 1;
+    funcion -> longitudes = ( unsigned int * ) realloc ( funcion -> longitudes , cantidad * sizeof ( unsigned int ) );
+    funcion -> checksums = ( unsigned int * ) realloc ( funcion -> checksums , cantidad * sizeof ( unsigned int ) );
+    funcion -> saltos = ( int * ) realloc ( funcion -> saltos , cantidad * sizeof ( int ) );
 
-  /* Seteo la MINIMA profundidad del basic block */
-    basic_block -> profundidad = -1;
+  /* El ultimo basic block sigue en el nuevo */
+    funcion -> longitudes [ cantidad - 1 ] = 1 + numero_aleatorio ( semilla , 12 );
+    funcion -> checksums [ cantidad - 1 ] = numero_aleatorio ( semilla , 0xffffff );
+    funcion -> saltos [ cantidad - 1 ] = SIN_SALTO;
+    funcion -> cantidad_basic_blocks = cantidad;
   }
+}
 
-/* Seteo la profundidad de los basic blocks */
-  setear_maxima_profundidad_hacia_abajo ( 0 , funcion , funcion -> basic_blocks [ 0 ] );
+/****************************************************************************/ 
 
-/* Creo el archivo donde voy a guardar el grafo */
-  fout = qfopen ( output_file , "w" );
+void liberar_funcion_sintetica ( Funcion_Sintetica *funcion )
+{
+/* Libero los basic blocks */
+  free ( funcion -> longitudes );
+  free ( funcion -> checksums );
+  free ( funcion -> saltos );
+
+/* Libero los llamados y la vtable */
+  delete ( funcion -> llamados_desde );
+  delete ( funcion -> llamados_a );
+  delete ( funcion -> vtable );
+
+/* Libero la funcion */
+  free ( funcion );
+}
 
-/* Obtengo el nombre de la funcion */
-  get_formated_name ( funcion , name , NAME_LEN , FALSE );
+/****************************************************************************/ 
 
-/* Genero la salida para graficar el grafo */
-  qfprintf ( fout , "graph:\n" );
-  qfprintf ( fout , "{\n" );
-  qfprintf ( fout , "title: \"%s - %s\"\n" , file , name );
-  qfprintf ( fout , "manhattan_edges: yes\n" );
-  qfprintf ( fout , "layoutalgorithm: mindepth\n" );
-  qfprintf ( fout , "finetuning: no\n" );
-  qfprintf ( fout , "layout_downfactor: 100\n" );
-  qfprintf ( fout , "layout_upfactor: 0\n" );
-  qfprintf ( fout , "layout_nearfactor: 10\n" );
-  qfprintf ( fout , "xlspace: 12\n" );
-  qfprintf ( fout , "yspace: 30\n" );
-  qfprintf ( fout , "\n" );
+void materializar_funciones_sinteticas ( List &sinteticas , unsigned int *direcciones , List &indice_funciones , List &funciones )
+{
+  Funcion_Sintetica *funcion_sintetica;
+  Funcion *funcion;
+  Funcion *funcion_hija;
+  Basic_Block *basic_block;
+  List basic_blocks_funcion;
+  unsigned int address;
+  unsigned int address_hija;
+  unsigned int longitud;
+  unsigned int pos;
+  unsigned int cont, cont2;
 
-/* Abro el archivo con el desensamblado */
-  fdis = qfopen ( disasm_file , "rb" );
+/* Ubico las funciones una detras de la otra */
+  address = BASE_SINTETICA;
 
-/* Escribo todos los basic blocks como nodos */
-  for ( cont = 0 ; cont < funcion -> cantidad_basic_blocks ; cont ++ )
+  for ( pos = 0 ; pos < sinteticas.Len () ; pos ++ )
   {
-  /* Levanto el siguiente basic block */
-    basic_block = funcion -> basic_blocks [ cont ];
+  /* Levanto la siguiente funcion */
+    funcion_sintetica = ( Funcion_Sintetica * ) sinteticas.Get ( pos );
 
-  /* Transformo la direccion del basic block en una etiqueta */
-//    qsnprintf ( basic_block_label , 256 , "%x:%u-%u:%u:%i" , basic_block -> addr_inicial , basic_block -> profundidad , basic_block -> profundidad2 , basic_block -> peso , basic_block -> id );
-    qsnprintf ( basic_block_label , 256 , "%x: chk=%x" , basic_block -> addr_inicial , basic_block -> checksum );
-//    qsnprintf ( basic_block_label , 256 , "%x" , basic_block -> addr_inicial );
+  /* Asigno la direccion de la funcion */
+    direcciones [ funcion_sintetica -> id ] = address;
 
-  /* Me posiciono en la direccion del file que indica el basic block */
-    qfseek ( fdis , basic_block -> pos_file_disasm , SEEK_SET );
+  /* Calculo cuanto ocupa la funcion ( 4 bytes por instruccion ) */
+    for ( cont = 0 , longitud = 0 ; cont < funcion_sintetica -> cantidad_basic_blocks ; cont ++ )
+    {
+      longitud += funcion_sintetica -> longitudes [ cont ] * 4;
+    }
+
+  /* Alineo la proxima funcion a 16 */
+    address += ( longitud + 0xf ) & ~0xf;
+  }
 
-  /* Reinicializo el objeto string */
-    desensamblado.Reset ();
+/* Armo las funciones como si las hubiera analizado */
+  for ( pos = 0 ; pos < sinteticas.Len () ; pos ++ )
+  {
+  /* Levanto la siguiente funcion */
+    funcion_sintetica = ( Funcion_Sintetica * ) sinteticas.Get ( pos );
 
-  /* Levanto las instrucciones del basic block */
-    desensamblado.Load ( fdis );
+  /* Creo la funcion */
+    funcion = ( Funcion * ) malloc ( sizeof ( Funcion ) );
+    memset ( funcion , 0 , sizeof ( Funcion ) );
 
-  /* Saco el ultimo fin de linea de la ultima instruccion */
-    desensamblado.Truncate ( desensamblado.Len () - 1 );
+  /* Seteo los datos generales */
+    funcion -> address = direcciones [ funcion_sintetica -> id ];
+    funcion -> address_equivalente = BADADDR;
+    qsnprintf ( funcion -> name , NAME_LEN , "sub_%X" , funcion -> address );
+    qstrncpy ( funcion -> demangled_name , "" , NAME_LEN );
+    funcion -> graph_ecuation = NULL;
+    funcion -> identica = FALSE;
+    funcion -> patcheada = FALSE;
 
-  /* Seteo el orden vertical donde se va a ubicar el basic block */
-    qsnprintf ( vertical_order , 64 , "vertical_order: %i " , basic_block -> profundidad );
+  /* Creo los basic blocks uno detras del otro */
+    basic_blocks_funcion.Clear ();
+    address = funcion -> address;
 
-  /* Si el basic block NO pudo ser asociado, significa que cambio mucho */
-    if ( basic_block -> association_id == -1 )
+    for ( cont = 0 ; cont < funcion_sintetica -> cantidad_basic_blocks ; cont ++ )
     {
-    /* direccion + instrucciones */
-      qsnprintf ( basic_block_content , MAX_DISASM , "%s\n\n%s" , basic_block_label , desensamblado.Get () );
-
-    /* Declaro el nodo en el grafo */
-      qfprintf ( fout , "node: { title: \"%x\" label: \"%s\" color: red textcolor: black bordercolor: black %s" , basic_block -> addr_inicial , basic_block_content , vertical_order );
+      basic_block = crear_basic_block ( address , funcion_sintetica -> longitudes [ cont ] , funcion_sintetica -> checksums [ cont ] );
+      basic_blocks_funcion.Add ( basic_block );
+      address = basic_block -> addr_final;
     }
-  /* Si el basic block tuvo cambios en la longitud */
-    else if ( basic_block -> change_type == 2 )
-    {
-    /* ID + direccion + instrucciones */
-      qsnprintf ( basic_block_content , MAX_DISASM , "ID_%i\n%s\n\n%s" , basic_block -> association_id , basic_block_label , desensamblado.Get () );
 
-    /* Declaro el nodo en el grafo */
-      qfprintf ( fout , "node: { title: \"%x\" label: \"%s\" color: %s textcolor: black bordercolor: black %s" , basic_block -> addr_inicial , basic_block_content , "yellow" , vertical_order );
-    }
-  /* Si el basic block no cambio o tuvo cambios triviales */
-    else
+  /* Conecto los basic blocks */
+    for ( cont = 0 ; cont < funcion_sintetica -> cantidad_basic_blocks ; cont ++ )
     {
-    /* ID + direccion + instrucciones */
-      qsnprintf ( basic_block_content , MAX_DISASM , "ID_%i\n%s\n\n%s" , basic_block -> association_id , basic_block_label , desensamblado.Get () );
+    /* Levanto el siguiente basic block */
+      basic_block = ( Basic_Block * ) basic_blocks_funcion.Get ( cont );
 
-    /* Declaro el nodo en el grafo */
-      qfprintf ( fout , "node: { title: \"%x\" label: \"%s\" color: %s textcolor: black bordercolor: black %s" , basic_block -> addr_inicial , basic_block_content , ( basic_block -> change_type == 0 ) ? "white":"green" , vertical_order );
+    /* Si NO es el ultimo basic block, sigue en el proximo */
+      if ( cont + 1 < funcion_sintetica -> cantidad_basic_blocks )
+      {
+        basic_block -> basic_blocks_hijos -> Add ( ( void * ) ( ( Basic_Block * ) basic_blocks_funcion.Get ( cont + 1 ) ) -> addr_inicial );
+      }
+
+    /* Si el basic block termina con un salto a otro lado */
+      if ( ( funcion_sintetica -> saltos [ cont ] != SIN_SALTO ) && ( funcion_sintetica -> saltos [ cont ] != ( int ) cont + 1 ) )
+      {
+        basic_block -> basic_blocks_hijos -> Add ( ( void * ) ( ( Basic_Block * ) basic_blocks_funcion.Get ( funcion_sintetica -> saltos [ cont ] ) ) -> addr_inicial );
+      }
     }
 
-  /* Cierro el basic block */
-    qfprintf ( fout , "}\n" );
-  }
+  /* Agrego los llamados a las funciones que existen en esta version */
+    for ( cont = 0 ; cont < funcion_sintetica -> llamados_a -> Len () ; cont ++ )
+    {
+    /* Obtengo la direccion de la funcion llamada */
+      address_hija = direcciones [ ( unsigned int ) funcion_sintetica -> llamados_a -> Get ( cont ) ];
 
-/* Dejo un espacio en blanco */
-  qfprintf ( fout , "\n" );
+    /* Si la funcion llamada fue borrada */
+      if ( address_hija == 0 )
+      {
+        continue;
+      }
 
-/* Escribo todas las conexiones entre los nodos */
-  for ( cont = 0 ; cont < funcion -> cantidad_basic_blocks ; cont ++ )
-  {
-  /* Levanto el siguiente basic block */
-    basic_block = funcion -> basic_blocks [ cont ];
+    /* Agrego el llamado al basic block */
+      basic_block = ( Basic_Block * ) basic_blocks_funcion.Get ( ( unsigned int ) funcion_sintetica -> llamados_desde -> Get ( cont ) );
+      basic_block -> funciones_hijas -> Add ( ( void * ) address_hija );
+      basic_block -> cantidad_referencias ++;
+    }
 
-  /* Si el basic block tiene 2 salidas ( TRUE - FALSE ) */
-    if ( basic_block -> basic_blocks_hijos -> Len () == 2 )
-    {
-    /* Declaro el enlace POSITIVO en el grafo */
-      qfprintf ( fout , "edge: { sourcename: \"%x\" targetname: \"%x\" color: green }\n" , basic_block -> addr_inicial , ( unsigned int ) basic_block -> basic_blocks_hijos -> Get ( 0 ) );
+  /* Agrego la vtable al primer basic block */
+    basic_block = ( Basic_Block * ) basic_blocks_funcion.Get ( 0 );
 
-    /* Declaro el enlace NEGATIVO en el grafo */
-      qfprintf ( fout , "edge: { sourcename: \"%x\" targetname: \"%x\" color: red }\n" , basic_block -> addr_inicial , ( unsigned int ) basic_block -> basic_blocks_hijos -> Get ( 1 ) );
-    }
-  /* Si tiene cero, uno o mas de 2 basic blocks hijos */
-    else
+    for ( cont = 0 ; cont < funcion_sintetica -> vtable -> Len () ; cont ++ )
     {
-    /* Recorro todas las conexiones hacia otros basic blocks hijos */
-      for ( cont2 = 0 ; cont2 < basic_block -> basic_blocks_hijos -> Len () ; cont2 ++ )
+    /* Obtengo la direccion del metodo */
+      address_hija = direcciones [ ( unsigned int ) funcion_sintetica -> vtable -> Get ( cont ) ];
+
+    /* Si el metodo existe en esta version */
+      if ( address_hija != 0 )
       {
-      /* Declaro el enlace en el grafo */
-        qfprintf ( fout , "edge: { sourcename: \"%x\" targetname: \"%x\" color: blue }\n" , basic_block -> addr_inicial , ( unsigned int ) basic_block -> basic_blocks_hijos -> Get ( cont2 ) );
+        basic_block -> ptr_funciones_hijas -> Add ( ( void * ) address_hija );
       }
     }
-  }
-
-/* Fin del grafo */
-  qfprintf ( fout , "}\n" );
 
-/* Cierro el file */
-  qfclose ( fout );
+  /* Calculo la longitud y los checksums de la funcion */
+    funcion -> longitud = calcular_longitud_funcion ( basic_blocks_funcion );
+    calcular_checksum_funcion ( basic_blocks_funcion , &funcion -> checksum , &funcion -> checksum_real );
 
-/* Cierro el file de desensamblado */
-  qfclose ( fdis );
+  /* Las referencias padre se resuelven cuando estan todas las funciones */
+    funcion -> cantidad_referencias_padre = 0;
+    funcion -> basic_blocks_padres = NULL;
+    funcion -> referencias_padre_x_vtable = new ( List );
 
-  return ( ret );
-}
+  /* Copio los basic blocks a la funcion */
+    funcion -> cantidad_basic_blocks = basic_blocks_funcion.Len ();
+    funcion -> basic_blocks = ( Basic_Block ** ) malloc ( sizeof ( Basic_Block * ) * funcion -> cantidad_basic_blocks );
 
-/****************************************************************************/
+    for ( cont = 0 ; cont < basic_blocks_funcion.Len () ; cont ++ )
+    {
+      funcion -> basic_blocks [ cont ] = ( Basic_Block * ) basic_blocks_funcion.Get ( cont );
+    }
 
-void mostrar_grafo ( char *output_file )
-{
-  char ida_path [ MAX_PATH ];
-  char wingraph_line [ MAX_PATH * 2 ];
-  char *pathname;
+  /* Calculo la geometria igual que en analizar_funcion */
+  /* ( las direcciones sinteticas estan fuera del IDB, no tienen referencias en IDA ) */
+    funcion -> cantidad_referencias_hijas = calcular_cantidad_hijos ( funcion );
+    funcion -> conexiones_internas = calcular_cantidad_conexiones_internas ( funcion );
+    setear_profundidad_hacia_abajo ( 0 , funcion , funcion -> basic_blocks [ 0 ] );
+    setear_profundidad_hacia_arriba ( -1 , funcion , NULL );
+    funcion -> peso = setear_peso_a_basic_blocks ( 0 , funcion , funcion -> basic_blocks [ 0 ] );
+    calcular_dominadores ( funcion );
+    poner_ids_a_basic_blocks ( 0 , funcion , funcion -> basic_blocks [ 0 ] );
 
-/* Averiguo la ruta del IDA */
-  GetModuleFileName ( GetModuleHandle ( NULL ) , ida_path , MAX_PATH );
+  /* Calculo el hash del contenido */
+    funcion -> hash_contenido = calcular_hash ( HASH_INICIAL , funcion_sintetica -> checksums , funcion_sintetica -> cantidad_basic_blocks * sizeof ( unsigned int ) );
+    funcion -> hash_contenido = calcular_hash ( funcion -> hash_contenido , funcion_sintetica -> longitudes , funcion_sintetica -> cantidad_basic_blocks * sizeof ( unsigned int ) );
 
-/* Busco la ultima barra */
-  pathname = strrchr ( ida_path , '\\' );
+  /* Agrego la funcion a la lista */
+    indice_funciones.Add ( ( void * ) funcion -> address );
+    funciones.Add ( funcion );
+  }
 
-/* Si encontro la ultima barra */
-  if ( pathname != NULL )
+/* Resuelvo las referencias padre de todas las funciones */
+  for ( pos = 0 ; pos < funciones.Len () ; pos ++ )
   {
-  /* Reemplazo 'idag.exe' por 'wingraph.exe' */
-    qsnprintf ( pathname , MAX_PATH - strlen ( ida_path ) , "\\%s" , "wingraph32.exe -remove" );
+  /* Levanto la siguiente funcion */
+    funcion = ( Funcion * ) funciones.Get ( pos );
 
-  /* Armo el path completo para pasarle al graficador de IDA */
-    qsnprintf ( wingraph_line , MAX_PATH * 2 , "%s %s" , ida_path , output_file );
+  /* Recorro todos los basic blocks */
+    for ( cont = 0 ; cont < funcion -> cantidad_basic_blocks ; cont ++ )
+    {
+    /* Levanto el siguiente basic block */
+      basic_block = funcion -> basic_blocks [ cont ];
 
-  /* Muestro el grafo */
-    WinExec ( wingraph_line , SW_SHOW );
+    /* Recorro todos los llamados del basic block */
+      for ( cont2 = 0 ; cont2 < basic_block -> funciones_hijas -> Len () ; cont2 ++ )
+      {
+      /* Levanto la funcion llamada */
+        funcion_hija = get_estructura_funcion2 ( indice_funciones , funciones , ( unsigned int ) basic_block -> funciones_hijas -> Get ( cont2 ) );
+
+      /* Hago espacio para un basic block padre mas */
+        funcion_hija -> basic_blocks_padres = ( Basic_Block_Padre * ) realloc ( funcion_hija -> basic_blocks_padres , ( funcion_hija -> cantidad_referencias_padre + 1 ) * sizeof ( Basic_Block_Padre ) );
+
+      /* Seteo la referencia padre */
+        funcion_hija -> basic_blocks_padres [ funcion_hija -> cantidad_referencias_padre ].funcion = NULL;
+        funcion_hija -> basic_blocks_padres [ funcion_hija -> cantidad_referencias_padre ].direccion_funcion = funcion -> address;
+        funcion_hija -> basic_blocks_padres [ funcion_hija -> cantidad_referencias_padre ].referencia = basic_block -> addr_inicial;
+        funcion_hija -> basic_blocks_padres [ funcion_hija -> cantidad_referencias_padre ].checksum = 0;
+        funcion_hija -> cantidad_referencias_padre ++;
+      }
+
+    /* Recorro todos los metodos de la vtable del basic block */
+      for ( cont2 = 0 ; cont2 < basic_block -> ptr_funciones_hijas -> Len () ; cont2 ++ )
+      {
+      /* Levanto el metodo */
+        funcion_hija = get_estructura_funcion2 ( indice_funciones , funciones , ( unsigned int ) basic_block -> ptr_funciones_hijas -> Get ( cont2 ) );
+
+      /* Si la referencia x vtable NO esta registrada */
+        if ( funcion_hija -> referencias_padre_x_vtable -> Find ( ( void * ) funcion -> address ) == FALSE )
+        {
+          funcion_hija -> referencias_padre_x_vtable -> Add ( ( void * ) funcion -> address );
+        }
+      }
+    }
+  }
+
+/* Actualizo todos los checksums de los basic blocks padres de las funciones */
+  for ( pos = 0 ; pos < funciones.Len () ; pos ++ )
+  {
+    actualizar_checksum_basic_blocks_padres ( indice_funciones , funciones , ( Funcion * ) funciones.Get ( pos ) );
   }
 }
 
-/****************************************************************************/
+/****************************************************************************/ 
 
-int buscar_funciones_equivalentes ( char *file1 , char *file2 )
+Basic_Block *crear_basic_block ( unsigned int addr_inicial , unsigned int longitud , unsigned int checksum )
 {
-  List funciones_a_recorrer;
-  Funcion *funcion1;
-  Funcion *funcion2;
-  unsigned int address1 = 0;
-  unsigned int address2 = 0;
-  unsigned int cont;
-  unsigned int matcheds;
-  int ret = TRUE;
-  FILE *f1;
-  FILE *f2;
+  Basic_Block *basic_block;
 
-/* Intento abrir los 2 files de relevamiento */
-  f1 = qfopen ( file1 , "rb" );
-  f2 = qfopen ( file2 , "rb" );
+/* Creo el basic block */
+  basic_block = ( Basic_Block * ) malloc ( sizeof ( Basic_Block ) );
+
+/* Seteo los limites del basic block ( 4 bytes por instruccion ) */
+  basic_block -> addr_inicial = addr_inicial;
+  basic_block -> addr_final = addr_inicial + ( longitud * 4 );
+  basic_block -> longitud = longitud;
+  basic_block -> longitud_en_bytes = longitud * 4;
+  basic_block -> checksum = checksum;
+
+/* Seteo las profundidades */
+  basic_block -> profundidad = MAX_INT;
+  basic_block -> profundidad2 = 0xffffffff;
+
+/* Inicializo el peso y la posicion en el file de desensamblado */
+  basic_block -> peso = 0;
+  basic_block -> pos_file_disasm = 0;
+
+/* Inicializo la estructura de dominadores y loops */
+  basic_block -> dominador = SIN_DOMINADOR;
+  basic_block -> profundidad_loop = 0;
+  basic_block -> cabecera_loop = FALSE;
+
+/* Inicializo las properties usadas para recorrer el grafo y diffear */
+  basic_block -> visitado = FALSE;
+  basic_block -> id = -1;
+  basic_block -> association_id = -1;
+  basic_block -> change_type = -1;
+
+/* Creo las listas de conexiones */
+  basic_block -> basic_blocks_hijos = new ( List );
+  basic_block -> cantidad_referencias = 0;
+  basic_block -> funciones_hijas = new ( List );
+  basic_block -> ptr_funciones_hijas = new ( List );
+  basic_block -> cadena_basic_blocks = new ( List );
+  basic_block -> anclas = new ( List );
 
-/* Si NO pude abrir alguno de los files */
-  if ( f1 == NULL || f2 == NULL )
-  {
-  /* Mensaje de ERROR al usuario */
-    my_msg ( "ERROR: analized files don't exist !\n" );
+  return ( basic_block );
+}
 
-  /* Salgo */
-    return ( FALSE );
-  }
+/****************************************************************************/ 
 
-/* Mensaje al usuario */
-  my_msg ( "loading analized files ...\n" );
+unsigned int numero_aleatorio ( unsigned int *semilla , unsigned int maximo )
+{
+/* Si no hay rango */
+  if ( maximo == 0 )
+  {
+    return ( 0 );
+  }
 
-/* Levanto los 2 archivos */
-  levantar_funciones ( f1 , indice_funciones1 , funciones1 );
-  levantar_funciones ( f2 , indice_funciones2 , funciones2 );
+/* Avanzo el generador congruencial */
+  *semilla = ( *semilla * 1103515245 ) + 12345;
 
-/* Mientras el usuario ingrese direcciones */
-//  while ( my_askaddr ( ( unsigned long int * ) &address , "This option searchs an equivalent function in the second file" ) == TRUE )
+/* Descarto los bits bajos que son los menos aleatorios */
+  return ( ( *semilla >> 8 ) % maximo );
+}
 
-  while ( my_AskUsingForm ( funciones_a_buscar , &address1 , &address2 ) == TRUE )
-  {
-  /* Si la direccion es del file1 */
-    if ( address1 != 0 )
-    {
-    /* Lista de funciones a usar */
-      funciones_a_recorrer = funciones2;
+/****************************************************************************/ 
 
-    /* Busco la funcion ingresada por el usuario */
-      funcion1 = get_estructura_funcion2 ( indice_funciones1 , funciones1 , address1 );
-    }
-  /* Si la direccion es del file2 */
-    else
-    {
-    /* Lista de funciones a usar */
-      funciones_a_recorrer = funciones1;
+unsigned int get_memoria_maxima ( void )
+{
+  BOOL ( WINAPI *my_GetProcessMemoryInfo ) ( HANDLE , PROCESS_MEMORY_COUNTERS * , DWORD );
+  PROCESS_MEMORY_COUNTERS contadores;
+  unsigned int memoria = 0;
 
-    /* Busco la funcion ingresada por el usuario */
-      funcion1 = get_estructura_funcion2 ( indice_funciones2 , funciones2 , address2 );
-    }
+/* Resuelvo el simbolo */
+  my_GetProcessMemoryInfo = ( BOOL ( WINAPI * ) ( HANDLE , PROCESS_MEMORY_COUNTERS * , DWORD ) ) GetProcAddress ( LoadLibrary ( "psapi.dll" ) , "GetProcessMemoryInfo" );
 
-  /* Si la direccion ingresada por el usuario NO existe */
-    if ( funcion1 == NULL )
-    {
-    /* Mensaje de ERROR */
-      my_msg ( "ERROR: the function doesn't exist\n" );
+/* Si pude resolver el simbolo y leer la memoria del proceso */
+  if ( ( my_GetProcessMemoryInfo != NULL ) && ( my_GetProcessMemoryInfo ( GetCurrentProcess () , &contadores , sizeof ( contadores ) ) == TRUE ) )
+  {
+  /* Retorno el pico de memoria en KB */
+    memoria = contadores.PeakWorkingSetSize / 1024;
+  }
 
-    /* Reinicializo las direcciones a buscar */
-      address1 = 0;  
-      address2 = 0;  
+  return ( memoria );
+}
 
-    /* Continuo pidiendo direcciones */
-      continue;
-    }
+/****************************************************************************/ 
 
-  /* Inicializo el contador de matcheos */
-    matcheds = 0;
+void liberar_funciones ( List &indice_funciones , List &funciones )
+{
+  Funcion *funcion;
+  Basic_Block *basic_block;
+  unsigned int pos;
+  unsigned int cont;
 
-  /* Mensaje al usuario */
-    my_msg ( "searching equivalent functions of %x\n" , funcion1 -> address );
+/* Recorro todas las funciones */
+  for ( pos = 0 ; pos < funciones.Len () ; pos ++ )
+  {
+  /* Levanto la siguiente funcion */
+    funcion = ( Funcion * ) funciones.Get ( pos );
 
-  /* Recorro todas las funciones de programa2 */
-    for ( cont = 0 ; cont < funciones_a_recorrer.Len () ; cont ++ )
+  /* Si el cuerpo de la funcion esta levantado */
+    if ( funcion -> basic_blocks != NULL )
     {
-    /* Levanto la siguiente funcion */
-      funcion2 = ( Funcion * ) funciones_a_recorrer.Get ( cont );
-
-    /* Si las 2 funciones tienen la misma geometria */
-      if ( strcmp ( funcion1 -> graph_ecuation , funcion2 -> graph_ecuation ) == 0 )
+    /* Libero todos los basic blocks */
+      for ( cont = 0 ; cont < funcion -> cantidad_basic_blocks ; cont ++ )
       {
-      /* Imprimo la posible funcion equivalente */
-        my_msg ( "equivalent matched: %x\n" , funcion2 -> address );
-
-      /* Incremento el contador de matcheos */
-        matcheds ++;
+        basic_block = funcion -> basic_blocks [ cont ];
+        delete ( basic_block -> basic_blocks_hijos );
+        delete ( basic_block -> funciones_hijas );
+        delete ( basic_block -> ptr_funciones_hijas );
+        delete ( basic_block -> cadena_basic_blocks );
+        delete ( basic_block -> anclas );
+        free ( basic_block );
       }
-    }
 
-  /* Si NO encontre funciones equivalentes */
-    if ( matcheds == 0 )
-    {
-    /* Mensaje al usuario */
-      my_msg ( "equivalent function not found\n" );
-    }
-    else
-    {
-    /* Fin de la busqueda */
-      my_msg ( "done\n" );
+      free ( funcion -> basic_blocks );
     }
 
-  /* Reinicializo las direcciones a buscar */
-    address1 = 0;  
-    address2 = 0;  
+  /* Libero las referencias y la ecuacion del grafo */
+    free ( funcion -> basic_blocks_padres );
+    delete ( funcion -> referencias_padre_x_vtable );
+    free ( funcion -> graph_ecuation );
+
+  /* Libero la funcion */
+    free ( funcion );
   }
 
-/* Cierro los 2 files */
-  qfclose ( f1 );
-  qfclose ( f2 );
+/* Vacio las listas */
+  indice_funciones.Clear ();
+  funciones.Clear ();
+}
 
-  return ( ret );
+/****************************************************************************/ 
+
+void reiniciar_comparacion ( void )
+{
+  unsigned int pos;
+
+/* Libero las filas de resultados ( apuntan a las funciones ) */
+  liberar_filas_resultados ();
+
+/* Libero las huellas de una comparacion previa */
+  liberar_huellas ();
+
+/* Libero los grafos y las funciones de los 2 programas */
+  liberar_grafo_programa ( &grafo_programa1 );
+  liberar_grafo_programa ( &grafo_programa2 );
+  liberar_funciones ( indice_funciones1 , funciones1 );
+  liberar_funciones ( indice_funciones2 , funciones2 );
+
+/* Las posiciones de los cuerpos eran de los archivos anteriores */
+  posiciones_funciones1.Clear ();
+  posiciones_funciones2.Clear ();
+
+/* Vacio las listas de la comparacion */
+  funciones1_reconocidas.Clear ();
+  funciones2_reconocidas.Clear ();
+  funciones1_matcheadas.Clear ();
+  funciones2_matcheadas.Clear ();
+  funciones1_geometricamente_identicas.Clear ();
+  funciones2_geometricamente_identicas.Clear ();
+  funciones1_cambiadas.Clear ();
+  funciones2_cambiadas.Clear ();
+  funciones1_irreconocidas.Clear ();
+  funciones2_irreconocidas.Clear ();
+  funciones1_levantadas.Clear ();
+  funciones2_levantadas.Clear ();
+  funciones1_intermedias.Clear ();
+  funciones1_intermedias2.Clear ();
+
+/* Libero las estadisticas de las fases */
+  for ( pos = 0 ; pos < estadisticas_fases.Len () ; pos ++ )
+  {
+    free ( estadisticas_fases.Get ( pos ) );
+  }
+
+  estadisticas_fases.Clear ();
 }
 
 /****************************************************************************/